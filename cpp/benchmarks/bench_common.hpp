@@ -0,0 +1,152 @@
+/**
+ * @file bench_common.hpp
+ * @brief Minimal benchmark harness shared by the bench_*.cpp suites
+ *
+ * Each benchmark is a function taking a State. It is registered once and
+ * run once for every input size it lists:
+ *
+ *   DAIW_BENCHMARK(simd, apply_gain, 64, 1024, 65536) {
+ *       std::vector<float> buffer(state.size(), 0.5f);
+ *       state.measure([&] { simd::apply_gain(buffer.data(), buffer.size(), 0.9f); },
+ *                     state.size(), state.size() * sizeof(float));
+ *   }
+ *
+ * measure() calibrates an iteration count and times several batches. It
+ * reports the median and minimum ns per iteration plus item and byte rates.
+ * bench_main.cpp writes the results as CSV or JSON.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace daiw::bench {
+
+// =============================================================================
+// Results & Options
+// =============================================================================
+
+struct Result {
+    std::string suite;
+    std::string name;
+    size_t size = 0;
+    size_t iterations = 0;          // Per batch
+    double ns_median = 0.0;         // Per iteration
+    double ns_min = 0.0;            // Per iteration
+    double items_per_second = 0.0;  // From the median
+    double bytes_per_second = 0.0;  // From the median (0 if not reported)
+};
+
+struct Options {
+    double min_time_seconds = 0.2;  // Total measuring time per benchmark/size
+    size_t repetitions = 5;         // Timed batches per benchmark/size
+};
+
+// =============================================================================
+// State
+// =============================================================================
+
+/// Prevent the optimizer from discarding a computed value
+template<typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+class State {
+public:
+    State(size_t size, const Options& options) : size_(size), options_(options) {}
+
+    /// Input size this run was registered with
+    size_t size() const { return size_; }
+
+    /**
+     * Time body() repeatedly.
+     * items_per_iteration / bytes_per_iteration describe one call of body()
+     * and are used for the throughput columns.
+     */
+    template<typename Body>
+    void measure(Body&& body, double items_per_iteration = 1.0,
+                 double bytes_per_iteration = 0.0) {
+        using Clock = std::chrono::steady_clock;
+
+        // Calibrate: grow the batch until one batch takes a slice of the budget
+        const double batch_target =
+            options_.min_time_seconds / static_cast<double>(options_.repetitions);
+        size_t iterations = 1;
+        for (;;) {
+            const auto start = Clock::now();
+            for (size_t i = 0; i < iterations; ++i) body();
+            const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+            if (elapsed >= batch_target || iterations >= (size_t{1} << 30)) break;
+            const double scale = elapsed > 0.0 ? batch_target / elapsed : 16.0;
+            iterations = static_cast<size_t>(static_cast<double>(iterations) *
+                                             (scale > 16.0 ? 16.0 : scale * 1.2)) + 1;
+        }
+
+        samples_ns_.clear();
+        for (size_t r = 0; r < options_.repetitions; ++r) {
+            const auto start = Clock::now();
+            for (size_t i = 0; i < iterations; ++i) body();
+            const double elapsed =
+                std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            samples_ns_.push_back(elapsed / static_cast<double>(iterations));
+        }
+
+        iterations_ = iterations;
+        items_per_iteration_ = items_per_iteration;
+        bytes_per_iteration_ = bytes_per_iteration;
+    }
+
+    /// Summarise the last measure() call
+    Result result(const std::string& suite, const std::string& name) const;
+
+private:
+    size_t size_;
+    Options options_;
+    size_t iterations_ = 0;
+    double items_per_iteration_ = 1.0;
+    double bytes_per_iteration_ = 0.0;
+    std::vector<double> samples_ns_;
+};
+
+// =============================================================================
+// Registry
+// =============================================================================
+
+using BenchmarkFn = void (*)(State&);
+
+struct Benchmark {
+    const char* suite;
+    const char* name;
+    BenchmarkFn fn;
+    std::vector<size_t> sizes;
+};
+
+/// All registered benchmarks, in registration order per translation unit
+std::vector<Benchmark>& registry();
+
+struct Registration {
+    Registration(const char* suite, const char* name, BenchmarkFn fn,
+                 std::vector<size_t> sizes) {
+        registry().push_back({suite, name, fn, std::move(sizes)});
+    }
+};
+
+} // namespace daiw::bench
+
+/// Define and register a benchmark run once per listed size
+#define DAIW_BENCHMARK(suite, name, ...)                                          \
+    static void bench_##suite##_##name(::daiw::bench::State& state);              \
+    static const ::daiw::bench::Registration bench_registration_##suite##_##name( \
+        #suite, #name, &bench_##suite##_##name, {__VA_ARGS__});                   \
+    static void bench_##suite##_##name(::daiw::bench::State& state)
@@ -0,0 +1,170 @@
+/**
+ * @file bench_core.cpp
+ * @brief Lock-free queue, ring buffer and memory pool benchmarks
+ *
+ * Single-threaded cases measure the raw cost of an operation. The threaded
+ * cases measure end-to-end transfer throughput. Their size is the number of
+ * items moved per iteration, including thread start-up.
+ */
+
+#include "bench_common.hpp"
+#include "daiw/core.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace daiw;
+
+namespace {
+
+constexpr size_t QUEUE_CAPACITY = 1 << 14;
+constexpr size_t RING_CAPACITY = 1 << 16;
+constexpr size_t POOL_CAPACITY = 4096;
+
+struct PoolObject {
+    uint64_t payload[8];
+    explicit PoolObject(uint64_t value) { payload[0] = value; }
+};
+
+} // namespace
+
+// =============================================================================
+// SPSC Queue
+// =============================================================================
+
+DAIW_BENCHMARK(core, spsc_push_pop, 16, 256, 4096) {
+    auto queue = std::make_unique<SPSCQueue<uint64_t, QUEUE_CAPACITY>>();
+    state.measure([&] {
+        for (size_t i = 0; i < state.size(); ++i) queue->push(i);
+        while (auto item = queue->pop()) bench::do_not_optimize(*item);
+    }, static_cast<double>(state.size()));
+}
+
+DAIW_BENCHMARK(core, spsc_two_threads, 1 << 14, 1 << 17, 1 << 20) {
+    auto queue = std::make_unique<SPSCQueue<uint64_t, QUEUE_CAPACITY>>();
+    const uint64_t count = state.size();
+
+    state.measure([&] {
+        std::thread consumer([&] {
+            uint64_t received = 0;
+            while (received < count) {
+                if (auto item = queue->pop()) {
+                    bench::do_not_optimize(*item);
+                    ++received;
+                }
+            }
+        });
+        for (uint64_t i = 0; i < count; ++i) {
+            while (!queue->push(i)) std::this_thread::yield();
+        }
+        consumer.join();
+    }, static_cast<double>(count));
+}
+
+// =============================================================================
+// MPSC Queue
+// =============================================================================
+
+DAIW_BENCHMARK(core, mpsc_push_pop, 16, 256, 4096) {
+    auto queue = std::make_unique<MPSCQueue<uint64_t, QUEUE_CAPACITY>>();
+    state.measure([&] {
+        for (size_t i = 0; i < state.size(); ++i) queue->push(i);
+        while (auto item = queue->pop()) bench::do_not_optimize(*item);
+    }, static_cast<double>(state.size()));
+}
+
+DAIW_BENCHMARK(core, mpsc_four_producers, 1 << 14, 1 << 17, 1 << 20) {
+    constexpr int NUM_PRODUCERS = 4;
+    auto queue = std::make_unique<MPSCQueue<uint64_t, QUEUE_CAPACITY>>();
+    const uint64_t per_producer = state.size() / NUM_PRODUCERS;
+    const uint64_t total = per_producer * NUM_PRODUCERS;
+
+    state.measure([&] {
+        std::vector<std::thread> producers;
+        for (int p = 0; p < NUM_PRODUCERS; ++p) {
+            producers.emplace_back([&] {
+                for (uint64_t i = 0; i < per_producer; ++i) {
+                    while (!queue->push(i)) std::this_thread::yield();
+                }
+            });
+        }
+
+        uint64_t received = 0;
+        while (received < total) {
+            if (queue->pop()) ++received;
+        }
+        for (auto& t : producers) t.join();
+    }, static_cast<double>(total));
+}
+
+// =============================================================================
+// Ring Buffer
+// =============================================================================
+
+DAIW_BENCHMARK(core, ring_buffer_write_read, 64, 512, 4096) {
+    auto ring = std::make_unique<RingBuffer<float, RING_CAPACITY>>();
+    std::vector<float> input(state.size(), 0.25f);
+    std::vector<float> output(state.size());
+
+    state.measure([&] {
+        ring->write(input.data(), input.size());
+        ring->read(output.data(), output.size());
+        bench::do_not_optimize(output.data());
+    }, static_cast<double>(state.size()),
+       static_cast<double>(2 * state.size() * sizeof(float)));
+}
+
+DAIW_BENCHMARK(core, ring_buffer_two_threads, 64, 512, 4096) {
+    // Stream 1 << 18 samples in chunks of state.size()
+    constexpr size_t TOTAL = 1 << 18;
+    auto ring = std::make_unique<RingBuffer<float, RING_CAPACITY>>();
+    const size_t chunk = state.size();
+
+    state.measure([&] {
+        std::thread reader([&] {
+            std::vector<float> output(chunk);
+            size_t received = 0;
+            while (received < TOTAL) {
+                received += ring->read(output.data(), chunk);
+            }
+            bench::do_not_optimize(output.data());
+        });
+
+        std::vector<float> input(chunk, 0.5f);
+        size_t sent = 0;
+        while (sent < TOTAL) {
+            const size_t n = ring->write(input.data(), std::min(chunk, TOTAL - sent));
+            if (n == 0) std::this_thread::yield();
+            sent += n;
+        }
+        reader.join();
+    }, static_cast<double>(TOTAL), static_cast<double>(TOTAL * sizeof(float)));
+}
+
+// =============================================================================
+// Memory Pool
+// =============================================================================
+
+DAIW_BENCHMARK(core, memory_pool_acquire_release, 1, 64, 1024, 4096) {
+    auto pool = std::make_unique<MemoryPool<PoolObject, POOL_CAPACITY>>();
+    std::vector<PoolObject*> live(state.size());
+
+    state.measure([&] {
+        for (size_t i = 0; i < live.size(); ++i) live[i] = pool->acquire(i);
+        for (PoolObject* obj : live) pool->release(obj);
+        bench::do_not_optimize(live.data());
+    }, static_cast<double>(state.size()));
+}
+
+DAIW_BENCHMARK(core, new_delete_baseline, 1, 64, 1024, 4096) {
+    std::vector<PoolObject*> live(state.size());
+
+    state.measure([&] {
+        for (size_t i = 0; i < live.size(); ++i) live[i] = new PoolObject(i);
+        for (PoolObject* obj : live) delete obj;
+        bench::do_not_optimize(live.data());
+    }, static_cast<double>(state.size()));
+}
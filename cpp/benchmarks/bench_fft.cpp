@@ -0,0 +1,66 @@
+/**
+ * @file bench_fft.cpp
+ * @brief Shared FFT engine benchmarks
+ *
+ * Sizes are transform points, from a short analysis frame to a long
+ * convolution partition. Items are points per transform.
+ */
+
+#include "bench_common.hpp"
+#include "daiw/fft.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace daiw;
+
+namespace {
+
+std::vector<float> make_signal(size_t n, unsigned seed = 42) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> signal(n);
+    for (auto& s : signal) s = dist(rng);
+    return signal;
+}
+
+} // namespace
+
+// =============================================================================
+// Transforms
+// =============================================================================
+
+DAIW_BENCHMARK(fft, complex_round_trip, 256, 1024, 4096, 32768) {
+    // Forward + inverse keeps the data bounded across iterations
+    const auto* plan = dsp::fft_plan(state.size());
+    const auto re = make_signal(state.size(), 1);
+    const auto im = make_signal(state.size(), 2);
+    std::vector<dsp::Complex> data(state.size());
+    for (size_t i = 0; i < data.size(); ++i) data[i] = dsp::Complex(re[i], im[i]);
+    state.measure([&] {
+        plan->forward(data.data());
+        plan->inverse(data.data());
+        bench::do_not_optimize(data.data());
+    }, static_cast<double>(state.size()));
+}
+
+DAIW_BENCHMARK(fft, real_forward, 256, 1024, 4096, 32768) {
+    const auto* plan = dsp::fft_plan(state.size());
+    const auto signal = make_signal(state.size());
+    std::vector<dsp::Complex> spectrum(plan->num_bins());
+    state.measure([&] {
+        plan->forward_real(signal.data(), spectrum.data());
+        bench::do_not_optimize(spectrum.data());
+    }, static_cast<double>(state.size()));
+}
+
+DAIW_BENCHMARK(fft, real_round_trip, 256, 1024, 4096, 32768) {
+    const auto* plan = dsp::fft_plan(state.size());
+    auto signal = make_signal(state.size());
+    dsp::FftScratch scratch;
+    state.measure([&] {
+        plan->forward_real(signal.data(), scratch.spectrum());
+        plan->inverse_real(scratch.spectrum(), signal.data());
+        bench::do_not_optimize(signal.data());
+    }, static_cast<double>(state.size()));
+}
@@ -0,0 +1,181 @@
+/**
+ * @file bench_harmony.cpp
+ * @brief Chord detection, key detection and voice leading benchmarks
+ *
+ * Sizes are detections (chords), notes (keys) or chords voiced per
+ * iteration, so the items_per_second column is directly comparable across
+ * sizes.
+ */
+
+#include "bench_common.hpp"
+#include "daiw/harmony.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace daiw;
+
+namespace {
+
+std::vector<harmony::PitchClassSet> make_pitch_class_sets(size_t count) {
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> pitch_class(0, 11);
+    std::uniform_int_distribution<int> note_count(3, 5);
+
+    std::vector<harmony::PitchClassSet> sets(count);
+    for (auto& pcs : sets) {
+        const int notes = note_count(rng);
+        for (int n = 0; n < notes; ++n) pcs.add(pitch_class(rng));
+    }
+    return sets;
+}
+
+std::vector<MidiNote> make_melody(size_t count) {
+    // C major scale with occasional chromatic passing tones
+    static constexpr int SCALE[] = {0, 2, 4, 5, 7, 9, 11};
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<int> degree(0, 6);
+    std::uniform_int_distribution<int> chromatic(0, 9);
+
+    std::vector<MidiNote> notes(count);
+    for (auto& note : notes) {
+        const int pc = SCALE[degree(rng)] + (chromatic(rng) == 0 ? 1 : 0);
+        note = static_cast<MidiNote>(60 + pc);
+    }
+    return notes;
+}
+
+std::vector<harmony::ChordTones> make_progression(size_t count) {
+    // Diatonic triads in C, root position
+    static constexpr int SCALE[] = {0, 2, 4, 5, 7, 9, 11};
+    std::mt19937 rng(31);
+    std::uniform_int_distribution<int> degree(0, 6);
+
+    std::vector<harmony::ChordTones> chords(count);
+    for (auto& chord : chords) {
+        const int d = degree(rng);
+        for (int third = 0; third < 3; ++third) chord.pitch_classes.add(SCALE[(d + 2 * third) % 7]);
+        chord.bass = SCALE[d];
+    }
+    return chords;
+}
+
+} // namespace
+
+DAIW_BENCHMARK(harmony, chord_detect, 1, 64, 1024) {
+    const harmony::ChordDetector detector;
+    const auto sets = make_pitch_class_sets(state.size());
+
+    state.measure([&] {
+        for (const auto& pcs : sets) {
+            auto detection = detector.detect(pcs);
+            bench::do_not_optimize(detection.confidence);
+        }
+    }, static_cast<double>(state.size()));
+}
+
+DAIW_BENCHMARK(harmony, chord_lookup, 1, 64, 1024) {
+    const auto sets = make_pitch_class_sets(state.size());
+
+    state.measure([&] {
+        for (const auto& pcs : sets) {
+            const auto& match = harmony::ChordDetector::lookup(pcs);
+            bench::do_not_optimize(match.confidence);
+        }
+    }, static_cast<double>(state.size()));
+}
+
+DAIW_BENCHMARK(harmony, chord_detect_from_notes, 1, 64, 1024) {
+    const harmony::ChordDetector detector;
+    const auto sets = make_pitch_class_sets(state.size());
+
+    // Voice each set as MIDI notes in the middle register
+    std::vector<std::vector<MidiNote>> voicings;
+    voicings.reserve(sets.size());
+    for (const auto& pcs : sets) {
+        std::vector<MidiNote> notes;
+        for (int pc = 0; pc < 12; ++pc) {
+            if (pcs.contains(pc)) notes.push_back(static_cast<MidiNote>(60 + pc));
+        }
+        voicings.push_back(std::move(notes));
+    }
+
+    state.measure([&] {
+        for (const auto& notes : voicings) {
+            auto detection = detector.detect_from_notes(notes);
+            bench::do_not_optimize(detection.confidence);
+        }
+    }, static_cast<double>(state.size()));
+}
+
+DAIW_BENCHMARK(harmony, key_detect_accumulated, 16, 256, 4096) {
+    harmony::KeyDetector detector;
+    const auto melody = make_melody(state.size());
+
+    state.measure([&] {
+        detector.clear();
+        for (MidiNote note : melody) detector.accumulate(note);
+        auto detection = detector.detect_accumulated();
+        bench::do_not_optimize(detection.confidence);
+    }, static_cast<double>(state.size()));
+}
+
+DAIW_BENCHMARK(harmony, key_detect_histogram, 1, 64, 1024) {
+    const harmony::KeyDetector detector;
+
+    std::mt19937 rng(29);
+    std::uniform_real_distribution<float> weight(0.0f, 1.0f);
+    std::vector<std::array<float, harmony::NOTES_PER_OCTAVE>> histograms(state.size());
+    for (auto& histogram : histograms) {
+        for (auto& bin : histogram) bin = weight(rng);
+    }
+
+    state.measure([&] {
+        for (const auto& histogram : histograms) {
+            auto detection = detector.detect(histogram);
+            bench::do_not_optimize(detection.confidence);
+        }
+    }, static_cast<double>(state.size()));
+}
+
+DAIW_BENCHMARK(harmony, key_tracker_advance, 16, 256, 4096) {
+    const auto melody = make_melody(state.size());
+    harmony::KeyTracker tracker;
+
+    // One advance per note, as a per-track realtime follower would run
+    state.measure([&] {
+        for (MidiNote note : melody) {
+            tracker.add_note(note);
+            auto change = tracker.advance(0.125f);
+            bench::do_not_optimize(change);
+        }
+    }, static_cast<double>(state.size()));
+}
+
+DAIW_BENCHMARK(harmony, voice_lead, 16, 256) {
+    const auto chords = make_progression(state.size());
+    const harmony::VoiceLeader leader;
+    harmony::Voicing start;
+    leader.voice(chords.front(), start);
+
+    // Chord-by-chord, as live reharmonization would call it
+    state.measure([&] {
+        harmony::Voicing current = start;
+        for (const auto& chord : chords) {
+            harmony::Voicing next;
+            if (leader.lead(current, chord, next)) current = next;
+        }
+        bench::do_not_optimize(current);
+    }, static_cast<double>(state.size()));
+}
+
+DAIW_BENCHMARK(harmony, voice_lead_progression, 8, 64) {
+    const auto chords = make_progression(state.size());
+    harmony::VoiceLeader leader;
+    std::vector<harmony::Voicing> voicings(state.size());
+
+    state.measure([&] {
+        int broken = leader.lead_progression(chords.data(), static_cast<int>(chords.size()), voicings.data());
+        bench::do_not_optimize(broken);
+    }, static_cast<double>(state.size()));
+}
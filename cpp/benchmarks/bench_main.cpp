@@ -1,30 +1,231 @@
 /**
  * @file bench_main.cpp
  * @brief Benchmark suite entry point
+ *
+ * Usage:
+ *   daiw_benchmarks [--format=csv|json] [--filter=<text>] [--out=<file>]
+ *                   [--min-time=<seconds>] [--repetitions=<n>] [--list]
+ *
+ * --filter matches "suite/name" as a substring. Results go to stdout unless
+ * --out is given; progress goes to stderr so the output stays machine-readable.
  */
 
+#include "bench_common.hpp"
+#include "daiw/core.hpp"
+#include "daiw/simd.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
 #include <iostream>
-#include <chrono>
-
-// Simple benchmark timing utility
-class Timer {
-public:
-    void start() { start_ = std::chrono::high_resolution_clock::now(); }
-    double stop() {
-        auto end = std::chrono::high_resolution_clock::now();
-        return std::chrono::duration<double, std::milli>(end - start_).count();
-    }
-private:
-    std::chrono::high_resolution_clock::time_point start_;
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE__) || defined(_M_X64)
+    #include <xmmintrin.h>
+#endif
+
+namespace daiw::bench {
+
+std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+Result State::result(const std::string& suite, const std::string& name) const {
+    Result r;
+    r.suite = suite;
+    r.name = name;
+    r.size = size_;
+    r.iterations = iterations_;
+
+    if (samples_ns_.empty()) return r;
+
+    std::vector<double> sorted = samples_ns_;
+    std::sort(sorted.begin(), sorted.end());
+    const size_t mid = sorted.size() / 2;
+    r.ns_median = sorted.size() % 2 ? sorted[mid] : 0.5 * (sorted[mid - 1] + sorted[mid]);
+    r.ns_min = sorted.front();
+
+    if (r.ns_median > 0.0) {
+        r.items_per_second = items_per_iteration_ * 1e9 / r.ns_median;
+        r.bytes_per_second = bytes_per_iteration_ * 1e9 / r.ns_median;
+    }
+    return r;
+}
+
+} // namespace daiw::bench
+
+namespace {
+
+using daiw::bench::Result;
+
+enum class Format { CSV, JSON };
+
+struct Config {
+    Format format = Format::CSV;
+    std::string filter;
+    std::string out_path;
+    bool list_only = false;
+    daiw::bench::Options options;
 };
 
+const char* compiler_name() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc";
+#else
+    return "unknown";
+#endif
+}
+
+std::string json_escape(std::string_view text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+void write_csv(std::ostream& os, const std::vector<Result>& results) {
+    os << "suite,name,size,iterations,ns_median,ns_min,items_per_second,bytes_per_second\n";
+    for (const auto& r : results) {
+        os << r.suite << ',' << r.name << ',' << r.size << ',' << r.iterations << ','
+           << r.ns_median << ',' << r.ns_min << ',' << r.items_per_second << ','
+           << r.bytes_per_second << '\n';
+    }
+}
+
+void write_json(std::ostream& os, const std::vector<Result>& results) {
+    char timestamp[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    os << "{\n"
+       << "  \"context\": {\n"
+       << "    \"version\": \"" << daiw::VERSION << "\",\n"
+       << "    \"simd\": \"" << daiw::simd::simd_level_name(daiw::simd::get_simd_level()) << "\",\n"
+       << "    \"compiler\": \"" << json_escape(compiler_name()) << "\",\n"
+       << "    \"timestamp\": \"" << timestamp << "\"\n"
+       << "  },\n"
+       << "  \"benchmarks\": [\n";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        os << "    {\"suite\": \"" << json_escape(r.suite) << "\", "
+           << "\"name\": \"" << json_escape(r.name) << "\", "
+           << "\"size\": " << r.size << ", "
+           << "\"iterations\": " << r.iterations << ", "
+           << "\"ns_median\": " << r.ns_median << ", "
+           << "\"ns_min\": " << r.ns_min << ", "
+           << "\"items_per_second\": " << r.items_per_second << ", "
+           << "\"bytes_per_second\": " << r.bytes_per_second << "}"
+           << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+
+    os << "  ]\n}\n";
+}
+
+/// Flush denormals to zero like an audio callback does, so decaying gains stay fast
+void disable_denormals() {
+#if defined(__SSE__) || defined(_M_X64)
+    _mm_setcsr(_mm_getcsr() | 0x8040);  // FTZ | DAZ
+#endif
+}
+
+bool parse_args(int argc, char** argv, Config& config) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        const auto value_of = [&](std::string_view prefix) {
+            return std::string(arg.substr(prefix.size()));
+        };
+
+        if (arg == "--format=csv") {
+            config.format = Format::CSV;
+        } else if (arg == "--format=json") {
+            config.format = Format::JSON;
+        } else if (arg.rfind("--filter=", 0) == 0) {
+            config.filter = value_of("--filter=");
+        } else if (arg.rfind("--out=", 0) == 0) {
+            config.out_path = value_of("--out=");
+        } else if (arg.rfind("--min-time=", 0) == 0) {
+            config.options.min_time_seconds = std::atof(value_of("--min-time=").c_str());
+        } else if (arg.rfind("--repetitions=", 0) == 0) {
+            config.options.repetitions =
+                std::max<size_t>(1, std::strtoul(value_of("--repetitions=").c_str(), nullptr, 10));
+        } else if (arg == "--list") {
+            config.list_only = true;
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n"
+                      << "Usage: " << argv[0]
+                      << " [--format=csv|json] [--filter=<text>] [--out=<file>]"
+                         " [--min-time=<seconds>] [--repetitions=<n>] [--list]\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 int main(int argc, char** argv) {
-    std::cout << "DAiW Benchmarks v1.0.0\n";
-    std::cout << "======================\n\n";
+    Config config;
+    if (!parse_args(argc, argv, config)) {
+        return 1;
+    }
+
+    disable_denormals();
+
+    std::vector<Result> results;
+
+    for (const auto& bench : daiw::bench::registry()) {
+        const std::string full_name = std::string(bench.suite) + "/" + bench.name;
+        if (!config.filter.empty() && full_name.find(config.filter) == std::string::npos) {
+            continue;
+        }
+
+        for (size_t size : bench.sizes) {
+            if (config.list_only) {
+                std::cout << full_name << '/' << size << '\n';
+                continue;
+            }
+
+            std::cerr << "Running " << full_name << '/' << size << "...\n";
+            daiw::bench::State state(size, config.options);
+            bench.fn(state);
+            results.push_back(state.result(bench.suite, bench.name));
+        }
+    }
+
+    if (config.list_only) {
+        return 0;
+    }
 
-    // Run benchmarks (would be implemented in other files)
-    std::cout << "Benchmark suite placeholder.\n";
-    std::cout << "Build with -DDAIW_BUILD_BENCHMARKS=ON to run full suite.\n";
+    std::ostringstream output;
+    if (config.format == Format::JSON) {
+        write_json(output, results);
+    } else {
+        write_csv(output, results);
+    }
+
+    if (config.out_path.empty()) {
+        std::cout << output.str();
+    } else {
+        std::ofstream file(config.out_path);
+        if (!file) {
+            std::cerr << "Cannot write " << config.out_path << "\n";
+            return 1;
+        }
+        file << output.str();
+    }
 
     return 0;
 }
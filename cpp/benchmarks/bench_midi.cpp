@@ -0,0 +1,246 @@
+/**
+ * @file bench_midi.cpp
+ * @brief MIDI sequence and Standard MIDI File benchmarks
+ *
+ * Sizes are events per sequence/file. Range queries ask for one bar
+ * (4 * PPQ ticks) at a pseudo-random position, like a playhead would; the
+ * cursor benchmark plays the whole sequence as a loop, one block per call.
+ *
+ * The corpus benchmarks scan a directory of .mid files through the
+ * memory-mapped streaming reader and report MB/s in bytes_per_second. They
+ * use DAIW_BENCH_MIDI_DIR when set; otherwise they generate size files into
+ * a temporary directory.
+ */
+
+#include "bench_common.hpp"
+#include "daiw/midi.hpp"
+#include "daiw/midi_stream.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace daiw;
+
+namespace {
+
+constexpr Tick TICKS_PER_NOTE = 120;
+
+midi::Sequence make_sequence(size_t num_events) {
+    midi::Sequence sequence;
+    for (size_t i = 0; i < num_events; ++i) {
+        sequence.add_event(midi::note_on(static_cast<Tick>(i) * TICKS_PER_NOTE, 0,
+                                         static_cast<MidiNote>(36 + i % 48), 100));
+    }
+    sequence.sort();
+    return sequence;
+}
+
+void put_u32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void put_variable_length(std::vector<uint8_t>& out, uint32_t value) {
+    uint8_t bytes[4];
+    int count = 0;
+    do {
+        bytes[count++] = static_cast<uint8_t>(value & 0x7F);
+        value >>= 7;
+    } while (value > 0 && count < 4);
+
+    while (count-- > 0) {
+        out.push_back(static_cast<uint8_t>(bytes[count] | (count > 0 ? 0x80 : 0x00)));
+    }
+}
+
+/// Build an in-memory format 1 SMF with num_events note on/off events over 4 tracks
+std::vector<uint8_t> make_smf(size_t num_events) {
+    constexpr uint16_t NUM_TRACKS = 4;
+    std::vector<uint8_t> file = {'M', 'T', 'h', 'd'};
+    put_u32(file, 6);
+    file.insert(file.end(), {0x00, 0x01, 0x00, NUM_TRACKS, 0x01, 0xE0});  // format 1, PPQ 480
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> note(36, 84);
+
+    for (uint16_t track = 0; track < NUM_TRACKS; ++track) {
+        std::vector<uint8_t> body;
+
+        // Track name meta event
+        body.insert(body.end(), {0x00, 0xFF, 0x03, 0x05, 'T', 'r', 'a', 'c', 'k'});
+
+        const size_t track_events = num_events / NUM_TRACKS / 2;
+        for (size_t i = 0; i < track_events; ++i) {
+            const auto pitch = static_cast<uint8_t>(note(rng));
+            put_variable_length(body, i == 0 ? 0 : 60);
+            body.insert(body.end(), {static_cast<uint8_t>(0x90 | track), pitch, 100});
+            put_variable_length(body, 60);
+            body.insert(body.end(), {pitch, 0});  // Running status note off
+        }
+
+        // End of track
+        body.insert(body.end(), {0x00, 0xFF, 0x2F, 0x00});
+
+        file.insert(file.end(), {'M', 'T', 'r', 'k'});
+        put_u32(file, static_cast<uint32_t>(body.size()));
+        file.insert(file.end(), body.begin(), body.end());
+    }
+
+    return file;
+}
+
+struct Corpus {
+    std::vector<std::string> paths;
+    size_t total_bytes = 0;
+};
+
+/// .mid files under DAIW_BENCH_MIDI_DIR, or num_files generated ones
+Corpus make_corpus(size_t num_files) {
+    namespace fs = std::filesystem;
+
+    fs::path dir;
+    if (const char* env = std::getenv("DAIW_BENCH_MIDI_DIR")) {
+        dir = env;
+    } else {
+        dir = fs::temp_directory_path() / ("daiw_bench_midi_" + std::to_string(num_files));
+        fs::create_directories(dir);
+        for (size_t i = 0; i < num_files; ++i) {
+            const fs::path path = dir / ("file_" + std::to_string(i) + ".mid");
+            if (fs::exists(path)) continue;
+            const auto file = make_smf(2000 + (i % 8) * 1000);
+            std::ofstream(path, std::ios::binary)
+                .write(reinterpret_cast<const char*>(file.data()),
+                       static_cast<std::streamsize>(file.size()));
+        }
+    }
+
+    Corpus corpus;
+    for (const auto& entry : fs::recursive_directory_iterator(dir)) {
+        const auto ext = entry.path().extension();
+        if (entry.is_regular_file() && (ext == ".mid" || ext == ".midi")) {
+            corpus.paths.push_back(entry.path().string());
+            corpus.total_bytes += static_cast<size_t>(entry.file_size());
+        }
+    }
+    return corpus;
+}
+
+} // namespace
+
+// =============================================================================
+// Sequence
+// =============================================================================
+
+DAIW_BENCHMARK(midi, sequence_get_events_in_range, 1000, 10000, 100000) {
+    const auto sequence = make_sequence(state.size());
+    const Tick bar = 4 * static_cast<Tick>(sequence.ppq());
+    const Tick length = sequence.length();
+
+    std::vector<MidiEvent> out;
+    out.reserve(64);
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<Tick> position(0, length);
+
+    state.measure([&] {
+        const Tick start = position(rng);
+        out.clear();
+        sequence.get_events_in_range(start, start + bar, std::back_inserter(out));
+        bench::do_not_optimize(out.data());
+    });
+}
+
+DAIW_BENCHMARK(midi, sequence_cursor_advance_looped, 1000, 10000, 100000) {
+    const auto sequence = make_sequence(state.size());
+    const Tick block = static_cast<Tick>(sequence.ppq()) / 4;  // ~one audio block
+    midi::SequenceCursor cursor(sequence);
+
+    std::vector<MidiEvent> out;
+    out.reserve(64);
+
+    state.measure([&] {
+        out.clear();
+        cursor.advance_looped(block, 0, sequence.length(), std::back_inserter(out));
+        bench::do_not_optimize(out.data());
+    });
+}
+
+DAIW_BENCHMARK(midi, sequence_sort, 1000, 10000, 100000) {
+    auto sequence = make_sequence(state.size());
+
+    // Reverse-ordered input so each call does real work
+    std::vector<MidiEvent> reversed(sequence.events().rbegin(), sequence.events().rend());
+    state.measure([&] {
+        sequence.mutable_events() = reversed;
+        sequence.sort();
+        bench::do_not_optimize(sequence.events().data());
+    }, static_cast<double>(state.size()));
+}
+
+// =============================================================================
+// Standard MIDI File Reader
+// =============================================================================
+
+DAIW_BENCHMARK(midi, file_reader_read, 1000, 10000, 100000) {
+    const auto file = make_smf(state.size());
+
+    state.measure([&] {
+        midi::FileReader reader;
+        const bool ok = reader.read(file.data(), file.size());
+        bench::do_not_optimize(ok);
+        bench::do_not_optimize(reader.get_sequence(0));
+    }, static_cast<double>(state.size()), static_cast<double>(file.size()));
+}
+
+DAIW_BENCHMARK(midi, file_stream_merged, 1000, 10000, 100000) {
+    const auto file = make_smf(state.size());
+
+    state.measure([&] {
+        midi::StreamingFileReader reader;
+        reader.open(file.data(), file.size());
+        size_t count = 0;
+        for (const auto& e : reader.merged()) {
+            count += e.event.data1;
+        }
+        bench::do_not_optimize(count);
+    }, static_cast<double>(state.size()), static_cast<double>(file.size()));
+}
+
+// =============================================================================
+// Corpus Scans (MB/s)
+// =============================================================================
+
+DAIW_BENCHMARK(midi, corpus_file_reader, 64) {
+    const auto corpus = make_corpus(state.size());
+
+    state.measure([&] {
+        std::vector<uint8_t> buffer;
+        for (const auto& path : corpus.paths) {
+            std::ifstream in(path, std::ios::binary);
+            buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            midi::FileReader reader;
+            bench::do_not_optimize(reader.read(buffer.data(), buffer.size()));
+        }
+    }, static_cast<double>(corpus.paths.size()), static_cast<double>(corpus.total_bytes));
+}
+
+DAIW_BENCHMARK(midi, corpus_stream_merged, 64) {
+    const auto corpus = make_corpus(state.size());
+
+    state.measure([&] {
+        midi::StreamingFileReader reader;
+        for (const auto& path : corpus.paths) {
+            if (!reader.open(path)) continue;
+            size_t notes = 0;
+            for (const auto& e : reader.merged()) {
+                notes += e.event.isNoteOn() ? 1 : 0;
+            }
+            bench::do_not_optimize(notes);
+        }
+    }, static_cast<double>(corpus.paths.size()), static_cast<double>(corpus.total_bytes));
+}
@@ -1,6 +1,130 @@
 /**
  * @file bench_simd.cpp
  * @brief SIMD operation benchmarks
+ *
+ * Sizes are samples per call, from a small host block to a long offline
+ * buffer that no longer fits in L1/L2.
  */
 
-// Placeholder for SIMD benchmarks
+#include "bench_common.hpp"
+#include "daiw/simd.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace daiw;
+
+namespace {
+
+std::vector<float> make_signal(size_t n, unsigned seed = 42) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> signal(n);
+    for (auto& s : signal) s = dist(rng);
+    return signal;
+}
+
+constexpr double bytes(size_t n, size_t streams) {
+    return static_cast<double>(n * streams * sizeof(float));
+}
+
+} // namespace
+
+// =============================================================================
+// Buffer Operations
+// =============================================================================
+
+DAIW_BENCHMARK(simd, apply_gain, 64, 512, 4096, 65536) {
+    auto buffer = make_signal(state.size());
+    state.measure([&] {
+        simd::apply_gain(buffer.data(), buffer.size(), 0.999f);
+        bench::do_not_optimize(buffer.data());
+    }, static_cast<double>(state.size()), bytes(state.size(), 2));
+}
+
+DAIW_BENCHMARK(simd, mix_buffers, 64, 512, 4096, 65536) {
+    auto dst = make_signal(state.size(), 1);
+    const auto src = make_signal(state.size(), 2);
+    state.measure([&] {
+        simd::mix_buffers(dst.data(), src.data(), dst.size(), 0.5f);
+        bench::do_not_optimize(dst.data());
+    }, static_cast<double>(state.size()), bytes(state.size(), 3));
+}
+
+DAIW_BENCHMARK(simd, copy_with_gain, 64, 512, 4096, 65536) {
+    std::vector<float> dst(state.size());
+    const auto src = make_signal(state.size());
+    state.measure([&] {
+        simd::copy_with_gain(dst.data(), src.data(), dst.size(), 0.5f);
+        bench::do_not_optimize(dst.data());
+    }, static_cast<double>(state.size()), bytes(state.size(), 2));
+}
+
+DAIW_BENCHMARK(simd, clear_buffer, 64, 512, 4096, 65536) {
+    std::vector<float> buffer(state.size());
+    state.measure([&] {
+        simd::clear_buffer(buffer.data(), buffer.size());
+        bench::do_not_optimize(buffer.data());
+    }, static_cast<double>(state.size()), bytes(state.size(), 1));
+}
+
+DAIW_BENCHMARK(simd, find_peak, 64, 512, 4096, 65536) {
+    const auto buffer = make_signal(state.size());
+    state.measure([&] {
+        float peak = simd::find_peak(buffer.data(), buffer.size());
+        bench::do_not_optimize(peak);
+    }, static_cast<double>(state.size()), bytes(state.size(), 1));
+}
+
+DAIW_BENCHMARK(simd, apply_envelope, 64, 512, 4096, 65536) {
+    auto buffer = make_signal(state.size(), 1);
+    std::vector<float> envelope(state.size());
+    simd::generate_ramp(envelope.data(), envelope.size(), 1.0f, 0.999f);
+    state.measure([&] {
+        simd::apply_envelope(buffer.data(), envelope.data(), buffer.size());
+        bench::do_not_optimize(buffer.data());
+    }, static_cast<double>(state.size()), bytes(state.size(), 3));
+}
+
+DAIW_BENCHMARK(simd, generate_ramp, 64, 512, 4096, 65536) {
+    std::vector<float> buffer(state.size());
+    state.measure([&] {
+        simd::generate_ramp(buffer.data(), buffer.size(), 0.0f, 1.0f);
+        bench::do_not_optimize(buffer.data());
+    }, static_cast<double>(state.size()), bytes(state.size(), 1));
+}
+
+// =============================================================================
+// Stereo Operations
+// =============================================================================
+
+DAIW_BENCHMARK(simd, mono_to_stereo, 64, 512, 4096, 65536) {
+    const auto mono = make_signal(state.size());
+    std::vector<float> stereo(2 * state.size());
+    state.measure([&] {
+        simd::mono_to_stereo(stereo.data(), mono.data(), mono.size());
+        bench::do_not_optimize(stereo.data());
+    }, static_cast<double>(state.size()), bytes(state.size(), 3));
+}
+
+DAIW_BENCHMARK(simd, stereo_to_mono, 64, 512, 4096, 65536) {
+    const auto stereo = make_signal(2 * state.size());
+    std::vector<float> mono(state.size());
+    state.measure([&] {
+        simd::stereo_to_mono(mono.data(), stereo.data(), mono.size());
+        bench::do_not_optimize(mono.data());
+    }, static_cast<double>(state.size()), bytes(state.size(), 3));
+}
+
+DAIW_BENCHMARK(simd, apply_pan, 64, 512, 4096, 65536) {
+    auto left = make_signal(state.size(), 1);
+    auto right = make_signal(state.size(), 2);
+    float pan = -1.0f;
+    state.measure([&] {
+        // Vary the pan so the gains are recomputed each call, as in automation
+        pan = pan > 1.0f ? -1.0f : pan + 0.01f;
+        simd::apply_pan(left.data(), right.data(), left.size(), pan);
+        bench::do_not_optimize(left.data());
+        bench::do_not_optimize(right.data());
+    }, static_cast<double>(state.size()), bytes(state.size(), 4));
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+/**
+ * Shared FFT Engine
+ *
+ * Power-of-two complex and real-input FFTs for every spectral consumer
+ * (plugins, offline render nodes, analysis) without a JUCE dependency.
+ *
+ * - fft_plan(size) returns a process-wide plan, built once per size and
+ *   shared by every caller. Lookups after the first are lock-free.
+ * - Real transforms run a half-size complex FFT on the packed even/odd
+ *   samples plus one split pass, so they cost about half a complex FFT.
+ * - Butterflies run 4 (AVX2) or 2 (SSE4.2) complex points per instruction
+ *   after a scalar radix-4 first pass.
+ * - FftScratch leases an aligned FFT_MAX_SIZE work buffer from a shared
+ *   MemoryPool (lock-free, ABA-safe), so process() paths need not own spectra.
+ *
+ * Conventions: forward is X[k] = sum x[n] e^{-2 pi i k n / N}; inverse
+ * transforms are scaled by 1/N so forward + inverse is the identity.
+ * Real spectra hold N/2 + 1 bins (DC .. Nyquist).
+ */
+
+#include "daiw/memory_pool.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace daiw::dsp {
+
+using Complex = std::complex<float>;
+
+/// Supported transform sizes (points)
+inline constexpr size_t FFT_MIN_SIZE = 4;
+inline constexpr size_t FFT_MAX_SIZE = size_t{1} << 15;
+
+/// True for the power-of-two sizes fft_plan() accepts
+constexpr bool is_valid_fft_size(size_t size) {
+    return size >= FFT_MIN_SIZE && size <= FFT_MAX_SIZE && (size & (size - 1)) == 0;
+}
+
+// =============================================================================
+// Plans
+// =============================================================================
+
+/**
+ * Twiddle and bit-reversal tables for one transform size. Immutable after
+ * construction, so one plan may run on any number of threads at once.
+ */
+class FftPlan {
+public:
+    /// size must satisfy is_valid_fft_size(); use fft_plan() to share plans
+    explicit FftPlan(size_t size);
+    ~FftPlan();
+
+    FftPlan(const FftPlan&) = delete;
+    FftPlan& operator=(const FftPlan&) = delete;
+
+    /// Transform size in points
+    size_t size() const noexcept { return size_; }
+
+    /// Bins in a real spectrum: size() / 2 + 1
+    size_t num_bins() const noexcept { return size_ / 2 + 1; }
+
+    /// In-place complex FFT of size() points
+    void forward(Complex* data) const noexcept;
+
+    /// In-place inverse complex FFT of size() points, scaled by 1/size()
+    void inverse(Complex* data) const noexcept;
+
+    /**
+     * Real-input FFT: size() samples to num_bins() bins.
+     * input and spectrum may be the same memory (as floats).
+     */
+    void forward_real(const float* input, Complex* spectrum) const noexcept;
+
+    /**
+     * Inverse of forward_real(): num_bins() bins to size() samples, scaled
+     * by 1/size(). spectrum is left untouched; output must not alias it.
+     */
+    void inverse_real(const Complex* spectrum, float* output) const noexcept;
+
+private:
+    /// Unscaled forward complex FFT of n points (size_ or size_ / 2)
+    void transform(Complex* data, size_t n, const uint32_t* swaps, size_t num_swaps) const noexcept;
+
+    size_t size_;
+
+    // Stage twiddles: stage with half-width h uses [h, 2h): e^{-i pi k / h}
+    Complex* twiddles_ = nullptr;
+
+    // Bit-reversal swap pairs (i < j) for size_ and size_ / 2 points
+    uint32_t* swaps_ = nullptr;
+    size_t num_swaps_ = 0;
+    uint32_t* half_swaps_ = nullptr;
+    size_t num_half_swaps_ = 0;
+
+    std::unique_ptr<std::byte[]> storage_;
+};
+
+/**
+ * Shared plan for size, built on first use (allocates; call from prepare,
+ * not the audio thread). Returns nullptr for unsupported sizes. Plans live
+ * until process exit.
+ */
+const FftPlan* fft_plan(size_t size);
+
+// =============================================================================
+// Scratch Buffers
+// =============================================================================
+
+/// One pooled work buffer: a FFT_MAX_SIZE real frame or its complex spectrum
+struct alignas(64) FftScratchBlock {
+    FftScratchBlock() {}  // Leave uninitialized: leasing must not touch the data
+
+    float samples[FFT_MAX_SIZE + 2];
+};
+
+/// Work buffers leased at once across the process
+inline constexpr size_t FFT_SCRATCH_BLOCKS = 32;
+
+using FftScratchPool = MemoryPool<FftScratchBlock, FFT_SCRATCH_BLOCKS>;
+
+/// The process-wide scratch pool
+FftScratchPool& fft_scratch_pool();
+
+/**
+ * RAII lease of one scratch block (lock-free, RT-safe). Check the lease
+ * before use: it is empty when every block is taken.
+ */
+class FftScratch {
+public:
+    FftScratch() : block_(fft_scratch_pool().acquire()) {}
+    ~FftScratch() { fft_scratch_pool().release(block_); }
+
+    FftScratch(const FftScratch&) = delete;
+    FftScratch& operator=(const FftScratch&) = delete;
+
+    explicit operator bool() const noexcept { return block_ != nullptr; }
+
+    /// FFT_MAX_SIZE + 2 floats, 64-byte aligned
+    float* data() noexcept { return block_ ? block_->samples : nullptr; }
+
+    /// The same memory as FFT_MAX_SIZE / 2 + 1 complex bins
+    Complex* spectrum() noexcept { return reinterpret_cast<Complex*>(data()); }
+
+private:
+    FftScratchBlock* block_;
+};
+
+} // namespace daiw::dsp
@@ -14,9 +14,12 @@
 
 #pragma once
 
+#include "daiw/simd.hpp"
 #include "daiw/types.hpp"
 
 #include <array>
+#include <bit>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <cmath>
@@ -99,42 +102,38 @@ enum class Degree {
  */
 class PitchClassSet {
 public:
-    PitchClassSet() : bits_(0) {}
+    constexpr PitchClassSet() : bits_(0) {}
 
-    explicit PitchClassSet(uint16_t bits) : bits_(bits & 0x0FFF) {}
+    constexpr explicit PitchClassSet(uint16_t bits) : bits_(bits & 0x0FFF) {}
 
     /// Add a pitch class
-    void add(int pitch_class) {
+    constexpr void add(int pitch_class) {
         bits_ |= (1 << (pitch_class % NOTES_PER_OCTAVE));
     }
 
     /// Remove a pitch class
-    void remove(int pitch_class) {
+    constexpr void remove(int pitch_class) {
         bits_ &= ~(1 << (pitch_class % NOTES_PER_OCTAVE));
     }
 
     /// Check if pitch class is present
-    bool contains(int pitch_class) const {
+    constexpr bool contains(int pitch_class) const {
         return bits_ & (1 << (pitch_class % NOTES_PER_OCTAVE));
     }
 
     /// Get count of pitch classes
-    int count() const {
-        int c = 0;
-        for (int i = 0; i < NOTES_PER_OCTAVE; ++i) {
-            if (bits_ & (1 << i)) c++;
-        }
-        return c;
+    constexpr int count() const {
+        return std::popcount(bits_);
     }
 
     /// Clear all pitch classes
-    void clear() { bits_ = 0; }
+    constexpr void clear() { bits_ = 0; }
 
     /// Get raw bits
-    uint16_t bits() const { return bits_; }
+    constexpr uint16_t bits() const { return bits_; }
 
     /// Transpose by semitones
-    PitchClassSet transpose(int semitones) const {
+    constexpr PitchClassSet transpose(int semitones) const {
         int shift = ((semitones % NOTES_PER_OCTAVE) + NOTES_PER_OCTAVE) % NOTES_PER_OCTAVE;
         uint16_t rotated = ((bits_ << shift) | (bits_ >> (NOTES_PER_OCTAVE - shift))) & 0x0FFF;
         return PitchClassSet(rotated);
@@ -152,7 +151,7 @@ public:
         return result;
     }
 
-    bool operator==(const PitchClassSet& other) const {
+    constexpr bool operator==(const PitchClassSet& other) const {
         return bits_ == other.bits_;
     }
 
@@ -164,6 +163,32 @@ private:
 // Chord
 // =============================================================================
 
+/**
+ * Intervals of a chord quality above a root on C, as PitchClassSet bits.
+ * Qualities without a template of their own fall back to the major triad.
+ */
+constexpr uint16_t chord_template(ChordQuality quality) {
+    constexpr auto intervals = [](auto... semitones) {
+        return static_cast<uint16_t>(((1 << semitones) | ...));
+    };
+
+    switch (quality) {
+        case ChordQuality::Major:           return intervals(0, 4, 7);
+        case ChordQuality::Minor:           return intervals(0, 3, 7);
+        case ChordQuality::Diminished:      return intervals(0, 3, 6);
+        case ChordQuality::Augmented:       return intervals(0, 4, 8);
+        case ChordQuality::Dominant7:       return intervals(0, 4, 7, 10);
+        case ChordQuality::Major7:          return intervals(0, 4, 7, 11);
+        case ChordQuality::Minor7:          return intervals(0, 3, 7, 10);
+        case ChordQuality::Diminished7:     return intervals(0, 3, 6, 9);
+        case ChordQuality::HalfDiminished7: return intervals(0, 3, 6, 10);
+        case ChordQuality::Sus2:            return intervals(0, 2, 7);
+        case ChordQuality::Sus4:            return intervals(0, 5, 7);
+        case ChordQuality::Power:           return intervals(0, 7);
+        default:                            return intervals(0, 4, 7);
+    }
+}
+
 /**
  * Represents a chord with root, quality, and extensions.
  */
@@ -175,69 +200,8 @@ struct Chord {
 
     /// Get pitch class set for this chord
     PitchClassSet pitch_classes() const {
-        PitchClassSet pcs;
         int r = static_cast<int>(root);
-        pcs.add(r);
-
-        // Add intervals based on quality
-        switch (quality) {
-            case ChordQuality::Major:
-                pcs.add(r + 4);  // Major 3rd
-                pcs.add(r + 7);  // Perfect 5th
-                break;
-            case ChordQuality::Minor:
-                pcs.add(r + 3);  // Minor 3rd
-                pcs.add(r + 7);  // Perfect 5th
-                break;
-            case ChordQuality::Diminished:
-                pcs.add(r + 3);  // Minor 3rd
-                pcs.add(r + 6);  // Diminished 5th
-                break;
-            case ChordQuality::Augmented:
-                pcs.add(r + 4);  // Major 3rd
-                pcs.add(r + 8);  // Augmented 5th
-                break;
-            case ChordQuality::Dominant7:
-                pcs.add(r + 4);
-                pcs.add(r + 7);
-                pcs.add(r + 10); // Minor 7th
-                break;
-            case ChordQuality::Major7:
-                pcs.add(r + 4);
-                pcs.add(r + 7);
-                pcs.add(r + 11); // Major 7th
-                break;
-            case ChordQuality::Minor7:
-                pcs.add(r + 3);
-                pcs.add(r + 7);
-                pcs.add(r + 10);
-                break;
-            case ChordQuality::Diminished7:
-                pcs.add(r + 3);
-                pcs.add(r + 6);
-                pcs.add(r + 9);  // Diminished 7th
-                break;
-            case ChordQuality::HalfDiminished7:
-                pcs.add(r + 3);
-                pcs.add(r + 6);
-                pcs.add(r + 10);
-                break;
-            case ChordQuality::Sus2:
-                pcs.add(r + 2);  // Major 2nd
-                pcs.add(r + 7);
-                break;
-            case ChordQuality::Sus4:
-                pcs.add(r + 5);  // Perfect 4th
-                pcs.add(r + 7);
-                break;
-            case ChordQuality::Power:
-                pcs.add(r + 7);  // Just 5th
-                break;
-            default:
-                pcs.add(r + 4);
-                pcs.add(r + 7);
-                break;
-        }
+        PitchClassSet pcs = PitchClassSet(chord_template(quality)).transpose(r);
 
         // Add extensions
         for (int ext : extensions) {
@@ -387,42 +351,214 @@ struct Scale {
 // Chord Detector
 // =============================================================================
 
+/**
+ * Best and second-best chord template for one pitch class set.
+ * Roots hold NoteName values, qualities ChordQuality values.
+ */
+struct ChordMatch {
+    uint8_t root = 0;
+    uint8_t quality = 0;
+    uint8_t runner_up_root = 0;
+    uint8_t runner_up_quality = 0;
+    float confidence = 0.0f;
+    float runner_up_confidence = 0.0f;
+};
+
+namespace detail {
+
+/// Qualities the detector matches, in tie-break order
+inline constexpr std::array<ChordQuality, 12> DETECTABLE_QUALITIES = {
+    ChordQuality::Major,
+    ChordQuality::Minor,
+    ChordQuality::Diminished,
+    ChordQuality::Augmented,
+    ChordQuality::Dominant7,
+    ChordQuality::Major7,
+    ChordQuality::Minor7,
+    ChordQuality::Diminished7,
+    ChordQuality::HalfDiminished7,
+    ChordQuality::Sus2,
+    ChordQuality::Sus4,
+    ChordQuality::Power
+};
+
+/**
+ * 0.6 * recall + 0.4 * precision for matches of template_count template
+ * notes among input_count input notes. Evaluated as one division of
+ * integers, so equal scores compare equal and the nearest distinct scores
+ * still differ by many float ulps.
+ */
+constexpr float chord_match_score(int matches, int template_count, int input_count) {
+    if (template_count == 0 || input_count == 0) return 0.0f;
+
+    // (3 * m / t + 2 * m / n) / 5
+    return static_cast<float>(matches * (3 * input_count + 2 * template_count)) /
+           static_cast<float>(5 * template_count * input_count);
+}
+
+/**
+ * Match every 12-bit pitch class set against all 12 roots x 12 qualities.
+ * The first candidate (by root, then quality order) wins ties and the
+ * runner-up is the first best-scoring candidate after it. Sets with fewer
+ * than two notes stay empty (C major, zero confidence).
+ *
+ * Transposing a set transposes every candidate's root with it, so scores
+ * are only computed for one rotation of each set; the other eleven
+ * rotations reuse them and just redo the tie-break. That keeps constant
+ * evaluation within the default compiler limits.
+ */
+constexpr std::array<ChordMatch, 1 << NOTES_PER_OCTAVE> build_chord_table() {
+    constexpr int NUM_SETS = 1 << NOTES_PER_OCTAVE;
+    constexpr int NUM_QUALITIES = static_cast<int>(DETECTABLE_QUALITIES.size());
+    constexpr int NO_CANDIDATE = -1;
+
+    // Plain arrays: std::array's accessors are calls, which dominate
+    // constant evaluation time
+    struct RootMasks {
+        uint16_t roots[NUM_QUALITIES] = {};
+    };
+
+    constexpr auto rotate = [](int bits, int semitones) {
+        return ((bits << semitones) | (bits >> (NOTES_PER_OCTAVE - semitones))) & (NUM_SETS - 1);
+    };
+
+    uint8_t note_count[NUM_SETS] = {};
+    for (int bits = 1; bits < NUM_SETS; ++bits) {
+        note_count[bits] = static_cast<uint8_t>(note_count[bits >> 1] + (bits & 1));
+    }
+
+    uint16_t templates[NUM_QUALITIES] = {};
+    uint8_t quality_codes[NUM_QUALITIES] = {};
+    for (int q = 0; q < NUM_QUALITIES; ++q) {
+        templates[q] = chord_template(DETECTABLE_QUALITIES[q]);
+        quality_codes[q] = static_cast<uint8_t>(DETECTABLE_QUALITIES[q]);
+    }
+
+    // First candidate (root * NUM_QUALITIES + quality index) after `after`
+    // whose root, transposed back down by semitones, is in its quality's mask
+    const auto first_candidate = [](const RootMasks& masks, int semitones, int after) {
+        int any_root = 0;
+        for (uint16_t mask : masks.roots) any_root |= mask;
+
+        for (int root = (after + 1) / NUM_QUALITIES; root < NOTES_PER_OCTAVE; ++root) {
+            const int untransposed_bit = 1 << ((root + NOTES_PER_OCTAVE - semitones) % NOTES_PER_OCTAVE);
+            if (!(any_root & untransposed_bit)) continue;
+
+            for (int q = 0; q < NUM_QUALITIES; ++q) {
+                const int candidate = root * NUM_QUALITIES + q;
+                if (candidate > after && (masks.roots[q] & untransposed_bit)) return candidate;
+            }
+        }
+        return NO_CANDIDATE;
+    };
+
+    std::array<ChordMatch, NUM_SETS> table{};
+    for (int bits = 0; bits < NUM_SETS; ++bits) {
+        const int input_count = note_count[bits];
+        if (input_count < 2) continue;
+
+        // Only the smallest rotation of each set is scored
+        bool smallest_rotation = true;
+        for (int semitones = 1; semitones < NOTES_PER_OCTAVE && smallest_rotation; ++semitones) {
+            smallest_rotation = rotate(bits, semitones) >= bits;
+        }
+        if (!smallest_rotation) continue;
+
+        // Roots reaching the best and second-best score, per quality
+        float best = 0.0f;
+        float second = 0.0f;
+        RootMasks best_roots{};
+        RootMasks second_roots{};
+        for (int q = 0; q < NUM_QUALITIES; ++q) {
+            const int chord_on_c = templates[q];
+            for (int root = 0; root < NOTES_PER_OCTAVE; ++root) {
+                const int chord = rotate(chord_on_c, root);
+                const float score = chord_match_score(note_count[bits & chord], note_count[chord], input_count);
+                const auto root_bit = static_cast<uint16_t>(1 << root);
+
+                if (score <= 0.0f || score < second) continue;
+                if (score > best) {
+                    second = best;
+                    second_roots = best_roots;
+                    best = score;
+                    best_roots = {};
+                    best_roots.roots[q] = root_bit;
+                } else if (score == best) {
+                    best_roots.roots[q] |= root_bit;
+                } else if (score > second) {
+                    second = score;
+                    second_roots = {};
+                    second_roots.roots[q] = root_bit;
+                } else {
+                    second_roots.roots[q] |= root_bit;
+                }
+            }
+        }
+
+        for (int semitones = 0; semitones < NOTES_PER_OCTAVE; ++semitones) {
+            ChordMatch& match = table[rotate(bits, semitones)];
+
+            const int winner = first_candidate(best_roots, semitones, NO_CANDIDATE);
+            match.root = static_cast<uint8_t>(winner / NUM_QUALITIES);
+            match.quality = quality_codes[winner % NUM_QUALITIES];
+            match.confidence = best;
+
+            int runner_up = first_candidate(best_roots, semitones, winner);
+            float runner_up_confidence = best;
+            if (runner_up == NO_CANDIDATE) {
+                runner_up = first_candidate(second_roots, semitones, NO_CANDIDATE);
+                runner_up_confidence = second;
+            }
+            if (runner_up != NO_CANDIDATE) {
+                match.runner_up_root = static_cast<uint8_t>(runner_up / NUM_QUALITIES);
+                match.runner_up_quality = quality_codes[runner_up % NUM_QUALITIES];
+                match.runner_up_confidence = runner_up_confidence;
+            }
+        }
+    }
+
+    return table;
+}
+
+/**
+ * Every detection, indexed by PitchClassSet::bits(). Defined (as
+ * build_chord_table() evaluated at compile time) in chord_table.cpp, so
+ * only that translation unit pays for the constant evaluation.
+ */
+extern const std::array<ChordMatch, 1 << NOTES_PER_OCTAVE> CHORD_TABLE;
+
+} // namespace detail
+
 /**
  * Detects chords from pitch class sets.
- * Uses template matching with weighted scoring.
+ * Uses template matching with weighted scoring, precomputed at compile
+ * time for all 4096 pitch class sets so detection is a table lookup.
  */
 class ChordDetector {
 public:
     struct Detection {
         Chord chord;
         float confidence;  // 0.0 - 1.0
+        Chord runner_up;   // Next best template, different from chord
+        float runner_up_confidence = 0.0f;
     };
 
+    /// Best and runner-up match for a pitch class set (no allocation)
+    static const ChordMatch& lookup(const PitchClassSet& pcs) {
+        return detail::CHORD_TABLE[pcs.bits()];
+    }
+
     /// Detect chord from pitch class set
     Detection detect(const PitchClassSet& pcs) const {
-        if (pcs.count() < 2) {
-            return {Chord{}, 0.0f};
-        }
-
-        Detection best{Chord{}, 0.0f};
-
-        // Try each possible root
-        for (int root = 0; root < NOTES_PER_OCTAVE; ++root) {
-            // Try each chord quality
-            for (auto quality : all_qualities_) {
-                Chord candidate;
-                candidate.root = static_cast<NoteName>(root);
-                candidate.quality = quality;
-
-                float score = match_score(pcs, candidate.pitch_classes());
-                if (score > best.confidence) {
-                    best.chord = candidate;
-                    best.confidence = score;
-                }
-            }
-        }
-
-        return best;
+        const ChordMatch& match = lookup(pcs);
+
+        Detection result{Chord{}, match.confidence, Chord{}};
+        result.chord.root = static_cast<NoteName>(match.root);
+        result.chord.quality = static_cast<ChordQuality>(match.quality);
+        result.runner_up.root = static_cast<NoteName>(match.runner_up_root);
+        result.runner_up.quality = static_cast<ChordQuality>(match.runner_up_quality);
+        result.runner_up_confidence = match.runner_up_confidence;
+        return result;
     }
 
     /// Detect chord from MIDI notes
@@ -433,51 +569,117 @@ public:
         }
         return detect(pcs);
     }
+};
 
-private:
-    float match_score(const PitchClassSet& input, const PitchClassSet& template_pcs) const {
-        int matches = 0;
-        int template_count = template_pcs.count();
-        int input_count = input.count();
+// =============================================================================
+// Key Detector
+// =============================================================================
 
-        // Count matching pitch classes
-        for (int i = 0; i < NOTES_PER_OCTAVE; ++i) {
-            if (input.contains(i) && template_pcs.contains(i)) {
-                matches++;
-            }
-        }
+/// Major and minor key on every root
+constexpr int NUM_KEYS = 2 * NOTES_PER_OCTAVE;
+
+namespace detail {
+
+/**
+ * Krumhansl-Kessler profiles for all 24 keys, each rotated to its root,
+ * centered and scaled to unit length: a key's Pearson correlation with a
+ * histogram is then one dot product divided by the histogram's centered
+ * length. Stored by pitch class (12 rows of 24 keys) so scoring every key
+ * is one broadcast multiply-add per pitch class. Key k has root k / 2 and
+ * is minor when k is odd, which keeps the original tie-break order.
+ */
+struct KeyProfiles {
+    alignas(32) float weights[NOTES_PER_OCTAVE][NUM_KEYS];
+};
+
+inline const KeyProfiles& key_profiles() {
+    static const KeyProfiles profiles = [] {
+        // Krumhansl-Kessler major and minor profiles
+        static constexpr float PROFILES[2][NOTES_PER_OCTAVE] = {
+            {6.35f, 2.23f, 3.48f, 2.33f, 4.38f, 4.09f, 2.52f, 5.19f, 2.39f, 3.66f, 2.29f, 2.88f},
+            {6.33f, 2.68f, 3.52f, 5.38f, 2.60f, 3.53f, 2.54f, 4.75f, 3.98f, 2.69f, 3.34f, 3.17f}
+        };
+
+        KeyProfiles result{};
+        for (int mode = 0; mode < 2; ++mode) {
+            const float* profile = PROFILES[mode];
 
-        if (template_count == 0) return 0.0f;
+            float mean = 0.0f;
+            for (int i = 0; i < NOTES_PER_OCTAVE; ++i) mean += profile[i];
+            mean /= NOTES_PER_OCTAVE;
 
-        // Score based on:
-        // - How many template notes are present
-        // - Penalty for extra notes
-        float recall = static_cast<float>(matches) / template_count;
-        float precision = input_count > 0 ? static_cast<float>(matches) / input_count : 0.0f;
+            float length = 0.0f;
+            for (int i = 0; i < NOTES_PER_OCTAVE; ++i) {
+                length += (profile[i] - mean) * (profile[i] - mean);
+            }
+            length = std::sqrt(length);
 
-        // F1-like score with slight preference for recall
-        return (recall * 0.6f + precision * 0.4f);
+            for (int root = 0; root < NOTES_PER_OCTAVE; ++root) {
+                for (int pc = 0; pc < NOTES_PER_OCTAVE; ++pc) {
+                    const float weight = profile[(pc - root + NOTES_PER_OCTAVE) % NOTES_PER_OCTAVE];
+                    result.weights[pc][2 * root + mode] = (weight - mean) / length;
+                }
+            }
+        }
+        return result;
+    }();
+    return profiles;
+}
+
+/// scores[k] = dot(histogram, key k's profile) for all 24 keys
+inline void score_keys(const float* histogram, float* scores) noexcept {
+    const KeyProfiles& profiles = key_profiles();
+
+#if defined(DAIW_AVX2) || defined(DAIW_AVX512)
+    __m256 s0 = _mm256_setzero_ps();
+    __m256 s1 = _mm256_setzero_ps();
+    __m256 s2 = _mm256_setzero_ps();
+    for (int pc = 0; pc < NOTES_PER_OCTAVE; ++pc) {
+        const __m256 x = _mm256_set1_ps(histogram[pc]);
+        const float* w = profiles.weights[pc];
+        s0 = _mm256_fmadd_ps(x, _mm256_load_ps(w), s0);
+        s1 = _mm256_fmadd_ps(x, _mm256_load_ps(w + 8), s1);
+        s2 = _mm256_fmadd_ps(x, _mm256_load_ps(w + 16), s2);
+    }
+    _mm256_storeu_ps(scores, s0);
+    _mm256_storeu_ps(scores + 8, s1);
+    _mm256_storeu_ps(scores + 16, s2);
+
+#elif defined(DAIW_SSE42)
+    __m128 s[NUM_KEYS / 4];
+    for (auto& v : s) v = _mm_setzero_ps();
+    for (int pc = 0; pc < NOTES_PER_OCTAVE; ++pc) {
+        const __m128 x = _mm_set1_ps(histogram[pc]);
+        const float* w = profiles.weights[pc];
+        for (int i = 0; i < NUM_KEYS / 4; ++i) {
+            s[i] = _mm_add_ps(s[i], _mm_mul_ps(x, _mm_load_ps(w + 4 * i)));
+        }
     }
+    for (int i = 0; i < NUM_KEYS / 4; ++i) _mm_storeu_ps(scores + 4 * i, s[i]);
+
+#elif defined(DAIW_NEON)
+    float32x4_t s[NUM_KEYS / 4];
+    for (auto& v : s) v = vdupq_n_f32(0.0f);
+    for (int pc = 0; pc < NOTES_PER_OCTAVE; ++pc) {
+        const float32x4_t x = vdupq_n_f32(histogram[pc]);
+        const float* w = profiles.weights[pc];
+        for (int i = 0; i < NUM_KEYS / 4; ++i) {
+            s[i] = vmlaq_f32(s[i], x, vld1q_f32(w + 4 * i));
+        }
+    }
+    for (int i = 0; i < NUM_KEYS / 4; ++i) vst1q_f32(scores + 4 * i, s[i]);
 
-    const std::array<ChordQuality, 12> all_qualities_ = {
-        ChordQuality::Major,
-        ChordQuality::Minor,
-        ChordQuality::Diminished,
-        ChordQuality::Augmented,
-        ChordQuality::Dominant7,
-        ChordQuality::Major7,
-        ChordQuality::Minor7,
-        ChordQuality::Diminished7,
-        ChordQuality::HalfDiminished7,
-        ChordQuality::Sus2,
-        ChordQuality::Sus4,
-        ChordQuality::Power
-    };
-};
+#else
+    for (int k = 0; k < NUM_KEYS; ++k) scores[k] = 0.0f;
+    for (int pc = 0; pc < NOTES_PER_OCTAVE; ++pc) {
+        for (int k = 0; k < NUM_KEYS; ++k) {
+            scores[k] += histogram[pc] * profiles.weights[pc][k];
+        }
+    }
+#endif
+}
 
-// =============================================================================
-// Key Detector
-// =============================================================================
+} // namespace detail
 
 /**
  * Detects musical key from pitch class distribution.
@@ -491,48 +693,58 @@ public:
         bool is_minor;
     };
 
-    KeyDetector() {
-        init_profiles();
-    }
-
-    /// Detect key from pitch class histogram
-    Detection detect(const std::array<float, NOTES_PER_OCTAVE>& histogram) const {
-        Detection best{{NoteName::C, ScaleType::Major}, 0.0f, false};
+    /**
+     * Pearson correlation of histogram with every key (key k: root k / 2,
+     * minor when k is odd). Returns false, leaving correlations untouched,
+     * when the histogram is empty or flat and so fits no key.
+     */
+    static bool correlate_keys(const std::array<float, NOTES_PER_OCTAVE>& histogram,
+                               std::array<float, NUM_KEYS>& correlations) noexcept {
+        float sum = 0.0f, sum_squares = 0.0f;
+        for (float v : histogram) {
+            sum += v;
+            sum_squares += v * v;
+        }
+        if (sum < 0.001f) return false;
 
-        // Normalize histogram
-        float sum = 0.0f;
-        for (float v : histogram) sum += v;
-        if (sum < 0.001f) return best;
+        // Length of the histogram minus its mean
+        const float centered = sum_squares - sum * sum / NOTES_PER_OCTAVE;
+        if (centered <= 1e-6f * sum_squares) return false;
 
-        std::array<float, NOTES_PER_OCTAVE> normalized;
-        for (int i = 0; i < NOTES_PER_OCTAVE; ++i) {
-            normalized[i] = histogram[i] / sum;
-        }
-
-        // Try each key (major and minor)
-        for (int root = 0; root < NOTES_PER_OCTAVE; ++root) {
-            // Major key
-            float major_score = correlate(normalized, major_profile_, root);
-            if (major_score > best.confidence) {
-                best.scale.root = static_cast<NoteName>(root);
-                best.scale.type = ScaleType::Major;
-                best.confidence = major_score;
-                best.is_minor = false;
-            }
+        detail::score_keys(histogram.data(), correlations.data());
+        const float scale = 1.0f / std::sqrt(centered);
+        for (float& r : correlations) r *= scale;
+        return true;
+    }
 
-            // Minor key
-            float minor_score = correlate(normalized, minor_profile_, root);
-            if (minor_score > best.confidence) {
-                best.scale.root = static_cast<NoteName>(root);
-                best.scale.type = ScaleType::NaturalMinor;
-                best.confidence = minor_score;
-                best.is_minor = true;
+    /// Index of the best key (first on ties), -1 when none correlates positively
+    static int best_key(const std::array<float, NUM_KEYS>& correlations) noexcept {
+        int best = -1;
+        float best_correlation = 0.0f;
+        for (int k = 0; k < NUM_KEYS; ++k) {
+            if (correlations[k] > best_correlation) {
+                best = k;
+                best_correlation = correlations[k];
             }
         }
-
         return best;
     }
 
+    /// Detection for key index k with the given confidence
+    static Detection key_detection(int key, float confidence) noexcept {
+        const bool is_minor = key % 2 != 0;
+        return {{static_cast<NoteName>(key / 2), is_minor ? ScaleType::NaturalMinor : ScaleType::Major},
+                confidence, is_minor};
+    }
+
+    /// Detect key from pitch class histogram
+    Detection detect(const std::array<float, NOTES_PER_OCTAVE>& histogram) const {
+        std::array<float, NUM_KEYS> correlations;
+        const int key = correlate_keys(histogram, correlations) ? best_key(correlations) : -1;
+        if (key < 0) return {{NoteName::C, ScaleType::Major}, 0.0f, false};
+        return key_detection(key, correlations[key]);
+    }
+
     /// Accumulate note for key detection
     void accumulate(MidiNote note, float weight = 1.0f) {
         accumulated_[note % NOTES_PER_OCTAVE] += weight;
@@ -549,49 +761,124 @@ public:
     }
 
 private:
-    void init_profiles() {
-        // Krumhansl-Kessler major profile
-        major_profile_ = {
-            6.35f, 2.23f, 3.48f, 2.33f, 4.38f, 4.09f,
-            2.52f, 5.19f, 2.39f, 3.66f, 2.29f, 2.88f
-        };
+    std::array<float, NOTES_PER_OCTAVE> accumulated_{};
+};
 
-        // Krumhansl-Kessler minor profile
-        minor_profile_ = {
-            6.33f, 2.68f, 3.52f, 5.38f, 2.60f, 3.53f,
-            2.54f, 4.75f, 3.98f, 2.69f, 3.34f, 3.17f
-        };
+// =============================================================================
+// Key Tracker
+// =============================================================================
+
+/**
+ * Streaming key detection for live input.
+ *
+ * Notes feed a pitch class histogram that decays exponentially with time
+ * (half_life seconds), so the estimate follows modulations instead of
+ * averaging the whole performance. advance() applies the decay, re-scores
+ * all 24 keys and reports when the tracked key changes.
+ *
+ * Hysteresis keeps the key from flapping between close candidates: a new
+ * key must correlate at least min_confidence, beat the current key by
+ * switch_margin, and keep that lead for hold_time seconds of advance()
+ * calls. Allocation-free, so it can run per track on the audio thread.
+ */
+class KeyTracker {
+public:
+    struct Settings {
+        float half_life = 4.0f;        // Seconds for a note's weight to halve (0 = no decay)
+        float min_confidence = 0.5f;   // Correlation a key needs to be reported
+        float switch_margin = 0.05f;   // Correlation lead a new key needs over the current one
+        float hold_time = 1.0f;        // Seconds a new key must keep its lead
+    };
+
+    using KeyChange = KeyDetector::Detection;
+
+    KeyTracker() = default;
+    explicit KeyTracker(const Settings& settings) : settings_(settings) {}
+
+    void set_settings(const Settings& settings) { settings_ = settings; }
+    const Settings& settings() const { return settings_; }
+
+    /// Add a note to the histogram (weight e.g. velocity or duration)
+    void add_note(MidiNote note, float weight = 1.0f) {
+        histogram_[note % NOTES_PER_OCTAVE] += weight;
     }
 
-    float correlate(const std::array<float, NOTES_PER_OCTAVE>& input,
-                   const std::array<float, NOTES_PER_OCTAVE>& profile,
-                   int rotation) const {
-        // Pearson correlation coefficient
-        float sum_xy = 0.0f, sum_x = 0.0f, sum_y = 0.0f;
-        float sum_x2 = 0.0f, sum_y2 = 0.0f;
-        const int n = NOTES_PER_OCTAVE;
+    /**
+     * Let seconds pass: decay the histogram and re-evaluate the key.
+     * @return The new key when it changed during this call
+     */
+    std::optional<KeyChange> advance(float seconds) {
+        if (seconds > 0.0f && settings_.half_life > 0.0f) {
+            const float decay = std::exp2(-seconds / settings_.half_life);
+            float remaining = 0.0f;
+            for (float& v : histogram_) {
+                v *= decay;
+                remaining += v;
+            }
+            // Long silence: drop the residue (far below one note's weight)
+            // rather than decay into denormals
+            if (remaining < 1e-4f) histogram_.fill(0.0f);
+        }
+
+        int candidate = -1;
+        if (KeyDetector::correlate_keys(histogram_, correlations_)) {
+            candidate = KeyDetector::best_key(correlations_);
+        } else {
+            correlations_.fill(0.0f);
+        }
+
+        const bool leads = candidate >= 0 && candidate != key_ &&
+                           correlations_[candidate] >= settings_.min_confidence &&
+                           (key_ < 0 || correlations_[candidate] >= correlations_[key_] + settings_.switch_margin);
+        if (!leads) {
+            challenger_ = -1;
+            return std::nullopt;
+        }
 
-        for (int i = 0; i < n; ++i) {
-            float x = input[(i + rotation) % n];
-            float y = profile[i];
-            sum_xy += x * y;
-            sum_x += x;
-            sum_y += y;
-            sum_x2 += x * x;
-            sum_y2 += y * y;
+        if (candidate != challenger_) {
+            // This call's seconds already count toward the hold
+            challenger_ = candidate;
+            challenger_time_ = seconds;
+        } else {
+            challenger_time_ += seconds;
         }
+        if (challenger_time_ < settings_.hold_time) return std::nullopt;
 
-        float numerator = n * sum_xy - sum_x * sum_y;
-        float denominator = std::sqrt((n * sum_x2 - sum_x * sum_x) *
-                                       (n * sum_y2 - sum_y * sum_y));
+        key_ = candidate;
+        challenger_ = -1;
+        return current();
+    }
+
+    /// True once a key has been established
+    bool has_key() const { return key_ >= 0; }
 
-        if (denominator < 0.0001f) return 0.0f;
-        return numerator / denominator;
+    /// Tracked key with its latest correlation (C major, 0 before the first)
+    KeyDetector::Detection current() const {
+        if (key_ < 0) return {{NoteName::C, ScaleType::Major}, 0.0f, false};
+        return KeyDetector::key_detection(key_, correlations_[key_]);
     }
 
-    std::array<float, NOTES_PER_OCTAVE> major_profile_;
-    std::array<float, NOTES_PER_OCTAVE> minor_profile_;
-    std::array<float, NOTES_PER_OCTAVE> accumulated_{};
+    /// Latest correlation with every key (key k: root k / 2, minor when k is odd)
+    const std::array<float, NUM_KEYS>& correlations() const { return correlations_; }
+
+    const std::array<float, NOTES_PER_OCTAVE>& histogram() const { return histogram_; }
+
+    /// Forget all notes and the tracked key
+    void reset() {
+        histogram_.fill(0.0f);
+        correlations_.fill(0.0f);
+        key_ = -1;
+        challenger_ = -1;
+        challenger_time_ = 0.0f;
+    }
+
+private:
+    Settings settings_;
+    std::array<float, NOTES_PER_OCTAVE> histogram_{};
+    std::array<float, NUM_KEYS> correlations_{};
+    int key_ = -1;               // Tracked key index
+    int challenger_ = -1;        // Key currently leading it, if any
+    float challenger_time_ = 0.0f;
 };
 
 // =============================================================================
@@ -700,8 +987,57 @@ public:
 // Voice Leading Analyzer
 // =============================================================================
 
+namespace detail {
+
+/**
+ * Minimum-cost pairing of two small pitch lists: each of the n <= m `from`
+ * pitches gets a distinct `to` pitch, minimizing the summed distance.
+ * Exact bitmask DP over the subsets of `to` (m <= MAX_CHORD_NOTES, so at
+ * most 256 states on the stack). match[i] is the `to` index of from[i].
+ */
+inline int min_cost_assignment(const int* from, int n, const int* to, int m, int8_t* match) {
+    constexpr size_t STATES = size_t{1} << MAX_CHORD_NOTES;
+    std::array<int, STATES> cost;
+    std::array<int8_t, STATES> last;
+    cost.fill(INT32_MAX);
+    cost[0] = 0;
+
+    // States with i bits set have paired from[0..i-1]
+    const unsigned masks = 1u << m;
+    for (unsigned mask = 0; mask < masks; ++mask) {
+        const int i = std::popcount(mask);
+        if (i >= n || cost[mask] == INT32_MAX) continue;
+        for (int j = 0; j < m; ++j) {
+            if (mask & (1u << j)) continue;
+            const unsigned next = mask | (1u << j);
+            const int c = cost[mask] + std::abs(to[j] - from[i]);
+            if (c < cost[next]) {
+                cost[next] = c;
+                last[next] = static_cast<int8_t>(j);
+            }
+        }
+    }
+
+    unsigned best = masks;
+    for (unsigned mask = 0; mask < masks; ++mask) {
+        if (std::popcount(mask) == n && (best == masks || cost[mask] < cost[best])) {
+            best = mask;
+        }
+    }
+    for (unsigned mask = best, i = static_cast<unsigned>(n); i-- > 0;) {
+        match[i] = last[mask];
+        mask &= ~(1u << last[mask]);
+    }
+    return cost[best];
+}
+
+}  // namespace detail
+
 /**
  * Analyzes voice leading between chords.
+ *
+ * Voices are paired by minimum total movement (detail::min_cost_assignment)
+ * when both chords fit in MAX_CHORD_NOTES, greedily otherwise.
  */
 class VoiceLeadingAnalyzer {
 public:
@@ -734,31 +1070,58 @@ public:
             return result;
         }
 
-        // Simple nearest-voice matching
-        std::vector<bool> used(chord2_pitches.size(), false);
+        const size_t n1 = chord1_pitches.size();
+        const size_t n2 = chord2_pitches.size();
+        result.movements.reserve(std::min(n1, n2));
 
-        for (int from : chord1_pitches) {
-            int best_idx = -1;
-            int best_distance = 999;
+        auto add_movement = [&result](int from, int to) {
+            int interval = to - from;
+            result.movements.push_back({from, to, interval});
+            result.total_movement += std::abs(interval);
+            result.largest_leap = std::max(result.largest_leap, std::abs(interval));
+        };
 
-            for (size_t i = 0; i < chord2_pitches.size(); ++i) {
-                if (!used[i]) {
-                    int dist = std::abs(chord2_pitches[i] - from);
-                    if (dist < best_distance) {
-                        best_distance = dist;
-                        best_idx = static_cast<int>(i);
+        constexpr size_t max_notes = MAX_CHORD_NOTES;
+        if (n1 <= max_notes && n2 <= max_notes) {
+            // Optimal pairing; extra voices on the larger side are left out
+            const int m1 = static_cast<int>(n1);
+            const int m2 = static_cast<int>(n2);
+            std::array<int8_t, MAX_CHORD_NOTES> match;
+            if (n1 <= n2) {
+                detail::min_cost_assignment(chord1_pitches.data(), m1, chord2_pitches.data(), m2, match.data());
+                for (size_t i = 0; i < n1; ++i) {
+                    add_movement(chord1_pitches[i], chord2_pitches[static_cast<size_t>(match[i])]);
+                }
+            } else {
+                detail::min_cost_assignment(chord2_pitches.data(), m2, chord1_pitches.data(), m1, match.data());
+                for (size_t i = 0; i < n1; ++i) {
+                    for (size_t j = 0; j < n2; ++j) {
+                        if (static_cast<size_t>(match[j]) == i) add_movement(chord1_pitches[i], chord2_pitches[j]);
                     }
                 }
             }
+        } else {
+            // Nearest-voice matching
+            std::vector<bool> used(chord2_pitches.size(), false);
+
+            for (int from : chord1_pitches) {
+                size_t best_idx = chord2_pitches.size();
+                int best_distance = 999;
+
+                for (size_t i = 0; i < chord2_pitches.size(); ++i) {
+                    if (!used[i]) {
+                        int dist = std::abs(chord2_pitches[i] - from);
+                        if (dist < best_distance) {
+                            best_distance = dist;
+                            best_idx = i;
+                        }
+                    }
+                }
 
-            if (best_idx >= 0) {
-                used[best_idx] = true;
-                int to = chord2_pitches[best_idx];
-                int interval = to - from;
-
-                result.movements.push_back({from, to, interval});
-                result.total_movement += std::abs(interval);
-                result.largest_leap = std::max(result.largest_leap, std::abs(interval));
+                if (best_idx < chord2_pitches.size()) {
+                    used[best_idx] = true;
+                    add_movement(from, chord2_pitches[best_idx]);
+                }
             }
         }
 
@@ -785,7 +1148,8 @@ public:
 
         // Calculate smoothness (inverse of average movement)
         if (!result.movements.empty()) {
-            float avg_movement = static_cast<float>(result.total_movement) / result.movements.size();
+            float avg_movement = static_cast<float>(result.total_movement) /
+                                  static_cast<float>(result.movements.size());
             result.smoothness_score = std::max(0.0f, 1.0f - (avg_movement / 12.0f));
         }
 
@@ -793,6 +1157,133 @@ public:
     }
 };
 
+// =============================================================================
+// Voice Leader
+// =============================================================================
+
+constexpr int MAX_VOICES = 6;
+constexpr int MAX_VOICED_CHORDS = 64;        // Chords per lead_progression() call
+constexpr int MAX_VOICING_CANDIDATES = 64;   // Voicings per chord lead_progression() considers
+
+/// One MIDI note per voice, lowest voice first
+struct Voicing {
+    std::array<MidiNote, MAX_VOICES> notes{};
+    uint8_t size = 0;
+
+    MidiNote operator[](size_t voice) const { return notes[voice]; }
+    bool operator==(const Voicing& other) const = default;
+};
+
+/// A chord to be voiced: its pitch classes and the one the bass must take
+struct ChordTones {
+    PitchClassSet pitch_classes;
+    int bass = -1;  // Pitch class of the lowest voice, -1 = any chord tone
+
+    /// Root position unless the chord has a slash bass; set bass = -1 afterwards to allow any inversion
+    static ChordTones from_chord(const Chord& chord) {
+        return {chord.pitch_classes(), static_cast<int>(chord.bass.value_or(chord.root))};
+    }
+};
+
+struct VoiceLeadingRules {
+    int voices = 4;
+    // Inclusive range of each voice, lowest first (default: SATB)
+    std::array<MidiNote, MAX_VOICES> lowest = {40, 48, 55, 60, 0, 0};
+    std::array<MidiNote, MAX_VOICES> highest = {60, 67, 72, 79, 127, 127};
+    int max_spacing = 12;                 // Largest gap between adjacent upper voices
+    bool forbid_parallel_fifths = true;
+    bool forbid_parallel_octaves = true;  // Includes unisons
+    bool require_all_tones = true;        // Every chord tone sounds when there are enough voices
+};
+
+/**
+ * Voice leading solver for live reharmonization.
+ *
+ * lead() finds the voicing of the next chord that moves the voices the
+ * fewest total semitones from the current one, subject to the rules: each
+ * voice within its range, voices strictly ascending (no crossing or
+ * unisons), upper voices at most max_spacing apart, no forbidden parallel
+ * fifths/octaves against the previous voicing, and every chord tone
+ * present. The assignment of chord tones to voices is an exact
+ * branch-and-bound search with the covered tones as bitmask state.
+ *
+ * lead_progression() voices a whole progression at once: a Viterbi pass
+ * over the MAX_VOICING_CANDIDATES most central voicings of each chord,
+ * minimizing total movement so early chords are voiced with later ones in
+ * mind.
+ *
+ * Nothing allocates: lead() and voice() work in a few KB of stack and
+ * lead_progression() uses scratch arrays inside the object, so a
+ * preconstructed VoiceLeader can run on the audio thread.
+ */
+class VoiceLeader {
+public:
+    /// Cost lead_progression() charges for a transition that breaks a parallel rule
+    static constexpr int PARALLEL_PENALTY = 1000;
+
+    VoiceLeader() = default;
+    explicit VoiceLeader(const VoiceLeadingRules& rules) : rules_(rules) {}
+
+    void set_rules(const VoiceLeadingRules& rules) { rules_ = rules; }
+    const VoiceLeadingRules& rules() const { return rules_; }
+
+    /// Number of voices in every voicing produced (rules().voices clamped to 1..MAX_VOICES)
+    int voice_count() const { return std::clamp(rules_.voices, 1, MAX_VOICES); }
+
+    /**
+     * Cheapest voicing of `to` reached from `from`.
+     * @return false when from has the wrong size or no voicing keeps the rules
+     */
+    bool lead(const Voicing& from, const ChordTones& to, Voicing& result) const;
+
+    /// Voicing with no predecessor: voices as close to the middle of their ranges as the rules allow
+    bool voice(const ChordTones& chord, Voicing& result) const;
+
+    /**
+     * Voice count chords (at most MAX_VOICED_CHORDS) into result[0..count-1],
+     * minimizing total movement, starting from `start` when given. Transitions
+     * that break a parallel rule cost PARALLEL_PENALTY rather than being
+     * impossible, so a voiceable progression always gets a result.
+     * @return Number of transitions that break a parallel rule, or -1 when a
+     *         chord cannot be voiced within the ranges (or count is out of range)
+     */
+    int lead_progression(const ChordTones* chords, int count, Voicing* result,
+                         const Voicing* start = nullptr);
+
+    /// Total semitones moved between two voicings of the same size
+    static int movement(const Voicing& from, const Voicing& to) {
+        int total = 0;
+        for (size_t v = 0; v < from.size; ++v) total += std::abs(to[v] - from[v]);
+        return total;
+    }
+
+    /// True when two voices move in parallel fifths or octaves the rules forbid
+    bool has_forbidden_parallels(const Voicing& from, const Voicing& to) const;
+
+private:
+    VoiceLeadingRules rules_;
+
+    // lead_progression() scratch
+    std::array<std::array<Voicing, MAX_VOICING_CANDIDATES>, MAX_VOICED_CHORDS> candidates_{};
+    std::array<size_t, MAX_VOICED_CHORDS> candidate_counts_{};
+    std::array<std::array<uint8_t, MAX_VOICING_CANDIDATES>, MAX_VOICED_CHORDS> back_{};
+};
+
+/**
+ * Lead fromVoicing to the pitch classes of toChordTones with VoiceLeader,
+ * each voice staying within an octave of where it was.
+ *
+ * The result has one note per voice of fromVoicing, lowest first, so its
+ * size follows fromVoicing rather than toChordTones: chord tones are
+ * doubled or left out to fit the voices. Parallels, then full coverage,
+ * are given up when nothing satisfies them. When fromVoicing is empty or
+ * has more than MAX_VOICES notes, or no voicing exists even then, each
+ * chord tone is instead moved to its octave nearest the same-index voice
+ * and the result has one note per chord tone.
+ */
+std::vector<MidiNote> optimalVoiceLead(const std::vector<MidiNote>& fromVoicing,
+                                       const std::vector<MidiNote>& toChordTones);
+
 // =============================================================================
 // Convenience Functions
 // =============================================================================
@@ -3,6 +3,7 @@
 #include <array>
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <new>
 
@@ -12,7 +13,10 @@ namespace daiw {
  * Lock-free memory pool for real-time safe allocations.
  *
  * Pre-allocates a fixed number of objects that can be acquired/released
- * without blocking. All operations are wait-free.
+ * without blocking. All operations are lock-free (a CAS retry loop on the
+ * free-list head, so not wait-free). The head carries a generation tag that
+ * every push and pop bumps, so a CAS with a stale head fails instead of
+ * corrupting the list when a slot is popped and pushed back in between (ABA).
  *
  * Usage:
  *   MemoryPool<MyObject, 64> pool;
@@ -22,14 +26,16 @@ namespace daiw {
  */
 template<typename T, size_t Capacity>
 class MemoryPool {
+    static_assert(Capacity > 0 && Capacity < 0xFFFFFFFFu, "Slot indices are 32-bit");
+
 public:
     MemoryPool() {
         // Initialize free list
         for (size_t i = 0; i < Capacity - 1; ++i) {
-            slots_[i].next.store(i + 1, std::memory_order_relaxed);
+            slots_[i].next.store(static_cast<uint32_t>(i + 1), std::memory_order_relaxed);
         }
         slots_[Capacity - 1].next.store(INVALID_INDEX, std::memory_order_relaxed);
-        free_head_.store(0, std::memory_order_release);
+        free_head_.store(pack(0, 0), std::memory_order_release);
         allocated_count_.store(0, std::memory_order_relaxed);
     }
 
@@ -49,23 +55,25 @@ public:
     /**
      * Acquire an object from the pool.
      * Returns nullptr if pool is exhausted.
-     * Thread-safe and wait-free.
+     * Thread-safe and lock-free.
      */
     template<typename... Args>
     T* acquire(Args&&... args) {
-        size_t head;
-        size_t new_head;
+        uint64_t tagged = free_head_.load(std::memory_order_acquire);
+        uint32_t head;
+        uint64_t new_head;
 
         do {
-            head = free_head_.load(std::memory_order_acquire);
+            head = index_of(tagged);
             if (head == INVALID_INDEX) {
                 return nullptr;  // Pool exhausted
             }
-            new_head = slots_[head].next.load(std::memory_order_relaxed);
+            // May read a next that is already stale; the tag makes the CAS fail then
+            new_head = pack(slots_[head].next.load(std::memory_order_relaxed), tag_of(tagged) + 1);
         } while (!free_head_.compare_exchange_weak(
-            head, new_head,
-            std::memory_order_release,
-            std::memory_order_relaxed));
+            tagged, new_head,
+            std::memory_order_acq_rel,
+            std::memory_order_acquire));
 
         // Mark slot as in use
         slots_[head].in_use.store(true, std::memory_order_release);
@@ -77,7 +85,7 @@ public:
 
     /**
      * Release an object back to the pool.
-     * Thread-safe and wait-free.
+     * Thread-safe and lock-free.
      */
     void release(T* ptr) {
         if (!ptr) return;
@@ -99,12 +107,13 @@ public:
         allocated_count_.fetch_sub(1, std::memory_order_relaxed);
 
         // Add back to free list
-        size_t head;
+        uint64_t tagged = free_head_.load(std::memory_order_relaxed);
+        uint64_t new_head;
         do {
-            head = free_head_.load(std::memory_order_acquire);
-            slots_[index].next.store(head, std::memory_order_relaxed);
+            slots_[index].next.store(index_of(tagged), std::memory_order_relaxed);
+            new_head = pack(static_cast<uint32_t>(index), tag_of(tagged) + 1);
         } while (!free_head_.compare_exchange_weak(
-            head, index,
+            tagged, new_head,
             std::memory_order_release,
             std::memory_order_relaxed));
     }
@@ -123,16 +132,23 @@ public:
     static constexpr size_t capacity() { return Capacity; }
 
 private:
-    static constexpr size_t INVALID_INDEX = ~size_t(0);
+    static constexpr uint32_t INVALID_INDEX = ~uint32_t(0);
+
+    // Free-list head: slot index in the low 32 bits, generation tag in the high 32
+    static constexpr uint64_t pack(uint32_t index, uint32_t tag) {
+        return (uint64_t{tag} << 32) | index;
+    }
+    static constexpr uint32_t index_of(uint64_t head) { return static_cast<uint32_t>(head); }
+    static constexpr uint32_t tag_of(uint64_t head) { return static_cast<uint32_t>(head >> 32); }
 
     struct Slot {
         alignas(T) std::byte storage[sizeof(T)];
-        std::atomic<size_t> next{INVALID_INDEX};
+        std::atomic<uint32_t> next{INVALID_INDEX};
         std::atomic<bool> in_use{false};
     };
 
     std::array<Slot, Capacity> slots_;
-    std::atomic<size_t> free_head_{0};
+    std::atomic<uint64_t> free_head_{0};
     std::atomic<size_t> allocated_count_{0};
 };
 
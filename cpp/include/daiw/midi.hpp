@@ -18,10 +18,13 @@
 #include "daiw/lock_free_queue.hpp"
 #include "daiw/memory_pool.hpp"
 
+#include <algorithm>
 #include <vector>
 #include <array>
 #include <functional>
 #include <cstring>
+#include <string>
+#include <string_view>
 
 namespace daiw {
 namespace midi {
@@ -155,7 +158,7 @@ public:
         for (MidiChannel ch = 0; ch < MAX_MIDI_CHANNELS; ++ch) {
             for (MidiNote note = 0; note < MAX_POLYPHONY; ++note) {
                 if (active_notes_[ch][note] > 0) {
-                    *out++ = note_off(timestamp, ch, note);
+                    *out++ = midi::note_off(timestamp, ch, note);
                 }
             }
         }
@@ -182,35 +185,66 @@ public:
 
     /// Add an event to the sequence
     void add_event(const MidiEvent& event) {
+        if (!events_.empty() && event.timestamp < events_.back().timestamp) {
+            sorted_ = false;
+        }
         events_.push_back(event);
         if (event.timestamp > length_ticks_) {
             length_ticks_ = event.timestamp;
         }
+        ++revision_;
     }
 
-    /// Sort events by timestamp
+    /// Pre-size event storage
+    void reserve(size_t count) { events_.reserve(count); }
+
+    /// Sort events by timestamp (stable, so same-tick events keep their order)
     void sort() {
-        std::sort(events_.begin(), events_.end(),
-            [](const MidiEvent& a, const MidiEvent& b) {
-                return a.timestamp < b.timestamp;
-            });
+        if (!sorted_) {
+            std::stable_sort(events_.begin(), events_.end(),
+                [](const MidiEvent& a, const MidiEvent& b) {
+                    return a.timestamp < b.timestamp;
+                });
+            sorted_ = true;
+            ++revision_;
+        }
     }
 
-    /// Get events in time range [start, end)
+    /// True when events are in timestamp order (range queries are O(log n + k))
+    bool is_sorted() const { return sorted_; }
+
+    /**
+     * Get events in time range [start, end).
+     * Binary search when sorted; falls back to a linear scan otherwise.
+     */
     template<typename OutputIt>
     OutputIt get_events_in_range(Tick start, Tick end, OutputIt out) const {
-        for (const auto& event : events_) {
-            if (event.timestamp >= start && event.timestamp < end) {
-                *out++ = event;
+        if (!sorted_) {
+            for (const auto& event : events_) {
+                if (event.timestamp >= start && event.timestamp < end) {
+                    *out++ = event;
+                }
             }
+            return out;
+        }
+
+        for (auto it = lower_bound(start); it != events_.end() && it->timestamp < end; ++it) {
+            *out++ = *it;
         }
         return out;
     }
 
+    /// Index of the first event at or after tick (requires is_sorted())
+    size_t index_at(Tick tick) const {
+        return static_cast<size_t>(lower_bound(tick) - events_.begin());
+    }
+
     /// Clear all events
     void clear() {
         events_.clear();
         length_ticks_ = 0;
+        sorted_ = true;
+        ++revision_;
     }
 
     /// Get PPQ (pulses per quarter note)
@@ -228,11 +262,22 @@ public:
     /// Get number of events
     size_t event_count() const { return events_.size(); }
 
-    /// Get all events (const)
+    /// Get all events
     const std::vector<MidiEvent>& events() const { return events_; }
 
-    /// Get all events (mutable)
-    std::vector<MidiEvent>& events() { return events_; }
+    /**
+     * Get all events for in-place editing.
+     * The caller may reorder events, so the sequence is treated as unsorted
+     * until the next sort(). Use events() for read-only access.
+     */
+    std::vector<MidiEvent>& mutable_events() {
+        sorted_ = false;
+        ++revision_;
+        return events_;
+    }
+
+    /// Incremented on every structural change; lets cursors detect stale positions
+    uint64_t revision() const { return revision_; }
 
     /// Transpose all notes by semitones
     void transpose(int semitones) {
@@ -262,12 +307,136 @@ public:
             Tick offset = nearest_grid - event.timestamp;
             event.timestamp += static_cast<Tick>(offset * strength);
         }
+        // Rounding can swap neighbours when strength < 1
+        sorted_ = std::is_sorted(events_.begin(), events_.end(),
+            [](const MidiEvent& a, const MidiEvent& b) {
+                return a.timestamp < b.timestamp;
+            });
+        ++revision_;
     }
 
 private:
+    std::vector<MidiEvent>::const_iterator lower_bound(Tick tick) const {
+        return std::lower_bound(events_.begin(), events_.end(), tick,
+            [](const MidiEvent& event, Tick t) { return event.timestamp < t; });
+    }
+
     std::vector<MidiEvent> events_;
     size_t ppq_;
     Tick length_ticks_;
+    bool sorted_ = true;
+    uint64_t revision_ = 0;
+};
+
+// =============================================================================
+// Sequence Playback Cursor
+// =============================================================================
+
+/**
+ * Incremental playhead over a sorted Sequence.
+ *
+ * The playback loop calls advance() once per block; each call only touches
+ * the events it emits, so per-block cost is O(events emitted) instead of
+ * O(events in clip). Seeking (and resyncing after the sequence changes)
+ * is a binary search.
+ */
+class SequenceCursor {
+public:
+    explicit SequenceCursor(const Sequence& sequence)
+        : sequence_(&sequence) { seek(0); }
+
+    /// Jump to a tick; the next advance() starts emitting from here
+    void seek(Tick tick) {
+        position_ = tick;
+        resync();
+    }
+
+    /// Current playhead position
+    Tick position() const { return position_; }
+
+    /**
+     * Emit events in [position(), end) with their sequence timestamps and
+     * move the playhead to end. Moving backwards is treated as a seek.
+     */
+    template<typename OutputIt>
+    OutputIt advance(Tick end, OutputIt out) {
+        emit_until(end, [&](const MidiEvent& event) { *out++ = event; });
+        return out;
+    }
+
+    /**
+     * Play num_ticks ticks inside the loop [loop_start, loop_end), wrapping
+     * at loop_end. A wrapped block is not contiguous in sequence time, so
+     * emitted events carry their offset from the start of the block as
+     * timestamp. An empty loop (loop_end <= loop_start) plays straight on.
+     */
+    template<typename OutputIt>
+    OutputIt advance_looped(Tick num_ticks, Tick loop_start, Tick loop_end, OutputIt out) {
+        if (loop_end <= loop_start) {
+            return advance_offset(position_ + num_ticks, 0, out);
+        }
+        if (position_ >= loop_end) {
+            seek(loop_start);
+        }
+
+        Tick block_offset = 0;
+        while (num_ticks > 0) {
+            const Tick span = std::min(num_ticks, loop_end - position_);
+            out = advance_offset(position_ + span, block_offset, out);
+            block_offset += span;
+            num_ticks -= span;
+            if (position_ >= loop_end) {
+                seek(loop_start);
+            }
+        }
+        return out;
+    }
+
+private:
+    /// advance() with timestamps rewritten relative to the block start
+    template<typename OutputIt>
+    OutputIt advance_offset(Tick end, Tick block_offset, OutputIt out) {
+        const Tick base = position_ - block_offset;
+        emit_until(end, [&](MidiEvent event) {
+            event.timestamp -= base;
+            *out++ = event;
+        });
+        return out;
+    }
+
+    template<typename Emit>
+    void emit_until(Tick end, Emit&& emit) {
+        if (end < position_) {
+            seek(end);
+            return;
+        }
+        if (!sequence_->is_sorted()) {
+            for (const auto& event : sequence_->events()) {
+                if (event.timestamp >= position_ && event.timestamp < end) emit(event);
+            }
+            position_ = end;
+            return;
+        }
+        if (revision_ != sequence_->revision()) {
+            resync();
+        }
+
+        const auto& events = sequence_->events();
+        while (index_ < events.size() && events[index_].timestamp < end) {
+            emit(events[index_++]);
+        }
+        position_ = end;
+    }
+
+    void resync() {
+        revision_ = sequence_->revision();
+        index_ = sequence_->is_sorted() ? sequence_->index_at(position_) : 0;
+    }
+
+    const Sequence* sequence_;
+    Tick position_ = 0;
+    size_t index_ = 0;
+    uint64_t revision_ = 0;
 };
 
 // =============================================================================
@@ -284,9 +453,7 @@ using MidiCallback = std::function<void(const MidiEvent&)>;
 class Processor {
 public:
     Processor()
-        : input_queue_(MIDI_QUEUE_SIZE)
-        , output_queue_(MIDI_QUEUE_SIZE)
-        , transpose_(0)
+        : transpose_(0)
         , velocity_scale_(1.0f)
         , channel_filter_(0xFFFF)  // All channels enabled
     {}
@@ -298,8 +465,9 @@ public:
 
     /// Process pending events (call from audio thread)
     void process(Tick current_tick) {
-        MidiEvent event;
-        while (input_queue_.pop(event)) {
+        while (auto next = input_queue_.pop()) {
+            const MidiEvent& event = *next;
+
             // Apply channel filter
             if (!is_channel_enabled(event.channel())) {
                 continue;
@@ -322,7 +490,10 @@ public:
 
     /// Pop processed event from output queue (thread-safe, RT-safe)
     bool pop_event(MidiEvent& event) {
-        return output_queue_.pop(event);
+        auto next = output_queue_.pop();
+        if (!next) return false;
+        event = *next;
+        return true;
     }
 
     /// Set transpose amount in semitones
@@ -384,8 +555,8 @@ private:
         return result;
     }
 
-    SPSCQueue<MidiEvent> input_queue_;
-    SPSCQueue<MidiEvent> output_queue_;
+    SPSCQueue<MidiEvent, MIDI_QUEUE_SIZE> input_queue_;
+    SPSCQueue<MidiEvent, MIDI_QUEUE_SIZE> output_queue_;
     NoteTracker tracker_;
     int transpose_;
     float velocity_scale_;
@@ -507,9 +678,156 @@ private:
 // MIDI File Reader (SMF Format)
 // =============================================================================
 
+namespace smf {
+
+inline uint32_t read_uint32_be(const uint8_t* data) {
+    return (uint32_t{data[0]} << 24) | (uint32_t{data[1]} << 16) | (uint32_t{data[2]} << 8) | data[3];
+}
+
+inline uint16_t read_uint16_be(const uint8_t* data) {
+    return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+/// Read a variable-length quantity; returns bytes consumed (at most 4)
+inline size_t read_variable_length(const uint8_t* data, size_t max_size, uint32_t& value) {
+    value = 0;
+    size_t bytes_read = 0;
+
+    for (size_t i = 0; i < max_size && i < 4; ++i) {
+        uint8_t byte = data[i];
+        value = (value << 7) | (byte & 0x7F);
+        bytes_read++;
+
+        if (!(byte & 0x80)) break;
+    }
+
+    return bytes_read;
+}
+
+} // namespace smf
+
+/**
+ * Storage estimate for a track chunk: a running-status note message is
+ * 3 bytes (1-byte delta + 2 data bytes), the common case in dense tracks.
+ */
+inline size_t estimate_event_count(size_t track_length) {
+    return track_length / 3;
+}
+
+/**
+ * Lazy decoder for one MTrk chunk body.
+ * Yields channel events in file order with absolute timestamps; meta and
+ * SysEx events are skipped (the track name and first tempo are remembered).
+ * Never allocates, so it can walk a memory-mapped file in place.
+ */
+class TrackDecoder {
+public:
+    TrackDecoder() = default;
+    TrackDecoder(const uint8_t* begin, const uint8_t* end)
+        : pos_(begin), end_(end) {}
+
+    /// Decode the next channel event; false at the end of the track
+    bool next(MidiEvent& event) {
+        while (pos_ < end_) {
+            uint32_t delta;
+            pos_ += smf::read_variable_length(pos_, remaining(), delta);
+            tick_ += delta;
+            if (pos_ >= end_) break;
+
+            uint8_t status = *pos_;
+
+            // Handle running status
+            if (status < 0x80) {
+                if (running_status_ == 0) break;  // Data byte with no status: corrupt
+                status = running_status_;
+            } else {
+                ++pos_;
+                if (status < 0xF0) {
+                    running_status_ = status;
+                }
+            }
+
+            const uint8_t type = status & 0xF0;
+            if (type == 0x80 || type == 0x90 || type == 0xA0 || type == 0xB0 || type == 0xE0) {
+                // Two data bytes
+                if (remaining() < 2) break;
+                event.timestamp = tick_;
+                event.status = status;
+                event.data1 = pos_[0];
+                event.data2 = pos_[1];
+                event.padding = 0;
+                pos_ += 2;
+                return true;
+            }
+            if (type == 0xC0 || type == 0xD0) {
+                // One data byte
+                if (remaining() < 1) break;
+                event.timestamp = tick_;
+                event.status = status;
+                event.data1 = *pos_++;
+                event.data2 = 0;
+                event.padding = 0;
+                return true;
+            }
+            if (status == 0xFF) {
+                // Meta event
+                if (remaining() < 2) break;
+                const uint8_t meta_type = *pos_++;
+                uint32_t length;
+                pos_ += smf::read_variable_length(pos_, remaining(), length);
+                if (length > remaining()) break;
+
+                if (meta_type == 0x03 && length > 0 && name_.empty()) {
+                    name_ = std::string_view(reinterpret_cast<const char*>(pos_), length);
+                } else if (meta_type == 0x51 && length == 3 && tempo_ == 0) {
+                    tempo_ = (uint32_t{pos_[0]} << 16) | (uint32_t{pos_[1]} << 8) | pos_[2];
+                } else if (meta_type == 0x2F) {
+                    break;  // End of track
+                }
+                pos_ += length;
+            } else if (status == 0xF0 || status == 0xF7) {
+                // SysEx
+                uint32_t length;
+                pos_ += smf::read_variable_length(pos_, remaining(), length);
+                if (length > remaining()) break;
+                pos_ += length;
+            } else {
+                break;  // System common/real-time messages are not valid in a file
+            }
+        }
+
+        pos_ = end_;
+        return false;
+    }
+
+    /// Track name from the first 0x03 meta event decoded so far (points into the file)
+    std::string_view name() const { return name_; }
+
+    /// Microseconds per quarter from the first 0x51 meta event decoded so far (0 = none)
+    uint32_t tempo() const { return tempo_; }
+
+    /// Absolute tick of the last decoded delta
+    Tick tick() const { return tick_; }
+
+    bool at_end() const { return pos_ >= end_; }
+
+private:
+    size_t remaining() const { return static_cast<size_t>(end_ - pos_); }
+
+    const uint8_t* pos_ = nullptr;
+    const uint8_t* end_ = nullptr;
+    Tick tick_ = 0;
+    uint8_t running_status_ = 0;
+    std::string_view name_;
+    uint32_t tempo_ = 0;
+};
+
 /**
  * Standard MIDI File (SMF) reader.
  * Parses .mid files into Sequence objects.
+ *
+ * Materializes every track; use StreamingFileReader (midi_stream.hpp) to
+ * scan large files or corpora without building sequences.
  */
 class FileReader {
 public:
@@ -529,15 +847,17 @@ public:
         }
 
         // Parse header
-        size_t header_length = read_uint32_be(data + 4);
-        format_ = read_uint16_be(data + 8);
-        num_tracks_ = read_uint16_be(data + 10);
-        ppq_ = read_uint16_be(data + 12);
+        size_t header_length = smf::read_uint32_be(data + 4);
+        format_ = smf::read_uint16_be(data + 8);
+        num_tracks_ = smf::read_uint16_be(data + 10);
+        ppq_ = smf::read_uint16_be(data + 12);
 
         // Parse tracks
         size_t offset = 8 + header_length;
         sequences_.clear();
         track_info_.clear();
+        sequences_.reserve(num_tracks_);
+        track_info_.reserve(num_tracks_);
 
         for (uint16_t track = 0; track < num_tracks_ && offset < size; ++track) {
             if (!parse_track(data, size, offset)) {
@@ -574,29 +894,6 @@ public:
     }
 
 private:
-    static uint32_t read_uint32_be(const uint8_t* data) {
-        return (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
-    }
-
-    static uint16_t read_uint16_be(const uint8_t* data) {
-        return (data[0] << 8) | data[1];
-    }
-
-    static size_t read_variable_length(const uint8_t* data, size_t max_size, uint32_t& value) {
-        value = 0;
-        size_t bytes_read = 0;
-
-        for (size_t i = 0; i < max_size && i < 4; ++i) {
-            uint8_t byte = data[i];
-            value = (value << 7) | (byte & 0x7F);
-            bytes_read++;
-
-            if (!(byte & 0x80)) break;
-        }
-
-        return bytes_read;
-    }
-
     bool parse_track(const uint8_t* data, size_t size, size_t& offset) {
         // Check MTrk header
         if (offset + 8 > size) return false;
@@ -605,97 +902,33 @@ private:
             return false;
         }
 
-        uint32_t track_length = read_uint32_be(data + offset + 4);
+        uint32_t track_length = smf::read_uint32_be(data + offset + 4);
         offset += 8;
 
+        const size_t track_end = std::min(offset + track_length, size);
+        TrackDecoder decoder(data + offset, data + track_end);
+
         Sequence seq(ppq_);
+        seq.reserve(estimate_event_count(track_length));
         TrackInfo info{"", 0, 0};
-        Tick absolute_time = 0;
-        uint8_t running_status = 0;
-
-        size_t track_end = offset + track_length;
-        while (offset < track_end && offset < size) {
-            // Read delta time
-            uint32_t delta;
-            offset += read_variable_length(data + offset, track_end - offset, delta);
-            absolute_time += delta;
-
-            if (offset >= track_end) break;
-
-            // Read event
-            uint8_t status = data[offset];
-
-            // Handle running status
-            if (status < 0x80) {
-                status = running_status;
-            } else {
-                offset++;
-                if (status < 0xF0) {
-                    running_status = status;
-                }
-            }
-
-            // Parse event based on status
-            uint8_t type = status & 0xF0;
-            uint8_t channel = status & 0x0F;
 
-            if (type == 0x80 || type == 0x90 || type == 0xA0 || type == 0xB0 || type == 0xE0) {
-                // Two data bytes
-                if (offset + 2 > track_end) break;
-                uint8_t data1 = data[offset++];
-                uint8_t data2 = data[offset++];
-
-                MidiEvent event;
-                event.timestamp = absolute_time;
-                event.status = status;
-                event.data1 = data1;
-                event.data2 = data2;
-
-                seq.add_event(event);
-                info.event_count++;
-                info.channel = channel;
-            }
-            else if (type == 0xC0 || type == 0xD0) {
-                // One data byte
-                if (offset + 1 > track_end) break;
-                uint8_t data1 = data[offset++];
-
-                MidiEvent event;
-                event.timestamp = absolute_time;
-                event.status = status;
-                event.data1 = data1;
-                event.data2 = 0;
-
-                seq.add_event(event);
-                info.event_count++;
-            }
-            else if (status == 0xFF) {
-                // Meta event
-                if (offset + 2 > track_end) break;
-                uint8_t meta_type = data[offset++];
-                uint32_t length;
-                offset += read_variable_length(data + offset, track_end - offset, length);
-
-                // Track name
-                if (meta_type == 0x03 && length > 0 && offset + length <= track_end) {
-                    info.name = std::string(reinterpret_cast<const char*>(data + offset), length);
-                }
+        MidiEvent event;
+        while (decoder.next(event)) {
+            seq.add_event(event);
+            info.event_count++;
 
-                offset += length;
-            }
-            else if (status == 0xF0 || status == 0xF7) {
-                // SysEx
-                uint32_t length;
-                offset += read_variable_length(data + offset, track_end - offset, length);
-                offset += length;
+            const auto type = event.type();
+            if (type != MidiMessageType::ProgramChange && type != MidiMessageType::ChannelPressure) {
+                info.channel = event.channel();
             }
         }
+        info.name = std::string(decoder.name());
 
         seq.sort();
         sequences_.push_back(std::move(seq));
         track_info_.push_back(std::move(info));
 
-        offset = track_end;
+        offset = offset + track_length;
         return true;
     }
 
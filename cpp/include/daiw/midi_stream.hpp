@@ -0,0 +1,316 @@
+/**
+ * DAiW Streaming MIDI File Reader
+ *
+ * Zero-copy Standard MIDI File access for corpus-scale analysis.
+ *
+ * Features:
+ * - Memory-mapped input (or any caller-owned buffer)
+ * - Track chunks indexed up front, decoded lazily on demand
+ * - k-way heap merge of Format 1 tracks into one time-ordered stream
+ * - Iterator API: for (const auto& e : reader.merged()) { ... }
+ */
+
+#pragma once
+
+#include "daiw/midi.hpp"
+
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace daiw {
+namespace midi {
+
+// =============================================================================
+// Memory-Mapped File
+// =============================================================================
+
+/**
+ * Read-only memory mapping of a whole file.
+ * Move-only; the mapping is released on close() or destruction.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+#if defined(_WIN32)
+            file_ = std::exchange(other.file_, nullptr);
+            mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Map a file; false if it cannot be opened or is empty
+    bool open(const std::string& path);
+    void close();
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool is_open() const { return data_ != nullptr; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#if defined(_WIN32)
+    void* file_ = nullptr;     // HANDLE, kept opaque so the header needs no <windows.h>
+    void* mapping_ = nullptr;  // HANDLE
+#endif
+};
+
+// =============================================================================
+// Merged Track Stream
+// =============================================================================
+
+/// Event from a merged stream, tagged with its source track
+struct TrackEvent {
+    MidiEvent event;
+    uint16_t track = 0;
+};
+
+/**
+ * Time-ordered merge of several TrackDecoders.
+ *
+ * Holds one pending event per track in a min-heap keyed on
+ * (timestamp, track), so each step is O(log tracks) and events at the same
+ * tick come out in track order, then file order. Single pass: iterate it once.
+ */
+class MergedEvents {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = TrackEvent;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const TrackEvent*;
+        using reference = const TrackEvent&;
+
+        iterator() = default;
+        explicit iterator(MergedEvents* owner) : owner_(owner) {}
+
+        reference operator*() const { return owner_->heap_.front(); }
+        pointer operator->() const { return &owner_->heap_.front(); }
+
+        iterator& operator++() {
+            owner_->pop();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        bool operator==(std::default_sentinel_t) const {
+            return owner_ == nullptr || owner_->heap_.empty();
+        }
+
+    private:
+        MergedEvents* owner_ = nullptr;
+    };
+
+    explicit MergedEvents(std::vector<TrackDecoder> decoders)
+        : decoders_(std::move(decoders)) {
+        heap_.reserve(decoders_.size());
+        for (size_t t = 0; t < decoders_.size(); ++t) {
+            TrackEvent pending;
+            pending.track = static_cast<uint16_t>(t);
+            if (decoders_[t].next(pending.event)) {
+                heap_.push_back(pending);
+            }
+        }
+        for (size_t i = heap_.size() / 2; i-- > 0;) {
+            sift_down(i);
+        }
+    }
+
+    iterator begin() { return iterator(this); }
+    std::default_sentinel_t end() const { return {}; }
+
+    /// Decoder for a track (e.g. for its name once decoding has passed it)
+    const TrackDecoder& decoder(size_t track) const { return decoders_[track]; }
+
+private:
+    static bool earlier(const TrackEvent& a, const TrackEvent& b) {
+        if (a.event.timestamp != b.event.timestamp) {
+            return a.event.timestamp < b.event.timestamp;
+        }
+        return a.track < b.track;
+    }
+
+    /// Refill the top from its own track and restore the heap in one pass
+    void pop() {
+        TrackEvent& top = heap_.front();
+        if (!decoders_[top.track].next(top.event)) {
+            top = heap_.back();
+            heap_.pop_back();
+        }
+        if (!heap_.empty()) {
+            sift_down(0);
+        }
+    }
+
+    void sift_down(size_t i) {
+        const size_t n = heap_.size();
+        const TrackEvent item = heap_[i];
+        for (;;) {
+            size_t child = 2 * i + 1;
+            if (child >= n) break;
+            if (child + 1 < n && earlier(heap_[child + 1], heap_[child])) ++child;
+            if (!earlier(heap_[child], item)) break;
+            heap_[i] = heap_[child];
+            i = child;
+        }
+        heap_[i] = item;
+    }
+
+    std::vector<TrackDecoder> decoders_;
+    std::vector<TrackEvent> heap_;
+};
+
+// =============================================================================
+// Streaming File Reader
+// =============================================================================
+
+/**
+ * Standard MIDI File reader that works in place over a mapped buffer.
+ *
+ * open() validates the header and indexes the track chunks (O(tracks));
+ * no event is decoded until a track or the merged stream is iterated, and
+ * nothing is materialized unless read_track() is asked to.
+ */
+class StreamingFileReader {
+public:
+    struct TrackChunk {
+        size_t offset;    // Start of the chunk body
+        size_t length;    // Body length (clamped to the file)
+    };
+
+    /// Memory-map and index a file
+    bool open(const std::string& path) {
+        close();
+        if (!file_.open(path)) return false;
+        if (!index(file_.data(), file_.size())) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    /// Index a caller-owned buffer (not copied; must outlive the reader)
+    bool open(const uint8_t* data, size_t size) {
+        close();
+        if (!index(data, size)) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+        file_.close();
+        data_ = nullptr;
+        size_ = 0;
+        tracks_.clear();
+        format_ = 0;
+        ppq_ = DEFAULT_PPQ;
+    }
+
+    /// Get format (0, 1, or 2)
+    uint16_t format() const { return format_; }
+
+    /// Get PPQ
+    uint16_t ppq() const { return ppq_; }
+
+    /// Number of track chunks actually present in the file
+    size_t num_tracks() const { return tracks_.size(); }
+
+    /// Bytes of the underlying file/buffer
+    size_t size_bytes() const { return size_; }
+
+    const TrackChunk& track_chunk(size_t track) const { return tracks_[track]; }
+
+    /// Lazy decoder over one track
+    TrackDecoder track(size_t track) const {
+        const TrackChunk& chunk = tracks_[track];
+        return TrackDecoder(data_ + chunk.offset, data_ + chunk.offset + chunk.length);
+    }
+
+    /// Decode one track into a Sequence, pre-sized from the chunk length
+    void read_track(size_t track, Sequence& out) const {
+        out.clear();
+        out.set_ppq(ppq_);
+        out.reserve(estimate_event_count(tracks_[track].length));
+
+        TrackDecoder decoder = this->track(track);
+        MidiEvent event;
+        while (decoder.next(event)) {
+            out.add_event(event);
+        }
+        out.sort();
+    }
+
+    /**
+     * All tracks merged into one time-ordered stream (Format 0/1).
+     * The reader must outlive the returned range.
+     */
+    MergedEvents merged() const {
+        std::vector<TrackDecoder> decoders;
+        decoders.reserve(tracks_.size());
+        for (size_t t = 0; t < tracks_.size(); ++t) {
+            decoders.push_back(track(t));
+        }
+        return MergedEvents(std::move(decoders));
+    }
+
+private:
+    bool index(const uint8_t* data, size_t size) {
+        if (data == nullptr || size < 14) return false;  // Minimum header size
+        if (data[0] != 'M' || data[1] != 'T' || data[2] != 'h' || data[3] != 'd') {
+            return false;
+        }
+
+        const size_t header_length = smf::read_uint32_be(data + 4);
+        if (header_length < 6) return false;
+
+        format_ = smf::read_uint16_be(data + 8);
+        const uint16_t declared_tracks = smf::read_uint16_be(data + 10);
+        ppq_ = smf::read_uint16_be(data + 12);
+
+        data_ = data;
+        size_ = size;
+        tracks_.reserve(declared_tracks);
+
+        // Walk chunk headers only; unknown chunk types are skipped per the spec
+        size_t offset = 8 + header_length;
+        while (offset + 8 <= size && tracks_.size() < declared_tracks) {
+            const uint8_t* chunk = data + offset;
+            const size_t length = smf::read_uint32_be(chunk + 4);
+            const size_t body = offset + 8;
+            const size_t available = std::min(length, size - body);
+
+            if (chunk[0] == 'M' && chunk[1] == 'T' && chunk[2] == 'r' && chunk[3] == 'k') {
+                tracks_.push_back({body, available});
+            }
+            offset = body + available;
+        }
+        return true;
+    }
+
+    MappedFile file_;
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    uint16_t format_ = 0;
+    uint16_t ppq_ = DEFAULT_PPQ;
+    std::vector<TrackChunk> tracks_;
+};
+
+} // namespace midi
+} // namespace daiw
@@ -0,0 +1,100 @@
+/**
+ * DAiW Counter-Based Random Numbers
+ *
+ * Stateless random draws keyed by (seed, stream, counter) for humanization.
+ *
+ * Features:
+ * - SplitMix64 finalizer over a Weyl sequence: draw i is a pure function of i
+ * - Reproducible regardless of processing order or block size
+ * - Independent streams per parameter (timing, velocity, ...) from one seed
+ * - No engine state to construct, seed, or share between threads
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace daiw::random {
+
+constexpr uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ull;
+
+/**
+ * SplitMix64 output function (Steele, Lea & Flood 2014).
+ */
+constexpr uint64_t splitmix64(uint64_t x) noexcept {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/**
+ * Random-access generator: bits(i) is the i-th element of a SplitMix64
+ * sequence whose start is derived from (seed, stream).
+ *
+ * Usage:
+ *   CounterRng timing(seed, 0);
+ *   for (size_t i = 0; i < n; ++i) offset[i] = timing.normal(first + i) * sigma;
+ */
+class CounterRng {
+public:
+    constexpr explicit CounterRng(uint64_t seed, uint64_t stream = 0) noexcept
+        : key_(splitmix64(splitmix64(seed) ^ (stream * 0xD1B54A32D192ED03ull))) {}
+
+    constexpr uint64_t bits(uint64_t counter) const noexcept {
+        return splitmix64(key_ + counter * GOLDEN_GAMMA);
+    }
+
+    /// Uniform in [0, 1)
+    float uniform(uint64_t counter) const noexcept {
+        return static_cast<float>(bits(counter) >> 40) * 0x1.0p-24f;
+    }
+
+    /// Uniform in [-1, 1)
+    float uniform_signed(uint64_t counter) const noexcept {
+        return static_cast<float>(bits(counter) >> 40) * 0x1.0p-23f - 1.0f;
+    }
+
+    /// Standard normal (Box-Muller on the two halves of one draw)
+    float normal(uint64_t counter) const noexcept {
+        const uint64_t b = bits(counter);
+        const float u1 = static_cast<float>((b >> 40) + 1) * 0x1.0p-24f;  // (0, 1]
+        const float u2 = static_cast<float>((b >> 8) & 0xFFFFFF) * 0x1.0p-24f;
+        return std::sqrt(-2.0f * std::log(u1)) * std::cos(6.28318530718f * u2);
+    }
+
+    /// out[i] = uniform_signed(first + i)
+    void fill_uniform_signed(float* out, uint64_t first, size_t n) const noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = uniform_signed(first + i);
+        }
+    }
+
+    /// out[i] = normal(first + i)
+    void fill_normal(float* out, uint64_t first, size_t n) const noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = normal(first + i);
+        }
+    }
+
+private:
+    uint64_t key_;
+};
+
+/**
+ * Fresh seed for callers that ask for non-reproducible output.
+ * std::random_device is read once per process; later calls just step a
+ * shared Weyl counter.
+ */
+inline uint64_t random_seed() noexcept {
+    static std::atomic<uint64_t> state{[] {
+        std::random_device rd;
+        return (static_cast<uint64_t>(rd()) << 32) | rd();
+    }()};
+    return splitmix64(state.fetch_add(GOLDEN_GAMMA, std::memory_order_relaxed));
+}
+
+}  // namespace daiw::random
@@ -12,6 +12,7 @@
  * - NEON (ARM/Apple Silicon)
  */
 
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -327,25 +328,326 @@ inline void generate_ramp(float* data, size_t n, float start, float end) {
  * Optimized for processing many MIDI events at once.
  */
 inline void apply_timing_offsets(int64_t* ticks, const int16_t* offsets, size_t n) {
-    // Note: Using scalar for int64 as SIMD benefit is limited
+#if defined(DAIW_AVX2)
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i off16 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(offsets + i));
+        __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ticks + i));
+        t = _mm256_add_epi64(t, _mm256_cvtepi16_epi64(off16));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(ticks + i), t);
+    }
+
+    for (; i < n; ++i) {
+        ticks[i] += offsets[i];
+    }
+
+#else
     for (size_t i = 0; i < n; ++i) {
         ticks[i] += offsets[i];
     }
+#endif
 }
 
+/**
+ * Clamp ticks from below (e.g. keep early-pushed notes at or after 0).
+ * ticks[i] = max(ticks[i], min_tick)
+ */
+inline void clamp_ticks_min(int64_t* ticks, int64_t min_tick, size_t n) {
+#if defined(DAIW_AVX2)
+    __m256i lo = _mm256_set1_epi64x(min_tick);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ticks + i));
+        __m256i below = _mm256_cmpgt_epi64(lo, t);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(ticks + i),
+                            _mm256_blendv_epi8(t, lo, below));
+    }
+
+    for (; i < n; ++i) {
+        if (ticks[i] < min_tick) ticks[i] = min_tick;
+    }
+
+#else
+    for (size_t i = 0; i < n; ++i) {
+        if (ticks[i] < min_tick) ticks[i] = min_tick;
+    }
+#endif
+}
+
+#if defined(DAIW_AVX2)
+namespace detail {
+
+/// Clamp 16 u16 lanes to [1, 127] and narrow to 16 bytes
+inline __m128i clamp_velocities_u16(__m256i v) {
+    v = _mm256_min_epu16(v, _mm256_set1_epi16(127));
+    v = _mm256_max_epu16(v, _mm256_set1_epi16(1));
+    return _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+}
+
+} // namespace detail
+#endif
+
 /**
  * Scale velocities by curve.
  * velocity[i] = clamp(velocity[i] * scale[i] / 100, 1, 127)
  */
 inline void scale_velocities(uint8_t* velocities, const uint8_t* scales, size_t n) {
+#if defined(DAIW_AVX2)
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m256i v = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(velocities + i)));
+        __m256i s = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(scales + i)));
+
+        // product <= 255 * 255 fits in u16; (x * 5243) >> 19 == x / 100 below
+        // 43699, and anything above that clamps to 127 either way
+        __m256i product = _mm256_mullo_epi16(v, s);
+        __m256i scaled = _mm256_srli_epi16(_mm256_mulhi_epu16(product, _mm256_set1_epi16(5243)), 3);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(velocities + i),
+                         detail::clamp_velocities_u16(scaled));
+    }
+
+    for (; i < n; ++i) {
+        int32_t scaled = (static_cast<int32_t>(velocities[i]) * scales[i]) / 100;
+        velocities[i] = static_cast<uint8_t>(
+            scaled < 1 ? 1 : (scaled > 127 ? 127 : scaled)
+        );
+    }
+
+#else
     for (size_t i = 0; i < n; ++i) {
         int32_t scaled = (static_cast<int32_t>(velocities[i]) * scales[i]) / 100;
         velocities[i] = static_cast<uint8_t>(
             scaled < 1 ? 1 : (scaled > 127 ? 127 : scaled)
         );
     }
+#endif
+}
+
+/**
+ * Blend velocities toward per-note targets.
+ * velocity[i] = clamp(round(velocity[i] * (1 - amount) + target[i] * amount), 1, 127)
+ * amount is quantized to 1/256 steps.
+ */
+inline void blend_velocities(uint8_t* velocities, const uint8_t* targets, float amount, size_t n) {
+    const float clamped = amount < 0.0f ? 0.0f : (amount > 1.0f ? 1.0f : amount);
+    const int32_t w = static_cast<int32_t>(clamped * 256.0f + 0.5f);
+
+#if defined(DAIW_AVX2)
+    // v * (256 - w) + t * w + 128 <= 255 * 256 + 128 fits in u16
+    const __m256i weight = _mm256_set1_epi16(static_cast<int16_t>(w));
+    const __m256i keep = _mm256_set1_epi16(static_cast<int16_t>(256 - w));
+    const __m256i half = _mm256_set1_epi16(128);
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m256i v = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(velocities + i)));
+        __m256i t = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(targets + i)));
+
+        __m256i mixed = _mm256_add_epi16(_mm256_mullo_epi16(v, keep), _mm256_mullo_epi16(t, weight));
+        mixed = _mm256_srli_epi16(_mm256_add_epi16(mixed, half), 8);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(velocities + i),
+                         detail::clamp_velocities_u16(mixed));
+    }
+
+    for (; i < n; ++i) {
+        int32_t mixed = (velocities[i] * (256 - w) + targets[i] * w + 128) >> 8;
+        velocities[i] = static_cast<uint8_t>(mixed < 1 ? 1 : (mixed > 127 ? 127 : mixed));
+    }
+
+#else
+    for (size_t i = 0; i < n; ++i) {
+        int32_t mixed = (velocities[i] * (256 - w) + targets[i] * w + 128) >> 8;
+        velocities[i] = static_cast<uint8_t>(mixed < 1 ? 1 : (mixed > 127 ? 127 : mixed));
+    }
+#endif
 }
 
+// =============================================================================
+// Fast Log / Exp
+// =============================================================================
+
+namespace detail {
+
+inline float bits_to_float(uint32_t bits) {
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+inline uint32_t float_to_bits(float f) {
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+// log2(m) = 2/ln2 * atanh((m - 1) / (m + 1)), series to t^9
+constexpr float LOG2_C1 = 2.8853900817779268f;   // 2 / ln2
+constexpr float LOG2_C3 = LOG2_C1 / 3.0f;
+constexpr float LOG2_C5 = LOG2_C1 / 5.0f;
+constexpr float LOG2_C7 = LOG2_C1 / 7.0f;
+constexpr float LOG2_C9 = LOG2_C1 / 9.0f;
+
+// 2^f on [-0.5, 0.5]: Taylor series of e^(f ln2) to f^6
+constexpr float EXP2_C1 = 0.6931471805599453f;
+constexpr float EXP2_C2 = 0.2402265069591007f;
+constexpr float EXP2_C3 = 0.0555041086648216f;
+constexpr float EXP2_C4 = 0.0096181291076285f;
+constexpr float EXP2_C5 = 0.0013333558146428f;
+constexpr float EXP2_C6 = 0.0001540353039338f;
+
+constexpr float MIN_NORMAL = 1.17549435e-38f;
+
+inline float fast_log2_scalar(float x) {
+    const uint32_t bits = float_to_bits(x > MIN_NORMAL ? x : MIN_NORMAL);
+    const float exponent = static_cast<float>(static_cast<int32_t>(bits >> 23) - 127);
+    const float m = bits_to_float((bits & 0x007FFFFFu) | 0x3F800000u);  // [1, 2)
+
+    const float t = (m - 1.0f) / (m + 1.0f);
+    const float t2 = t * t;
+    const float poly = LOG2_C1 + t2 * (LOG2_C3 + t2 * (LOG2_C5 + t2 * (LOG2_C7 + t2 * LOG2_C9)));
+    return exponent + t * poly;
+}
+
+inline float fast_exp2_scalar(float x) {
+    x = x < -126.0f ? -126.0f : (x > 126.0f ? 126.0f : x);
+    const float whole = std::nearbyint(x);
+    const float f = x - whole;
+
+    const float poly = 1.0f + f * (EXP2_C1 + f * (EXP2_C2 + f * (EXP2_C3
+                     + f * (EXP2_C4 + f * (EXP2_C5 + f * EXP2_C6)))));
+    const uint32_t scale = static_cast<uint32_t>(static_cast<int32_t>(whole) + 127) << 23;
+    return bits_to_float(scale) * poly;
+}
+
+} // namespace detail
+
+/**
+ * Approximate base-2 logarithm.
+ * out[i] = log2(max(in[i], FLT_MIN)), absolute error < 1e-5.
+ * in and out may alias.
+ */
+inline void fast_log2(float* out, const float* in, size_t n) {
+#if defined(DAIW_AVX2)
+    const __m256 min_normal = _mm256_set1_ps(detail::MIN_NORMAL);
+    const __m256i mantissa_mask = _mm256_set1_epi32(0x007FFFFF);
+    const __m256i one_bits = _mm256_set1_epi32(0x3F800000);
+    const __m256i bias = _mm256_set1_epi32(127);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        const __m256i bits = _mm256_castps_si256(_mm256_max_ps(_mm256_loadu_ps(in + i), min_normal));
+        const __m256 exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), bias));
+        const __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, mantissa_mask), one_bits));
+
+        const __m256 t = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+        const __m256 t2 = _mm256_mul_ps(t, t);
+        __m256 poly = _mm256_set1_ps(detail::LOG2_C9);
+        poly = _mm256_fmadd_ps(poly, t2, _mm256_set1_ps(detail::LOG2_C7));
+        poly = _mm256_fmadd_ps(poly, t2, _mm256_set1_ps(detail::LOG2_C5));
+        poly = _mm256_fmadd_ps(poly, t2, _mm256_set1_ps(detail::LOG2_C3));
+        poly = _mm256_fmadd_ps(poly, t2, _mm256_set1_ps(detail::LOG2_C1));
+        _mm256_storeu_ps(out + i, _mm256_fmadd_ps(t, poly, exponent));
+    }
+
+    for (; i < n; ++i) {
+        out[i] = detail::fast_log2_scalar(in[i]);
+    }
+
+#else
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = detail::fast_log2_scalar(in[i]);
+    }
+#endif
+}
+
+/**
+ * Approximate power of two.
+ * out[i] = 2^clamp(in[i], -126, 126), relative error < 1e-6.
+ * in and out may alias.
+ */
+inline void fast_exp2(float* out, const float* in, size_t n) {
+#if defined(DAIW_AVX2)
+    const __m256 lo = _mm256_set1_ps(-126.0f);
+    const __m256 hi = _mm256_set1_ps(126.0f);
+    const __m256i bias = _mm256_set1_epi32(127);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        const __m256 x = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(in + i), lo), hi);
+        const __m256 whole = _mm256_round_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        const __m256 f = _mm256_sub_ps(x, whole);
+
+        __m256 poly = _mm256_set1_ps(detail::EXP2_C6);
+        poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(detail::EXP2_C5));
+        poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(detail::EXP2_C4));
+        poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(detail::EXP2_C3));
+        poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(detail::EXP2_C2));
+        poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(detail::EXP2_C1));
+        poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(1.0f));
+
+        const __m256i scale = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(whole), bias), 23);
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_castsi256_ps(scale), poly));
+    }
+
+    for (; i < n; ++i) {
+        out[i] = detail::fast_exp2_scalar(in[i]);
+    }
+
+#else
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = detail::fast_exp2_scalar(in[i]);
+    }
+#endif
+}
+
+// =============================================================================
+// Lane Transposes
+// =============================================================================
+
+#if defined(DAIW_AVX2) || defined(DAIW_AVX512)
+
+/**
+ * Transpose an 8x8 tile of floats held in 8 registers (in place).
+ * Turns 8 per-sample vectors of 8 lanes into 8 per-lane vectors of
+ * 8 samples and back, for recursive filters run one lane per register slot.
+ */
+inline void transpose8x8(__m256 (&r)[8]) noexcept {
+    const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+    const __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+    const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+    const __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+    const __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+    const __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+    const __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+    const __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+
+    const __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    r[0] = _mm256_permute2f128_ps(u0, u4, 0x20);
+    r[1] = _mm256_permute2f128_ps(u1, u5, 0x20);
+    r[2] = _mm256_permute2f128_ps(u2, u6, 0x20);
+    r[3] = _mm256_permute2f128_ps(u3, u7, 0x20);
+    r[4] = _mm256_permute2f128_ps(u0, u4, 0x31);
+    r[5] = _mm256_permute2f128_ps(u1, u5, 0x31);
+    r[6] = _mm256_permute2f128_ps(u2, u6, 0x31);
+    r[7] = _mm256_permute2f128_ps(u3, u7, 0x31);
+}
+
+#endif
+
 // =============================================================================
 // Stereo Operations
 // =============================================================================
@@ -358,17 +660,16 @@ inline void mono_to_stereo(float* stereo, const float* mono, size_t n) {
 #if defined(DAIW_AVX2)
     size_t i = 0;
 
-    for (; i + 4 <= n; i += 4) {
-        __m128 samples = _mm_loadu_ps(mono + i);
-        __m256 doubled = _mm256_castps128_ps256(samples);
-        doubled = _mm256_insertf128_ps(doubled, samples, 1);
+    for (; i + 8 <= n; i += 8) {
+        __m256 samples = _mm256_loadu_ps(mono + i);
 
-        // Interleave: [a,b,c,d,a,b,c,d] -> [a,a,b,b,c,c,d,d]
-        __m256 lo = _mm256_unpacklo_ps(doubled, doubled);
-        __m256 hi = _mm256_unpackhi_ps(doubled, doubled);
+        // [a..h] -> lo = [a,a,b,b | e,e,f,f], hi = [c,c,d,d | g,g,h,h]
+        __m256 lo = _mm256_unpacklo_ps(samples, samples);
+        __m256 hi = _mm256_unpackhi_ps(samples, samples);
 
-        _mm256_storeu_ps(stereo + 2*i, lo);
-        _mm256_storeu_ps(stereo + 2*i + 8, hi);
+        // Recombine lanes: [a,a,b,b,c,c,d,d] and [e,e,f,f,g,g,h,h]
+        _mm256_storeu_ps(stereo + 2*i, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(stereo + 2*i + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
     }
 
     for (; i < n; ++i) {
@@ -0,0 +1,364 @@
+/**
+ * @file fft.cpp
+ * @brief Shared FFT engine: plans, plan cache and scratch pool
+ *
+ * Complex transforms are iterative decimation-in-time: bit-reversal by a
+ * precomputed swap list, one scalar radix-4 pass for the first two stages,
+ * then radix-2 stages whose butterflies run 4 (AVX2) or 2 (SSE4.2) complex
+ * points per vector. Each stage reads its twiddles contiguously.
+ */
+
+#include "daiw/fft.hpp"
+#include "daiw/simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <new>
+
+namespace daiw::dsp {
+
+namespace {
+
+constexpr size_t TABLE_ALIGNMENT = 64;
+
+size_t log2_size(size_t size) {
+    size_t bits = 0;
+    while ((size_t{1} << bits) < size) ++bits;
+    return bits;
+}
+
+uint32_t reverse_bits(uint32_t value, size_t bits) {
+    uint32_t reversed = 0;
+    for (size_t b = 0; b < bits; ++b) {
+        reversed = (reversed << 1) | (value & 1u);
+        value >>= 1;
+    }
+    return reversed;
+}
+
+/// Swap pairs (i < bitrev(i)) for an n-point permutation; returns the count
+size_t build_swaps(uint32_t* swaps, size_t n) {
+    const size_t bits = log2_size(n);
+    size_t count = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        const uint32_t j = reverse_bits(i, bits);
+        if (i < j) {
+            swaps[2 * count] = i;
+            swaps[2 * count + 1] = j;
+            ++count;
+        }
+    }
+    return count;
+}
+
+size_t align_up(size_t bytes) {
+    return (bytes + TABLE_ALIGNMENT - 1) & ~(TABLE_ALIGNMENT - 1);
+}
+
+/// First two stages of a bit-reversed DIT: radix-4 butterflies, w = 1, -i
+void radix4_first_pass(Complex* data, size_t n) noexcept {
+    float* d = reinterpret_cast<float*>(data);
+    for (size_t j = 0; j < n; j += 4) {
+        float* x = d + 2 * j;
+        const float t0r = x[0] + x[2], t0i = x[1] + x[3];
+        const float t1r = x[0] - x[2], t1i = x[1] - x[3];
+        const float t2r = x[4] + x[6], t2i = x[5] + x[7];
+        const float t3r = x[4] - x[6], t3i = x[5] - x[7];
+
+        // -i * t3 = (t3i, -t3r)
+        x[0] = t0r + t2r;
+        x[1] = t0i + t2i;
+        x[2] = t1r + t3i;
+        x[3] = t1i - t3r;
+        x[4] = t0r - t2r;
+        x[5] = t0i - t2i;
+        x[6] = t1r - t3i;
+        x[7] = t1i + t3r;
+    }
+}
+
+/// One radix-2 stage of half-width h (h >= 4): a, b = a + w b, a - w b
+void radix2_stage(Complex* data, size_t n, size_t h, const Complex* twiddles) noexcept {
+    for (size_t j = 0; j < n; j += 2 * h) {
+        float* a = reinterpret_cast<float*>(data + j);
+        float* b = reinterpret_cast<float*>(data + j + h);
+        const float* w = reinterpret_cast<const float*>(twiddles);
+        size_t k = 0;
+
+#if defined(DAIW_AVX2) || defined(DAIW_AVX512)
+        // (br + i bi)(wr + i wi): fmaddsub(b, wr, swap(b) * wi)
+        for (; k + 4 <= h; k += 4) {
+            const __m256 wv = _mm256_load_ps(w + 2 * k);
+            const __m256 bv = _mm256_loadu_ps(b + 2 * k);
+            const __m256 wb = _mm256_fmaddsub_ps(bv, _mm256_moveldup_ps(wv),
+                                                 _mm256_mul_ps(_mm256_permute_ps(bv, 0xB1),
+                                                               _mm256_movehdup_ps(wv)));
+            const __m256 av = _mm256_loadu_ps(a + 2 * k);
+            _mm256_storeu_ps(a + 2 * k, _mm256_add_ps(av, wb));
+            _mm256_storeu_ps(b + 2 * k, _mm256_sub_ps(av, wb));
+        }
+#elif defined(DAIW_SSE42)
+        for (; k + 2 <= h; k += 2) {
+            const __m128 wv = _mm_load_ps(w + 2 * k);
+            const __m128 bv = _mm_loadu_ps(b + 2 * k);
+            const __m128 wb = _mm_addsub_ps(_mm_mul_ps(bv, _mm_moveldup_ps(wv)),
+                                            _mm_mul_ps(_mm_shuffle_ps(bv, bv, 0xB1), _mm_movehdup_ps(wv)));
+            const __m128 av = _mm_loadu_ps(a + 2 * k);
+            _mm_storeu_ps(a + 2 * k, _mm_add_ps(av, wb));
+            _mm_storeu_ps(b + 2 * k, _mm_sub_ps(av, wb));
+        }
+#endif
+
+        for (; k < h; ++k) {
+            const float wr = w[2 * k], wi = w[2 * k + 1];
+            const float br = b[2 * k], bi = b[2 * k + 1];
+            const float tr = br * wr - bi * wi;
+            const float ti = br * wi + bi * wr;
+            const float ar = a[2 * k], ai = a[2 * k + 1];
+            a[2 * k] = ar + tr;
+            a[2 * k + 1] = ai + ti;
+            b[2 * k] = ar - tr;
+            b[2 * k + 1] = ai - ti;
+        }
+    }
+}
+
+#if defined(DAIW_AVX2) || defined(DAIW_AVX512)
+// Four interleaved complex values per __m256
+
+inline __m256 complex_multiply(__m256 a, __m256 w) noexcept {
+    return _mm256_fmaddsub_ps(a, _mm256_moveldup_ps(w),
+                              _mm256_mul_ps(_mm256_permute_ps(a, 0xB1), _mm256_movehdup_ps(w)));
+}
+
+/// Complex values in reverse order
+inline __m256 reverse_complex(__m256 v) noexcept {
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(v), 0x1B));
+}
+
+inline __m256 imag_sign() noexcept { return _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f); }
+inline __m256 real_sign() noexcept { return _mm256_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f); }
+
+/**
+ * Vector body of the real-FFT split passes, over k in [1, limit) where the
+ * k and N/2 - k blocks never overlap; returns the first k left to scalar.
+ * even = (X[k] + conj X[m]) / 2, diff = (X[k] - conj X[m]) / 2,
+ * out[k] = even + rot, out[m] = conj(even - rot) with
+ * rot = W^k (-i diff) (forward) or i conj(W^k) diff (inverse).
+ */
+template<bool Inverse>
+size_t split_pass_avx(const float* in, float* out, const float* w, size_t half) noexcept {
+    const __m256 halfScale = _mm256_set1_ps(0.5f);
+    size_t k = 1;
+    for (; 2 * k + 6 < half; k += 4) {
+        const size_t m = half - k - 3;
+        const __m256 a = _mm256_loadu_ps(in + 2 * k);
+        const __m256 b = _mm256_xor_ps(reverse_complex(_mm256_loadu_ps(in + 2 * m)), imag_sign());
+        const __m256 wv = _mm256_loadu_ps(w + 2 * k);
+
+        const __m256 even = _mm256_mul_ps(halfScale, _mm256_add_ps(a, b));
+        const __m256 diff = _mm256_mul_ps(halfScale, _mm256_sub_ps(a, b));
+
+        __m256 rot;
+        if constexpr (Inverse) {
+            const __m256 odd = complex_multiply(diff, _mm256_xor_ps(wv, imag_sign()));
+            rot = _mm256_xor_ps(_mm256_permute_ps(odd, 0xB1), real_sign());       // i * odd
+        } else {
+            const __m256 odd = _mm256_xor_ps(_mm256_permute_ps(diff, 0xB1), imag_sign());  // -i * diff
+            rot = complex_multiply(odd, wv);
+        }
+
+        _mm256_storeu_ps(out + 2 * k, _mm256_add_ps(even, rot));
+        const __m256 mirrored = _mm256_xor_ps(_mm256_sub_ps(even, rot), imag_sign());
+        _mm256_storeu_ps(out + 2 * m, reverse_complex(mirrored));
+    }
+    return k;
+}
+#endif
+
+} // namespace
+
+// =============================================================================
+// FftPlan
+// =============================================================================
+
+FftPlan::FftPlan(size_t size) : size_(size) {
+    // One aligned allocation: twiddles, then both swap lists
+    const size_t twiddle_bytes = align_up(size_ * sizeof(Complex));
+    const size_t swap_bytes = align_up(size_ * sizeof(uint32_t));
+    const size_t half_swap_bytes = align_up(size_ / 2 * sizeof(uint32_t));
+    storage_ = std::make_unique<std::byte[]>(twiddle_bytes + swap_bytes + half_swap_bytes + TABLE_ALIGNMENT);
+
+    auto base = reinterpret_cast<uintptr_t>(storage_.get());
+    base = (base + TABLE_ALIGNMENT - 1) & ~(TABLE_ALIGNMENT - 1);
+    std::byte* cursor = reinterpret_cast<std::byte*>(base);
+
+    twiddles_ = reinterpret_cast<Complex*>(cursor);
+    swaps_ = reinterpret_cast<uint32_t*>(cursor + twiddle_bytes);
+    half_swaps_ = reinterpret_cast<uint32_t*>(cursor + twiddle_bytes + swap_bytes);
+
+    // Double precision so large stages stay accurate
+    twiddles_[0] = Complex(1.0f, 0.0f);
+    for (size_t h = 1; h < size_; h *= 2) {
+        for (size_t k = 0; k < h; ++k) {
+            const double angle = -M_PI * static_cast<double>(k) / static_cast<double>(h);
+            twiddles_[h + k] = Complex(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+        }
+    }
+
+    num_swaps_ = build_swaps(swaps_, size_);
+    num_half_swaps_ = build_swaps(half_swaps_, size_ / 2);
+}
+
+FftPlan::~FftPlan() = default;
+
+void FftPlan::transform(Complex* data, size_t n, const uint32_t* swaps, size_t num_swaps) const noexcept {
+    for (size_t s = 0; s < num_swaps; ++s) {
+        std::swap(data[swaps[2 * s]], data[swaps[2 * s + 1]]);
+    }
+
+    if (n < 4) {
+        // n == 2: one butterfly
+        const Complex a = data[0];
+        data[0] = a + data[1];
+        data[1] = a - data[1];
+        return;
+    }
+
+    radix4_first_pass(data, n);
+    for (size_t h = 4; h < n; h *= 2) {
+        radix2_stage(data, n, h, twiddles_ + h);
+    }
+}
+
+void FftPlan::forward(Complex* data) const noexcept {
+    transform(data, size_, swaps_, num_swaps_);
+}
+
+void FftPlan::inverse(Complex* data) const noexcept {
+    // IFFT(x) = conj(FFT(conj(x))) / N
+    for (size_t i = 0; i < size_; ++i) data[i] = std::conj(data[i]);
+    transform(data, size_, swaps_, num_swaps_);
+
+    const float scale = 1.0f / static_cast<float>(size_);
+    for (size_t i = 0; i < size_; ++i) data[i] = std::conj(data[i]) * scale;
+}
+
+void FftPlan::forward_real(const float* input, Complex* spectrum) const noexcept {
+    // z[n] = x[2n] + i x[2n+1]; Z = FFT_{N/2}(z)
+    const size_t half = size_ / 2;
+    float* packed = reinterpret_cast<float*>(spectrum);
+    if (packed != input) std::copy(input, input + size_, packed);
+    transform(spectrum, half, half_swaps_, num_half_swaps_);
+
+    // Split: E = (Z[k] + conj Z[N/2-k]) / 2, O = (Z[k] - conj Z[N/2-k]) / 2i,
+    // X[k] = E + W^k O, X[N/2-k] = conj(E - W^k O)
+    const Complex z0 = spectrum[0];
+    spectrum[0] = Complex(z0.real() + z0.imag(), 0.0f);
+    spectrum[half] = Complex(z0.real() - z0.imag(), 0.0f);
+
+    // Explicit float math: std::complex multiplication handles inf/nan out of line
+    const float* w = reinterpret_cast<const float*>(twiddles_ + half);  // e^{-2 pi i k / N}
+    float* x = reinterpret_cast<float*>(spectrum);
+    size_t k = 1;
+#if defined(DAIW_AVX2) || defined(DAIW_AVX512)
+    k = split_pass_avx<false>(x, x, w, half);
+#endif
+    for (; k <= half / 2; ++k) {
+        const size_t m = half - k;
+        const float evenR = 0.5f * (x[2 * k] + x[2 * m]);
+        const float evenI = 0.5f * (x[2 * k + 1] - x[2 * m + 1]);
+        const float oddR = 0.5f * (x[2 * k + 1] + x[2 * m + 1]);
+        const float oddI = -0.5f * (x[2 * k] - x[2 * m]);
+        const float wr = w[2 * k], wi = w[2 * k + 1];
+        const float rotR = wr * oddR - wi * oddI;
+        const float rotI = wr * oddI + wi * oddR;
+        x[2 * k] = evenR + rotR;
+        x[2 * k + 1] = evenI + rotI;
+        x[2 * m] = evenR - rotR;
+        x[2 * m + 1] = rotI - evenI;
+    }
+}
+
+void FftPlan::inverse_real(const Complex* spectrum, float* output) const noexcept {
+    // Undo the split into Z[k] = E + i O, then z = IFFT_{N/2}(Z)
+    const size_t half = size_ / 2;
+    Complex* packed = reinterpret_cast<Complex*>(output);
+
+    const float x0 = spectrum[0].real();
+    const float xn = spectrum[half].real();
+    packed[0] = Complex(0.5f * (x0 + xn), 0.5f * (x0 - xn));
+
+    const float* w = reinterpret_cast<const float*>(twiddles_ + half);
+    const float* x = reinterpret_cast<const float*>(spectrum);
+    float* z = output;
+    size_t k = 1;
+#if defined(DAIW_AVX2) || defined(DAIW_AVX512)
+    k = split_pass_avx<true>(x, z, w, half);
+#endif
+    for (; k <= half / 2; ++k) {
+        const size_t m = half - k;
+        const float evenR = 0.5f * (x[2 * k] + x[2 * m]);
+        const float evenI = 0.5f * (x[2 * k + 1] - x[2 * m + 1]);
+        const float diffR = 0.5f * (x[2 * k] - x[2 * m]);
+        const float diffI = 0.5f * (x[2 * k + 1] + x[2 * m + 1]);
+        const float wr = w[2 * k], wi = w[2 * k + 1];
+        const float oddR = diffR * wr + diffI * wi;  // diff * conj(w)
+        const float oddI = diffI * wr - diffR * wi;
+        z[2 * k] = evenR - oddI;                     // E + i O
+        z[2 * k + 1] = evenI + oddR;
+        z[2 * m] = evenR + oddI;                     // conj(E) + i conj(O)
+        z[2 * m + 1] = oddR - evenI;
+    }
+
+    // Inverse half-size transform, scaled so forward_real + inverse_real = identity
+    for (size_t i = 0; i < half; ++i) packed[i] = std::conj(packed[i]);
+    transform(packed, half, half_swaps_, num_half_swaps_);
+
+    const float scale = 1.0f / static_cast<float>(half);
+    for (size_t i = 0; i < half; ++i) packed[i] = std::conj(packed[i]) * scale;
+}
+
+// =============================================================================
+// Plan Cache
+// =============================================================================
+
+namespace {
+
+constexpr size_t NUM_PLAN_SLOTS = 16;
+static_assert((size_t{1} << (NUM_PLAN_SLOTS - 1)) >= FFT_MAX_SIZE, "one slot per power of two");
+
+std::array<std::atomic<const FftPlan*>, NUM_PLAN_SLOTS> g_plans{};
+std::mutex g_plan_mutex;
+
+} // namespace
+
+const FftPlan* fft_plan(size_t size) {
+    if (!is_valid_fft_size(size)) return nullptr;
+
+    auto& slot = g_plans[log2_size(size)];
+    if (const FftPlan* plan = slot.load(std::memory_order_acquire)) return plan;
+
+    // Plans are never freed, so published pointers stay valid
+    std::lock_guard<std::mutex> lock(g_plan_mutex);
+    const FftPlan* plan = slot.load(std::memory_order_relaxed);
+    if (!plan) {
+        plan = new FftPlan(size);
+        slot.store(plan, std::memory_order_release);
+    }
+    return plan;
+}
+
+// =============================================================================
+// Scratch Pool
+// =============================================================================
+
+FftScratchPool& fft_scratch_pool() {
+    static FftScratchPool pool;
+    return pool;
+}
+
+} // namespace daiw::dsp
@@ -0,0 +1,16 @@
+/**
+ * @file chord_table.cpp
+ * @brief Compile-time chord detection table
+ */
+
+#include "daiw/harmony.hpp"
+
+namespace daiw {
+namespace harmony {
+namespace detail {
+
+constexpr std::array<ChordMatch, 1 << NOTES_PER_OCTAVE> CHORD_TABLE = build_chord_table();
+
+} // namespace detail
+} // namespace harmony
+} // namespace daiw
@@ -3,9 +3,12 @@
  * @brief Voice leading algorithms
  */
 
+#include "daiw/harmony.hpp"
 #include "daiw/types.hpp"
 #include <vector>
 #include <algorithm>
+#include <bit>
+#include <climits>
 #include <cmath>
 
 namespace daiw {
@@ -35,20 +38,206 @@ int calculateMovement(const std::vector<MidiNote>& from,
     return movement;
 }
 
+namespace {
+
+// =============================================================================
+// Voicing search
+// =============================================================================
+
+constexpr int MIDI_NOTES = 128;
+
+/// Pitches a voice may take, cheapest first
+struct VoiceCandidates {
+    std::array<MidiNote, MIDI_NOTES> pitch;
+    std::array<int16_t, MIDI_NOTES> cost;
+    size_t count = 0;
+};
+
 /**
- * @brief Find optimal voice leading between two chords
- *
- * Minimizes total voice movement while avoiding parallel fifths/octaves.
+ * Everything the search needs, built once per chord. Each voice's cost is
+ * its distance from an anchor: the previous voicing's note when leading,
+ * the middle of the voice's range otherwise.
  */
-std::vector<MidiNote> optimalVoiceLead(
-    const std::vector<MidiNote>& fromVoicing,
-    const std::vector<MidiNote>& toChordTones
-) {
-    if (toChordTones.empty()) return {};
+struct SearchSpace {
+    const VoiceLeadingRules* rules = nullptr;
+    const Voicing* from = nullptr;  // Checked for parallels when set
+    size_t voices = 0;
+    uint16_t tones = 0;
+    int needed_tones = 0;           // Distinct chord tones a voicing must cover
+    std::array<VoiceCandidates, MAX_VOICES> candidates;
+    std::array<int, MAX_VOICES + 1> suffix_min{};  // Cheapest cost of voices v.. (lower bound)
+};
+
+bool build_space(SearchSpace& space, const VoiceLeadingRules& rules, size_t voices,
+                 const ChordTones& chord, const Voicing* from) {
+    space.rules = &rules;
+    space.from = from;
+    space.voices = voices;
+    space.tones = chord.pitch_classes.bits();
+    if (space.tones == 0) return false;
+
+    // A slash bass outside the chord covers no chord tone
+    int available = static_cast<int>(voices);
+    if (chord.bass >= 0 && !chord.pitch_classes.contains(chord.bass)) --available;
+    space.needed_tones = rules.require_all_tones
+                             ? std::min(available, chord.pitch_classes.count())
+                             : 0;
+
+    for (size_t v = 0; v < voices; ++v) {
+        const int lo = rules.lowest[v];
+        const int hi = std::max(lo, static_cast<int>(rules.highest[v]));
+        const int anchor = from ? (*from)[v] : (lo + hi) / 2;
+        auto& c = space.candidates[v];
+        c.count = 0;
+
+        for (int p = lo; p <= hi && p < MIDI_NOTES; ++p) {
+            const int pc = p % NOTES_PER_OCTAVE;
+            const bool allowed = (v == 0 && chord.bass >= 0) ? pc == chord.bass
+                                                             : chord.pitch_classes.contains(pc);
+            if (!allowed) continue;
+
+            // Insertion by cost; ties keep the lower pitch first
+            const int cost = std::abs(p - anchor);
+            size_t k = c.count++;
+            while (k > 0 && c.cost[k - 1] > cost) {
+                c.pitch[k] = c.pitch[k - 1];
+                c.cost[k] = c.cost[k - 1];
+                --k;
+            }
+            c.pitch[k] = static_cast<MidiNote>(p);
+            c.cost[k] = static_cast<int16_t>(cost);
+        }
+        if (c.count == 0) return false;
+    }
+
+    space.suffix_min[voices] = 0;
+    for (size_t v = voices; v-- > 0;) {
+        space.suffix_min[v] = space.suffix_min[v + 1] + space.candidates[v].cost[0];
+    }
+    return true;
+}
+
+/// Whether the voice pair (lower, upper) moves in forbidden parallels
+bool forbidden_pair(const VoiceLeadingRules& rules, int lower_from, int upper_from,
+                    int lower_to, int upper_to) {
+    const int lower_move = lower_to - lower_from;
+    const int upper_move = upper_to - upper_from;
+    if (lower_move == 0 || upper_move == 0 || (lower_move > 0) != (upper_move > 0)) {
+        return false;
+    }
+
+    const int before = std::abs(upper_from - lower_from) % NOTES_PER_OCTAVE;
+    const int after = std::abs(upper_to - lower_to) % NOTES_PER_OCTAVE;
+    if (before != after) return false;
+    return (after == 7 && rules.forbid_parallel_fifths) ||
+           (after == 0 && rules.forbid_parallel_octaves);
+}
+
+/// Keeps the single cheapest voicing
+struct BestSink {
+    Voicing best;
+    int best_cost = INT_MAX;
+
+    int bound() const { return best_cost; }
+    void accept(const Voicing& voicing, int cost) {
+        best = voicing;
+        best_cost = cost;
+    }
+};
+
+/// Keeps the `capacity` cheapest voicings
+struct CheapestSink {
+    Voicing* voicings;
+    std::array<int, MAX_VOICING_CANDIDATES> costs;
+    size_t capacity;
+    size_t count = 0;
+    size_t worst = 0;  // Index of the most expensive kept voicing
+
+    CheapestSink(Voicing* out, size_t cap) : voicings(out), capacity(cap) {}
+
+    int bound() const { return count < capacity ? INT_MAX : costs[worst]; }
+
+    void accept(const Voicing& voicing, int cost) {
+        const size_t slot = count < capacity ? count++ : worst;
+        voicings[slot] = voicing;
+        costs[slot] = cost;
+        worst = 0;
+        for (size_t i = 1; i < count; ++i) {
+            if (costs[i] > costs[worst]) worst = i;
+        }
+    }
+
+    /// Order the kept voicings cheapest first
+    void sort() {
+        for (size_t i = 1; i < count; ++i) {
+            for (size_t k = i; k > 0 && costs[k - 1] > costs[k]; --k) {
+                std::swap(costs[k - 1], costs[k]);
+                std::swap(voicings[k - 1], voicings[k]);
+            }
+        }
+    }
+};
+
+/**
+ * Depth-first over voices, lowest first. Pitches are tried cheapest first,
+ * so once cost + the remaining voices' lower bound reaches the sink's bound
+ * no later pitch of this voice can help.
+ */
+template <typename Sink>
+void search(const SearchSpace& space, Sink& sink, Voicing& current,
+            size_t voice, int cost, uint16_t covered) {
+    const int covered_count = std::popcount(covered);
+    if (voice == space.voices) {
+        if (covered_count >= space.needed_tones) sink.accept(current, cost);
+        return;
+    }
+    if (covered_count + static_cast<int>(space.voices - voice) < space.needed_tones) return;
+
+    const VoiceLeadingRules& rules = *space.rules;
+    const VoiceCandidates& c = space.candidates[voice];
+    for (size_t k = 0; k < c.count; ++k) {
+        const int next_cost = cost + c.cost[k];
+        if (next_cost + space.suffix_min[voice + 1] >= sink.bound()) break;
+
+        const int p = c.pitch[k];
+        if (voice > 0) {
+            const int below = current[voice - 1];
+            if (p <= below) continue;
+            if (voice > 1 && p - below > rules.max_spacing) continue;
+        }
+        if (space.from) {
+            bool forbidden = false;
+            for (size_t lower = 0; lower < voice && !forbidden; ++lower) {
+                forbidden = forbidden_pair(rules, (*space.from)[lower], (*space.from)[voice],
+                                           current[lower], p);
+            }
+            if (forbidden) continue;
+        }
+
+        current.notes[voice] = static_cast<MidiNote>(p);
+        const uint16_t tone = static_cast<uint16_t>(1u << (p % NOTES_PER_OCTAVE)) & space.tones;
+        search(space, sink, current, voice + 1, next_cost, static_cast<uint16_t>(covered | tone));
+    }
+    current.notes[voice] = 0;
+}
 
+template <typename Sink>
+bool solve(const VoiceLeadingRules& rules, size_t voices, const ChordTones& chord,
+           const Voicing* from, Sink& sink) {
+    SearchSpace space;
+    if (!build_space(space, rules, voices, chord, from)) return false;
+
+    Voicing current;
+    current.size = static_cast<uint8_t>(voices);
+    search(space, sink, current, 0, 0, 0);
+    return true;
+}
+
+/// Pre-solver behaviour: move each given tone to its octave nearest the same-index voice
+std::vector<MidiNote> nearestOctaveVoiceLead(const std::vector<MidiNote>& fromVoicing,
+                                             const std::vector<MidiNote>& toChordTones) {
     std::vector<MidiNote> result = toChordTones;
 
-    // Simple nearest-note algorithm
     for (size_t i = 0; i < result.size() && i < fromVoicing.size(); ++i) {
         MidiNote fromNote = fromVoicing[i];
         MidiNote bestNote = result[i];
@@ -72,6 +261,158 @@ std::vector<MidiNote> optimalVoiceLead(
     return result;
 }
 
+}  // namespace
+
+// =============================================================================
+// VoiceLeader
+// =============================================================================
+
+bool VoiceLeader::lead(const Voicing& from, const ChordTones& to, Voicing& result) const {
+    const auto voices = static_cast<size_t>(voice_count());
+    if (from.size != voices) return false;
+
+    BestSink sink;
+    if (!solve(rules_, voices, to, &from, sink) || sink.best_cost == INT_MAX) return false;
+    result = sink.best;
+    return true;
+}
+
+bool VoiceLeader::voice(const ChordTones& chord, Voicing& result) const {
+    BestSink sink;
+    if (!solve(rules_, static_cast<size_t>(voice_count()), chord, nullptr, sink) || sink.best_cost == INT_MAX) {
+        return false;
+    }
+    result = sink.best;
+    return true;
+}
+
+bool VoiceLeader::has_forbidden_parallels(const Voicing& from, const Voicing& to) const {
+    const size_t voices = std::min(from.size, to.size);
+    for (size_t upper = 1; upper < voices; ++upper) {
+        for (size_t lower = 0; lower < upper; ++lower) {
+            if (forbidden_pair(rules_, from[lower], from[upper], to[lower], to[upper])) return true;
+        }
+    }
+    return false;
+}
+
+int VoiceLeader::lead_progression(const ChordTones* chords, int count, Voicing* result,
+                                  const Voicing* start) {
+    const auto voices = static_cast<size_t>(voice_count());
+    if (count <= 0 || count > MAX_VOICED_CHORDS) return -1;
+    if (start && start->size != voices) return -1;
+    const auto chords_count = static_cast<size_t>(count);
+
+    // States: each chord's most central voicings
+    for (size_t t = 0; t < chords_count; ++t) {
+        CheapestSink sink(candidates_[t].data(), MAX_VOICING_CANDIDATES);
+        if (!solve(rules_, voices, chords[t], nullptr, sink) || sink.count == 0) return -1;
+        sink.sort();
+        candidate_counts_[t] = sink.count;
+    }
+
+    std::array<int, MAX_VOICING_CANDIDATES> cost{};
+    std::array<int, MAX_VOICING_CANDIDATES> next{};
+    if (start) {
+        for (size_t s = 0; s < candidate_counts_[0]; ++s) {
+            cost[s] = movement(*start, candidates_[0][s]) +
+                      (has_forbidden_parallels(*start, candidates_[0][s]) ? PARALLEL_PENALTY : 0);
+        }
+    }
+
+    for (size_t t = 1; t < chords_count; ++t) {
+        for (size_t s = 0; s < candidate_counts_[t]; ++s) {
+            int best = INT_MAX;
+            size_t best_prev = 0;
+            for (size_t p = 0; p < candidate_counts_[t - 1]; ++p) {
+                // The parallel check is the expensive part; skip it when movement alone loses
+                int c = cost[p] + movement(candidates_[t - 1][p], candidates_[t][s]);
+                if (c >= best) continue;
+                if (has_forbidden_parallels(candidates_[t - 1][p], candidates_[t][s])) {
+                    c += PARALLEL_PENALTY;
+                }
+                if (c < best) {
+                    best = c;
+                    best_prev = p;
+                }
+            }
+            next[s] = best;
+            back_[t][s] = static_cast<uint8_t>(best_prev);
+        }
+        std::swap(cost, next);
+    }
+
+    size_t state = 0;
+    for (size_t s = 1; s < candidate_counts_[chords_count - 1]; ++s) {
+        if (cost[s] < cost[state]) state = s;
+    }
+    for (size_t t = chords_count; t-- > 0;) {
+        result[t] = candidates_[t][state];
+        if (t > 0) state = back_[t][state];
+    }
+
+    int broken = 0;
+    for (size_t t = 0; t < chords_count; ++t) {
+        const Voicing* previous = t > 0 ? &result[t - 1] : start;
+        if (previous && has_forbidden_parallels(*previous, result[t])) ++broken;
+    }
+    return broken;
+}
+
+// =============================================================================
+// Legacy helpers
+// =============================================================================
+
+/**
+ * @brief Find optimal voice leading between two chords
+ *
+ * Minimizes total voice movement while avoiding parallel fifths/octaves.
+ * See the declaration in harmony.hpp for the size of the result.
+ */
+std::vector<MidiNote> optimalVoiceLead(
+    const std::vector<MidiNote>& fromVoicing,
+    const std::vector<MidiNote>& toChordTones
+) {
+    if (toChordTones.empty()) return {};
+    if (fromVoicing.empty() || fromVoicing.size() > static_cast<size_t>(MAX_VOICES)) {
+        return nearestOctaveVoiceLead(fromVoicing, toChordTones);
+    }
+
+    std::vector<MidiNote> sorted = fromVoicing;
+    std::sort(sorted.begin(), sorted.end());
+    Voicing from;
+    from.size = static_cast<uint8_t>(sorted.size());
+    std::copy(sorted.begin(), sorted.end(), from.notes.begin());
+
+    VoiceLeadingRules rules;
+    rules.voices = from.size;
+    rules.max_spacing = 127;
+    for (size_t v = 0; v < from.size; ++v) {
+        rules.lowest[v] = static_cast<MidiNote>(std::max(0, from[v] - 12));
+        rules.highest[v] = static_cast<MidiNote>(std::min(127, from[v] + 12));
+    }
+
+    ChordTones to;
+    for (MidiNote note : toChordTones) to.pitch_classes.add(note);
+
+    VoiceLeader leader(rules);
+    Voicing result;
+    bool found = leader.lead(from, to, result);
+    if (!found) {
+        rules.forbid_parallel_fifths = rules.forbid_parallel_octaves = false;
+        leader.set_rules(rules);
+        found = leader.lead(from, to, result);
+    }
+    if (!found) {
+        rules.require_all_tones = false;
+        leader.set_rules(rules);
+        found = leader.lead(from, to, result);
+    }
+    if (!found) return nearestOctaveVoiceLead(fromVoicing, toChordTones);
+
+    return std::vector<MidiNote>(result.notes.begin(), result.notes.begin() + result.size);
+}
+
 /**
  * @brief Check for parallel fifths between two voicings
  */
@@ -4,9 +4,9 @@
  */
 
 #include "daiw/types.hpp"
+#include "daiw/random.hpp"
 #include <vector>
 #include <cmath>
-#include <random>
 
 namespace daiw {
 namespace groove {
@@ -41,20 +41,25 @@ TickCount applySwing(TickCount tick, float swing, int ppq) {
 
 /**
  * @brief Apply humanization to a note event
+ *
+ * The variation is keyed by (seed, note_index), so results do not depend on
+ * how many notes were humanized before this one or on which thread.
  */
 NoteEvent humanize(const NoteEvent& note, const GrooveSettings& settings,
-                   std::mt19937& rng) {
+                   uint64_t seed, uint64_t note_index) {
     NoteEvent result = note;
 
     if (settings.humanization > 0.0f) {
-        std::uniform_real_distribution<float> timingDist(-30.0f, 30.0f);
-        float timingOffset = timingDist(rng) * settings.humanization;
+        const random::CounterRng timingRng(seed, 0);
+        float timingOffset = timingRng.uniform_signed(note_index) * 30.0f * settings.humanization;
         result.startTick += static_cast<TickCount>(timingOffset);
     }
 
     if (settings.velocityVar > 0.0f) {
-        std::uniform_int_distribution<int> velDist(-10, 10);
-        int velOffset = static_cast<int>(velDist(rng) * settings.velocityVar);
+        // Integer offset in [-10, 10]
+        const random::CounterRng velRng(seed, 1);
+        int velStep = static_cast<int>(velRng.uniform(note_index) * 21.0f) - 10;
+        int velOffset = static_cast<int>(velStep * settings.velocityVar);
         int newVel = result.velocity + velOffset;
         result.velocity = static_cast<MidiVelocity>(
             std::clamp(newVel, 1, 127)
@@ -4,8 +4,8 @@
  */
 
 #include "daiw/types.hpp"
+#include "daiw/random.hpp"
 #include <vector>
-#include <random>
 #include <cmath>
 
 namespace daiw {
@@ -55,23 +55,28 @@ const HumanizePreset PRESET_PUNK = {
 
 /**
  * @brief Humanize a sequence of notes
+ *
+ * Every variation is a function of (seed, note index) only, so a track
+ * humanized block by block (first_index = index of the block's first note)
+ * matches the same track humanized in one call.
  */
 std::vector<NoteEvent> humanize(
     const std::vector<NoteEvent>& notes,
     const HumanizePreset& preset,
-    int ppq = DEFAULT_PPQ
+    int ppq,
+    uint64_t seed,
+    size_t first_index = 0
 ) {
-    std::random_device rd;
-    std::mt19937 rng(rd());
+    const random::CounterRng timingRng(seed, 0);
+    const random::CounterRng velRng(seed, 1);
+    const random::CounterRng ghostRng(seed, 2);
 
     std::vector<NoteEvent> result;
     result.reserve(notes.size());
 
-    std::uniform_real_distribution<float> timingDist(-1.0f, 1.0f);
-    std::uniform_real_distribution<float> velDist(-1.0f, 1.0f);
-    std::uniform_real_distribution<float> ghostDist(0.0f, 1.0f);
-
-    for (const auto& note : notes) {
+    for (size_t i = 0; i < notes.size(); ++i) {
+        const NoteEvent& note = notes[i];
+        const uint64_t index = first_index + i;
         NoteEvent humanized = note;
 
         // Check if this is a downbeat
@@ -79,13 +84,13 @@ std::vector<NoteEvent> humanize(
 
         // Apply timing variation
         if (!preset.protectDownbeats || !isDownbeat) {
-            float timingOffset = timingDist(rng) * preset.timingVar * 30.0f;
+            float timingOffset = timingRng.uniform_signed(index) * preset.timingVar * 30.0f;
             timingOffset += preset.rushDrag * 15.0f;  // Rush/drag bias
             humanized.startTick += static_cast<TickCount>(timingOffset);
         }
 
         // Apply velocity variation
-        float velOffset = velDist(rng) * preset.velocityVar * 30.0f;
+        float velOffset = velRng.uniform_signed(index) * preset.velocityVar * 30.0f;
         int newVel = note.velocity + static_cast<int>(velOffset);
         humanized.velocity = static_cast<MidiVelocity>(
             std::clamp(newVel, 1, 127)
@@ -94,7 +99,7 @@ std::vector<NoteEvent> humanize(
         result.push_back(humanized);
 
         // Maybe add ghost note
-        if (ghostDist(rng) < preset.ghostNoteChance) {
+        if (ghostRng.uniform(index) < preset.ghostNoteChance) {
             NoteEvent ghost = note;
             ghost.startTick += ppq / 4;  // Quarter beat later
             ghost.velocity = static_cast<MidiVelocity>(note.velocity * 0.3f);
@@ -105,5 +110,16 @@ std::vector<NoteEvent> humanize(
     return result;
 }
 
+/**
+ * @brief Humanize a sequence of notes with a fresh random seed
+ */
+std::vector<NoteEvent> humanize(
+    const std::vector<NoteEvent>& notes,
+    const HumanizePreset& preset,
+    int ppq = DEFAULT_PPQ
+) {
+    return humanize(notes, preset, ppq, random::random_seed());
+}
+
 }  // namespace humanizer
 }  // namespace daiw
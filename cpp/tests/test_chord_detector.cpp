@@ -0,0 +1,147 @@
+/**
+ * @file test_chord_detector.cpp
+ * @brief Tests for the table-driven chord detector
+ */
+
+#include <catch2/catch_all.hpp>
+#include "daiw/harmony.hpp"
+
+namespace {
+
+using namespace daiw::harmony;
+
+/// Score as an exact fraction: 0.6 * recall + 0.4 * precision
+struct ReferenceScore {
+    long numerator = 0;
+    long denominator = 1;
+
+    bool operator>(const ReferenceScore& other) const {
+        return numerator * other.denominator > other.numerator * denominator;
+    }
+};
+
+struct ReferenceDetection {
+    Chord chord;
+    ReferenceScore score;
+    Chord runner_up;
+    ReferenceScore runner_up_score;
+};
+
+/// The original 12 roots x 12 qualities search, with exact comparisons
+ReferenceDetection reference_detect(const PitchClassSet& input) {
+    static constexpr ChordQuality QUALITIES[] = {
+        ChordQuality::Major, ChordQuality::Minor, ChordQuality::Diminished,
+        ChordQuality::Augmented, ChordQuality::Dominant7, ChordQuality::Major7,
+        ChordQuality::Minor7, ChordQuality::Diminished7, ChordQuality::HalfDiminished7,
+        ChordQuality::Sus2, ChordQuality::Sus4, ChordQuality::Power
+    };
+
+    ReferenceDetection result;
+    if (input.count() < 2) return result;
+
+    for (int root = 0; root < NOTES_PER_OCTAVE; ++root) {
+        for (ChordQuality quality : QUALITIES) {
+            Chord candidate;
+            candidate.root = static_cast<NoteName>(root);
+            candidate.quality = quality;
+
+            const PitchClassSet chord = candidate.pitch_classes();
+            int matches = 0;
+            for (int pc = 0; pc < NOTES_PER_OCTAVE; ++pc) {
+                if (input.contains(pc) && chord.contains(pc)) ++matches;
+            }
+            const long t = chord.count();
+            const long n = input.count();
+            const ReferenceScore score{matches * (3 * n + 2 * t), 5 * t * n};
+
+            if (score > result.score) {
+                result.runner_up = result.chord;
+                result.runner_up_score = result.score;
+                result.chord = candidate;
+                result.score = score;
+            } else if (score > result.runner_up_score) {
+                result.runner_up = candidate;
+                result.runner_up_score = score;
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("ChordDetector table matches the exhaustive search", "[harmony][chord]") {
+    const ChordDetector detector;
+
+    for (int bits = 0; bits < (1 << NOTES_PER_OCTAVE); ++bits) {
+        const PitchClassSet pcs(static_cast<uint16_t>(bits));
+        const auto expected = reference_detect(pcs);
+        const auto detection = detector.detect(pcs);
+
+        INFO("pitch class set " << bits);
+        REQUIRE(detection.chord.root == expected.chord.root);
+        REQUIRE(detection.chord.quality == expected.chord.quality);
+        REQUIRE(detection.runner_up.root == expected.runner_up.root);
+        REQUIRE(detection.runner_up.quality == expected.runner_up.quality);
+
+        const float confidence = static_cast<float>(expected.score.numerator) /
+                                 static_cast<float>(expected.score.denominator);
+        const float runner_up_confidence = static_cast<float>(expected.runner_up_score.numerator) /
+                                           static_cast<float>(expected.runner_up_score.denominator);
+        REQUIRE(detection.confidence == confidence);
+        REQUIRE(detection.runner_up_confidence == runner_up_confidence);
+        REQUIRE(detection.runner_up_confidence <= detection.confidence);
+    }
+}
+
+TEST_CASE("ChordDetector recognizes common chords", "[harmony][chord]") {
+    const ChordDetector detector;
+
+    SECTION("Triads and sevenths score a perfect match") {
+        const auto a_minor7 = detector.detect_from_notes({57, 60, 64, 67});
+        REQUIRE(a_minor7.chord.name() == "Am7");
+        REQUIRE(a_minor7.confidence == Catch::Approx(1.0f));
+
+        const auto g7 = detector.detect_from_notes({43, 59, 62, 65});
+        REQUIRE(g7.chord.name() == "G7");
+        REQUIRE(g7.confidence == Catch::Approx(1.0f));
+    }
+
+    SECTION("Runner-up is the next best template") {
+        // C E G: C major, then the C5 power chord it contains
+        // (0.6 * 2/2 + 0.4 * 2/3, ahead of Am7's 0.6 * 3/4 + 0.4 * 3/3)
+        const auto c_major = detector.detect_from_notes({60, 64, 67});
+        REQUIRE(c_major.chord.name() == "C");
+        REQUIRE(c_major.confidence == Catch::Approx(1.0f));
+        REQUIRE(c_major.runner_up.name() == "C5");
+        REQUIRE(c_major.runner_up_confidence == Catch::Approx(13.0f / 15.0f));
+    }
+
+    SECTION("Fewer than two pitch classes detect nothing") {
+        REQUIRE(detector.detect(PitchClassSet()).confidence == 0.0f);
+        REQUIRE(detector.detect_from_notes({60, 72, 84}).confidence == 0.0f);
+    }
+
+    SECTION("Lookup is the raw table entry") {
+        PitchClassSet d_minor;
+        d_minor.add(2);
+        d_minor.add(5);
+        d_minor.add(9);
+        const ChordMatch& match = ChordDetector::lookup(d_minor);
+        REQUIRE(match.root == static_cast<uint8_t>(NoteName::D));
+        REQUIRE(match.quality == static_cast<uint8_t>(ChordQuality::Minor));
+    }
+}
+
+TEST_CASE("Chord templates match Chord::pitch_classes", "[harmony][chord]") {
+    static_assert(chord_template(ChordQuality::Major) == 0b000010010001);
+    static_assert(chord_template(ChordQuality::Augmented7) == chord_template(ChordQuality::Major));
+
+    Chord chord;
+    chord.root = NoteName::A;
+    chord.quality = ChordQuality::Dominant7;
+    chord.extensions = {14};
+
+    // A C# E G + B
+    REQUIRE(chord.pitch_classes().bits() == ((1 << 9) | (1 << 1) | (1 << 4) | (1 << 7) | (1 << 11)));
+}
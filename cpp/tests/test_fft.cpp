@@ -0,0 +1,163 @@
+/**
+ * @file test_fft.cpp
+ * @brief Tests for the shared FFT engine
+ */
+
+#include <catch2/catch_all.hpp>
+#include "daiw/fft.hpp"
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using daiw::dsp::Complex;
+
+namespace {
+
+/// O(N^2) reference DFT in double precision
+std::vector<std::complex<double>> reference_dft(const std::vector<Complex>& input) {
+    const size_t n = input.size();
+    std::vector<std::complex<double>> output(n);
+    for (size_t k = 0; k < n; ++k) {
+        for (size_t j = 0; j < n; ++j) {
+            const double angle = -2.0 * M_PI * static_cast<double>((k * j) % n) / static_cast<double>(n);
+            output[k] += std::complex<double>(input[j]) * std::polar(1.0, angle);
+        }
+    }
+    return output;
+}
+
+std::vector<float> random_signal(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> signal(n);
+    for (auto& s : signal) s = dist(rng);
+    return signal;
+}
+
+} // namespace
+
+TEST_CASE("FFT plans are cached per size", "[fft]") {
+    const auto* plan = daiw::dsp::fft_plan(1024);
+    REQUIRE(plan != nullptr);
+    REQUIRE(plan->size() == 1024);
+    REQUIRE(plan->num_bins() == 513);
+    REQUIRE(daiw::dsp::fft_plan(1024) == plan);
+    REQUIRE(daiw::dsp::fft_plan(2048) != plan);
+
+    // Unsupported sizes
+    REQUIRE(daiw::dsp::fft_plan(0) == nullptr);
+    REQUIRE(daiw::dsp::fft_plan(2) == nullptr);
+    REQUIRE(daiw::dsp::fft_plan(1000) == nullptr);
+    REQUIRE(daiw::dsp::fft_plan(daiw::dsp::FFT_MAX_SIZE * 2) == nullptr);
+}
+
+TEST_CASE("FFT matches the reference DFT", "[fft]") {
+    // 4 and 8 take the radix-4 pass only; larger sizes hit the vector stages
+    const size_t size = GENERATE(4, 8, 16, 64, 512, 2048);
+    const auto* plan = daiw::dsp::fft_plan(size);
+    const double tolerance = 1e-6 * std::sqrt(static_cast<double>(size)) * 4.0;
+
+    SECTION("complex") {
+        const auto re = random_signal(size, 1);
+        const auto im = random_signal(size, 2);
+        std::vector<Complex> data(size);
+        for (size_t i = 0; i < size; ++i) data[i] = Complex(re[i], im[i]);
+        const auto expected = reference_dft(data);
+
+        auto transformed = data;
+        plan->forward(transformed.data());
+        for (size_t k = 0; k < size; ++k) {
+            REQUIRE(std::abs(std::complex<double>(transformed[k]) - expected[k]) < tolerance);
+        }
+
+        plan->inverse(transformed.data());
+        for (size_t i = 0; i < size; ++i) {
+            REQUIRE(std::abs(transformed[i] - data[i]) < 1e-5f);
+        }
+    }
+
+    SECTION("real") {
+        const auto signal = random_signal(size, 3);
+        std::vector<Complex> as_complex(signal.begin(), signal.end());
+        const auto expected = reference_dft(as_complex);
+
+        std::vector<Complex> spectrum(plan->num_bins());
+        plan->forward_real(signal.data(), spectrum.data());
+        for (size_t k = 0; k < plan->num_bins(); ++k) {
+            REQUIRE(std::abs(std::complex<double>(spectrum[k]) - expected[k]) < tolerance);
+        }
+
+        std::vector<float> restored(size);
+        plan->inverse_real(spectrum.data(), restored.data());
+        for (size_t i = 0; i < size; ++i) {
+            REQUIRE(restored[i] == Catch::Approx(signal[i]).margin(1e-5f));
+        }
+    }
+}
+
+TEST_CASE("FFT real transform runs in place", "[fft]") {
+    constexpr size_t N = 256;
+    const auto* plan = daiw::dsp::fft_plan(N);
+    const auto signal = random_signal(N, 4);
+
+    std::vector<Complex> expected(plan->num_bins());
+    plan->forward_real(signal.data(), expected.data());
+
+    std::vector<Complex> in_place(plan->num_bins());
+    float* samples = reinterpret_cast<float*>(in_place.data());
+    std::copy(signal.begin(), signal.end(), samples);
+    plan->forward_real(samples, in_place.data());
+
+    for (size_t k = 0; k < plan->num_bins(); ++k) {
+        REQUIRE(in_place[k] == expected[k]);
+    }
+}
+
+TEST_CASE("FFT scratch leases are pooled", "[fft]") {
+    const size_t available = daiw::dsp::fft_scratch_pool().available();
+    {
+        daiw::dsp::FftScratch scratch;
+        REQUIRE(scratch);
+        REQUIRE(reinterpret_cast<uintptr_t>(scratch.data()) % 64 == 0);
+        REQUIRE(daiw::dsp::fft_scratch_pool().available() == available - 1);
+
+        // A full-size transform fits in one lease
+        const auto* plan = daiw::dsp::fft_plan(daiw::dsp::FFT_MAX_SIZE);
+        const auto signal = random_signal(daiw::dsp::FFT_MAX_SIZE, 5);
+        plan->forward_real(signal.data(), scratch.spectrum());
+        REQUIRE(std::isfinite(scratch.spectrum()[plan->num_bins() - 1].real()));
+    }
+    REQUIRE(daiw::dsp::fft_scratch_pool().available() == available);
+}
+
+TEST_CASE("FFT scratch leases are exclusive across threads", "[fft]") {
+    // Every thread stamps its lease and checks the stamp survives; a pool
+    // that hands one block to two threads (ABA on the free list) breaks it
+    constexpr int THREADS = 4;
+    constexpr int ROUNDS = 20000;
+    std::atomic<int> collisions{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([t, &collisions] {
+            for (int round = 0; round < ROUNDS; ++round) {
+                daiw::dsp::FftScratch scratch;
+                if (!scratch) continue;
+                const float stamp = static_cast<float>(t * ROUNDS + round);
+                scratch.data()[0] = stamp;
+                scratch.data()[daiw::dsp::FFT_MAX_SIZE + 1] = stamp;
+                if (round % 8 == 0) std::this_thread::yield();
+                if (scratch.data()[0] != stamp || scratch.data()[daiw::dsp::FFT_MAX_SIZE + 1] != stamp) {
+                    collisions.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    REQUIRE(collisions.load() == 0);
+    REQUIRE(daiw::dsp::fft_scratch_pool().allocated() == 0);
+}
@@ -0,0 +1,204 @@
+/**
+ * @file test_key_tracker.cpp
+ * @brief Tests for key detection and streaming key tracking
+ */
+
+#include <catch2/catch_all.hpp>
+#include "daiw/harmony.hpp"
+#include <cmath>
+#include <random>
+
+using namespace daiw::harmony;
+
+namespace {
+
+/// The original Krumhansl-Schmuckler search: 24 Pearson correlations in double
+std::array<double, NUM_KEYS> reference_correlations(const std::array<float, NOTES_PER_OCTAVE>& histogram) {
+    static constexpr double PROFILES[2][NOTES_PER_OCTAVE] = {
+        {6.35, 2.23, 3.48, 2.33, 4.38, 4.09, 2.52, 5.19, 2.39, 3.66, 2.29, 2.88},
+        {6.33, 2.68, 3.52, 5.38, 2.60, 3.53, 2.54, 4.75, 3.98, 2.69, 3.34, 3.17}
+    };
+
+    std::array<double, NUM_KEYS> correlations{};
+    for (int root = 0; root < NOTES_PER_OCTAVE; ++root) {
+        for (int mode = 0; mode < 2; ++mode) {
+            double sum_xy = 0, sum_x = 0, sum_y = 0, sum_x2 = 0, sum_y2 = 0;
+            for (int i = 0; i < NOTES_PER_OCTAVE; ++i) {
+                const double x = histogram[(i + root) % NOTES_PER_OCTAVE];
+                const double y = PROFILES[mode][i];
+                sum_xy += x * y;
+                sum_x += x;
+                sum_y += y;
+                sum_x2 += x * x;
+                sum_y2 += y * y;
+            }
+            const double n = NOTES_PER_OCTAVE;
+            correlations[2 * root + mode] = (n * sum_xy - sum_x * sum_y) /
+                std::sqrt((n * sum_x2 - sum_x * sum_x) * (n * sum_y2 - sum_y * sum_y));
+        }
+    }
+    return correlations;
+}
+
+std::array<float, NOTES_PER_OCTAVE> scale_histogram(const Scale& scale) {
+    std::array<float, NOTES_PER_OCTAVE> histogram{};
+    for (int pc = 0; pc < NOTES_PER_OCTAVE; ++pc) {
+        if (scale.contains(pc)) histogram[pc] = 1.0f;
+    }
+    histogram[static_cast<int>(scale.root)] += 1.0f;  // Tonic emphasis
+    return histogram;
+}
+
+/// Play a scale's notes (tonic twice) at eight notes per second
+int play(KeyTracker& tracker, const Scale& scale, float seconds, Scale* last_change = nullptr) {
+    static constexpr int DEGREES[] = {0, 2, 4, 0, 5, 1, 3, 6};
+    const auto intervals = scale.intervals();
+    int changes = 0;
+    const int notes = static_cast<int>(seconds * 8.0f);
+    for (int i = 0; i < notes; ++i) {
+        const int degree = DEGREES[i % 8];
+        tracker.add_note(static_cast<daiw::MidiNote>(60 + static_cast<int>(scale.root) + intervals[degree]));
+        if (auto change = tracker.advance(0.125f)) {
+            ++changes;
+            if (last_change != nullptr) *last_change = change->scale;
+        }
+    }
+    return changes;
+}
+
+} // namespace
+
+// =============================================================================
+// KeyDetector
+// =============================================================================
+
+TEST_CASE("KeyDetector matches the Pearson correlation search", "[harmony][key]") {
+    std::mt19937 rng(41);
+    std::uniform_real_distribution<float> weight(0.0f, 1.0f);
+    const KeyDetector detector;
+
+    for (int trial = 0; trial < 500; ++trial) {
+        std::array<float, NOTES_PER_OCTAVE> histogram;
+        for (auto& bin : histogram) bin = weight(rng) * weight(rng);
+
+        const auto expected = reference_correlations(histogram);
+        std::array<float, NUM_KEYS> correlations;
+        REQUIRE(KeyDetector::correlate_keys(histogram, correlations));
+        for (int k = 0; k < NUM_KEYS; ++k) {
+            REQUIRE(correlations[k] == Catch::Approx(expected[k]).margin(1e-5));
+        }
+
+        int best = 0;
+        for (int k = 1; k < NUM_KEYS; ++k) {
+            if (expected[k] > expected[best]) best = k;
+        }
+        const auto detection = detector.detect(histogram);
+        REQUIRE(detection.confidence == Catch::Approx(expected[best]).margin(1e-5));
+        REQUIRE(static_cast<int>(detection.scale.root) == best / 2);
+        REQUIRE(detection.is_minor == (best % 2 == 1));
+    }
+}
+
+TEST_CASE("KeyDetector finds scale keys", "[harmony][key]") {
+    const KeyDetector detector;
+
+    const auto e_flat = detector.detect(scale_histogram({NoteName::Ds, ScaleType::Major}));
+    REQUIRE(e_flat.scale.root == NoteName::Ds);
+    REQUIRE_FALSE(e_flat.is_minor);
+
+    const auto f_sharp_minor = detector.detect(scale_histogram({NoteName::Fs, ScaleType::NaturalMinor}));
+    REQUIRE(f_sharp_minor.scale.root == NoteName::Fs);
+    REQUIRE(f_sharp_minor.scale.type == ScaleType::NaturalMinor);
+
+    SECTION("Empty and flat histograms fit no key") {
+        REQUIRE(detector.detect({}).confidence == 0.0f);
+        std::array<float, NOTES_PER_OCTAVE> flat;
+        flat.fill(3.0f);
+        REQUIRE(detector.detect(flat).confidence == 0.0f);
+    }
+}
+
+// =============================================================================
+// KeyTracker
+// =============================================================================
+
+TEST_CASE("KeyTracker follows a modulation once", "[harmony][key]") {
+    // F minor leads for exactly one second on the way from C to Ab major
+    KeyTracker::Settings settings;
+    settings.hold_time = 1.5f;
+    KeyTracker tracker(settings);
+    REQUIRE_FALSE(tracker.has_key());
+
+    Scale key;
+    REQUIRE(play(tracker, {NoteName::C, ScaleType::Major}, 8.0f, &key) == 1);
+    REQUIRE(key.root == NoteName::C);
+    REQUIRE(tracker.current().scale.root == NoteName::C);
+
+    // To Ab major: one change, no flapping through the keys in between
+    REQUIRE(play(tracker, {NoteName::Gs, ScaleType::Major}, 12.0f, &key) == 1);
+    REQUIRE(key.root == NoteName::Gs);
+    REQUIRE_FALSE(tracker.current().is_minor);
+
+    // The decayed C major residue never wins back
+    REQUIRE(play(tracker, {NoteName::Gs, ScaleType::Major}, 8.0f) == 0);
+}
+
+TEST_CASE("KeyTracker hysteresis", "[harmony][key]") {
+    KeyTracker::Settings settings;
+    settings.hold_time = 2.0f;
+    KeyTracker tracker(settings);
+
+    SECTION("A new key must hold its lead for hold_time") {
+        play(tracker, {NoteName::C, ScaleType::Major}, 8.0f);
+        REQUIRE(tracker.current().scale.root == NoteName::C);
+
+        // Brief excursions to D major are not enough
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(play(tracker, {NoteName::D, ScaleType::Major}, 1.5f) == 0);
+            play(tracker, {NoteName::C, ScaleType::Major}, 3.0f);
+        }
+        REQUIRE(tracker.current().scale.root == NoteName::C);
+    }
+
+    SECTION("A challenger is adopted after ceil(hold_time / block) blocks") {
+        for (const float block : {0.25f, 0.3f, 0.4f, 0.7f, 2.0f, 3.0f}) {
+            settings.half_life = 0.0f;  // Constant correlations
+            tracker.set_settings(settings);
+            tracker.reset();
+            const auto histogram = scale_histogram({NoteName::E, ScaleType::Major});
+            for (int pc = 0; pc < NOTES_PER_OCTAVE; ++pc) {
+                tracker.add_note(static_cast<daiw::MidiNote>(60 + pc), histogram[pc]);
+            }
+
+            int blocks = 0;
+            while (!tracker.advance(block) && blocks < 100) ++blocks;
+            REQUIRE(blocks + 1 == static_cast<int>(std::ceil(settings.hold_time / block)));
+            REQUIRE(tracker.current().scale.root == NoteName::E);
+        }
+    }
+
+    SECTION("Nothing is reported without enough evidence") {
+        // A tritone correlates below min_confidence with every key
+        tracker.add_note(60);
+        tracker.add_note(66);
+        REQUIRE_FALSE(tracker.advance(10.0f).has_value());
+        REQUIRE_FALSE(tracker.has_key());
+
+        // A lone note suggests a key, but only once it has held for hold_time
+        tracker.reset();
+        tracker.add_note(60);
+        REQUIRE_FALSE(tracker.advance(1.0f).has_value());
+        REQUIRE_FALSE(tracker.has_key());
+    }
+
+    SECTION("Silence decays the histogram away") {
+        play(tracker, {NoteName::A, ScaleType::NaturalMinor}, 8.0f);
+        REQUIRE(tracker.has_key());
+        for (int i = 0; i < 100; ++i) tracker.advance(1.0f);
+        for (float bin : tracker.histogram()) REQUIRE(bin == 0.0f);
+        REQUIRE(tracker.has_key());  // The last key stands until another takes over
+
+        tracker.reset();
+        REQUIRE_FALSE(tracker.has_key());
+    }
+}
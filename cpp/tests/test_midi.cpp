@@ -0,0 +1,238 @@
+/**
+ * @file test_midi.cpp
+ * @brief Tests for MIDI sequences, playback cursor and file readers
+ */
+
+#include <catch2/catch_all.hpp>
+#include "daiw/midi.hpp"
+#include "daiw/midi_stream.hpp"
+
+#include <iterator>
+#include <vector>
+
+using namespace daiw;
+
+namespace {
+
+/// One note-on every 100 ticks: 0, 100, ..., 900
+midi::Sequence make_sequence() {
+    midi::Sequence sequence;
+    for (int i = 0; i < 10; ++i) {
+        sequence.add_event(midi::note_on(i * 100, 0, static_cast<MidiNote>(60 + i), 100));
+    }
+    sequence.set_length(1000);
+    return sequence;
+}
+
+/// Format 1 SMF: track 0 notes at 0/240/480, track 1 at 120/240 with a name
+std::vector<uint8_t> make_smf() {
+    std::vector<uint8_t> file = {
+        'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 1, 0, 2, 0x01, 0xE0,
+        'M', 'T', 'r', 'k', 0, 0, 0, 19,
+        0x00, 0x90, 60, 100,
+        0x81, 0x70, 62, 100,            // Running status, delta 240
+        0x81, 0x70, 64, 100,
+        0x00, 0xC0, 5,                  // Program change
+        0x00, 0xFF, 0x2F, 0x00,
+        'M', 'T', 'r', 'k', 0, 0, 0, 16,
+        0x00, 0xFF, 0x03, 0x04, 'B', 'a', 's', 's',
+        0x78, 0x91, 36, 90,             // Delta 120
+        0x78, 0x81, 36, 0,
+    };
+    return file;
+}
+
+std::vector<Tick> timestamps(const std::vector<MidiEvent>& events) {
+    std::vector<Tick> ticks;
+    for (const auto& event : events) ticks.push_back(event.timestamp);
+    return ticks;
+}
+
+} // namespace
+
+TEST_CASE("Sequence range query", "[midi]") {
+    auto sequence = make_sequence();
+    REQUIRE(sequence.is_sorted());
+
+    std::vector<MidiEvent> out;
+    sequence.get_events_in_range(150, 400, std::back_inserter(out));
+    REQUIRE(timestamps(out) == std::vector<Tick>{200, 300});
+
+    SECTION("Unsorted insert falls back to a full scan") {
+        sequence.add_event(midi::note_on(250, 0, 40, 100));
+        REQUIRE_FALSE(sequence.is_sorted());
+
+        out.clear();
+        sequence.get_events_in_range(150, 400, std::back_inserter(out));
+        REQUIRE(out.size() == 3);
+
+        sequence.sort();
+        REQUIRE(sequence.is_sorted());
+        out.clear();
+        sequence.get_events_in_range(150, 400, std::back_inserter(out));
+        REQUIRE(timestamps(out) == std::vector<Tick>{200, 250, 300});
+    }
+}
+
+TEST_CASE("Sequence only invalidates on edits", "[midi]") {
+    auto sequence = make_sequence();
+    const auto revision = sequence.revision();
+
+    // Reading through a non-const sequence keeps the fast path
+    REQUIRE(sequence.events().size() == 10);
+    REQUIRE(sequence.is_sorted());
+    REQUIRE(sequence.revision() == revision);
+
+    sequence.mutable_events().front().timestamp = 1000;
+    REQUIRE_FALSE(sequence.is_sorted());
+    REQUIRE(sequence.revision() != revision);
+
+    sequence.sort();
+    REQUIRE(sequence.is_sorted());
+    REQUIRE(sequence.events().back().timestamp == 1000);
+}
+
+TEST_CASE("SequenceCursor advances incrementally", "[midi]") {
+    const auto sequence = make_sequence();
+    midi::SequenceCursor cursor(sequence);
+
+    std::vector<MidiEvent> out;
+    cursor.advance(150, std::back_inserter(out));
+    cursor.advance(300, std::back_inserter(out));
+    REQUIRE(timestamps(out) == std::vector<Tick>{0, 100, 200});
+    REQUIRE(cursor.position() == 300);
+
+    out.clear();
+    cursor.seek(850);
+    cursor.advance(2000, std::back_inserter(out));
+    REQUIRE(timestamps(out) == std::vector<Tick>{900});
+}
+
+TEST_CASE("SequenceCursor resyncs after edits", "[midi]") {
+    auto sequence = make_sequence();
+    midi::SequenceCursor cursor(sequence);
+
+    std::vector<MidiEvent> out;
+    cursor.advance(250, std::back_inserter(out));
+
+    sequence.add_event(midi::note_on(950, 0, 72, 100));
+    sequence.add_event(midi::note_on(260, 0, 72, 100));
+    sequence.sort();
+
+    out.clear();
+    cursor.advance(400, std::back_inserter(out));
+    REQUIRE(timestamps(out) == std::vector<Tick>{260, 300});
+}
+
+TEST_CASE("SequenceCursor loop wraparound", "[midi]") {
+    const auto sequence = make_sequence();
+    midi::SequenceCursor cursor(sequence);
+    cursor.seek(300);
+
+    // Loop [200, 500): play 250 ticks from 300 -> 500, wrap, 200 -> 250
+    std::vector<MidiEvent> out;
+    cursor.advance_looped(250, 200, 500, std::back_inserter(out));
+
+    // Timestamps are offsets from the block start
+    REQUIRE(timestamps(out) == std::vector<Tick>{0, 100, 200});
+    REQUIRE(out[2].data1 == 62);
+    REQUIRE(cursor.position() == 250);
+
+    SECTION("Blocks longer than the loop wrap more than once") {
+        out.clear();
+        cursor.advance_looped(700, 200, 500, std::back_inserter(out));
+        // 250 -> 500 (300, 400), 200 -> 500 (200, 300, 400), 200 -> 350 (200, 300)
+        REQUIRE(timestamps(out) == std::vector<Tick>{50, 150, 250, 350, 450, 550, 650});
+        REQUIRE(cursor.position() == 350);
+    }
+}
+
+TEST_CASE("TrackDecoder and FileReader agree", "[midi]") {
+    const auto file = make_smf();
+
+    midi::FileReader reader;
+    REQUIRE(reader.read(file.data(), file.size()));
+    REQUIRE(reader.num_tracks() == 2);
+    REQUIRE(reader.get_sequence(0)->event_count() == 4);
+    REQUIRE(reader.get_track_info(1)->name == "Bass");
+    REQUIRE(reader.get_track_info(1)->channel == 1);
+
+    midi::StreamingFileReader stream;
+    REQUIRE(stream.open(file.data(), file.size()));
+    REQUIRE(stream.format() == 1);
+    REQUIRE(stream.ppq() == 480);
+    REQUIRE(stream.num_tracks() == 2);
+
+    midi::Sequence sequence;
+    stream.read_track(0, sequence);
+    REQUIRE(timestamps(sequence.events()) == timestamps(reader.get_sequence(0)->events()));
+}
+
+TEST_CASE("TrackDecoder keeps the first track name", "[midi]") {
+    const std::vector<uint8_t> file = {
+        'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 0, 0, 1, 0x01, 0xE0,
+        'M', 'T', 'r', 'k', 0, 0, 0, 23,
+        0x00, 0xFF, 0x03, 0x04, 'L', 'e', 'a', 'd',
+        0x00, 0x90, 60, 100,
+        0x00, 0xFF, 0x03, 0x03, 'A', 'l', 't',   // A later name is ignored
+        0x00, 0xFF, 0x2F, 0x00,
+    };
+
+    midi::StreamingFileReader stream;
+    REQUIRE(stream.open(file.data(), file.size()));
+    midi::Sequence sequence;
+    stream.read_track(0, sequence);
+    REQUIRE(sequence.event_count() == 1);
+
+    midi::FileReader reader;
+    REQUIRE(reader.read(file.data(), file.size()));
+    REQUIRE(reader.get_track_info(0)->name == "Lead");
+
+    auto merged = stream.merged();
+    size_t events = 0;
+    for (const auto& e : merged) events += e.track == 0;
+    REQUIRE(events == 1);
+    REQUIRE(merged.decoder(0).name() == "Lead");
+}
+
+TEST_CASE("StreamingFileReader merges tracks in time order", "[midi]") {
+    const auto file = make_smf();
+    midi::StreamingFileReader stream;
+    REQUIRE(stream.open(file.data(), file.size()));
+
+    std::vector<Tick> ticks;
+    std::vector<uint16_t> tracks;
+    auto merged = stream.merged();
+    for (const auto& e : merged) {
+        ticks.push_back(e.event.timestamp);
+        tracks.push_back(e.track);
+    }
+
+    REQUIRE(ticks == std::vector<Tick>{0, 120, 240, 240, 480, 480});
+    // Same-tick events come out in track order
+    REQUIRE(tracks == std::vector<uint16_t>{0, 1, 0, 1, 0, 0});
+    REQUIRE(merged.decoder(1).name() == "Bass");
+}
+
+TEST_CASE("StreamingFileReader handles bad input", "[midi]") {
+    midi::StreamingFileReader stream;
+
+    auto file = make_smf();
+    file[0] = 'X';
+    REQUIRE_FALSE(stream.open(file.data(), file.size()));
+    REQUIRE_FALSE(stream.open("/nonexistent/file.mid"));
+
+    SECTION("Truncated track decodes what is present") {
+        auto truncated = make_smf();
+        truncated.resize(14 + 8 + 10);
+        REQUIRE(stream.open(truncated.data(), truncated.size()));
+        REQUIRE(stream.num_tracks() == 1);
+
+        size_t count = 0;
+        for (const auto& e : stream.merged()) {
+            (void)e;
+            ++count;
+        }
+        REQUIRE(count == 2);
+    }
+}
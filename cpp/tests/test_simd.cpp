@@ -5,6 +5,9 @@
 
 #include <catch2/catch_all.hpp>
 #include "daiw/types.hpp"
+#include "daiw/simd.hpp"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 // These would test the actual SIMD implementations
@@ -36,3 +39,78 @@ TEST_CASE("SIMD add operation", "[simd]") {
     REQUIRE(result[0] == Catch::Approx(1.5f));
     REQUIRE(result[3] == Catch::Approx(4.5f));
 }
+
+TEST_CASE("SIMD groove kernels match scalar reference", "[simd]") {
+    // 37 elements: covers the vector body and the scalar tail
+    constexpr size_t N = 37;
+    std::vector<int64_t> ticks(N);
+    std::vector<int16_t> offsets(N);
+    std::vector<uint8_t> velocities(N), scales(N), targets(N);
+    for (size_t i = 0; i < N; ++i) {
+        ticks[i] = static_cast<int64_t>(i) * 120 - 100;
+        offsets[i] = static_cast<int16_t>((i * 7919) % 61) - 30;
+        velocities[i] = static_cast<uint8_t>((i * 37) % 128);
+        scales[i] = static_cast<uint8_t>(50 + (i * 13) % 200);
+        targets[i] = static_cast<uint8_t>((i * 53) % 128);
+    }
+
+    SECTION("Timing offsets and clamp") {
+        auto result = ticks;
+        daiw::simd::apply_timing_offsets(result.data(), offsets.data(), N);
+        daiw::simd::clamp_ticks_min(result.data(), 0, N);
+        for (size_t i = 0; i < N; ++i) {
+            REQUIRE(result[i] == std::max<int64_t>(0, ticks[i] + offsets[i]));
+        }
+    }
+
+    SECTION("Scale velocities") {
+        auto result = velocities;
+        daiw::simd::scale_velocities(result.data(), scales.data(), N);
+        for (size_t i = 0; i < N; ++i) {
+            REQUIRE(result[i] == std::clamp(velocities[i] * scales[i] / 100, 1, 127));
+        }
+    }
+
+    SECTION("Blend velocities") {
+        auto result = velocities;
+        daiw::simd::blend_velocities(result.data(), targets.data(), 0.25f, N);
+        for (size_t i = 0; i < N; ++i) {
+            const int expected = (velocities[i] * 192 + targets[i] * 64 + 128) >> 8;
+            REQUIRE(result[i] == std::clamp(expected, 1, 127));
+        }
+    }
+}
+
+TEST_CASE("SIMD fast log2/exp2 stay within tolerance", "[simd]") {
+    // 101 elements: covers the vector body and the scalar tail
+    constexpr size_t N = 101;
+    std::vector<float> input(N);
+    for (size_t i = 0; i < N; ++i) {
+        input[i] = std::pow(10.0f, -20.0f + 0.23f * static_cast<float>(i));  // 1e-20 .. ~1e3
+    }
+
+    SECTION("log2") {
+        std::vector<float> result(N);
+        daiw::simd::fast_log2(result.data(), input.data(), N);
+        for (size_t i = 0; i < N; ++i) {
+            REQUIRE(std::abs(result[i] - std::log2(input[i])) < 1e-5f);
+        }
+
+        // Zero and denormals clamp to the smallest normal
+        float zero = 0.0f;
+        daiw::simd::fast_log2(&zero, &zero, 1);
+        REQUIRE(zero == Catch::Approx(-126.0f));
+    }
+
+    SECTION("exp2") {
+        std::vector<float> exponents(N), result(N);
+        for (size_t i = 0; i < N; ++i) {
+            exponents[i] = -40.0f + 0.7f * static_cast<float>(i) + 0.013f;
+        }
+        daiw::simd::fast_exp2(result.data(), exponents.data(), N);
+        for (size_t i = 0; i < N; ++i) {
+            const float expected = std::exp2(exponents[i]);
+            REQUIRE(std::abs(result[i] - expected) <= 2e-6f * expected);
+        }
+    }
+}
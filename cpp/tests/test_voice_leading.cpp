@@ -0,0 +1,321 @@
+/**
+ * @file test_voice_leading.cpp
+ * @brief Tests for voice assignment and the voice leading solver
+ */
+
+#include <catch2/catch_all.hpp>
+#include "daiw/harmony.hpp"
+#include <algorithm>
+#include <climits>
+#include <numeric>
+#include <random>
+
+using namespace daiw::harmony;
+
+namespace {
+
+ChordTones tones(std::initializer_list<int> pitch_classes, int bass = -1) {
+    ChordTones chord;
+    for (int pc : pitch_classes) chord.pitch_classes.add(pc);
+    chord.bass = bass;
+    return chord;
+}
+
+Voicing voicing(std::initializer_list<int> notes) {
+    Voicing v;
+    for (int note : notes) v.notes[v.size++] = static_cast<daiw::MidiNote>(note);
+    return v;
+}
+
+/// Every rule, checked directly
+bool keeps_rules(const VoiceLeader& leader, const ChordTones& chord,
+                 const Voicing* from, const Voicing& v) {
+    const VoiceLeadingRules& rules = leader.rules();
+    uint16_t covered = 0;
+    for (int i = 0; i < v.size; ++i) {
+        const int p = v[i];
+        if (p < rules.lowest[i] || p > rules.highest[i]) return false;
+        if (i == 0 && chord.bass >= 0) {
+            if (p % 12 != chord.bass) return false;
+        } else if (!chord.pitch_classes.contains(p)) {
+            return false;
+        }
+        if (i > 0 && p <= v[i - 1]) return false;
+        if (i > 1 && p - v[i - 1] > rules.max_spacing) return false;
+        if (chord.pitch_classes.contains(p)) covered |= 1 << (p % 12);
+    }
+
+    if (rules.require_all_tones) {
+        int available = v.size;
+        if (chord.bass >= 0 && !chord.pitch_classes.contains(chord.bass)) --available;
+        if (std::popcount(covered) < std::min(available, chord.pitch_classes.count())) return false;
+    }
+    return !from || !leader.has_forbidden_parallels(*from, v);
+}
+
+/// Cheapest valid voicing by enumerating every combination of in-range pitches
+int brute_force_cost(const VoiceLeader& leader, const ChordTones& chord, const Voicing* from) {
+    const VoiceLeadingRules& rules = leader.rules();
+    int best = INT_MAX;
+    Voicing v;
+    v.size = static_cast<uint8_t>(rules.voices);
+
+    auto recurse = [&](auto& self, int voice) -> void {
+        if (voice == rules.voices) {
+            if (!keeps_rules(leader, chord, from, v)) return;
+            int cost = 0;
+            for (int i = 0; i < v.size; ++i) {
+                const int anchor = from ? (*from)[i] : (rules.lowest[i] + rules.highest[i]) / 2;
+                cost += std::abs(v[i] - anchor);
+            }
+            best = std::min(best, cost);
+            return;
+        }
+        for (int p = rules.lowest[voice]; p <= rules.highest[voice]; ++p) {
+            v.notes[voice] = static_cast<daiw::MidiNote>(p);
+            self(self, voice + 1);
+        }
+    };
+    recurse(recurse, 0);
+    return best;
+}
+
+ChordTones random_chord(std::mt19937& rng) {
+    static const std::array<std::initializer_list<int>, 6> shapes = {{
+        {0, 4, 7}, {0, 3, 7}, {0, 3, 6}, {0, 4, 7, 10}, {0, 4, 7, 11}, {0, 3, 7, 10}
+    }};
+    const auto& shape = shapes[rng() % shapes.size()];
+    const int root = static_cast<int>(rng() % 12);
+
+    ChordTones chord;
+    for (int interval : shape) chord.pitch_classes.add(root + interval);
+    chord.bass = (rng() % 3 == 0) ? -1 : root;
+    return chord;
+}
+
+}  // namespace
+
+TEST_CASE("min_cost_assignment matches the best permutation", "[harmony][voice_leading]") {
+    std::mt19937 rng(7);
+    for (int trial = 0; trial < 200; ++trial) {
+        const int m = 1 + static_cast<int>(rng() % MAX_CHORD_NOTES);
+        const int n = 1 + static_cast<int>(rng() % m);
+        std::array<int, MAX_CHORD_NOTES> from{}, to{};
+        for (int i = 0; i < n; ++i) from[i] = 40 + static_cast<int>(rng() % 40);
+        for (int j = 0; j < m; ++j) to[j] = 40 + static_cast<int>(rng() % 40);
+
+        std::array<int8_t, MAX_CHORD_NOTES> match{};
+        const int cost = detail::min_cost_assignment(from.data(), n, to.data(), m, match.data());
+
+        int check = 0;
+        uint32_t used = 0;
+        for (int i = 0; i < n; ++i) {
+            REQUIRE((used & (1u << match[i])) == 0);
+            used |= 1u << match[i];
+            check += std::abs(to[match[i]] - from[i]);
+        }
+        REQUIRE(check == cost);
+
+        std::array<int, MAX_CHORD_NOTES> order;
+        std::iota(order.begin(), order.begin() + m, 0);
+        int best = INT_MAX;
+        do {
+            int c = 0;
+            for (int i = 0; i < n; ++i) c += std::abs(to[order[i]] - from[i]);
+            best = std::min(best, c);
+        } while (std::next_permutation(order.begin(), order.begin() + m));
+        REQUIRE(cost == best);
+    }
+}
+
+TEST_CASE("VoiceLeadingAnalyzer pairs voices optimally", "[harmony][voice_leading]") {
+    VoiceLeadingAnalyzer analyzer;
+
+    // Greedy pairing would take 62->61 and then 60->63 (4 semitones)
+    auto analysis = analyzer.analyze({62, 60}, {61, 63});
+    REQUIRE(analysis.total_movement == 2);
+    REQUIRE(analysis.movements.size() == 2);
+    REQUIRE(analysis.movements[0].from_pitch == 62);
+    REQUIRE(analysis.movements[0].to_pitch == 63);
+
+    // More voices than targets: the closest ones are paired
+    analysis = analyzer.analyze({48, 60, 64, 67}, {59, 65});
+    REQUIRE(analysis.movements.size() == 2);
+    REQUIRE(analysis.total_movement == 2);
+}
+
+TEST_CASE("VoiceLeader::voice centres voices and keeps the rules", "[harmony][voice_leading]") {
+    VoiceLeader leader;
+    const ChordTones c_major = tones({0, 4, 7}, 0);
+
+    Voicing v;
+    REQUIRE(leader.voice(c_major, v));
+    REQUIRE(v.size == 4);
+    REQUIRE(keeps_rules(leader, c_major, nullptr, v));
+    REQUIRE(v[0] % 12 == 0);
+
+    // Slash chord: bass on E
+    const ChordTones c_over_e = tones({0, 4, 7}, 4);
+    REQUIRE(leader.voice(c_over_e, v));
+    REQUIRE(v[0] % 12 == 4);
+
+    // Slash bass outside the chord still leaves the upper voices a full triad
+    const ChordTones c_over_bb = tones({0, 4, 7}, 10);
+    REQUIRE(leader.voice(c_over_bb, v));
+    REQUIRE(v[0] % 12 == 10);
+    REQUIRE(keeps_rules(leader, c_over_bb, nullptr, v));
+}
+
+TEST_CASE("VoiceLeader::lead finds the minimum-movement voicing", "[harmony][voice_leading]") {
+    std::mt19937 rng(2024);
+    VoiceLeader leader;
+
+    for (int trial = 0; trial < 60; ++trial) {
+        const ChordTones first = random_chord(rng);
+        const ChordTones second = random_chord(rng);
+
+        Voicing from;
+        REQUIRE(leader.voice(first, from));
+        int centred = 0;
+        for (int i = 0; i < from.size; ++i) {
+            centred += std::abs(from[i] - (leader.rules().lowest[i] + leader.rules().highest[i]) / 2);
+        }
+        REQUIRE(centred == brute_force_cost(leader, first, nullptr));
+
+        Voicing to;
+        const bool found = leader.lead(from, second, to);
+        const int expected = brute_force_cost(leader, second, &from);
+        REQUIRE(found == (expected != INT_MAX));
+        if (!found) continue;
+
+        REQUIRE(keeps_rules(leader, second, &from, to));
+        REQUIRE(VoiceLeader::movement(from, to) == expected);
+    }
+}
+
+TEST_CASE("VoiceLeader avoids parallel fifths and octaves", "[harmony][voice_leading]") {
+    VoiceLeadingRules rules;
+    rules.voices = 2;
+    rules.lowest = {36, 36, 0, 0, 0, 0};
+    rules.highest = {72, 72, 127, 127, 127, 127};
+
+    // C-G up a step to D-A would be parallel fifths
+    const Voicing from = voicing({48, 55});
+    const ChordTones d_fifth = tones({2, 9});
+
+    VoiceLeader leader(rules);
+    Voicing to;
+    REQUIRE(leader.lead(from, d_fifth, to));
+    REQUIRE_FALSE(leader.has_forbidden_parallels(from, to));
+    REQUIRE(VoiceLeader::movement(from, to) > 4);
+
+    rules.forbid_parallel_fifths = false;
+    leader.set_rules(rules);
+    REQUIRE(leader.lead(from, d_fifth, to));
+    REQUIRE(to == voicing({50, 57}));
+
+    // Octaves: C-C up to D-D
+    rules.forbid_parallel_fifths = true;
+    leader.set_rules(rules);
+    REQUIRE(leader.has_forbidden_parallels(voicing({48, 60}), voicing({50, 62})));
+    // Contrary motion between fifths is fine
+    REQUIRE_FALSE(leader.has_forbidden_parallels(voicing({48, 67}), voicing({53, 60})));
+}
+
+TEST_CASE("VoiceLeader reports impossible voicings", "[harmony][voice_leading]") {
+    VoiceLeader leader;
+    Voicing v;
+    REQUIRE_FALSE(leader.voice(ChordTones{}, v));
+
+    // A wrong-size previous voicing
+    REQUIRE_FALSE(leader.lead(voicing({48, 55}), tones({0, 4, 7}), v));
+
+    // No E anywhere in a one-note bass range
+    VoiceLeadingRules rules;
+    rules.lowest[0] = rules.highest[0] = 48;
+    leader.set_rules(rules);
+    REQUIRE_FALSE(leader.voice(tones({0, 4, 7}, 4), v));
+
+    std::array<Voicing, 2> out;
+    const ChordTones chords[2] = {tones({0, 4, 7}, 4), tones({0, 4, 7})};
+    REQUIRE(leader.lead_progression(chords, 2, out.data()) == -1);
+    REQUIRE(leader.lead_progression(chords, 0, out.data()) == -1);
+}
+
+TEST_CASE("VoiceLeader::lead_progression minimizes total movement", "[harmony][voice_leading]") {
+    // Narrow ranges so every voicing is a Viterbi candidate
+    VoiceLeadingRules rules;
+    rules.voices = 3;
+    rules.lowest = {43, 52, 57, 0, 0, 0};
+    rules.highest = {55, 64, 69, 127, 127, 127};
+    VoiceLeader leader(rules);
+
+    std::mt19937 rng(99);
+    for (int trial = 0; trial < 20; ++trial) {
+        std::array<ChordTones, 6> chords;
+        for (auto& chord : chords) {
+            chord = random_chord(rng);
+            chord.bass = -1;
+        }
+
+        std::array<Voicing, 6> path;
+        const int broken = leader.lead_progression(chords.data(), 6, path.data());
+        REQUIRE(broken >= 0);
+
+        int total = 0;
+        for (int t = 0; t < 6; ++t) {
+            REQUIRE(keeps_rules(leader, chords[t], nullptr, path[t]));
+            if (t > 0) total += VoiceLeader::movement(path[t - 1], path[t]);
+        }
+
+        // Chaining lead() from the same first voicing is one of the paths considered
+        Voicing step = path[0];
+        int chained = 0;
+        bool chain_ok = true;
+        for (int t = 1; t < 6 && chain_ok; ++t) {
+            Voicing next;
+            chain_ok = leader.lead(step, chords[t], next);
+            chained += VoiceLeader::movement(step, next);
+            step = next;
+        }
+        if (chain_ok && broken == 0) REQUIRE(total <= chained);
+    }
+}
+
+TEST_CASE("VoiceLeader::lead_progression continues from a start voicing", "[harmony][voice_leading]") {
+    VoiceLeader leader;
+
+    // I - vi - IV - V in C
+    const ChordTones chords[4] = {
+        tones({0, 4, 7}, 0), tones({9, 0, 4}, 9), tones({5, 9, 0}, 5), tones({7, 11, 2}, 7)
+    };
+    Voicing start;
+    REQUIRE(leader.voice(chords[3], start));
+
+    std::array<Voicing, 4> path;
+    REQUIRE(leader.lead_progression(chords, 4, path.data(), &start) == 0);
+    for (int t = 0; t < 4; ++t) {
+        REQUIRE(keeps_rules(leader, chords[t], t > 0 ? &path[t - 1] : &start, path[t]));
+    }
+}
+
+TEST_CASE("optimalVoiceLead returns one note per voice", "[harmony][voice_leading]") {
+    using daiw::MidiNote;
+
+    // Four voices onto a triad: a tone is doubled, not dropped
+    const std::vector<MidiNote> satb = {48, 55, 64, 72};
+    std::vector<MidiNote> led = optimalVoiceLead(satb, {65, 69, 72});
+    REQUIRE(led.size() == satb.size());
+    REQUIRE(std::is_sorted(led.begin(), led.end()));
+    for (MidiNote note : led) REQUIRE((note % 12 == 5 || note % 12 == 9 || note % 12 == 0));
+
+    // Three voices onto a seventh chord: a tone is left out
+    const std::vector<MidiNote> triad = {60, 64, 67};
+    led = optimalVoiceLead(triad, {55, 59, 62, 65});
+    REQUIRE(led.size() == triad.size());
+    for (size_t v = 0; v < led.size(); ++v) REQUIRE(std::abs(led[v] - triad[v]) <= 12);
+
+    // No voices to lead: the chord tones come back as given
+    REQUIRE(optimalVoiceLead({}, {60, 64, 67}) == std::vector<MidiNote>{60, 64, 67});
+    REQUIRE(optimalVoiceLead(satb, {}).empty());
+}
@@ -0,0 +1,113 @@
+/**
+ * bench_diagnose_batch.cpp - Catalog-scale progression diagnosis throughput
+ *
+ * Diagnoses a corpus of random progressions one string at a time through
+ * DiagnosticsEngine::diagnose() (full DiagnosticReport per call), then with
+ * diagnoseBatch() on one worker and on the shared hardware-sized pool.
+ * Reports rendered from the batch columns must match diagnose() on the
+ * first PARITY_CHECKS progressions.
+ *
+ * Build: cmake -DIDAW_BUILD_BENCHMARKS=ON ..
+ * Run:   ./idaw_bench_diagnose_batch [numProgressions]
+ */
+
+#include "diagnostics/DiagnosticsEngine.h"
+#include "ThreadPool.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace iDAW::diagnostics;
+
+namespace {
+
+constexpr size_t PARITY_CHECKS = 10000;
+
+std::vector<std::string> makeCorpus(size_t count) {
+    static const char* ROOTS[] = {"C", "C#", "Db", "D", "Eb", "E", "F", "F#", "Gb", "G", "Ab", "A", "Bb", "B"};
+    static const char* QUALITIES[] = {"", "", "", "m", "m", "7", "maj7", "m7", "dim", "sus4", "m7b5"};
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> length(3, 8);
+    std::uniform_int_distribution<int> root(0, 13);
+    std::uniform_int_distribution<int> quality(0, 10);
+
+    std::vector<std::string> corpus(count);
+    for (auto& progression : corpus) {
+        const int chords = length(rng);
+        for (int c = 0; c < chords; ++c) {
+            if (c > 0) progression += '-';
+            progression += ROOTS[root(rng)];
+            progression += QUALITIES[quality(rng)];
+        }
+    }
+    return corpus;
+}
+
+bool sameReport(const DiagnosticReport& a, const DiagnosticReport& b) {
+    if (a.success != b.success || a.issues.size() != b.issues.size() ||
+        a.suggestions.size() != b.suggestions.size() || a.ruleBreaks.size() != b.ruleBreaks.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.ruleBreaks.size(); ++i) {
+        if (a.ruleBreaks[i].toString() != b.ruleBreaks[i].toString()) return false;
+    }
+    for (size_t i = 0; i < a.suggestions.size(); ++i) {
+        if (a.suggestions[i].description != b.suggestions[i].description) return false;
+    }
+    return a.chordNames == b.chordNames && a.emotionalCharacter == b.emotionalCharacter &&
+           a.harmonyComplexity == b.harmonyComplexity && a.hasResolution == b.hasResolution;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t numProgressions = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const std::vector<std::string> corpus = makeCorpus(numProgressions);
+    const DiagnosticsEngine& engine = DiagnosticsEngine::getInstance();
+
+    size_t singleFindings = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& progression : corpus) {
+        const DiagnosticReport report = engine.diagnose(progression);
+        singleFindings += report.issues.size() + report.suggestions.size() + report.ruleBreaks.size();
+    }
+    const double singleMs = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    const BatchDiagnosis serial = engine.diagnoseBatch(corpus, 1);
+    const double serialMs = elapsedMs(start);
+
+    const size_t threads = iDAW::ThreadPool::shared().size();
+    start = std::chrono::steady_clock::now();
+    const BatchDiagnosis batch = engine.diagnoseBatch(corpus);
+    const double batchMs = elapsedMs(start);
+
+    // Rendered batch reports must equal the one-at-a-time reports (outside the timing)
+    size_t mismatches = 0;
+    for (size_t i = 0; i < corpus.size() && i < PARITY_CHECKS; ++i) {
+        if (!sameReport(engine.diagnose(corpus[i]), batch.report(i))) ++mismatches;
+    }
+    if (serial.findingCode != batch.findingCode || serial.findingChord != batch.findingChord) ++mismatches;
+
+    // Parse errors yield one finding but an issue plus a suggestion in the report
+    size_t batchFindings = 0;
+    for (size_t i = 0; i < batch.findingCode.size(); ++i) {
+        batchFindings += batch.findingCode[i] == FindingCode::ParseError ? 2 : 1;
+    }
+
+    std::printf("progressions,findings,single_ms,batch_1thread_ms,batch_ms,threads,speedup_1thread,speedup,"
+                "batch_ns_per_progression,mismatches\n");
+    std::printf("%zu,%zu,%.1f,%.1f,%.1f,%zu,%.1f,%.1f,%.1f,%zu\n", numProgressions, batch.findingCode.size(),
+                singleMs, serialMs, batchMs, threads, singleMs / serialMs, singleMs / batchMs,
+                1e6 * batchMs / static_cast<double>(numProgressions), mismatches);
+    return (mismatches == 0 && batchFindings == singleFindings) ? 0 : 1;
+}
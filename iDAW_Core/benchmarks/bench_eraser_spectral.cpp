@@ -0,0 +1,161 @@
+/**
+ * bench_eraser_spectral.cpp - CPU cost of The Eraser's spectral gate
+ *
+ * Times stereo 512-sample blocks of noise through:
+ *   legacy - the former per-sample processChannel() loop (FIFO copied with
+ *            % indexing every hop, separate window passes, one real FFT
+ *            pair per channel), on the shared FFT in place of juce::dsp
+ *   engine - SpectralGateEngine (double-written FIFO, stereo packed into
+ *            one complex FFT) at each FFT size / overlap
+ *
+ * Build: cmake -DIDAW_BUILD_BENCHMARKS=ON ..
+ * Run:   ./idaw_bench_eraser_spectral [sampleRate]
+ */
+
+#include "SpectralGateEngine.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace iDAW;
+
+namespace {
+
+constexpr int BLOCK_SIZE = 512;
+constexpr int NUM_CHANNELS = 2;
+constexpr int NUM_BLOCKS = 2000;
+constexpr float THRESHOLD = 400.0f;
+
+/**
+ * The pre-engine per-channel loop, kept for comparison (2048 / 512 only)
+ */
+class LegacyEraser {
+public:
+    static constexpr int FFT_SIZE = 2048;
+    static constexpr int HOP_SIZE = FFT_SIZE / 4;
+    static constexpr int NUM_BINS = FFT_SIZE / 2 + 1;
+
+    LegacyEraser() : m_fft(daiw::dsp::fft_plan(FFT_SIZE)) {
+        m_window.resize(FFT_SIZE);
+        for (int n = 0; n < FFT_SIZE; ++n) {
+            m_window[n] = static_cast<float>(1.0 - std::cos(2.0 * M_PI * n / (FFT_SIZE - 1)));
+        }
+        m_fftBuffer.resize(FFT_SIZE + 2);
+        m_spectrum.resize(NUM_BINS);
+        for (int ch = 0; ch < NUM_CHANNELS; ++ch) {
+            m_inputFIFO[ch].assign(FFT_SIZE, 0.0f);
+            m_outputFIFO[ch].assign(FFT_SIZE, 0.0f);
+            m_lookAhead[ch].assign(FFT_SIZE / 2, 0.0f);
+        }
+    }
+
+    void process(float* const* channels, int numSamples) {
+        for (int ch = 0; ch < NUM_CHANNELS; ++ch) processChannel(ch, channels[ch], numSamples);
+    }
+
+private:
+    void processChannel(int ch, float* samples, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            m_inputFIFO[ch][m_inputIndex[ch]] = samples[i];
+            const float out = m_lookAhead[ch][m_lookAheadIndex[ch]];
+            m_lookAhead[ch][m_lookAheadIndex[ch]] = m_outputFIFO[ch][m_outputIndex[ch]];
+            m_outputFIFO[ch][m_outputIndex[ch]] = 0.0f;
+            samples[i] = out;
+
+            m_inputIndex[ch] = (m_inputIndex[ch] + 1) % FFT_SIZE;
+            m_outputIndex[ch] = (m_outputIndex[ch] + 1) % FFT_SIZE;
+            m_lookAheadIndex[ch] = (m_lookAheadIndex[ch] + 1) % (FFT_SIZE / 2);
+
+            if (m_inputIndex[ch] % HOP_SIZE == 0) {
+                for (int j = 0; j < FFT_SIZE; ++j) {
+                    m_fftBuffer[j] = m_inputFIFO[ch][(m_inputIndex[ch] + j) % FFT_SIZE];
+                }
+                applyWindow();
+                m_fft->forward_real(m_fftBuffer.data(), m_spectrum.data());
+                for (auto& bin : m_spectrum) {
+                    if (std::abs(bin) > THRESHOLD) bin = 0.0f;
+                    (void)std::arg(bin);
+                }
+                m_fft->inverse_real(m_spectrum.data(), m_fftBuffer.data());
+                applyWindow();
+                for (int j = 0; j < FFT_SIZE; ++j) {
+                    m_outputFIFO[ch][(m_outputIndex[ch] + j) % FFT_SIZE] += m_fftBuffer[j] * 1.5f / FFT_SIZE;
+                }
+            }
+        }
+    }
+
+    void applyWindow() {
+        for (int n = 0; n < FFT_SIZE; ++n) m_fftBuffer[n] *= m_window[n];
+    }
+
+    const daiw::dsp::FftPlan* m_fft;
+    std::vector<float> m_window;
+    std::vector<float> m_fftBuffer;
+    std::vector<std::complex<float>> m_spectrum;
+    std::array<std::vector<float>, NUM_CHANNELS> m_inputFIFO, m_outputFIFO, m_lookAhead;
+    std::array<int, NUM_CHANNELS> m_inputIndex{}, m_outputIndex{}, m_lookAheadIndex{};
+};
+
+std::vector<std::vector<float>> makeNoise(int numSamples) {
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    std::vector<std::vector<float>> channels(NUM_CHANNELS, std::vector<float>(static_cast<size_t>(numSamples)));
+    for (auto& channel : channels) {
+        for (auto& x : channel) x = noise(rng);
+    }
+    return channels;
+}
+
+template<typename ProcessFn>
+double microsecondsPerBlock(std::vector<std::vector<float>>& signal, ProcessFn&& process) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (int block = 0; block < NUM_BLOCKS; ++block) {
+        const size_t offset = static_cast<size_t>(block % 64) * BLOCK_SIZE;
+        float* channels[NUM_CHANNELS] = {signal[0].data() + offset, signal[1].data() + offset};
+        process(channels);
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / NUM_BLOCKS;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const double sampleRate = argc > 1 ? std::atof(argv[1]) : 48000.0;
+    auto signal = makeNoise(64 * BLOCK_SIZE);
+    const double blockUs = 1e6 * BLOCK_SIZE / sampleRate;
+
+    std::printf("path,fft_size,hop_size,latency_samples,us_per_block,realtime_percent\n");
+
+    LegacyEraser legacy;
+    const double legacyUs = microsecondsPerBlock(signal, [&](float* const* channels) {
+        legacy.process(channels, BLOCK_SIZE);
+    });
+    std::printf("legacy,%d,%d,%d,%.2f,%.3f\n", LegacyEraser::FFT_SIZE, LegacyEraser::HOP_SIZE,
+                LegacyEraser::FFT_SIZE + LegacyEraser::FFT_SIZE / 2, legacyUs, 100.0 * legacyUs / blockUs);
+
+    const int configs[][2] = {{4096, 4}, {2048, 4}, {2048, 8}, {1024, 4}, {512, 4}};
+    for (const auto& config : configs) {
+        SpectralGateEngine engine;
+        engine.setFftConfig(config[0], config[1]);
+        engine.prepare(sampleRate);
+        SpectralGateParams params;
+        params.thresholdLinear = THRESHOLD;
+        engine.setParameters(params);
+
+        const double us = microsecondsPerBlock(signal, [&](float* const* channels) {
+            engine.process(channels, NUM_CHANNELS, BLOCK_SIZE);
+        });
+        std::printf("engine,%d,%d,%d,%.2f,%.3f\n", config[0], engine.getHopSize(), engine.getLatencySamples(), us,
+                    100.0 * us / blockUs);
+    }
+
+    return 0;
+}
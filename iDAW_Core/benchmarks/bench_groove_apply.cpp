@@ -0,0 +1,91 @@
+/**
+ * bench_groove_apply.cpp - Groove application on large arrangements
+ *
+ * Times GrooveEngine::applyGroove over std::vector<MidiNote> (AoS) and over
+ * NoteBuffer (SoA, SIMD kernels), and counts heap allocations made during
+ * the SoA calls, which should be zero.
+ *
+ * Build: cmake -DIDAW_BUILD_BENCHMARKS=ON ..
+ * Run:   ./idaw_bench_groove_apply [numNotes]
+ */
+
+#include "groove/GrooveEngine.h"
+#include "groove/NoteBuffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace {
+std::atomic<size_t> g_allocations{0};
+}
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+using namespace iDAW::groove;
+
+namespace {
+
+constexpr int PPQ = 480;
+constexpr int RUNS = 50;
+
+std::vector<MidiNote> makeArrangement(size_t numNotes) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pitch(36, 84);
+    std::uniform_int_distribution<int> velocity(30, 120);
+
+    std::vector<MidiNote> notes(numNotes);
+    for (size_t i = 0; i < numNotes; ++i) {
+        notes[i] = {pitch(rng), velocity(rng), static_cast<int>(i) * (PPQ / 4), PPQ / 4, 0};
+    }
+    return notes;
+}
+
+template<typename Fn>
+double microsecondsPerRun(Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < RUNS; ++r) fn();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / RUNS;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t numNotes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+
+    const GrooveEngine& engine = GrooveEngine::getInstance();
+    const GrooveTemplate groove = getGenreTemplate(GenrePreset::Funk);
+    const std::vector<MidiNote> arrangement = makeArrangement(numNotes);
+
+    std::vector<MidiNote> aos;
+    const double aosUs = microsecondsPerRun([&] {
+        aos = arrangement;
+        engine.applyGroove(aos, groove, PPQ);
+    });
+
+    NoteBuffer soa(arrangement);
+    NoteBuffer original(arrangement);
+    const size_t allocationsBefore = g_allocations.load();
+    const double soaUs = microsecondsPerRun([&] {
+        std::copy_n(original.startTicks(), numNotes, soa.startTicks());
+        std::copy_n(original.velocities(), numNotes, soa.velocities());
+        engine.applyGroove(soa, groove, PPQ);
+    });
+    const size_t soaAllocations = g_allocations.load() - allocationsBefore;
+
+    std::printf("notes,aos_us,soa_us,speedup,soa_allocations\n");
+    std::printf("%zu,%.1f,%.1f,%.2f,%zu\n", numNotes, aosUs, soaUs, aosUs / soaUs, soaAllocations);
+    return 0;
+}
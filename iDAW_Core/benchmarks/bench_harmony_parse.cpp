@@ -0,0 +1,225 @@
+/**
+ * bench_harmony_parse.cpp - Chord progression parsing throughput
+ *
+ * Parses a corpus of random progressions (mixed delimiters, accidentals,
+ * qualities and slash chords) with the legacy std::regex tokenizer and
+ * prefix-matching chord parser, and with the single-pass string_view
+ * parser. Counts heap allocations made by parseProgressionInto() into a
+ * reused buffer, which should be zero, and checks both parsers agree on
+ * the first PARITY_CHECKS progressions.
+ *
+ * Build: cmake -DIDAW_BUILD_BENCHMARKS=ON ..
+ * Run:   ./idaw_bench_harmony_parse [numProgressions]
+ */
+
+#include "harmony/HarmonyEngine.h"
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace {
+std::atomic<size_t> g_allocations{0};
+}
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+using namespace iDAW::harmony;
+
+namespace {
+
+constexpr size_t PARITY_CHECKS = 10000;
+
+/**
+ * The parser this benchmark replaced: a std::regex built per call, then
+ * std::string copies and rfind() prefix checks per chord symbol
+ */
+class LegacyParser {
+public:
+    static std::optional<Chord> parseChord(const std::string& chordStr) {
+        if (chordStr.empty()) return std::nullopt;
+
+        std::string str = chordStr;
+        int bass = -1;
+        size_t slashPos = str.find('/');
+        if (slashPos != std::string::npos && slashPos < str.length() - 1) {
+            std::string bassStr = str.substr(slashPos + 1);
+            str = str.substr(0, slashPos);
+            if (!bassStr.empty()) {
+                char bassRoot = std::toupper(bassStr[0]);
+                if (bassRoot >= 'A' && bassRoot <= 'G') {
+                    int bassIdx = 0;
+                    for (size_t i = 0; i < 12; i++) {
+                        if (NOTE_NAMES[i][0] == bassRoot) {
+                            bassIdx = static_cast<int>(i);
+                            break;
+                        }
+                    }
+                    if (bassStr.length() > 1) {
+                        if (bassStr[1] == '#') bassIdx = (bassIdx + 1) % 12;
+                        else if (bassStr[1] == 'b') bassIdx = (bassIdx + 11) % 12;
+                    }
+                    bass = bassIdx;
+                }
+            }
+        }
+
+        if (str.empty()) return std::nullopt;
+        char rootChar = std::toupper(str[0]);
+        if (rootChar < 'A' || rootChar > 'G') return std::nullopt;
+
+        size_t rootLen = 1;
+        int rootIdx = 0;
+        for (size_t i = 0; i < 12; i++) {
+            if (NOTE_NAMES[i][0] == rootChar) {
+                rootIdx = static_cast<int>(i);
+                break;
+            }
+        }
+        if (str.length() > 1) {
+            if (str[1] == '#') {
+                rootIdx = (rootIdx + 1) % 12;
+                rootLen = 2;
+            } else if (str[1] == 'b') {
+                rootIdx = (rootIdx + 11) % 12;
+                rootLen = 2;
+            }
+        }
+
+        std::string remainder = str.substr(rootLen);
+        ChordQuality quality = ChordQuality::Major;
+        if (remainder.rfind("maj7", 0) == 0 || remainder.rfind("Maj7", 0) == 0 ||
+            remainder.rfind("M7", 0) == 0) {
+            quality = ChordQuality::Major7;
+        } else if (remainder.rfind("maj", 0) == 0 || remainder.rfind("Maj", 0) == 0) {
+            quality = ChordQuality::Major;
+        } else if (remainder.rfind("min", 0) == 0 || remainder.rfind("m", 0) == 0 ||
+                   remainder[0] == '-') {
+            quality = remainder.find("7") != std::string::npos ? ChordQuality::Minor7 : ChordQuality::Minor;
+        } else if (remainder.rfind("dim", 0) == 0 || remainder[0] == 'o') {
+            quality = remainder.find("7") != std::string::npos ? ChordQuality::Dim7 : ChordQuality::Diminished;
+        } else if (remainder[0] == '+' || remainder.rfind("aug", 0) == 0) {
+            quality = ChordQuality::Augmented;
+        } else if (remainder.rfind("sus2", 0) == 0) {
+            quality = ChordQuality::Sus2;
+        } else if (remainder.rfind("sus4", 0) == 0 || remainder.rfind("sus", 0) == 0) {
+            quality = ChordQuality::Sus4;
+        } else if (remainder.rfind("7", 0) == 0) {
+            quality = ChordQuality::Dominant7;
+        } else if (remainder.rfind("6", 0) == 0) {
+            quality = ChordQuality::Major6;
+        } else if (remainder.rfind("add9", 0) == 0) {
+            quality = ChordQuality::Add9;
+        }
+
+        return Chord(rootIdx, quality, bass);
+    }
+
+    static std::vector<Chord> parseProgression(const std::string& progressionStr) {
+        std::vector<Chord> result;
+        std::regex delimRegex("[-\\xE2\\x80\\x93\\x94\\s|,]+");
+        std::sregex_token_iterator it(progressionStr.begin(), progressionStr.end(), delimRegex, -1);
+        std::sregex_token_iterator end;
+        for (; it != end; ++it) {
+            std::string chordStr = it->str();
+            if (!chordStr.empty()) {
+                if (auto chord = parseChord(chordStr)) result.push_back(*chord);
+            }
+        }
+        return result;
+    }
+};
+
+std::vector<std::string> makeCorpus(size_t count) {
+    static const char* ROOTS[] = {"C", "C#", "Db", "D", "Eb", "E", "F", "F#", "Gb", "G", "Ab", "A", "Bb", "B"};
+    static const char* QUALITIES[] = {"", "", "m", "7", "maj7", "m7", "dim", "dim7", "+", "sus2", "sus4",
+                                      "add9", "6", "M7", "-7", "m7b5", "min", "aug"};
+    static const char* DELIMITERS[] = {"-", " - ", " ", " | ", ", ", "–", " — "};
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> length(3, 8);
+    std::uniform_int_distribution<int> root(0, 13);
+    std::uniform_int_distribution<int> quality(0, 17);
+    std::uniform_int_distribution<int> delimiter(0, 6);
+    std::uniform_int_distribution<int> slash(0, 9);
+
+    std::vector<std::string> corpus(count);
+    for (auto& progression : corpus) {
+        const int chords = length(rng);
+        const char* delim = DELIMITERS[delimiter(rng)];
+        for (int c = 0; c < chords; ++c) {
+            if (c > 0) progression += delim;
+            progression += ROOTS[root(rng)];
+            progression += QUALITIES[quality(rng)];
+            if (slash(rng) == 0) {
+                progression += '/';
+                progression += ROOTS[root(rng)];
+            }
+        }
+    }
+    return corpus;
+}
+
+bool sameChords(const std::vector<Chord>& a, const Chord* b, size_t count) {
+    if (a.size() != count) return false;
+    for (size_t i = 0; i < count; ++i) {
+        if (a[i] != b[i] || a[i].bass() != b[i].bass()) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t numProgressions = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    const std::vector<std::string> corpus = makeCorpus(numProgressions);
+
+    size_t legacyChords = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& progression : corpus) {
+        legacyChords += LegacyParser::parseProgression(progression).size();
+    }
+    const double legacyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<Chord> chords;
+    chords.reserve(64);
+    size_t chordCount = 0;
+    const size_t allocationsBefore = g_allocations.load();
+    start = std::chrono::steady_clock::now();
+    for (const auto& progression : corpus) {
+        chords.clear();
+        chordCount += parseProgressionInto(progression, chords);
+    }
+    const double parserMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    const size_t parserAllocations = g_allocations.load() - allocationsBefore;
+
+    // Both parsers must produce the same chords (checked outside the timing)
+    size_t mismatches = 0;
+    for (size_t i = 0; i < corpus.size() && i < PARITY_CHECKS; ++i) {
+        const std::string& progression = corpus[i];
+        chords.clear();
+        const size_t count = parseProgressionInto(progression, chords);
+        if (!sameChords(LegacyParser::parseProgression(progression), chords.data(), count)) ++mismatches;
+    }
+
+    std::printf("progressions,chords,legacy_ms,parser_ms,speedup,parser_ns_per_progression,parser_allocations,mismatches\n");
+    std::printf("%zu,%zu,%.1f,%.1f,%.1f,%.1f,%zu,%zu\n", numProgressions, chordCount, legacyMs, parserMs,
+                legacyMs / parserMs, 1e6 * parserMs / static_cast<double>(numProgressions), parserAllocations,
+                mismatches);
+    return (mismatches == 0 && legacyChords == chordCount) ? 0 : 1;
+}
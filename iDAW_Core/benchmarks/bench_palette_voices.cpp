@@ -0,0 +1,147 @@
+/**
+ * bench_palette_voices.cpp - Cost of The Palette's voices vs polyphony
+ *
+ * Times one 512-sample block of held notes (osc1 sine FM-ing an osc2 saw)
+ * through:
+ *   legacy - the former processVoice() loop (pow() x3 and two table reads
+ *            per voice per sample, voices summed one by one)
+ *   engine - WavetableVoiceEngine (per-block pitch, 8 voices per SIMD step)
+ *
+ * Build: cmake -DIDAW_BUILD_BENCHMARKS=ON ..
+ * Run:   ./idaw_bench_palette_voices [sampleRate]
+ */
+
+#include "WavetableVoiceEngine.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace iDAW;
+
+namespace {
+
+constexpr int BLOCK_SIZE = 512;
+constexpr int NUM_BLOCKS = 4000;
+constexpr int TABLE_SIZE = PaletteConfig::WAVETABLE_SIZE;
+
+/**
+ * The pre-engine per-sample voice loop, kept for comparison
+ */
+class LegacyPalette {
+public:
+    explicit LegacyPalette(double sampleRate) : m_sampleRate(sampleRate) {
+        for (auto& table : m_tables) table.resize(TABLE_SIZE);
+        for (int i = 0; i < TABLE_SIZE; ++i) {
+            const float phase = static_cast<float>(i) / TABLE_SIZE;
+            m_tables[0][i] = std::sin(phase * 6.2831853f);
+            m_tables[1][i] = 2.0f * phase - 1.0f;
+        }
+    }
+
+    void noteOn(int voice, int note) {
+        m_voices[voice] = {true, note, 0.0f, 0.0f, 0.0f};
+    }
+
+    void process(float* output, int numSamples, const OscillatorParameters& params) {
+        for (int sample = 0; sample < numSamples; ++sample) {
+            float mixed = 0.0f;
+            for (auto& voice : m_voices) {
+                if (voice.active) mixed += processVoice(voice, params);
+            }
+            output[sample] = mixed;
+        }
+    }
+
+private:
+    struct Voice {
+        bool active = false;
+        int noteNumber = 60;
+        float phase1 = 0.0f;
+        float phase2 = 0.0f;
+        float envelope = 0.0f;
+    };
+
+    float processVoice(Voice& voice, const OscillatorParameters& params) {
+        const float freq = 440.0f * std::pow(2.0f, (voice.noteNumber - 69) / 12.0f);
+        const float freq1 = freq * std::pow(2.0f, params.osc1DetuneCents / 1200.0f);
+        const float freq2 = freq * std::pow(2.0f, params.osc2DetuneCents / 1200.0f);
+
+        const float osc1 = read(0, voice.phase1) * params.osc1Level;
+        const float inc1 = freq1 / static_cast<float>(m_sampleRate);
+        const float inc2 = (freq2 + osc1 * params.fmAmountHz) / static_cast<float>(m_sampleRate);
+        const float osc2 = read(1, voice.phase2) * params.osc2Level;
+
+        voice.phase1 += inc1;
+        if (voice.phase1 >= 1.0f) voice.phase1 -= 1.0f;
+        voice.phase2 += inc2;
+        while (voice.phase2 >= 1.0f) voice.phase2 -= 1.0f;
+        while (voice.phase2 < 0.0f) voice.phase2 += 1.0f;
+
+        // Attack ramp standing in for the ADSR switch
+        voice.envelope = std::min(voice.envelope + 0.001f, 0.7f);
+        return (osc1 + osc2) * voice.envelope;
+    }
+
+    float read(int table, float phase) {
+        const float scaled = phase * TABLE_SIZE;
+        const int index = static_cast<int>(scaled) % TABLE_SIZE;
+        const int next = (index + 1) % TABLE_SIZE;
+        const float frac = scaled - std::floor(scaled);
+        return m_tables[table][index] * (1.0f - frac) + m_tables[table][next] * frac;
+    }
+
+    double m_sampleRate;
+    std::array<std::vector<float>, 2> m_tables;
+    std::array<Voice, PaletteConfig::MAX_VOICES> m_voices;
+};
+
+template<typename ProcessFn>
+double microsecondsPerBlock(ProcessFn&& process) {
+    std::vector<float> block(BLOCK_SIZE);
+    volatile float sink = 0.0f;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < NUM_BLOCKS; ++b) {
+        process(block.data(), BLOCK_SIZE);
+        sink = sink + block[BLOCK_SIZE - 1];
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count()
+           / NUM_BLOCKS;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const double sampleRate = argc > 1 ? std::atof(argv[1]) : 48000.0;
+
+    OscillatorParameters params;
+    params.osc1Type = WavetableType::SINE;
+    params.osc2Type = WavetableType::SAW;
+    params.osc2DetuneCents = 7.0f;
+    params.fmAmountHz = 200.0f;
+
+    ADSREnvelope sustained;
+    sustained.attack = 0.5f;
+
+    std::printf("voices,legacy_us,engine_us,relative_to_legacy\n");
+
+    for (int numVoices : {1, 4, 8}) {
+        LegacyPalette legacy(sampleRate);
+        WavetableVoiceEngine engine;
+        engine.prepare(sampleRate, BLOCK_SIZE);
+        for (int v = 0; v < numVoices; ++v) {
+            legacy.noteOn(v, 48 + 5 * v);
+            engine.noteOn(48 + 5 * v, 1.0f, sustained);
+        }
+
+        const double legacyUs = microsecondsPerBlock([&](float* out, int n) { legacy.process(out, n, params); });
+        const double engineUs = microsecondsPerBlock([&](float* out, int n) { engine.render(out, n, params); });
+        std::printf("%d,%.2f,%.2f,%.2f\n", numVoices, legacyUs, engineUs, engineUs / legacyUs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * bench_parrot_yin.cpp - CPU cost of The Parrot's YIN pitch tracker
+ *
+ * Compares the direct O(N^2) difference function against the FFT one per
+ * analysis frame, then reports how much of one core a single streaming
+ * instance uses at each hop size. instances_per_core is the number of Parrots
+ * that could track pitch in real time on one core.
+ *
+ * Build: cmake -DIDAW_BUILD_BENCHMARKS=ON ..
+ * Run:   ./idaw_bench_parrot_yin [sampleRate]
+ */
+
+#include "YinPitchTracker.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int FRAME_SIZE = 4096;
+constexpr int HOST_BLOCK_SIZE = 256;
+constexpr double SECONDS_PER_RUN = 10.0;
+
+std::vector<float> makeVoiceLikeSignal(int numSamples, double sampleRate) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    std::vector<float> signal(static_cast<size_t>(numSamples));
+
+    // Slowly gliding harmonic tone with a little breath noise
+    double phase = 0.0;
+    for (int i = 0; i < numSamples; ++i) {
+        const double freq = 220.0 * std::pow(2.0, std::sin(i / sampleRate));
+        phase += freq / sampleRate;
+        double s = 0.0;
+        for (int h = 1; h <= 6; ++h) {
+            s += std::sin(2.0 * M_PI * h * phase) / h;
+        }
+        signal[static_cast<size_t>(i)] = static_cast<float>(0.4 * s) + 0.02f * noise(rng);
+    }
+    return signal;
+}
+
+double microsecondsPerFrame(iDAW::YinPitchTracker& tracker, const std::vector<float>& signal,
+                            int numFrames) {
+    const int maxStart = static_cast<int>(signal.size()) - FRAME_SIZE;
+    volatile float sink = 0.0f;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < numFrames; ++f) {
+        sink = sink + tracker.analyzeFrame(signal.data() + (f * 97) % maxStart);
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::micro>(end - start).count() / numFrames;
+}
+
+double realtimePercent(iDAW::YinPitchTracker& tracker, const std::vector<float>& signal,
+                       double sampleRate) {
+    tracker.reset();
+    const int total = static_cast<int>(signal.size()) / HOST_BLOCK_SIZE * HOST_BLOCK_SIZE;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (int pos = 0; pos < total; pos += HOST_BLOCK_SIZE) {
+        tracker.pushSamples(signal.data() + pos, HOST_BLOCK_SIZE);
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    const double elapsed = std::chrono::duration<double>(end - start).count();
+    return 100.0 * elapsed / (total / sampleRate);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const double sampleRate = argc > 1 ? std::atof(argv[1]) : 48000.0;
+    const auto signal = makeVoiceLikeSignal(static_cast<int>(SECONDS_PER_RUN * sampleRate), sampleRate);
+
+    iDAW::YinPitchTracker tracker;
+    tracker.prepare(sampleRate, FRAME_SIZE, 512);
+
+    // Per-frame cost
+    tracker.setMethod(iDAW::YinPitchTracker::Method::Direct);
+    const double directUs = microsecondsPerFrame(tracker, signal, 50);
+    tracker.setMethod(iDAW::YinPitchTracker::Method::FFT);
+    const double fftUs = microsecondsPerFrame(tracker, signal, 2000);
+
+    std::printf("method,frame_size,us_per_frame\n");
+    std::printf("direct,%d,%.2f\n", FRAME_SIZE, directUs);
+    std::printf("fft,%d,%.2f\n", FRAME_SIZE, fftUs);
+    std::printf("speedup,%d,%.1f\n\n", FRAME_SIZE, directUs / fftUs);
+
+    // Streaming cost per instance
+    std::printf("hop_size,frames_per_second,realtime_percent,instances_per_core\n");
+    const int hopSizes[] = {64, 128, 256, 512, 1024};
+    for (int hop : hopSizes) {
+        tracker.setHopSize(hop);
+        const double percent = realtimePercent(tracker, signal, sampleRate);
+        std::printf("%d,%.1f,%.3f,%.0f\n", hop, sampleRate / hop, percent, 100.0 / percent);
+    }
+
+    return 0;
+}
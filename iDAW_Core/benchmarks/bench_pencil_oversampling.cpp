@@ -0,0 +1,242 @@
+/**
+ * bench_pencil_oversampling.cpp - CPU and aliasing of The Pencil's drive modes
+ *
+ * Times one stereo 512-sample block through:
+ *   legacy  - the former per-sample path (base rate, std::tanh per band-sample)
+ *   off/2x/4x - GraphiteEngine at each oversampling setting
+ *
+ * Also drives a 7 kHz sine hard and reports the level of its 5th harmonic's
+ * alias (35 kHz folded to 13 kHz at 48 kHz) relative to the fundamental.
+ *
+ * A second table times the band filters alone: the former scalar
+ * Direct Form I loop (per channel, per band) against BiquadBank.
+ *
+ * Build: cmake -DIDAW_BUILD_BENCHMARKS=ON ..
+ * Run:   ./idaw_bench_pencil_oversampling [sampleRate]
+ */
+
+#include "BiquadBank.h"
+#include "GraphiteEngine.h"
+#include "TubeSaturation.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace iDAW;
+
+namespace {
+
+constexpr int BLOCK_SIZE = 512;
+constexpr int NUM_CHANNELS = 2;
+constexpr int NUM_BLOCKS = 4000;
+constexpr double PI = 3.14159265358979323846;
+
+std::array<BandParameters, 3> defaultBands(float drive) {
+    std::array<BandParameters, 3> bands;
+    bands[0] = {120.0f, PencilConfig::LOW_Q, drive, 0.5f, true};
+    bands[1] = {1000.0f, PencilConfig::MID_Q, drive, 0.5f, true};
+    bands[2] = {8000.0f, PencilConfig::HIGH_Q, drive, 0.5f, true};
+    return bands;
+}
+
+/** Direct Form I history of the former scalar filters */
+struct BiquadState {
+    float x1 = 0.0f, x2 = 0.0f;
+    float y1 = 0.0f, y2 = 0.0f;
+};
+
+BiquadCoeffs bandpass(double sampleRate, float frequency, float q) {
+    const float w0 = 2.0f * static_cast<float>(PI) * frequency / static_cast<float>(sampleRate);
+    const float alpha = std::sin(w0) / (2.0f * q);
+    const float a0 = 1.0f + alpha;
+    return {alpha / a0, 0.0f, -alpha / a0, -2.0f * std::cos(w0) / a0, (1.0f - alpha) / a0};
+}
+
+/**
+ * The pre-oversampling processSample() loop, kept for comparison
+ */
+class LegacyPencil {
+public:
+    LegacyPencil(double sampleRate, const std::array<BandParameters, 3>& bands) : m_bands(bands) {
+        for (int b = 0; b < 3; ++b) {
+            m_coeffs[b] = bandpass(sampleRate, bands[b].frequency, bands[b].q);
+        }
+    }
+
+    void process(int channel, float* samples, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            const float input = samples[i];
+            float output = 0.0f;
+            for (int b = 0; b < 3; ++b) {
+                BiquadState& s = m_state[b][channel];
+                const BiquadCoeffs& c = m_coeffs[b];
+                const float filtered = c.b0 * input + c.b1 * s.x1 + c.b2 * s.x2 - c.a1 * s.y1 - c.a2 * s.y2;
+                s.x2 = s.x1; s.x1 = input; s.y2 = s.y1; s.y1 = filtered;
+
+                const float drive = m_bands[b].drive;
+                const float saturated = drive <= 1.0f
+                    ? filtered : tubeSaturateReference(filtered, drive, PencilConfig::MAX_DRIVE);
+                const float bandOutput = filtered * (1.0f - m_bands[b].mix) + saturated * m_bands[b].mix;
+                m_levels[b] = std::max(std::abs(bandOutput), m_levels[b] * 0.99f);
+                output += bandOutput;
+            }
+            samples[i] = input * 0.5f + output * 0.5f;
+        }
+    }
+
+private:
+    std::array<BandParameters, 3> m_bands;
+    std::array<BiquadCoeffs, 3> m_coeffs;
+    std::array<std::array<BiquadState, 2>, 3> m_state{};
+    std::array<float, 3> m_levels{};
+};
+
+/** Power of one frequency in a signal (Goertzel) */
+double goertzelPower(const std::vector<float>& x, double frequency, double sampleRate) {
+    const double coeff = 2.0 * std::cos(2.0 * PI * frequency / sampleRate);
+    double s1 = 0.0, s2 = 0.0;
+    for (float v : x) {
+        const double s0 = v + coeff * s1 - s2;
+        s2 = s1;
+        s1 = s0;
+    }
+    return s1 * s1 + s2 * s2 - coeff * s1 * s2;
+}
+
+template<typename ProcessFn>
+double microsecondsPerBlock(ProcessFn&& process) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    std::array<std::vector<float>, NUM_CHANNELS> block;
+    for (auto& ch : block) {
+        ch.resize(BLOCK_SIZE);
+    }
+
+    double totalUs = 0.0;
+    for (int b = 0; b < NUM_BLOCKS; ++b) {
+        for (auto& ch : block) {
+            for (auto& s : ch) s = noise(rng);
+        }
+        float* channels[NUM_CHANNELS] = {block[0].data(), block[1].data()};
+        const auto start = std::chrono::steady_clock::now();
+        process(channels, BLOCK_SIZE);
+        totalUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+    return totalUs / NUM_BLOCKS;
+}
+
+template<typename ProcessFn>
+double aliasDb(ProcessFn&& process, double sampleRate) {
+    const double f0 = 7000.0;
+    const double alias = sampleRate - std::fmod(5.0 * f0, sampleRate);  // 5th harmonic folded
+    const int length = 1 << 15;
+
+    std::vector<float> signal(length);
+    for (int i = 0; i < length; ++i) {
+        signal[i] = static_cast<float>(0.8 * std::sin(2.0 * PI * f0 * i / sampleRate));
+    }
+    for (int offset = 0; offset < length; offset += BLOCK_SIZE) {
+        float* channels[1] = {signal.data() + offset};
+        process(channels, BLOCK_SIZE);
+    }
+
+    // Skip the filters' settling time
+    std::vector<float> tail(signal.begin() + length / 4, signal.end());
+    const double fundamental = goertzelPower(tail, f0, sampleRate);
+    const double aliased = goertzelPower(tail, std::abs(alias), sampleRate);
+    return 10.0 * std::log10(aliased / fundamental + 1e-30);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const double sampleRate = argc > 1 ? std::atof(argv[1]) : 48000.0;
+    const std::array<BandParameters, 3> bands = defaultBands(8.0f);
+
+    std::printf("mode,us_per_block,relative_to_legacy,alias_db\n");
+
+    LegacyPencil legacyTiming(sampleRate, bands);
+    const double legacyUs = microsecondsPerBlock([&](float* const* ch, int n) {
+        legacyTiming.process(0, ch[0], n);
+        legacyTiming.process(1, ch[1], n);
+    });
+    LegacyPencil legacyAlias(sampleRate, bands);
+    const double legacyAliasDb = aliasDb([&](float* const* ch, int n) { legacyAlias.process(0, ch[0], n); },
+                                         sampleRate);
+    std::printf("legacy,%.2f,1.00,%.1f\n", legacyUs, legacyAliasDb);
+
+    const std::pair<const char*, PencilOversampling> modes[] = {
+        {"off", PencilOversampling::Off},
+        {"2x", PencilOversampling::X2},
+        {"4x", PencilOversampling::X4},
+    };
+
+    for (const auto& [name, mode] : modes) {
+        GraphiteEngine engine;
+        engine.setOversampling(mode);
+        engine.prepare(sampleRate, BLOCK_SIZE);
+        for (int b = 0; b < 3; ++b) {
+            engine.setBandFilter(b, bands[b].frequency, bands[b].q);
+        }
+
+        std::array<float, 3> peaks{};
+        const double us = microsecondsPerBlock([&](float* const* ch, int n) {
+            engine.process(ch, NUM_CHANNELS, n, bands, peaks);
+        });
+
+        engine.reset();
+        const double alias = aliasDb([&](float* const* ch, int n) {
+            engine.process(ch, 1, n, bands, peaks);
+        }, sampleRate);
+
+        std::printf("%s,%.2f,%.2f,%.1f\n", name, us, us / legacyUs, alias);
+    }
+
+    // Band filters alone, 3 bands x 2 channels
+    std::array<BiquadCoeffs, 3> coeffs;
+    for (int b = 0; b < 3; ++b) {
+        coeffs[b] = bandpass(sampleRate, bands[b].frequency, bands[b].q);
+    }
+    std::array<std::array<std::vector<float>, 3>, NUM_CHANNELS> bandOut;
+    for (auto& channel : bandOut) {
+        for (auto& band : channel) band.resize(BLOCK_SIZE);
+    }
+
+    std::printf("\nfilters,us_per_block,relative_to_scalar\n");
+
+    std::array<std::array<BiquadState, 3>, NUM_CHANNELS> state{};
+    const double scalarUs = microsecondsPerBlock([&](float* const* ch, int n) {
+        for (int c = 0; c < NUM_CHANNELS; ++c) {
+            for (int b = 0; b < 3; ++b) {
+                BiquadState& s = state[c][b];
+                const BiquadCoeffs& k = coeffs[b];
+                float* out = bandOut[c][b].data();
+                for (int i = 0; i < n; ++i) {
+                    const float x = ch[c][i];
+                    const float y = k.b0 * x + k.b1 * s.x1 + k.b2 * s.x2 - k.a1 * s.y1 - k.a2 * s.y2;
+                    s.x2 = s.x1; s.x1 = x; s.y2 = s.y1; s.y1 = y;
+                    out[i] = y;
+                }
+            }
+        }
+    });
+    std::printf("scalar_df1,%.2f,1.00\n", scalarUs);
+
+    BiquadBank bank;
+    for (int b = 0; b < 3; ++b) {
+        bank.setCoefficients(b, coeffs[b]);
+    }
+    const BiquadBank::ChannelOutputs left = {bandOut[0][0].data(), bandOut[0][1].data(), bandOut[0][2].data()};
+    const BiquadBank::ChannelOutputs right = {bandOut[1][0].data(), bandOut[1][1].data(), bandOut[1][2].data()};
+    const double bankUs = microsecondsPerBlock([&](float* const* ch, int n) {
+        bank.process(ch[0], ch[1], left, right, n);
+    });
+    std::printf("biquad_bank,%.2f,%.2f\n", bankUs, bankUs / scalarUs);
+
+    return 0;
+}
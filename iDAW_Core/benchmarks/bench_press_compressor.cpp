@@ -0,0 +1,177 @@
+/**
+ * bench_press_compressor.cpp - CPU cost of The Press's compressor
+ *
+ * Times one stereo 512-sample block of program material held in gain
+ * reduction through:
+ *   legacy - the former per-sample loop (sqrt, log10, pow per sample, %
+ *            on the RMS window)
+ *   engine - CompressorEngine (SIMD detector, log-domain gain computer with
+ *            fast log2/exp2, simd::apply_envelope)
+ *   multiband_4 - MultibandCompressorEngine with 4 bands (SIMD crossover,
+ *            detector and envelopes vectorized across bands)
+ *
+ * Absolute times drift between sessions on a shared host (the legacy path
+ * has measured anywhere from 23 to 39 us on the same machine), so compare
+ * paths within one run via the relative_to_legacy column. One run, -O3:
+ *
+ *   path          AVX2+FMA   SSE4.2
+ *   legacy        37.8 us    38.2 us
+ *   engine         4.3 us    14.9 us
+ *   multiband_4   18.5 us    53.0 us
+ *
+ * Build: cmake -DIDAW_BUILD_BENCHMARKS=ON ..
+ * Run:   ./idaw_bench_press_compressor [sampleRate]
+ */
+
+#include "CompressorEngine.h"
+#include "MultibandCompressorEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace iDAW;
+
+namespace {
+
+constexpr int BLOCK_SIZE = 512;
+constexpr int NUM_CHANNELS = 2;
+constexpr int NUM_BLOCKS = 4000;
+
+/**
+ * The pre-engine processBlock() loop, kept for comparison
+ */
+class LegacyPress {
+public:
+    LegacyPress(double sampleRate, const CompressorParams& params) : m_params(params) {
+        m_window = std::max(1, static_cast<int>(PressConfig::RMS_WINDOW_MS * sampleRate / 1000.0));
+        m_rmsBuffer.assign(static_cast<size_t>(m_window), 0.0f);
+        m_attackCoeff = 1.0f - std::exp(-1.0f / (params.attackMs * static_cast<float>(sampleRate) / 1000.0f));
+        m_releaseCoeff = 1.0f - std::exp(-1.0f / (params.releaseMs * static_cast<float>(sampleRate) / 1000.0f));
+    }
+
+    void process(float* const* channels, int numChannels, int numSamples) {
+        const float makeupGain = dbToLinear(m_params.makeupGainDb);
+        float blockGainReduction = 0.0f;
+
+        for (int sample = 0; sample < numSamples; ++sample) {
+            float sumSquares = 0.0f;
+            for (int channel = 0; channel < numChannels; ++channel) {
+                const float x = channels[channel][sample];
+                sumSquares += x * x;
+                m_inputPeak = std::max(m_inputPeak, std::abs(x));
+            }
+
+            m_rmsSum -= m_rmsBuffer[m_rmsBufferIndex];
+            m_rmsBuffer[m_rmsBufferIndex] = sumSquares / numChannels;
+            m_rmsSum += m_rmsBuffer[m_rmsBufferIndex];
+            m_rmsBufferIndex = (m_rmsBufferIndex + 1) % m_window;
+
+            const float rmsLevel = std::sqrt(m_rmsSum / m_window);
+            const float inputDb = linearToDb(rmsLevel);
+            const float targetGainLinear = dbToLinear(
+                CompressorEngine::gainReductionDb(inputDb, m_params.thresholdDb, m_params.ratio));
+
+            const float coeff = targetGainLinear < m_envelopeState ? m_attackCoeff : m_releaseCoeff;
+            m_envelopeState += coeff * (targetGainLinear - m_envelopeState);
+            blockGainReduction = std::max(blockGainReduction, -linearToDb(m_envelopeState));
+
+            const float totalGain = m_envelopeState * makeupGain;
+            for (int channel = 0; channel < numChannels; ++channel) {
+                channels[channel][sample] *= totalGain;
+                m_outputPeak = std::max(m_outputPeak, std::abs(channels[channel][sample]));
+            }
+        }
+        m_gainReductionDb = blockGainReduction;
+    }
+
+private:
+    static float linearToDb(float linear) { return 20.0f * std::log10(std::max(linear, 1e-10f)); }
+    static float dbToLinear(float db) { return std::pow(10.0f, db / 20.0f); }
+
+    CompressorParams m_params;
+    int m_window = 0;
+    std::vector<float> m_rmsBuffer;
+    int m_rmsBufferIndex = 0;
+    float m_rmsSum = 0.0f;
+    float m_attackCoeff = 0.0f;
+    float m_releaseCoeff = 0.0f;
+    float m_envelopeState = 1.0f;
+    float m_inputPeak = 0.0f;
+    float m_outputPeak = 0.0f;
+    float m_gainReductionDb = 0.0f;
+};
+
+template<typename ProcessFn>
+double microsecondsPerBlock(const std::vector<float>& source, ProcessFn&& process) {
+    std::vector<std::vector<float>> buffers(NUM_CHANNELS, std::vector<float>(BLOCK_SIZE));
+    float* channels[NUM_CHANNELS] = {buffers[0].data(), buffers[1].data()};
+    volatile float sink = 0.0f;
+    double total = 0.0;
+
+    for (int b = 0; b < NUM_BLOCKS; ++b) {
+        // Refill outside the timed region so the gain stays in reduction
+        const size_t offset = static_cast<size_t>(b % 64) * BLOCK_SIZE;
+        for (int ch = 0; ch < NUM_CHANNELS; ++ch) {
+            std::copy(source.begin() + offset, source.begin() + offset + BLOCK_SIZE, buffers[ch].begin());
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        process(channels, NUM_CHANNELS, BLOCK_SIZE);
+        total += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        sink = sink + buffers[0][BLOCK_SIZE - 1];
+    }
+    return total / NUM_BLOCKS;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const double sampleRate = argc > 1 ? std::atof(argv[1]) : 48000.0;
+
+    // Noise bursts around -12 dBFS against a -20 dB threshold
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    std::vector<float> source(static_cast<size_t>(64 * BLOCK_SIZE));
+    for (size_t i = 0; i < source.size(); ++i) {
+        const float burst = (i / 4096) % 2 == 0 ? 1.0f : 0.3f;
+        source[i] = noise(rng) * burst;
+    }
+
+    CompressorParams params;
+    params.makeupGainDb = 3.0f;
+
+    LegacyPress legacy(sampleRate, params);
+    CompressorEngine engine;
+    engine.setParameters(params);
+    engine.prepare(sampleRate, BLOCK_SIZE);
+
+    const double legacyUs = microsecondsPerBlock(source, [&](float* const* ch, int nc, int n) {
+        legacy.process(ch, nc, n);
+    });
+    const double engineUs = microsecondsPerBlock(source, [&](float* const* ch, int nc, int n) {
+        engine.process(ch, nc, n);
+    });
+
+    // Four bands: the crossover plus per-band compression in one pass
+    MultibandParams multibandParams;
+    multibandParams.numBands = 4;
+    multibandParams.bands.fill(params);
+    MultibandCompressorEngine multiband;
+    multiband.setParameters(multibandParams);
+    multiband.prepare(sampleRate, BLOCK_SIZE);
+
+    const double multibandUs = microsecondsPerBlock(source, [&](float* const* ch, int nc, int n) {
+        multiband.process(ch, nc, n);
+    });
+
+    std::printf("path,us_per_block,relative_to_legacy\n");
+    std::printf("legacy,%.2f,1.00\n", legacyUs);
+    std::printf("engine,%.2f,%.2f\n", engineUs, engineUs / legacyUs);
+    std::printf("multiband_4,%.2f,%.2f\n", multibandUs, multibandUs / legacyUs);
+    return 0;
+}
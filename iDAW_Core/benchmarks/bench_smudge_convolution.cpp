@@ -0,0 +1,101 @@
+/**
+ * bench_smudge_convolution.cpp - CPU cost of The Smudge's convolution engine
+ *
+ * Measures per-block processing time of PartitionedConvolver against IR
+ * length and host block size. With non-uniform partitioning the mean cost
+ * per block should grow far slower than the IR length, and the worst block
+ * should stay close to the mean.
+ *
+ * Build: cmake -DIDAW_BUILD_BENCHMARKS=ON ..
+ * Run:   ./idaw_bench_smudge [sampleRate]
+ */
+
+#include "PartitionedConvolver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int NUM_CHANNELS = 2;
+constexpr double SECONDS_PER_RUN = 10.0;
+
+struct BlockStats {
+    double meanUs = 0.0;
+    double maxUs = 0.0;
+    double realtimePercent = 0.0;
+};
+
+BlockStats runBenchmark(iDAW::PartitionedConvolver& convolver, int blockSize, double sampleRate) {
+    const int numBlocks = static_cast<int>(SECONDS_PER_RUN * sampleRate / blockSize);
+
+    std::vector<float> input(static_cast<size_t>(blockSize));
+    std::vector<float> output(static_cast<size_t>(blockSize));
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+
+    convolver.reset();
+
+    double totalUs = 0.0;
+    double maxUs = 0.0;
+
+    for (int b = 0; b < numBlocks; ++b) {
+        for (auto& s : input) s = noise(rng);
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (int ch = 0; ch < NUM_CHANNELS; ++ch) {
+            convolver.process(ch, input.data(), output.data(), blockSize);
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        const double us = std::chrono::duration<double, std::micro>(end - start).count();
+        totalUs += us;
+        maxUs = std::max(maxUs, us);
+    }
+
+    BlockStats stats;
+    stats.meanUs = totalUs / numBlocks;
+    stats.maxUs = maxUs;
+    stats.realtimePercent = 100.0 * stats.meanUs / (1.0e6 * blockSize / sampleRate);
+    return stats;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const double sampleRate = argc > 1 ? std::atof(argv[1]) : 48000.0;
+
+    const double irSeconds[] = {0.25, 0.5, 1.0, 2.0, 4.0, 8.0};
+    const int blockSizes[] = {64, 256, 512, 1024};
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+
+    std::printf("ir_seconds,ir_samples,stages,block_size,mean_us,max_us,realtime_percent\n");
+
+    for (double seconds : irSeconds) {
+        // Exponentially decaying noise, like a real room
+        const int irLength = static_cast<int>(seconds * sampleRate);
+        std::vector<float> ir(static_cast<size_t>(irLength));
+        for (int i = 0; i < irLength; ++i) {
+            ir[static_cast<size_t>(i)] = noise(rng) * std::exp(-3.0f * i / static_cast<float>(irLength));
+        }
+
+        iDAW::PartitionedConvolver convolver;
+        convolver.setImpulseResponse(ir.data(), irLength, NUM_CHANNELS);
+
+        for (int blockSize : blockSizes) {
+            const BlockStats stats = runBenchmark(convolver, blockSize, sampleRate);
+            std::printf("%.2f,%d,%d,%d,%.2f,%.2f,%.3f\n",
+                        seconds, irLength, convolver.getNumStages(), blockSize,
+                        stats.meanUs, stats.maxUs, stats.realtimePercent);
+        }
+    }
+
+    return 0;
+}
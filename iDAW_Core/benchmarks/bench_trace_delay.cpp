@@ -0,0 +1,160 @@
+/**
+ * bench_trace_delay.cpp - CPU cost of The Trace's delay line
+ *
+ * Times one stereo 512-sample block of a modulated ping-pong delay through:
+ *   legacy  - the former per-sample loop (sin() LFO per sample, two reads
+ *             per channel in ping-pong, wrap loops and % per read)
+ *   linear/cubic/allpass - TapeDelayEngine with each interpolation kernel
+ *
+ * instances_per_core is the number of Traces one core could run in real
+ * time at that cost.
+ *
+ * Build: cmake -DIDAW_BUILD_BENCHMARKS=ON ..
+ * Run:   ./idaw_bench_trace_delay [sampleRate]
+ */
+
+#include "TapeDelayEngine.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace iDAW;
+
+namespace {
+
+constexpr int BLOCK_SIZE = 512;
+constexpr int NUM_CHANNELS = 2;
+constexpr int NUM_BLOCKS = 4000;
+constexpr float MAX_DELAY_MS = 2050.0f;
+
+/**
+ * The pre-engine processBlock() loop, kept for comparison
+ */
+class LegacyTrace {
+public:
+    explicit LegacyTrace(double sampleRate) : m_sampleRate(sampleRate) {
+        m_bufferSize = static_cast<int>(MAX_DELAY_MS * sampleRate / 1000.0) + 1;
+        for (auto& buffer : m_delayBuffer) buffer.assign(static_cast<size_t>(m_bufferSize), 0.0f);
+    }
+
+    void process(float* const* channels, int numSamples, const TapeDelayParameters& params) {
+        for (int sample = 0; sample < numSamples; ++sample) {
+            m_lfoPhase += params.modRateHz / static_cast<float>(m_sampleRate);
+            if (m_lfoPhase >= 1.0f) m_lfoPhase -= 1.0f;
+            const float modulation = std::sin(m_lfoPhase * 2.0f * 3.14159265f) * params.modDepthSamples;
+
+            const float delay = std::clamp(params.delaySamples + modulation, 1.0f,
+                                           static_cast<float>(m_bufferSize - 1));
+
+            for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+                const float input = channels[channel][sample];
+                float delayed = read(channel, delay);
+                if (params.tapeSaturation) delayed = saturate(delayed);
+
+                float feedbackSample = delayed;
+                if (params.pingPong) {
+                    feedbackSample = read(1 - channel, delay);
+                    if (params.tapeSaturation) feedbackSample = saturate(feedbackSample);
+                }
+
+                m_delayBuffer[channel][m_writeIndex[channel]] = input + feedbackSample * params.feedback;
+                m_writeIndex[channel] = (m_writeIndex[channel] + 1) % m_bufferSize;
+
+                channels[channel][sample] = input * (1.0f - params.mix) + delayed * params.mix;
+            }
+        }
+    }
+
+private:
+    float read(int channel, float delaySamples) {
+        int indexA = m_writeIndex[channel] - static_cast<int>(delaySamples);
+        int indexB = indexA - 1;
+        while (indexA < 0) indexA += m_bufferSize;
+        while (indexB < 0) indexB += m_bufferSize;
+        indexA %= m_bufferSize;
+        indexB %= m_bufferSize;
+        const float frac = delaySamples - std::floor(delaySamples);
+        return m_delayBuffer[channel][indexA] * (1.0f - frac) + m_delayBuffer[channel][indexB] * frac;
+    }
+
+    static float saturate(float sample) {
+        return std::tanh(sample * 2.0f) / std::tanh(2.0f);
+    }
+
+    double m_sampleRate;
+    int m_bufferSize = 0;
+    std::array<std::vector<float>, NUM_CHANNELS> m_delayBuffer;
+    std::array<int, NUM_CHANNELS> m_writeIndex = {0, 0};
+    float m_lfoPhase = 0.0f;
+};
+
+template<typename ProcessFn>
+double microsecondsPerBlock(ProcessFn&& process) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    std::array<std::vector<float>, NUM_CHANNELS> block;
+    for (auto& ch : block) {
+        ch.resize(BLOCK_SIZE);
+    }
+
+    double totalUs = 0.0;
+    for (int b = 0; b < NUM_BLOCKS; ++b) {
+        for (auto& ch : block) {
+            for (auto& s : ch) s = noise(rng);
+        }
+        float* channels[NUM_CHANNELS] = {block[0].data(), block[1].data()};
+        const auto start = std::chrono::steady_clock::now();
+        process(channels, BLOCK_SIZE);
+        totalUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+    return totalUs / NUM_BLOCKS;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const double sampleRate = argc > 1 ? std::atof(argv[1]) : 48000.0;
+    const float samplesPerMs = static_cast<float>(sampleRate) / 1000.0f;
+    const double blockUs = 1e6 * BLOCK_SIZE / sampleRate;
+
+    // "Ethereal" preset: long modulated ping-pong with tape
+    TapeDelayParameters params;
+    params.delaySamples = 450.0f * samplesPerMs;
+    params.feedback = 0.6f;
+    params.mix = 0.5f;
+    params.modDepthSamples = 20.0f * samplesPerMs;
+    params.modRateHz = 0.3f;
+    params.pingPong = true;
+    params.tapeSaturation = true;
+
+    std::printf("mode,us_per_block,relative_to_legacy,instances_per_core\n");
+
+    LegacyTrace legacy(sampleRate);
+    const double legacyUs = microsecondsPerBlock([&](float* const* ch, int n) { legacy.process(ch, n, params); });
+    std::printf("legacy,%.2f,1.00,%.0f\n", legacyUs, blockUs / legacyUs);
+
+    const std::pair<const char*, DelayInterpolation> modes[] = {
+        {"linear", DelayInterpolation::Linear},
+        {"cubic", DelayInterpolation::Cubic},
+        {"allpass", DelayInterpolation::Allpass},
+    };
+
+    for (const auto& [name, mode] : modes) {
+        TapeDelayEngine engine;
+        engine.prepare(sampleRate, BLOCK_SIZE, MAX_DELAY_MS * samplesPerMs);
+        params.interpolation = mode;
+
+        const double us = microsecondsPerBlock([&](float* const* ch, int n) {
+            engine.process(ch, NUM_CHANNELS, n, params);
+        });
+        std::printf("%s,%.2f,%.2f,%.0f\n", name, us, us / legacyUs, blockUs / us);
+    }
+
+    return 0;
+}
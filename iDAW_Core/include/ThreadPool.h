@@ -0,0 +1,96 @@
+/**
+ * ThreadPool.h - Worker pool for offline batch processing
+ *
+ * Side B only: batch analysis (groove extraction, progression diagnosis)
+ * fans work out over a fixed set of workers. Never call from the audio thread.
+ *
+ * Work is handed out one index at a time from an atomic counter, so uneven
+ * items (long and short MIDI files) balance across workers. Each call also
+ * passes a worker index in [0, size()) that callers use to pick per-thread
+ * scratch buffers without locking.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace iDAW {
+
+class ThreadPool {
+public:
+    /**
+     * @param numThreads Total workers including the calling thread
+     *                   (0 = std::thread::hardware_concurrency())
+     */
+    explicit ThreadPool(size_t numThreads = 0);
+    ~ThreadPool();
+
+    // Non-copyable
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Number of workers, counting the thread that calls parallelFor()
+     */
+    size_t size() const noexcept { return m_threads.size() + 1; }
+
+    /**
+     * Workers a parallelFor() with this maxWorkers uses: worker indices are
+     * in [0, workerCount(maxWorkers)). 0 means all of them.
+     */
+    size_t workerCount(size_t maxWorkers) const noexcept {
+        return maxWorkers == 0 ? size() : std::min(maxWorkers, size());
+    }
+
+    /**
+     * Run fn(index, worker) for every index in [0, count) and wait for all
+     * of them. The caller works too (as worker 0). Calls from inside a
+     * running job run serially on the calling worker instead of deadlocking.
+     *
+     * maxWorkers caps how many workers take part (0 = all), so callers can
+     * honour a requested thread count on a shared pool without creating
+     * threads. Larger values are clamped to size().
+     *
+     * If fn throws, no further indices are started, every worker finishes
+     * its current call, and the first exception is rethrown here. Indices
+     * already running or finished are not rolled back.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t, size_t)>& fn,
+                     size_t maxWorkers = 0);
+
+    /**
+     * Process-wide pool sized to the hardware
+     */
+    static ThreadPool& shared();
+
+private:
+    void workerLoop(size_t worker);
+    void runJob(size_t worker);
+
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_submitMutex;               // One job at a time
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+
+    const std::function<void(size_t, size_t)>* m_job = nullptr;
+    size_t m_jobCount = 0;
+    size_t m_jobWorkers = 0;                // Workers [0, m_jobWorkers) take part
+    uint64_t m_generation = 0;
+    std::atomic<size_t> m_nextIndex{0};
+    size_t m_activeWorkers = 0;
+    std::exception_ptr m_error;             // First exception thrown by the job
+    bool m_stopping = false;
+};
+
+} // namespace iDAW
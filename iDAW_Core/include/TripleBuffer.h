@@ -0,0 +1,82 @@
+/**
+ * TripleBuffer.h - Wait-free single-producer/single-consumer state publishing
+ *
+ * Passes whole snapshots (spectral frames, parameter masks) between the
+ * audio thread and the UI without either side ever blocking. Three
+ * preallocated buffers rotate between writer, reader and a shared middle
+ * slot; publish() and update() are a single atomic exchange each, and the
+ * reader always sees a complete frame written by one publish().
+ *
+ * Exactly one thread may write and one thread may read at a time. Callers
+ * with several writer (or reader) threads serialize them on their own side.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace iDAW {
+
+template<typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+
+    /** All three buffers start as copies of initial (e.g. presized vectors) */
+    explicit TripleBuffer(const T& initial)
+        : m_buffers{initial, initial, initial} {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    //==========================================================================
+    // Writer side
+    //==========================================================================
+
+    /**
+     * Buffer to fill before publish().
+     * Holds an older frame, not the last published one: write it completely.
+     */
+    T& writeBuffer() noexcept { return m_buffers[m_writeIndex]; }
+
+    /** Make the write buffer the latest frame (wait-free) */
+    void publish() noexcept {
+        const uint8_t previous = m_middle.exchange(
+            static_cast<uint8_t>(m_writeIndex | FRESH_BIT), std::memory_order_acq_rel);
+        m_writeIndex = previous & INDEX_MASK;
+    }
+
+    //==========================================================================
+    // Reader side
+    //==========================================================================
+
+    /**
+     * Take the latest published frame if there is one (wait-free).
+     * @return true if readBuffer() changed
+     */
+    bool update() noexcept {
+        if (!(m_middle.load(std::memory_order_relaxed) & FRESH_BIT)) {
+            return false;
+        }
+        const uint8_t previous = m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+        m_readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    /** Most recent frame taken by update() */
+    const T& readBuffer() const noexcept { return m_buffers[m_readIndex]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH_BIT = 0x4;
+
+    T m_buffers[3];
+
+    // Each side owns one index; the middle slot is shared
+    alignas(64) uint8_t m_writeIndex = 0;
+    alignas(64) std::atomic<uint8_t> m_middle{1};
+    alignas(64) uint8_t m_readIndex = 2;
+};
+
+} // namespace iDAW
@@ -12,6 +12,8 @@
 #include "../harmony/Chord.h"
 #include "../harmony/Progression.h"
 #include "../harmony/HarmonyEngine.h"
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
@@ -139,6 +141,123 @@ struct DiagnosticReport {
     std::string errorMessage;
 };
 
+/**
+ * Finding codes: one per issue, rule break or suggestion of a
+ * DiagnosticReport. The text is a function of the code, the chords and the
+ * key, so batch results store only codes and render text on request.
+ */
+enum class FindingCode : uint8_t {
+    ParseError,         // Issue + suggestion: the string did not parse
+    ModalInterchange,   // Rule break: non-diatonic chord
+    ParallelMotion,     // Rule break: parallel fourth/fifth into the chord
+    AvoidedResolution,  // Rule break: last chord is not the tonic
+    TritoneMotion,      // Issue: tritone root motion into the chord
+    ResolveToTonic,     // Suggestion: ends away from I and V
+    AddDominant,        // Suggestion: has a tonic but no V
+    PassingChord        // Suggestion: smooth the tritone motion into the chord
+};
+
+/**
+ * Get string name for finding code
+ */
+inline std::string findingCodeToString(FindingCode code) {
+    switch (code) {
+        case FindingCode::ParseError:        return "ParseError";
+        case FindingCode::ModalInterchange:  return "ModalInterchange";
+        case FindingCode::ParallelMotion:    return "ParallelMotion";
+        case FindingCode::AvoidedResolution: return "AvoidedResolution";
+        case FindingCode::TritoneMotion:     return "TritoneMotion";
+        case FindingCode::ResolveToTonic:    return "ResolveToTonic";
+        case FindingCode::AddDominant:       return "AddDominant";
+        case FindingCode::PassingChord:      return "PassingChord";
+        default:                             return "UNKNOWN";
+    }
+}
+
+/**
+ * Overall emotional character of a progression
+ */
+enum class EmotionalCharacter : uint8_t {
+    Unknown,
+    ComplexAmbiguous,
+    DarkIntrospective,
+    BittersweetMelancholic,
+    DrivingTension,
+    BrightUplifting,
+    BalancedVersatile
+};
+
+/**
+ * Get description for emotional character
+ */
+inline std::string emotionalCharacterToString(EmotionalCharacter character) {
+    switch (character) {
+        case EmotionalCharacter::ComplexAmbiguous:       return "complex, emotionally ambiguous";
+        case EmotionalCharacter::DarkIntrospective:      return "dark, introspective";
+        case EmotionalCharacter::BittersweetMelancholic: return "bittersweet, melancholic";
+        case EmotionalCharacter::DrivingTension:         return "driving, tension-filled";
+        case EmotionalCharacter::BrightUplifting:        return "bright, uplifting";
+        case EmotionalCharacter::BalancedVersatile:      return "balanced, versatile";
+        default:                                         return "unknown";
+    }
+}
+
+/**
+ * Columnar result of DiagnosticsEngine::diagnoseBatch()
+ *
+ * Per-progression columns are indexed by input position; chords and
+ * findings are flat columns sliced by chordStart/findingStart (size() + 1
+ * entries each). No strings are stored: chordName(), describe() and
+ * report() render them on request, identical to diagnose().
+ */
+struct BatchDiagnosis {
+    // Per progression
+    std::vector<uint8_t> success;         // 0 = could not parse
+    std::vector<Key> keys;
+    std::vector<float> complexity;
+    std::vector<uint8_t> hasResolution;
+    std::vector<EmotionalCharacter> character;
+    std::vector<uint32_t> chordStart;
+    std::vector<uint32_t> findingStart;
+    
+    // Per chord
+    std::vector<uint8_t> chordRoot;
+    std::vector<ChordQuality> chordQuality;
+    std::vector<int8_t> chordBass;        // -1 = no slash bass
+    
+    // Per finding, in report order
+    std::vector<FindingCode> findingCode;
+    std::vector<int32_t> findingChord;    // Chord index within the progression, -1 = none
+    
+    size_t size() const noexcept { return success.size(); }
+    size_t chordCount(size_t progression) const {
+        return chordStart[progression + 1] - chordStart[progression];
+    }
+    size_t findingCount(size_t progression) const {
+        return findingStart[progression + 1] - findingStart[progression];
+    }
+    
+    /**
+     * Chord of a progression (index within the progression)
+     */
+    Chord chord(size_t progression, size_t index) const;
+    
+    std::string chordName(size_t progression, size_t index) const {
+        return chord(progression, index).name();
+    }
+    
+    /**
+     * Text of a finding (index within the progression), as the issue
+     * description, RuleBreak::toString() or suggestion description
+     */
+    std::string describe(size_t progression, size_t finding) const;
+    
+    /**
+     * Full report, equal to DiagnosticsEngine::diagnose() of the same string
+     */
+    DiagnosticReport report(size_t progression) const;
+};
+
 /**
  * DiagnosticsEngine - Progression analysis and diagnostics
  */
@@ -163,6 +282,18 @@ public:
      */
     DiagnosticReport diagnose(const Progression& progression) const;
     
+    /**
+     * Diagnose many progression strings across a thread pool (Side B only)
+     *
+     * @param numThreads Workers of the shared pool to use (0 = all; larger
+     *                   counts are clamped to the hardware, no threads are
+     *                   created per call)
+     * @return Columnar results in input order; render strings on demand
+     */
+    BatchDiagnosis diagnoseBatch(
+        const std::vector<std::string>& progressions,
+        size_t numThreads = 0) const;
+    
     /**
      * Identify rule breaks in a progression
      */
@@ -198,22 +329,6 @@ public:
 private:
     DiagnosticsEngine() = default;
     ~DiagnosticsEngine() = default;
-    
-    // Internal analysis helpers
-    void analyzeVoiceLeading(
-        const Progression& progression,
-        std::vector<DiagnosticIssue>& issues) const;
-    
-    void analyzeBorrowedChords(
-        const Progression& progression,
-        const Key& key,
-        std::vector<RuleBreak>& ruleBreaks) const;
-    
-    void generateSuggestions(
-        const Progression& progression,
-        const Key& key,
-        const std::vector<DiagnosticIssue>& issues,
-        std::vector<DiagnosticSuggestion>& suggestions) const;
 };
 
 } // namespace diagnostics
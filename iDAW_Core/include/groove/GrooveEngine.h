@@ -53,6 +53,27 @@ struct MidiNote {
     int channel = 0;
 };
 
+class NoteBuffer;
+
+/**
+ * Reusable working buffers for groove extraction.
+ * Batch extraction keeps one per worker thread so steady-state extraction
+ * only allocates for the returned template.
+ */
+struct ExtractionScratch {
+    std::vector<float> deviations;
+    std::vector<int> velocities;
+    std::vector<int> noteCounts;
+};
+
+/**
+ * Result of extracting a groove from a MIDI file in a batch
+ */
+struct FileGrooveResult {
+    bool ok = false;                // False if the file could not be read/parsed
+    GrooveTemplate groove;
+};
+
 /**
  * GrooveEngine - Main groove processing interface
  * 
@@ -85,6 +106,41 @@ public:
         float tempoBpm,
         const ExtractionSettings& settings = ExtractionSettings{}) const;
     
+    /**
+     * Extract groove reusing caller-owned working buffers
+     */
+    GrooveTemplate extractGroove(
+        const std::vector<MidiNote>& notes,
+        int ppq,
+        float tempoBpm,
+        const ExtractionSettings& settings,
+        ExtractionScratch& scratch) const;
+    
+    /**
+     * Extract grooves from many note sets in parallel
+     * 
+     * @param noteSets One note vector per groove
+     * @param numThreads Workers of the shared pool to use (0 = all; at most the hardware)
+     * @return Templates in the same order as noteSets
+     */
+    std::vector<GrooveTemplate> extractGrooveBatch(
+        const std::vector<std::vector<MidiNote>>& noteSets,
+        int ppq,
+        float tempoBpm,
+        const ExtractionSettings& settings = ExtractionSettings{},
+        size_t numThreads = 0) const;
+    
+    /**
+     * Load MIDI files and extract their grooves in parallel
+     * 
+     * PPQ and tempo come from each file; each template is named after
+     * its file. Results are in the same order as paths.
+     */
+    std::vector<FileGrooveResult> extractGrooveFromFiles(
+        const std::vector<std::string>& paths,
+        const ExtractionSettings& settings = ExtractionSettings{},
+        size_t numThreads = 0) const;
+    
     /**
      * Apply groove to MIDI notes
      * 
@@ -99,6 +155,18 @@ public:
         int ppq,
         const ApplicationSettings& settings = ApplicationSettings{}) const;
     
+    /**
+     * Apply groove to a structure-of-arrays note buffer
+     * 
+     * Same result as the vector overload (velocities may differ by 1 from
+     * fixed-point blending), computed with SIMD kernels. Does not allocate.
+     */
+    void applyGroove(
+        NoteBuffer& notes,
+        const GrooveTemplate& groove,
+        int ppq,
+        const ApplicationSettings& settings = ApplicationSettings{}) const;
+    
     /**
      * Humanize MIDI notes (add subtle timing/velocity variations)
      * 
@@ -107,13 +175,33 @@ public:
      * @param vulnerability Vulnerability level (0.0-1.0)
      * @param ppq Pulses per quarter note
      * @param seed Random seed for reproducibility (-1 for random)
+     * @param firstNoteIndex Track index of notes[0]
+     * 
+     * Each note's variation depends only on (seed, note index), so a track
+     * humanized in blocks (passing each block's offset as firstNoteIndex)
+     * matches the same track humanized in one call.
      */
     void humanize(
         std::vector<MidiNote>& notes,
         float complexity,
         float vulnerability,
         int ppq,
-        int seed = -1) const;
+        int seed = -1,
+        size_t firstNoteIndex = 0) const;
+    
+    /**
+     * Humanize a structure-of-arrays note buffer
+     * 
+     * Same result as the vector overload for the same seed and indices.
+     * Does not allocate.
+     */
+    void humanize(
+        NoteBuffer& notes,
+        float complexity,
+        float vulnerability,
+        int ppq,
+        int seed = -1,
+        size_t firstNoteIndex = 0) const;
     
     /**
      * Calculate swing factor from notes
@@ -0,0 +1,214 @@
+/**
+ * GrooveLibrary.h - Binary groove template library format
+ *
+ * A groove library is one file holding any number of GrooveTemplates with
+ * their complete payload: timing deviations, velocity curve, events and
+ * statistics. The layout is designed to be memory-mapped and read in place:
+ *
+ *   [FileHeader]
+ *   [GrooveRecord x grooveCount]            fixed-size directory
+ *   [payload: float / int32 / EventRecord]  8-byte aligned arrays
+ *   [string table]                          names + source files (UTF-8)
+ *
+ * Integers are in the writer's native byte order so the file can be read in
+ * place; a reader whose order differs rejects it through ENDIAN_CHECK. Every
+ * offset is from the start of the file.
+ * Opening a file validates the header and directory bounds once (O(grooves))
+ * and never parses the payload - accessors return views into the mapping.
+ *
+ * Version history:
+ *   1 - Initial format
+ */
+
+#pragma once
+
+#include "GrooveTemplate.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace iDAW {
+namespace groove {
+
+namespace binary {
+
+constexpr char MAGIC[8] = {'I', 'D', 'A', 'W', 'G', 'R', 'V', '\0'};
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t ENDIAN_CHECK = 0x01020304;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;            // sizeof(FileHeader)
+    uint32_t grooveCount;
+    uint32_t recordSize;            // sizeof(GrooveRecord)
+    uint32_t eventSize;             // sizeof(EventRecord)
+    uint32_t endianCheck;           // ENDIAN_CHECK as written
+    uint64_t directoryOffset;
+    uint64_t stringTableOffset;
+    uint64_t stringTableSize;
+    uint64_t fileSize;
+};
+
+struct GrooveRecord {
+    uint32_t nameOffset;            // Into the string table
+    uint32_t nameLength;
+    uint32_t sourceFileOffset;
+    uint32_t sourceFileLength;
+
+    int32_t ppq;
+    float tempoBpm;
+    int32_t timeSignatureNum;
+    int32_t timeSignatureDenom;
+    float swingFactor;
+
+    // VelocityStats
+    int32_t velocityMin;
+    int32_t velocityMax;
+    float velocityMean;
+    float velocityStdDev;
+    int32_t ghostCount;
+    int32_t accentCount;
+
+    // TimingStats
+    float meanDeviationTicks;
+    float meanDeviationMs;
+    float maxDeviationTicks;
+    float maxDeviationMs;
+    float stdDeviationTicks;
+    float stdDeviationMs;
+
+    uint32_t deviationCount;
+    uint64_t deviationsOffset;      // float[deviationCount]
+    uint64_t velocityCurveOffset;   // int32_t[velocityCurveCount]
+    uint64_t eventsOffset;          // EventRecord[eventCount]
+    uint32_t velocityCurveCount;
+    uint32_t eventCount;
+};
+
+struct EventRecord {
+    int32_t pitch;
+    int32_t velocity;
+    int32_t startTick;
+    int32_t durationTicks;
+    int32_t channel;
+    float deviationTicks;
+    uint32_t flags;                 // EVENT_GHOST | EVENT_ACCENT
+    uint32_t reserved;
+};
+
+constexpr uint32_t EVENT_GHOST = 1u << 0;
+constexpr uint32_t EVENT_ACCENT = 1u << 1;
+
+static_assert(sizeof(FileHeader) == 64, "FileHeader layout is part of the format");
+static_assert(sizeof(GrooveRecord) == 120, "GrooveRecord layout is part of the format");
+static_assert(sizeof(EventRecord) == 32, "EventRecord layout is part of the format");
+
+} // namespace binary
+
+/**
+ * Read-only view of a contiguous array inside a groove library
+ */
+template<typename T>
+struct ArrayView {
+    const T* data = nullptr;
+    size_t size = 0;
+
+    const T* begin() const noexcept { return data; }
+    const T* end() const noexcept { return data + size; }
+    const T& operator[](size_t i) const noexcept { return data[i]; }
+    bool empty() const noexcept { return size == 0; }
+};
+
+/**
+ * GrooveLibraryFile - Zero-copy reader for binary groove libraries
+ *
+ * open() memory-maps the file; openFromMemory() reads a caller-owned buffer
+ * (which must stay alive and 8-byte aligned). Views returned by the
+ * accessors are valid until close() or destruction.
+ */
+class GrooveLibraryFile {
+public:
+    GrooveLibraryFile() = default;
+    ~GrooveLibraryFile();
+
+    GrooveLibraryFile(GrooveLibraryFile&& other) noexcept;
+    GrooveLibraryFile& operator=(GrooveLibraryFile&& other) noexcept;
+    GrooveLibraryFile(const GrooveLibraryFile&) = delete;
+    GrooveLibraryFile& operator=(const GrooveLibraryFile&) = delete;
+
+    /**
+     * Map a library file.
+     * @return false if the file cannot be mapped or fails validation
+     */
+    bool open(const std::string& path);
+
+    /** Use an in-memory library image (not copied) */
+    bool openFromMemory(const void* data, size_t size);
+
+    void close() noexcept;
+
+    bool isOpen() const noexcept { return m_header != nullptr; }
+    size_t size() const noexcept { return m_header ? m_header->grooveCount : 0; }
+    uint32_t version() const noexcept { return m_header ? m_header->version : 0; }
+
+    // Per-groove accessors (index < size())
+    const binary::GrooveRecord& record(size_t index) const noexcept { return m_records[index]; }
+    std::string_view name(size_t index) const noexcept;
+    std::string_view sourceFile(size_t index) const noexcept;
+    ArrayView<float> timingDeviations(size_t index) const noexcept;
+    ArrayView<int32_t> velocityCurve(size_t index) const noexcept;
+    ArrayView<binary::EventRecord> events(size_t index) const noexcept;
+
+    /** Index of the first groove with this name, or -1 */
+    int indexOf(std::string_view name) const noexcept;
+
+    /** Materialize one groove as an owning GrooveTemplate */
+    GrooveTemplate toTemplate(size_t index) const;
+
+    /** Materialize every groove */
+    std::vector<GrooveTemplate> loadAll() const;
+
+private:
+    bool validate(const uint8_t* base, size_t size) noexcept;
+    void unmap() noexcept;
+
+    const uint8_t* m_base = nullptr;
+    size_t m_size = 0;
+    const binary::FileHeader* m_header = nullptr;
+    const binary::GrooveRecord* m_records = nullptr;
+    const char* m_strings = nullptr;
+
+    // Mapping ownership (only set by open())
+    void* m_mapping = nullptr;
+    size_t m_mappingSize = 0;
+#if defined(_WIN32) || defined(_WIN64)
+    void* m_fileHandle = nullptr;
+    void* m_mapHandle = nullptr;
+#endif
+};
+
+/**
+ * Serialize grooves into a library image (the exact bytes save writes)
+ */
+std::vector<uint8_t> serializeGrooveLibrary(const std::vector<GrooveTemplate>& grooves);
+
+/**
+ * Write a groove library. The file is written to a temporary name next to
+ * the target, unique to this call, and renamed into place, so readers never
+ * see a partial library and concurrent saves to one path do not share a
+ * temporary file (the last rename wins).
+ */
+bool saveGrooveLibrary(const std::string& path, const std::vector<GrooveTemplate>& grooves);
+
+/**
+ * Bulk-load every groove from a library file
+ * @return std::nullopt if the file is missing or invalid
+ */
+std::optional<std::vector<GrooveTemplate>> loadGrooveLibrary(const std::string& path);
+
+} // namespace groove
+} // namespace iDAW
@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <optional>
 #include <cstdint>
 
 namespace iDAW {
@@ -121,6 +122,17 @@ public:
      */
     static GrooveTemplate fromMap(const std::map<std::string, std::string>& data);
     
+    /**
+     * Serialize with the full payload (a one-groove library, see GrooveLibrary.h)
+     */
+    std::vector<uint8_t> toBinary() const;
+    
+    /**
+     * Deserialize the first groove of a binary library image
+     * @return std::nullopt if the data is not a valid library
+     */
+    static std::optional<GrooveTemplate> fromBinary(const uint8_t* data, size_t size);
+    
     /**
      * Check if template is valid
      */
@@ -0,0 +1,42 @@
+/**
+ * MidiFileLoader.h - Standard MIDI File note loader for groove extraction
+ *
+ * Reads a .mid file into the flat MidiNote list GrooveEngine consumes:
+ * note-on/off pairs from every track merged and sorted by start tick,
+ * with PPQ and the first tempo of the file.
+ */
+
+#pragma once
+
+#include "GrooveEngine.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace iDAW {
+namespace groove {
+
+/**
+ * Notes and timing read from one MIDI file
+ */
+struct MidiFileNotes {
+    std::vector<MidiNote> notes;
+    int ppq = 480;
+    float tempoBpm = 120.0f;
+};
+
+/**
+ * Parse an in-memory Standard MIDI File.
+ * @param out Reused output (notes are cleared, capacity kept)
+ * @return false if the data is not a valid SMF
+ */
+bool parseMidiFileNotes(const uint8_t* data, size_t size, MidiFileNotes& out);
+
+/**
+ * Memory-map and parse a MIDI file (no intermediate file buffer).
+ * @return false if the file cannot be read or is not a valid SMF
+ */
+bool loadMidiFileNotes(const std::string& path, MidiFileNotes& out);
+
+} // namespace groove
+} // namespace iDAW
@@ -0,0 +1,72 @@
+/**
+ * NoteBuffer.h - Structure-of-arrays note storage for bulk groove processing
+ *
+ * Each note field lives in its own contiguous lane, so groove application
+ * runs as SIMD kernels over whole arrangements instead of per-note calls.
+ * The buffer also owns the scratch lanes those kernels need; after
+ * reserve()/resize() no groove operation on it allocates.
+ */
+
+#pragma once
+
+#include "GrooveEngine.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace iDAW {
+namespace groove {
+
+class NoteBuffer {
+public:
+    NoteBuffer() = default;
+    explicit NoteBuffer(const std::vector<MidiNote>& notes) { assign(notes); }
+
+    size_t size() const noexcept { return m_startTicks.size(); }
+    bool empty() const noexcept { return m_startTicks.empty(); }
+
+    void reserve(size_t count);
+    void resize(size_t count);
+    void clear() noexcept;
+
+    /** Append one note (allocates only when capacity is exceeded) */
+    void push_back(const MidiNote& note);
+
+    /** Replace contents with AoS notes */
+    void assign(const std::vector<MidiNote>& notes);
+
+    /** Read note i back as a MidiNote (start ticks saturate to the int range) */
+    MidiNote note(size_t index) const noexcept;
+
+    /** Write the buffer into an AoS vector (resizes out) */
+    void copyTo(std::vector<MidiNote>& out) const;
+
+    // Lanes
+    int64_t* startTicks() noexcept { return m_startTicks.data(); }
+    const int64_t* startTicks() const noexcept { return m_startTicks.data(); }
+    int32_t* durations() noexcept { return m_durations.data(); }
+    const int32_t* durations() const noexcept { return m_durations.data(); }
+    uint8_t* pitches() noexcept { return m_pitches.data(); }
+    const uint8_t* pitches() const noexcept { return m_pitches.data(); }
+    uint8_t* velocities() noexcept { return m_velocities.data(); }
+    const uint8_t* velocities() const noexcept { return m_velocities.data(); }
+    uint8_t* channels() noexcept { return m_channels.data(); }
+    const uint8_t* channels() const noexcept { return m_channels.data(); }
+
+    // Scratch lanes for kernels (contents undefined between calls)
+    int16_t* offsetScratch() noexcept { return m_offsetScratch.data(); }
+    uint8_t* velocityScratch() noexcept { return m_velocityScratch.data(); }
+
+private:
+    std::vector<int64_t> m_startTicks;
+    std::vector<int32_t> m_durations;
+    std::vector<uint8_t> m_pitches;
+    std::vector<uint8_t> m_velocities;
+    std::vector<uint8_t> m_channels;
+
+    std::vector<int16_t> m_offsetScratch;
+    std::vector<uint8_t> m_velocityScratch;
+};
+
+} // namespace groove
+} // namespace iDAW
@@ -9,6 +9,7 @@
 
 #include <array>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
 #include <cstdint>
@@ -123,7 +124,7 @@ public:
     /**
      * Parse chord from string (e.g., "Am7", "F#dim", "Cmaj7")
      */
-    static std::optional<Chord> fromString(const std::string& chordStr);
+    static std::optional<Chord> fromString(std::string_view chordStr);
     
     // Getters
     int root() const noexcept { return m_root; }
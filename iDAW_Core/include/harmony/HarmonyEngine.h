@@ -14,9 +14,11 @@
 #include "Chord.h"
 #include "Progression.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <memory>
+#include <optional>
 
 namespace iDAW {
 namespace harmony {
@@ -133,14 +135,43 @@ private:
 };
 
 /**
- * Utility: Parse chord from string
+ * ProgressionTokenizer - Splits a progression string into chord symbols
+ *
+ * Single pass over the text, no allocation: symbols are views into it.
+ * Delimiters are runs of '-', whitespace, '|', ',' and en/em dashes.
  */
-std::optional<Chord> parseChordString(const std::string& chordStr);
+class ProgressionTokenizer {
+public:
+    explicit ProgressionTokenizer(std::string_view text) noexcept : m_text(text) {}
+
+    /**
+     * Get the next chord symbol
+     * @return false once the text is exhausted
+     */
+    bool next(std::string_view& symbol) noexcept;
+
+private:
+    std::string_view m_text;
+    size_t m_pos = 0;
+};
+
+/**
+ * Utility: Parse chord from string (e.g., "Am7", "Bb/D"), without allocating
+ */
+std::optional<Chord> parseChordString(std::string_view chordStr);
 
 /**
  * Utility: Parse progression string into chords
+ * Symbols that are not chords are skipped.
+ */
+std::vector<Chord> parseProgressionString(std::string_view progressionStr);
+
+/**
+ * Utility: Parse progression string, appending the chords to out
+ * Allocation-free once out has the capacity, so out can be reused.
+ * @return Number of chords appended
  */
-std::vector<Chord> parseProgressionString(const std::string& progressionStr);
+size_t parseProgressionInto(std::string_view progressionStr, std::vector<Chord>& out);
 
 } // namespace harmony
 } // namespace iDAW
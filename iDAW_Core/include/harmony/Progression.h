@@ -8,6 +8,7 @@
 
 #include "Chord.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <optional>
@@ -91,7 +92,7 @@ public:
     /**
      * Parse progression from string (e.g., "F-C-Am-Dm")
      */
-    static std::optional<Progression> fromString(const std::string& progressionStr);
+    static std::optional<Progression> fromString(std::string_view progressionStr);
     
     // Accessors
     const std::vector<Chord>& chords() const noexcept { return m_chords; }
@@ -120,6 +121,12 @@ public:
      */
     Key detectKey() const;
     
+    /**
+     * Detect key from a chord list without building a Progression
+     * (no allocation; batch diagnosis calls this per progression)
+     */
+    static Key detectKey(const std::vector<Chord>& chords);
+    
     /**
      * Analyze and compute Roman numerals
      */
@@ -7,7 +7,9 @@
  * Uses FFT-based processing with linear phase response for transparent operation.
  * 
  * Features:
- * - 2048-sample FFT window for high frequency resolution
+ * - 2048-sample FFT window for high frequency resolution, or 512 / 128 for
+ *   low-latency tracking (any 512 - 4096 size at 4x or 8x overlap)
+ * - Stereo gated as one complex FFT (SpectralGateEngine)
  * - Spectral gating with AI-controlled threshold
  * - "Chalk Dust" particle visualization of erased frequencies
  * - Cursor-based frequency bin selection ("Eraser scrubbing")
@@ -17,25 +19,14 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include <array>
+#include "SpectralGateEngine.h"
+#include "TripleBuffer.h"
 #include <atomic>
 #include <vector>
-#include <complex>
-#include <memory>
+#include <mutex>
 
 namespace iDAW {
 
-/**
- * Configuration for the Eraser processor
- */
-struct EraserConfig {
-    static constexpr int FFT_ORDER = 11;                    // 2^11 = 2048 samples
-    static constexpr int FFT_SIZE = 1 << FFT_ORDER;         // 2048 samples
-    static constexpr int HOP_SIZE = FFT_SIZE / 4;           // 75% overlap (512 samples)
-    static constexpr int NUM_BINS = FFT_SIZE / 2 + 1;       // 1025 frequency bins
-    static constexpr float WINDOW_CORRECTION = 1.5f;        // Hann window correction factor
-};
-
 /**
  * Spectral bin state for visualization
  */
@@ -68,7 +59,7 @@ struct ChalkDustParticle {
  * 4. IFFT back to time domain
  * 5. Overlap-add with previous frames
  * 
- * The processor maintains a look-ahead buffer for linear phase operation.
+ * Output is delayed by one FFT size, reported to the host as latency.
  */
 class EraserProcessor : public juce::AudioProcessor {
 public:
@@ -134,6 +125,20 @@ public:
      */
     void setEraserCursor(float frequencyHz, float bandwidthHz, float intensity);
     
+    /**
+     * Select the FFT size and overlap (hop = fftSize / overlap) and report
+     * the new latency to the host. Takes effect at the next block.
+     * @param fftSize Power of two, 512 - 4096 (512 for low-latency tracking)
+     * @param overlap 4 or 8
+     * @return false (and no change) for an unsupported combination
+     */
+    bool setFftConfig(int fftSize, int overlap);
+    int getFftSize() const { return m_fftSize.load(); }
+    int getOverlap() const { return m_overlap.load(); }
+    
+    /** Number of frequency bins at the current FFT size */
+    int getNumBins() const { return m_fftSize.load() / 2 + 1; }
+    
     /**
      * Clear the eraser cursor (stop manual erasing)
      */
@@ -141,7 +146,7 @@ public:
     
     /**
      * Get spectral data for visualization
-     * Thread-safe copy of current FFT magnitudes
+     * Copy of the latest complete FFT frame; never blocks the audio thread.
      */
     std::vector<SpectralBinState> getSpectralState() const;
     
@@ -152,7 +157,7 @@ public:
     
     /**
      * Set frequency bins to erase (from UI scrubbing)
-     * @param binIndices Vector of bin indices to silence
+     * @param binIndices Vector of bin indices (at the current FFT size) to silence
      */
     void setErasedBins(const std::vector<int>& binIndices);
     
@@ -172,34 +177,15 @@ private:
     //==========================================================================
     
     /**
-     * Process a single channel through the spectral gate
-     */
-    void processChannel(int channel, float* samples, int numSamples);
-    
-    /**
-     * Apply Hann window to samples
-     */
-    void applyWindow(float* samples, int numSamples);
-    
-    /**
-     * Perform spectral gating on frequency domain data
-     */
-    void performSpectralGating(std::complex<float>* fftData);
-    
-    /**
-     * Convert bin index to frequency
-     */
-    float binToFrequency(int binIndex) const;
-    
-    /**
-     * Convert frequency to bin index
+     * Publish the engine's last frame to the UI and throw chalk dust
+     * from the bins it erased
      */
-    int frequencyToBin(float frequencyHz) const;
+    void publishSpectralFrame();
     
     /**
      * Generate chalk dust particles from erased bins
      */
-    void generateChalkDust(int binIndex, float magnitude);
+    void generateChalkDust(int binIndex, float magnitude, int numBins);
     
     /**
      * Update particle physics
@@ -212,31 +198,14 @@ private:
     void clearBuffers();
     
     //==========================================================================
-    // FFT
+    // Spectral Gate
     //==========================================================================
     
-    std::unique_ptr<juce::dsp::FFT> m_fft;
-    std::unique_ptr<juce::dsp::WindowingFunction<float>> m_window;
-    
-    //==========================================================================
-    // Processing Buffers
-    //==========================================================================
-    
-    // Input FIFO for overlap-add
-    std::array<std::vector<float>, 2> m_inputFIFO;     // Per channel
-    std::array<int, 2> m_inputFIFOIndex;
-    
-    // Output FIFO for overlap-add
-    std::array<std::vector<float>, 2> m_outputFIFO;    // Per channel
-    std::array<int, 2> m_outputFIFOIndex;
-    
-    // FFT working buffers
-    std::vector<float> m_fftBuffer;
-    std::vector<std::complex<float>> m_frequencyData;
+    SpectralGateEngine m_engine;
     
-    // Look-ahead buffer for linear phase
-    std::array<std::vector<float>, 2> m_lookAheadBuffer;
-    std::array<int, 2> m_lookAheadIndex;
+    // Requested FFT configuration (any thread writes, audio thread applies)
+    std::atomic<int> m_fftSize{EraserConfig::DEFAULT_FFT_SIZE};
+    std::atomic<int> m_overlap{EraserConfig::DEFAULT_OVERLAP};
     
     //==========================================================================
     // Parameters
@@ -251,16 +220,17 @@ private:
     std::atomic<float> m_eraserBandwidthHz{200.0f};
     std::atomic<float> m_eraserIntensity{1.0f};
     
-    // Manual bin erasure
-    std::vector<bool> m_erasedBins;
-    mutable std::mutex m_erasedBinsMutex;
+    // Manual bin erasure mask (UI writes, audio thread reads)
+    TripleBuffer<std::vector<uint8_t>> m_erasedBins;
+    std::mutex m_erasedBinsWriterMutex;  // Serializes UI writers only
     
     //==========================================================================
     // Visualization State
     //==========================================================================
     
-    std::vector<SpectralBinState> m_spectralState;
-    mutable std::mutex m_spectralStateMutex;
+    // Per-hop spectral frame (audio thread writes, UI reads)
+    mutable TripleBuffer<std::vector<SpectralBinState>> m_spectralState;
+    mutable std::mutex m_spectralStateReaderMutex;  // Serializes UI readers only
     
     std::vector<ChalkDustParticle> m_particles;
     mutable std::mutex m_particlesMutex;
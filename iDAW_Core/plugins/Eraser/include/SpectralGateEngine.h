@@ -0,0 +1,186 @@
+/**
+ * SpectralGateEngine.h - STFT core of "The Eraser"
+ *
+ * Hann-windowed overlap-add spectral gate with a runtime-selectable FFT size
+ * (512 - 4096) and overlap (4x or 8x):
+ *
+ *   1. Input is written twice into a 2N ring, so the latest N samples are
+ *      always one contiguous run: no per-hop copy with % indexing
+ *   2. Stereo is packed as z = w * (L + i R) and transformed with one complex
+ *      FFT; both channel spectra are split out of it for the gate decision
+ *   3. Each channel's bin gets its own real gain (threshold on that
+ *      channel's magnitude, manual mask, eraser cursor); the gated spectra
+ *      are repacked as gL L + i gR R, so one inverse complex FFT returns
+ *      L and R
+ *   4. Synthesis windowing (with the overlap normalization folded in) and
+ *      overlap-add into a contiguous accumulator that is compacted only once
+ *      every N / hop frames
+ *
+ * Latency is exactly one FFT size: 2048 samples by default, 512 in the
+ * low-latency tracking mode (512 / 128).
+ *
+ * Bin magnitudes are scaled to the former 2048-point analysis (JUCE's
+ * normalized Hann window), so thresholds and meters read the same in every
+ * mode. Transforms come from the shared daiw::dsp plans.
+ */
+
+#pragma once
+
+#include "daiw/fft.hpp"
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace iDAW {
+
+/**
+ * Configuration for the Eraser processor
+ */
+struct EraserConfig {
+    static constexpr int MIN_FFT_SIZE = 512;
+    static constexpr int MAX_FFT_SIZE = 4096;
+    static constexpr int MAX_BINS = MAX_FFT_SIZE / 2 + 1;    // 2049 frequency bins
+
+    // Overlap factor: hop = fftSize / overlap (Hann^2 overlap-adds flat from 4x)
+    static constexpr int MIN_OVERLAP = 4;
+    static constexpr int MAX_OVERLAP = 8;
+
+    // Default: 2048-sample window, 75% overlap (512-sample hop)
+    static constexpr int DEFAULT_FFT_SIZE = 2048;
+    static constexpr int DEFAULT_OVERLAP = 4;
+
+    // Low-latency tracking mode: 512-sample window, 128-sample hop
+    static constexpr int LOW_LATENCY_FFT_SIZE = 512;
+    static constexpr int LOW_LATENCY_OVERLAP = 4;
+
+    // Analysis size the threshold and meters are calibrated against
+    static constexpr int REFERENCE_FFT_SIZE = 2048;
+};
+
+/**
+ * Gate settings read once per process() call
+ */
+struct SpectralGateParams {
+    float thresholdLinear = 0.01f;      // Bins louder than this are erased
+    bool cursorActive = false;
+    float cursorCenterHz = 1000.0f;
+    float cursorBandwidthHz = 200.0f;
+    float cursorIntensity = 1.0f;
+};
+
+class SpectralGateEngine {
+public:
+    static constexpr int MAX_CHANNELS = 2;
+
+    SpectralGateEngine() = default;
+
+    SpectralGateEngine(const SpectralGateEngine&) = delete;
+    SpectralGateEngine& operator=(const SpectralGateEngine&) = delete;
+
+    /** True for the power-of-two sizes and overlaps setFftConfig() accepts */
+    static bool isValidConfig(int fftSize, int overlap) noexcept;
+
+    /** Latency (samples) of a configuration: one FFT size */
+    static constexpr int latencyForFftSize(int fftSize) noexcept { return fftSize; }
+
+    /**
+     * Look up every FFT plan and window and allocate for MAX_FFT_SIZE.
+     * Not RT-safe. Keeps the current FFT configuration.
+     */
+    void prepare(double sampleRate);
+
+    /** Clear the FIFOs, the overlap-add accumulator and the last frame */
+    void reset() noexcept;
+
+    /**
+     * Switch FFT size and overlap without allocating (RT-safe after
+     * prepare()). Clears the FIFOs when the configuration changes.
+     * @return false (and no change) for an invalid configuration
+     */
+    bool setFftConfig(int fftSize, int overlap) noexcept;
+
+    int getFftSize() const noexcept { return m_fftSize; }
+    int getOverlap() const noexcept { return m_overlap; }
+    int getHopSize() const noexcept { return m_fftSize / m_overlap; }
+    int getNumBins() const noexcept { return m_fftSize / 2 + 1; }
+    int getLatencySamples() const noexcept { return latencyForFftSize(m_fftSize); }
+
+    void setParameters(const SpectralGateParams& params) noexcept { m_params = params; }
+    const SpectralGateParams& getParameters() const noexcept { return m_params; }
+
+    /**
+     * Manual erase mask: one byte per bin (at least getNumBins()), nonzero =
+     * erase. Must stay valid until the next process() call; nullptr = none.
+     */
+    void setErasedBins(const uint8_t* mask) noexcept { m_erasedBins = mask; }
+
+    /**
+     * Gate up to MAX_CHANNELS channels in place (output delayed by
+     * getLatencySamples()). Runs one frame every getHopSize() samples.
+     * @return Number of frames processed during this call
+     */
+    int process(float* const* channels, int numChannels, int numSamples) noexcept;
+
+    //==========================================================================
+    // Last Frame (getNumBins() values each)
+    //==========================================================================
+
+    /** One channel's bin magnitudes before gating, reference-scaled */
+    const float* getMagnitudes(int channel) const noexcept { return m_magnitude[channel].data(); }
+
+    /** Erase amount applied to each of one channel's bins (0 = untouched, 1 = silenced) */
+    const float* getErasure(int channel) const noexcept { return m_erasure[channel].data(); }
+
+    /** One channel's spectrum before gating (unscaled) */
+    const std::complex<float>* getSpectrum(int channel) const noexcept { return m_spectrum[channel].data(); }
+
+    float binToFrequency(int bin) const noexcept;
+    int frequencyToBin(float frequencyHz) const noexcept;
+
+private:
+    /** Window, transform, gate and overlap-add the frame ending at the current hop */
+    void processFrame() noexcept;
+
+    /** Compute and apply per-bin gains to the packed spectrum in m_frame */
+    void gateSpectrum() noexcept;
+
+    const float* window() const noexcept { return m_windows.data() + (m_fftSize - EraserConfig::MIN_FFT_SIZE); }
+
+    double m_sampleRate = 44100.0;
+    int m_fftSize = EraserConfig::DEFAULT_FFT_SIZE;
+    int m_overlap = EraserConfig::DEFAULT_OVERLAP;
+    bool m_prepared = false;
+
+    SpectralGateParams m_params;
+    const uint8_t* m_erasedBins = nullptr;
+
+    // Shared plans, one per supported size (index log2(size / MIN_FFT_SIZE))
+    static constexpr int NUM_SIZES = 4;
+    std::array<const daiw::dsp::FftPlan*, NUM_SIZES> m_plans{};
+    const daiw::dsp::FftPlan* m_fft = nullptr;
+
+    // Periodic Hann windows for every size back to back: size N starts at N - MIN_FFT_SIZE
+    std::vector<float> m_windows;
+    float m_synthesisGain = 1.0f;               // 1 / sum of overlapping Hann^2
+
+    // Input: 2N ring written twice; m_inputPos is the start of the current hop
+    std::array<std::vector<float>, MAX_CHANNELS> m_input;
+    int m_inputPos = 0;
+    int m_hopFill = 0;
+
+    // Output: overlap-add accumulator (2N), live region [m_outputBase, + N);
+    // the first hop of it is the output being played out
+    std::array<std::vector<float>, MAX_CHANNELS> m_output;
+    int m_outputBase = 0;
+
+    // Packed stereo frame, N complex points
+    std::vector<std::complex<float>> m_frame;
+
+    // Last frame
+    std::array<std::vector<std::complex<float>>, MAX_CHANNELS> m_spectrum;
+    std::array<std::vector<float>, MAX_CHANNELS> m_magnitude;
+    std::array<std::vector<float>, MAX_CHANNELS> m_erasure;
+};
+
+} // namespace iDAW
@@ -4,9 +4,10 @@
  * Profile: 'Digital Surgeon' (Transparent, Linear Phase)
  * 
  * Implements spectral gating with:
- * - 2048-sample FFT with 75% overlap
+ * - Selectable FFT size / overlap (2048 with 75% overlap by default)
  * - Hann windowing for smooth transitions
- * - Linear phase processing via look-ahead buffer
+ * - Stereo packed into one complex FFT (SpectralGateEngine)
+ * - Latency of one FFT size, reported to the host per mode
  * - AI-controlled threshold
  * - Visual feedback via "Chalk Dust" particles
  */
@@ -15,6 +16,7 @@
 #include <cmath>
 #include <algorithm>
 #include <random>
+#include <cstring>
 
 namespace iDAW {
 
@@ -26,21 +28,10 @@ EraserProcessor::EraserProcessor()
     : AudioProcessor(BusesProperties()
                      .withInput("Input", juce::AudioChannelSet::stereo(), true)
                      .withOutput("Output", juce::AudioChannelSet::stereo(), true))
+    , m_erasedBins(std::vector<uint8_t>(EraserConfig::MAX_BINS, 0))
+    , m_spectralState(std::vector<SpectralBinState>(EraserConfig::MAX_BINS, SpectralBinState{}))
 {
-    // Initialize FFT
-    m_fft = std::make_unique<juce::dsp::FFT>(EraserConfig::FFT_ORDER);
-    
-    // Initialize Hann window
-    m_window = std::make_unique<juce::dsp::WindowingFunction<float>>(
-        EraserConfig::FFT_SIZE,
-        juce::dsp::WindowingFunction<float>::hann
-    );
-    
-    // Allocate buffers
-    m_fftBuffer.resize(EraserConfig::FFT_SIZE * 2);  // Real + Imaginary interleaved
-    m_frequencyData.resize(EraserConfig::NUM_BINS);
-    m_spectralState.resize(EraserConfig::NUM_BINS);
-    m_erasedBins.resize(EraserConfig::NUM_BINS, false);
+    setLatencySamples(SpectralGateEngine::latencyForFftSize(EraserConfig::DEFAULT_FFT_SIZE));
     
     // Reserve particle storage
     m_particles.reserve(MAX_PARTICLES);
@@ -56,29 +47,16 @@ void EraserProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
     m_sampleRate = sampleRate;
     m_samplesPerBlock = samplesPerBlock;
     
-    // Initialize per-channel buffers
-    for (int ch = 0; ch < 2; ++ch) {
-        m_inputFIFO[ch].resize(EraserConfig::FFT_SIZE, 0.0f);
-        m_inputFIFOIndex[ch] = 0;
-        
-        m_outputFIFO[ch].resize(EraserConfig::FFT_SIZE, 0.0f);
-        m_outputFIFOIndex[ch] = 0;
-        
-        // Look-ahead buffer = half FFT size for linear phase
-        m_lookAheadBuffer[ch].resize(EraserConfig::FFT_SIZE / 2, 0.0f);
-        m_lookAheadIndex[ch] = 0;
-    }
-    
-    // Clear FFT buffer
-    std::fill(m_fftBuffer.begin(), m_fftBuffer.end(), 0.0f);
+    // Plans and windows for every FFT size, so mode changes never allocate
+    m_engine.setFftConfig(m_fftSize.load(), m_overlap.load());
+    m_engine.prepare(sampleRate);
+    setLatencySamples(m_engine.getLatencySamples());
     
-    // Reset spectral state
-    for (auto& state : m_spectralState) {
-        state.magnitude = 0.0f;
-        state.phase = 0.0f;
-        state.erased = false;
-        state.eraserIntensity = 0.0f;
-    }
+    // Publish a silent spectral frame
+    auto& spectralState = m_spectralState.writeBuffer();
+    spectralState.resize(static_cast<size_t>(m_engine.getNumBins()));
+    std::fill(spectralState.begin(), spectralState.end(), SpectralBinState{});
+    m_spectralState.publish();
     
     m_prepared = true;
 }
@@ -94,183 +72,69 @@ void EraserProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     
     juce::ScopedNoDenormals noDenormals;
     
-    const int numChannels = buffer.getNumChannels();
+    const int numChannels = std::min(buffer.getNumChannels(), SpectralGateEngine::MAX_CHANNELS);
     const int numSamples = buffer.getNumSamples();
     
-    // Process each channel
-    for (int channel = 0; channel < std::min(numChannels, 2); ++channel) {
-        float* channelData = buffer.getWritePointer(channel);
-        processChannel(channel, channelData, numSamples);
+    // Pick up a new FFT size / overlap (clears the FIFOs, no allocation)
+    m_engine.setFftConfig(m_fftSize.load(), m_overlap.load());
+    
+    SpectralGateParams params;
+    params.thresholdLinear = m_thresholdLinear.load();
+    params.cursorActive = m_eraserActive.load();
+    params.cursorCenterHz = m_eraserCenterHz.load();
+    params.cursorBandwidthHz = m_eraserBandwidthHz.load();
+    params.cursorIntensity = m_eraserIntensity.load();
+    m_engine.setParameters(params);
+    
+    // Latest erased-bin mask from the UI
+    m_erasedBins.update();
+    m_engine.setErasedBins(m_erasedBins.readBuffer().data());
+    
+    // Both channels through one complex FFT per hop
+    if (m_engine.process(buffer.getArrayOfWritePointers(), numChannels, numSamples) > 0) {
+        publishSpectralFrame();
     }
     
     // Update particles
     updateParticles(static_cast<float>(numSamples) / static_cast<float>(m_sampleRate));
 }
 
-void EraserProcessor::processChannel(int channel, float* samples, int numSamples) {
-    auto& inputFIFO = m_inputFIFO[channel];
-    auto& outputFIFO = m_outputFIFO[channel];
-    auto& lookAhead = m_lookAheadBuffer[channel];
-    int& inputIndex = m_inputFIFOIndex[channel];
-    int& outputIndex = m_outputFIFOIndex[channel];
-    int& lookAheadIdx = m_lookAheadIndex[channel];
-    
-    for (int i = 0; i < numSamples; ++i) {
-        // Store input sample in FIFO
-        inputFIFO[inputIndex] = samples[i];
-        
-        // Output from look-ahead buffer (introduces latency for linear phase)
-        float outputSample = lookAhead[lookAheadIdx];
-        
-        // Store processed output in look-ahead buffer
-        lookAhead[lookAheadIdx] = outputFIFO[outputIndex];
-        
-        // Clear the output FIFO position we just read
-        outputFIFO[outputIndex] = 0.0f;
-        
-        // Output the delayed sample
-        samples[i] = outputSample;
-        
-        // Advance indices
-        inputIndex = (inputIndex + 1) % EraserConfig::FFT_SIZE;
-        outputIndex = (outputIndex + 1) % EraserConfig::FFT_SIZE;
-        lookAheadIdx = (lookAheadIdx + 1) % (EraserConfig::FFT_SIZE / 2);
-        
-        // Check if we have enough samples for FFT
-        if (inputIndex % EraserConfig::HOP_SIZE == 0) {
-            // Copy input FIFO to FFT buffer (with proper ordering)
-            for (int j = 0; j < EraserConfig::FFT_SIZE; ++j) {
-                int idx = (inputIndex + j) % EraserConfig::FFT_SIZE;
-                m_fftBuffer[j] = inputFIFO[idx];
-            }
-            
-            // Apply window
-            applyWindow(m_fftBuffer.data(), EraserConfig::FFT_SIZE);
-            
-            // Perform FFT (in-place, real-to-complex)
-            m_fft->performRealOnlyForwardTransform(m_fftBuffer.data());
-            
-            // Convert to complex for processing
-            for (int bin = 0; bin < EraserConfig::NUM_BINS; ++bin) {
-                float real = m_fftBuffer[bin * 2];
-                float imag = m_fftBuffer[bin * 2 + 1];
-                m_frequencyData[bin] = std::complex<float>(real, imag);
-            }
-            
-            // Perform spectral gating
-            performSpectralGating(m_frequencyData.data());
-            
-            // Convert back for IFFT
-            for (int bin = 0; bin < EraserConfig::NUM_BINS; ++bin) {
-                m_fftBuffer[bin * 2] = m_frequencyData[bin].real();
-                m_fftBuffer[bin * 2 + 1] = m_frequencyData[bin].imag();
-            }
-            
-            // Perform IFFT
-            m_fft->performRealOnlyInverseTransform(m_fftBuffer.data());
-            
-            // Apply window again for overlap-add
-            applyWindow(m_fftBuffer.data(), EraserConfig::FFT_SIZE);
-            
-            // Add to output FIFO (overlap-add)
-            for (int j = 0; j < EraserConfig::FFT_SIZE; ++j) {
-                int idx = (outputIndex + j) % EraserConfig::FFT_SIZE;
-                outputFIFO[idx] += m_fftBuffer[j] * EraserConfig::WINDOW_CORRECTION / 
-                                   static_cast<float>(EraserConfig::FFT_SIZE);
-            }
-        }
-    }
-}
-
-void EraserProcessor::applyWindow(float* samples, int numSamples) {
-    m_window->multiplyWithWindowingTable(samples, numSamples);
-}
-
-void EraserProcessor::performSpectralGating(std::complex<float>* fftData) {
-    const float threshold = m_thresholdLinear.load();
-    const bool eraserActive = m_eraserActive.load();
-    const float eraserCenterHz = m_eraserCenterHz.load();
-    const float eraserBandwidthHz = m_eraserBandwidthHz.load();
-    const float eraserIntensity = m_eraserIntensity.load();
+void EraserProcessor::publishSpectralFrame() {
+    const int numBins = m_engine.getNumBins();
+    const float* magnitudesLeft = m_engine.getMagnitudes(0);
+    const float* magnitudesRight = m_engine.getMagnitudes(1);
+    const float* erasureLeft = m_engine.getErasure(0);
+    const float* erasureRight = m_engine.getErasure(1);
     
-    // Calculate eraser bin range
-    int eraserCenterBin = frequencyToBin(eraserCenterHz);
-    int eraserWidthBins = frequencyToBin(eraserBandwidthHz) - frequencyToBin(0.0f);
-    int eraserMinBin = std::max(0, eraserCenterBin - eraserWidthBins / 2);
-    int eraserMaxBin = std::min(EraserConfig::NUM_BINS - 1, eraserCenterBin + eraserWidthBins / 2);
+    // Presized to MAX_BINS, so this never reallocates
+    std::vector<SpectralBinState>& spectralState = m_spectralState.writeBuffer();
+    spectralState.resize(static_cast<size_t>(numBins));
     
-    // Lock for spectral state update
-    std::lock_guard<std::mutex> stateLock(m_spectralStateMutex);
-    
-    // Lock for erased bins check
-    std::lock_guard<std::mutex> binsLock(m_erasedBinsMutex);
-    
-    for (int bin = 0; bin < EraserConfig::NUM_BINS; ++bin) {
-        float magnitude = std::abs(fftData[bin]);
-        float phase = std::arg(fftData[bin]);
+    for (int bin = 0; bin < numBins; ++bin) {
+        // Channels are gated independently; show the louder one
+        const int channel = magnitudesRight[bin] > magnitudesLeft[bin] ? 1 : 0;
+        const float magnitude = std::max(magnitudesLeft[bin], magnitudesRight[bin]);
         
         // Normalize magnitude for visualization
-        float normalizedMag = std::min(magnitude / 100.0f, 1.0f);
-        
-        // Update spectral state
-        m_spectralState[bin].magnitude = normalizedMag;
-        m_spectralState[bin].phase = phase;
-        
-        bool shouldErase = false;
-        float eraseAmount = 0.0f;
-        
-        // Check threshold gating
-        if (magnitude > threshold) {
-            shouldErase = true;
-            eraseAmount = 1.0f;
-        }
-        
-        // Check manual bin erasure
-        if (m_erasedBins[bin]) {
-            shouldErase = true;
-            eraseAmount = 1.0f;
-        }
-        
-        // Check eraser cursor
-        if (eraserActive && bin >= eraserMinBin && bin <= eraserMaxBin) {
-            // Smooth falloff at edges
-            float distFromCenter = std::abs(bin - eraserCenterBin) / 
-                                   static_cast<float>(eraserWidthBins / 2 + 1);
-            float cursorAmount = (1.0f - distFromCenter) * eraserIntensity;
-            
-            if (cursorAmount > eraseAmount) {
-                shouldErase = true;
-                eraseAmount = cursorAmount;
-            }
-        }
+        spectralState[bin].magnitude = std::min(magnitude / 100.0f, 1.0f);
+        spectralState[bin].phase = std::arg(m_engine.getSpectrum(channel)[bin]);
         
-        // Apply erasure
-        if (shouldErase && eraseAmount > 0.0f) {
+        const float eraseAmount = std::max(erasureLeft[bin], erasureRight[bin]);
+        if (eraseAmount > 0.0f) {
             // Generate chalk dust particles for visual feedback
             if (magnitude > 0.01f) {
-                generateChalkDust(bin, magnitude * eraseAmount);
+                generateChalkDust(bin, magnitude * eraseAmount, numBins);
             }
             
-            // Erase the frequency content (multiply by complement of erase amount)
-            fftData[bin] *= (1.0f - eraseAmount);
-            
-            m_spectralState[bin].erased = true;
-            m_spectralState[bin].eraserIntensity = eraseAmount;
+            spectralState[bin].erased = true;
+            spectralState[bin].eraserIntensity = eraseAmount;
         } else {
-            m_spectralState[bin].erased = false;
-            m_spectralState[bin].eraserIntensity = 0.0f;
+            spectralState[bin].erased = false;
+            spectralState[bin].eraserIntensity = 0.0f;
         }
     }
-}
-
-float EraserProcessor::binToFrequency(int binIndex) const {
-    return static_cast<float>(binIndex) * static_cast<float>(m_sampleRate) / 
-           static_cast<float>(EraserConfig::FFT_SIZE);
-}
-
-int EraserProcessor::frequencyToBin(float frequencyHz) const {
-    return static_cast<int>(frequencyHz * static_cast<float>(EraserConfig::FFT_SIZE) / 
-                            static_cast<float>(m_sampleRate));
+    
+    m_spectralState.publish();
 }
 
 //==============================================================================
@@ -300,35 +164,47 @@ void EraserProcessor::clearEraserCursor() {
     m_eraserActive.store(false);
 }
 
-void EraserProcessor::setErasedBins(const std::vector<int>& binIndices) {
-    std::lock_guard<std::mutex> lock(m_erasedBinsMutex);
+bool EraserProcessor::setFftConfig(int fftSize, int overlap) {
+    if (!SpectralGateEngine::isValidConfig(fftSize, overlap)) return false;
     
-    // Clear previous
-    std::fill(m_erasedBins.begin(), m_erasedBins.end(), false);
+    m_fftSize.store(fftSize);
+    m_overlap.store(overlap);
+    setLatencySamples(SpectralGateEngine::latencyForFftSize(fftSize));
+    return true;
+}
+
+void EraserProcessor::setErasedBins(const std::vector<int>& binIndices) {
+    std::lock_guard<std::mutex> lock(m_erasedBinsWriterMutex);
     
-    // Set new
+    // Build the whole mask, then hand it to the audio thread in one step
+    auto& mask = m_erasedBins.writeBuffer();
+    std::fill(mask.begin(), mask.end(), 0);
     for (int bin : binIndices) {
-        if (bin >= 0 && bin < EraserConfig::NUM_BINS) {
-            m_erasedBins[bin] = true;
+        if (bin >= 0 && bin < EraserConfig::MAX_BINS) {
+            mask[bin] = 1;
         }
     }
+    m_erasedBins.publish();
 }
 
 void EraserProcessor::clearErasedBins() {
-    std::lock_guard<std::mutex> lock(m_erasedBinsMutex);
-    std::fill(m_erasedBins.begin(), m_erasedBins.end(), false);
+    std::lock_guard<std::mutex> lock(m_erasedBinsWriterMutex);
+    auto& mask = m_erasedBins.writeBuffer();
+    std::fill(mask.begin(), mask.end(), 0);
+    m_erasedBins.publish();
 }
 
 std::vector<SpectralBinState> EraserProcessor::getSpectralState() const {
-    std::lock_guard<std::mutex> lock(m_spectralStateMutex);
-    return m_spectralState;
+    std::lock_guard<std::mutex> lock(m_spectralStateReaderMutex);
+    m_spectralState.update();
+    return m_spectralState.readBuffer();
 }
 
 //==============================================================================
 // Chalk Dust Particle System
 //==============================================================================
 
-void EraserProcessor::generateChalkDust(int binIndex, float magnitude) {
+void EraserProcessor::generateChalkDust(int binIndex, float magnitude, int numBins) {
     std::lock_guard<std::mutex> lock(m_particlesMutex);
     
     if (m_particles.size() >= MAX_PARTICLES) {
@@ -342,8 +218,7 @@ void EraserProcessor::generateChalkDust(int binIndex, float magnitude) {
     static std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
     
     // Create particle at frequency position
-    float freq = binToFrequency(binIndex);
-    float normalizedX = static_cast<float>(binIndex) / static_cast<float>(EraserConfig::NUM_BINS);
+    float normalizedX = static_cast<float>(binIndex) / static_cast<float>(numBins);
     
     ChalkDustParticle particle;
     particle.x = normalizedX;
@@ -398,19 +273,8 @@ void EraserProcessor::playbackStopped() {
 }
 
 void EraserProcessor::clearBuffers() {
-    // Clear all FIFOs and look-ahead buffers
-    for (int ch = 0; ch < 2; ++ch) {
-        std::fill(m_inputFIFO[ch].begin(), m_inputFIFO[ch].end(), 0.0f);
-        std::fill(m_outputFIFO[ch].begin(), m_outputFIFO[ch].end(), 0.0f);
-        std::fill(m_lookAheadBuffer[ch].begin(), m_lookAheadBuffer[ch].end(), 0.0f);
-        
-        m_inputFIFOIndex[ch] = 0;
-        m_outputFIFOIndex[ch] = 0;
-        m_lookAheadIndex[ch] = 0;
-    }
-    
-    // Clear FFT buffer
-    std::fill(m_fftBuffer.begin(), m_fftBuffer.end(), 0.0f);
+    // Clear the FIFOs and overlap-add accumulator
+    m_engine.reset();
     
     // Clear particles
     {
@@ -420,8 +284,8 @@ void EraserProcessor::clearBuffers() {
 }
 
 double EraserProcessor::getTailLengthSeconds() const {
-    // Look-ahead latency
-    return static_cast<double>(EraserConfig::FFT_SIZE) / m_sampleRate;
+    // One FFT frame
+    return static_cast<double>(m_fftSize.load()) / m_sampleRate;
 }
 
 //==============================================================================
@@ -429,9 +293,12 @@ double EraserProcessor::getTailLengthSeconds() const {
 //==============================================================================
 
 void EraserProcessor::getStateInformation(juce::MemoryBlock& destData) {
-    // Save threshold
+    // Save threshold, then the FFT configuration
     float threshold = m_thresholdDb.load();
     destData.append(&threshold, sizeof(float));
+    
+    const int fftConfig[2] = {m_fftSize.load(), m_overlap.load()};
+    destData.append(fftConfig, sizeof(fftConfig));
 }
 
 void EraserProcessor::setStateInformation(const void* data, int sizeInBytes) {
@@ -440,6 +307,13 @@ void EraserProcessor::setStateInformation(const void* data, int sizeInBytes) {
         std::memcpy(&threshold, data, sizeof(float));
         setThreshold(threshold);
     }
+    
+    // States saved before the FFT size was selectable stop after the threshold
+    if (sizeInBytes >= static_cast<int>(sizeof(float) + 2 * sizeof(int))) {
+        int fftConfig[2];
+        std::memcpy(fftConfig, static_cast<const char*>(data) + sizeof(float), sizeof(fftConfig));
+        setFftConfig(fftConfig[0], fftConfig[1]);
+    }
 }
 
 //==============================================================================
@@ -0,0 +1,255 @@
+/**
+ * SpectralGateEngine.cpp - STFT core of "The Eraser"
+ */
+
+#include "SpectralGateEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace iDAW {
+
+bool SpectralGateEngine::isValidConfig(int fftSize, int overlap) noexcept {
+    const auto isPowerOfTwo = [](int n) { return n > 0 && (n & (n - 1)) == 0; };
+    return isPowerOfTwo(fftSize) && fftSize >= EraserConfig::MIN_FFT_SIZE && fftSize <= EraserConfig::MAX_FFT_SIZE
+        && isPowerOfTwo(overlap) && overlap >= EraserConfig::MIN_OVERLAP && overlap <= EraserConfig::MAX_OVERLAP;
+}
+
+void SpectralGateEngine::prepare(double sampleRate) {
+    m_sampleRate = sampleRate;
+
+    for (int i = 0; i < NUM_SIZES; ++i) {
+        m_plans[static_cast<size_t>(i)] = daiw::dsp::fft_plan(static_cast<size_t>(EraserConfig::MIN_FFT_SIZE << i));
+    }
+
+    // Periodic Hann, so Hann^2 overlap-adds to a constant
+    m_windows.assign(static_cast<size_t>(2 * EraserConfig::MAX_FFT_SIZE - EraserConfig::MIN_FFT_SIZE), 0.0f);
+    for (int size = EraserConfig::MIN_FFT_SIZE; size <= EraserConfig::MAX_FFT_SIZE; size *= 2) {
+        float* w = m_windows.data() + (size - EraserConfig::MIN_FFT_SIZE);
+        for (int n = 0; n < size; ++n) {
+            w[n] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * M_PI * n / size));
+        }
+    }
+
+    for (int channel = 0; channel < MAX_CHANNELS; ++channel) {
+        m_input[channel].assign(2 * EraserConfig::MAX_FFT_SIZE, 0.0f);
+        m_output[channel].assign(2 * EraserConfig::MAX_FFT_SIZE, 0.0f);
+        m_spectrum[channel].assign(EraserConfig::MAX_BINS, {});
+    }
+    m_frame.assign(EraserConfig::MAX_FFT_SIZE, {});
+    for (int channel = 0; channel < MAX_CHANNELS; ++channel) {
+        m_magnitude[channel].assign(EraserConfig::MAX_BINS, 0.0f);
+        m_erasure[channel].assign(EraserConfig::MAX_BINS, 0.0f);
+    }
+
+    m_prepared = true;
+
+    const int fftSize = m_fftSize;
+    const int overlap = m_overlap;
+    m_fft = nullptr;
+    setFftConfig(fftSize, overlap);
+}
+
+void SpectralGateEngine::reset() noexcept {
+    if (!m_prepared) return;
+
+    for (int channel = 0; channel < MAX_CHANNELS; ++channel) {
+        std::fill(m_input[channel].begin(), m_input[channel].end(), 0.0f);
+        std::fill(m_output[channel].begin(), m_output[channel].end(), 0.0f);
+        std::fill(m_spectrum[channel].begin(), m_spectrum[channel].end(), std::complex<float>{});
+    }
+    for (int channel = 0; channel < MAX_CHANNELS; ++channel) {
+        std::fill(m_magnitude[channel].begin(), m_magnitude[channel].end(), 0.0f);
+        std::fill(m_erasure[channel].begin(), m_erasure[channel].end(), 0.0f);
+    }
+
+    m_inputPos = 0;
+    m_hopFill = 0;
+    m_outputBase = 0;
+}
+
+bool SpectralGateEngine::setFftConfig(int fftSize, int overlap) noexcept {
+    if (!isValidConfig(fftSize, overlap)) return false;
+    if (fftSize == m_fftSize && overlap == m_overlap && m_fft) return true;
+
+    m_fftSize = fftSize;
+    m_overlap = overlap;
+    if (!m_prepared) return true;
+
+    int sizeIndex = 0;
+    while ((EraserConfig::MIN_FFT_SIZE << sizeIndex) < fftSize) ++sizeIndex;
+    m_fft = m_plans[static_cast<size_t>(sizeIndex)];
+
+    // Hann^2 summed over the frames overlapping any one sample
+    const float* w = window();
+    const int hop = getHopSize();
+    float overlapSum = 0.0f;
+    for (int n = 0; n < fftSize; n += hop) overlapSum += w[n] * w[n];
+    m_synthesisGain = 1.0f / overlapSum;
+
+    reset();
+    return true;
+}
+
+float SpectralGateEngine::binToFrequency(int bin) const noexcept {
+    return static_cast<float>(bin) * static_cast<float>(m_sampleRate) / static_cast<float>(m_fftSize);
+}
+
+int SpectralGateEngine::frequencyToBin(float frequencyHz) const noexcept {
+    return static_cast<int>(frequencyHz * static_cast<float>(m_fftSize) / static_cast<float>(m_sampleRate));
+}
+
+int SpectralGateEngine::process(float* const* channels, int numChannels, int numSamples) noexcept {
+    if (!m_fft) return 0;
+
+    numChannels = std::min(numChannels, MAX_CHANNELS);
+    const int fftSize = m_fftSize;
+    const int hop = getHopSize();
+    int frames = 0;
+
+    // Chunks end on hop boundaries, so a chunk never wraps either ring
+    for (int done = 0; done < numSamples;) {
+        const int length = std::min(numSamples - done, hop - m_hopFill);
+        const int writePos = m_inputPos + m_hopFill;
+        const size_t bytes = static_cast<size_t>(length) * sizeof(float);
+
+        for (int channel = 0; channel < MAX_CHANNELS; ++channel) {
+            float* input = m_input[channel].data();
+            if (channel < numChannels) {
+                float* io = channels[channel] + done;
+                std::memcpy(input + writePos, io, bytes);
+                std::memcpy(input + writePos + fftSize, io, bytes);
+                std::memcpy(io, m_output[channel].data() + m_outputBase + m_hopFill, bytes);
+            } else {
+                std::fill(input + writePos, input + writePos + length, 0.0f);
+                std::fill(input + writePos + fftSize, input + writePos + fftSize + length, 0.0f);
+            }
+        }
+
+        m_hopFill += length;
+        done += length;
+
+        if (m_hopFill == hop) {
+            m_hopFill = 0;
+            m_inputPos = (m_inputPos + hop) & (fftSize - 1);
+            processFrame();
+            ++frames;
+        }
+    }
+
+    return frames;
+}
+
+void SpectralGateEngine::processFrame() noexcept {
+    const int fftSize = m_fftSize;
+    const int hop = getHopSize();
+    const float* w = window();
+
+    // The hop just played out is done; compact once the live region reaches the end
+    m_outputBase += hop;
+    if (m_outputBase + fftSize > 2 * fftSize) {
+        for (int channel = 0; channel < MAX_CHANNELS; ++channel) {
+            float* output = m_output[channel].data();
+            std::memmove(output, output + m_outputBase, static_cast<size_t>(fftSize - hop) * sizeof(float));
+            std::fill(output + (fftSize - hop), output + 2 * fftSize, 0.0f);
+        }
+        m_outputBase = 0;
+    }
+
+    // Oldest sample first: m_inputPos is one past the newest
+    const float* left = m_input[0].data() + m_inputPos;
+    const float* right = m_input[1].data() + m_inputPos;
+    float* frame = reinterpret_cast<float*>(m_frame.data());
+    for (int n = 0; n < fftSize; ++n) {
+        frame[2 * n] = w[n] * left[n];
+        frame[2 * n + 1] = w[n] * right[n];
+    }
+
+    m_fft->forward(m_frame.data());
+    gateSpectrum();
+    m_fft->inverse(m_frame.data());
+
+    // Synthesis window and overlap-add: L from the real part, R from the imaginary
+    float* outLeft = m_output[0].data() + m_outputBase;
+    float* outRight = m_output[1].data() + m_outputBase;
+    const float gain = m_synthesisGain;
+    for (int n = 0; n < fftSize; ++n) {
+        const float g = w[n] * gain;
+        outLeft[n] += g * frame[2 * n];
+        outRight[n] += g * frame[2 * n + 1];
+    }
+}
+
+void SpectralGateEngine::gateSpectrum() noexcept {
+    const int fftSize = m_fftSize;
+    const int numBins = getNumBins();
+    const float scale = 2.0f * static_cast<float>(EraserConfig::REFERENCE_FFT_SIZE) / static_cast<float>(fftSize);
+    const float threshold = m_params.thresholdLinear;
+
+    // Eraser cursor bin range
+    const bool cursorActive = m_params.cursorActive;
+    const int cursorCenterBin = frequencyToBin(m_params.cursorCenterHz);
+    const int cursorWidthBins = frequencyToBin(m_params.cursorBandwidthHz) - frequencyToBin(0.0f);
+    const int cursorMinBin = std::max(0, cursorCenterBin - cursorWidthBins / 2);
+    const int cursorMaxBin = std::min(numBins - 1, cursorCenterBin + cursorWidthBins / 2);
+    const float cursorFalloff = 1.0f / static_cast<float>(cursorWidthBins / 2 + 1);
+
+    std::complex<float>* z = m_frame.data();
+    std::complex<float>* spectrumLeft = m_spectrum[0].data();
+    std::complex<float>* spectrumRight = m_spectrum[1].data();
+
+    // Erase amount for one channel's bin: threshold, manual mask, eraser cursor
+    const auto eraseAmountFor = [&](int bin, float magnitude) {
+        float eraseAmount = 0.0f;
+
+        // Threshold gating and manual bin erasure
+        if (magnitude > threshold || (m_erasedBins && m_erasedBins[bin])) {
+            eraseAmount = 1.0f;
+        }
+
+        // Eraser cursor, with a smooth falloff at the edges
+        if (cursorActive && bin >= cursorMinBin && bin <= cursorMaxBin) {
+            const float cursorAmount = (1.0f - std::abs(bin - cursorCenterBin) * cursorFalloff)
+                                     * m_params.cursorIntensity;
+            eraseAmount = std::max(eraseAmount, cursorAmount);
+        }
+
+        return std::max(eraseAmount, 0.0f);
+    };
+
+    for (int bin = 0; bin < numBins; ++bin) {
+        // Z[k] = L[k] + i R[k], and L, R are Hermitian:
+        // L[k] = (Z[k] + conj Z[N-k]) / 2,  R[k] = (Z[k] - conj Z[N-k]) / 2i
+        const int mirror = (fftSize - bin) & (fftSize - 1);
+        const float re = z[bin].real(), im = z[bin].imag();
+        const float mirrorRe = z[mirror].real(), mirrorIm = -z[mirror].imag();
+
+        const float leftRe = 0.5f * (re + mirrorRe), leftIm = 0.5f * (im + mirrorIm);
+        const float rightRe = 0.5f * (im - mirrorIm), rightIm = -0.5f * (re - mirrorRe);
+        spectrumLeft[bin] = {leftRe, leftIm};
+        spectrumRight[bin] = {rightRe, rightIm};
+
+        // Each channel is gated on its own magnitude
+        const float magnitudeLeft = std::sqrt(leftRe * leftRe + leftIm * leftIm) * scale;
+        const float magnitudeRight = std::sqrt(rightRe * rightRe + rightIm * rightIm) * scale;
+        m_magnitude[0][bin] = magnitudeLeft;
+        m_magnitude[1][bin] = magnitudeRight;
+
+        const float eraseLeft = eraseAmountFor(bin, magnitudeLeft);
+        const float eraseRight = eraseAmountFor(bin, magnitudeRight);
+        m_erasure[0][bin] = eraseLeft;
+        m_erasure[1][bin] = eraseRight;
+        if (eraseLeft <= 0.0f && eraseRight <= 0.0f) continue;
+
+        // Repack the gated channels: Z[k] = gL L[k] + i gR R[k] and
+        // Z[N-k] = conj(gL L[k]) + i conj(gR R[k])
+        const float gainLeft = 1.0f - eraseLeft;
+        const float gainRight = 1.0f - eraseRight;
+        const float gatedLeftRe = gainLeft * leftRe, gatedLeftIm = gainLeft * leftIm;
+        const float gatedRightRe = gainRight * rightRe, gatedRightIm = gainRight * rightIm;
+        z[bin] = {gatedLeftRe - gatedRightIm, gatedLeftIm + gatedRightRe};
+        if (mirror != bin) z[mirror] = {gatedLeftRe + gatedRightIm, gatedRightRe - gatedLeftIm};
+    }
+}
+
+} // namespace iDAW
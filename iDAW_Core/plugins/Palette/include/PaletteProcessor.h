@@ -4,7 +4,7 @@
  * Profile: 'Wavetable Synth' with Watercolor UI
  * 
  * Features:
- * - Dual-oscillator wavetable engine
+ * - Dual-oscillator wavetable engine (8 voices rendered across SIMD lanes)
  * - FM modulation matrix
  * - State variable filter
  * - 2 LFOs + 2 ADSR envelopes
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "WavetableVoiceEngine.h"
 #include <atomic>
 #include <array>
 #include <vector>
@@ -21,27 +22,6 @@
 
 namespace iDAW {
 
-/**
- * Configuration for The Palette
- */
-struct PaletteConfig {
-    static constexpr int WAVETABLE_SIZE = 2048;
-    static constexpr int NUM_WAVETABLES = 4;  // Sine, Saw, Square, Noise
-    static constexpr int MAX_VOICES = 8;
-    static constexpr float MAX_FM_AMOUNT = 1000.0f;  // Hz deviation
-};
-
-/**
- * Wavetable types
- */
-enum class WavetableType {
-    SINE,
-    SAW,
-    SQUARE,
-    NOISE,
-    CUSTOM
-};
-
 /**
  * Filter types
  */
@@ -51,22 +31,6 @@ enum class FilterType {
     BANDPASS
 };
 
-/**
- * ADSR Envelope
- */
-struct ADSREnvelope {
-    float attack = 0.01f;    // seconds
-    float decay = 0.1f;      // seconds
-    float sustain = 0.7f;    // level (0-1)
-    float release = 0.3f;    // seconds
-    
-    // State
-    enum class Stage { IDLE, ATTACK, DECAY, SUSTAIN, RELEASE };
-    Stage stage = Stage::IDLE;
-    float level = 0.0f;
-    float releaseLevel = 0.0f;
-};
-
 /**
  * LFO
  */
@@ -89,19 +53,6 @@ struct WatercolorVisualState {
     float diffusionRate = 0.05f;    // Paint bleeding speed
 };
 
-/**
- * Voice state for polyphony
- */
-struct Voice {
-    bool active = false;
-    int noteNumber = 60;
-    float velocity = 1.0f;
-    float phase1 = 0.0f;     // Osc 1 phase
-    float phase2 = 0.0f;     // Osc 2 phase
-    ADSREnvelope ampEnv;
-    ADSREnvelope filterEnv;
-};
-
 /**
  * PaletteProcessor - Wavetable Synthesizer
  */
@@ -178,18 +129,12 @@ private:
     void handleMidiEvent(const juce::MidiMessage& msg);
     void noteOn(int note, float velocity);
     void noteOff(int note);
-    float processVoice(Voice& voice);
-    float readWavetable(WavetableType type, float phase);
+    void updateFilterCoefficients(float cutoff);
     float processFilter(float input);
-    float processEnvelope(ADSREnvelope& env);
     void updateVisualState();
-    void generateWavetables();
-    
-    // Wavetables
-    std::array<std::vector<float>, 4> m_wavetables;
     
-    // Voices
-    std::array<Voice, PaletteConfig::MAX_VOICES> m_voices;
+    // Wavetables and voices
+    WavetableVoiceEngine m_voiceEngine;
     
     // Oscillator parameters
     WavetableType m_osc1Type = WavetableType::SINE;
@@ -213,6 +158,8 @@ private:
     // Filter state (per voice simplified to mono for efficiency)
     float m_filterState1 = 0.0f;
     float m_filterState2 = 0.0f;
+    float m_filterF = 0.0f;  // Coefficients, updated at control rate
+    float m_filterQ = 1.0f;
     
     // Envelope templates
     ADSREnvelope m_ampEnvTemplate;
@@ -0,0 +1,155 @@
+/**
+ * WavetableVoiceEngine.h - Polyphonic oscillator core of "The Palette"
+ *
+ * Voice state is kept as structure-of-arrays with one lane per voice, so
+ * all MAX_VOICES (8) voices render together, one AVX lane each:
+ *
+ *   per block:  pitch + detune -> phase increments (no pow() per sample)
+ *               amp envelopes  -> [sample][voice] gain buffer
+ *   per sample: osc1 gather -> FM -> osc2 gather -> * gain -> sum of lanes
+ *
+ * Wavetable reads are linear interpolations over gathered taps; tables
+ * carry guard samples so the upper tap never wraps. Builds without AVX run
+ * the same loop one lane at a time.
+ *
+ * Each table is stored as per-octave band-limited mip levels (level k keeps
+ * harmonics up to WAVETABLE_SIZE / 2 >> k), built once with the shared
+ * daiw::dsp FFT plan. Every voice reads the level whose top harmonic stays
+ * below Nyquist at its phase increment, so high notes do not alias. The
+ * position parameters morph each oscillator from its table toward the next
+ * one (Sine -> Saw -> Square -> Noise -> Sine).
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace iDAW {
+
+/**
+ * Configuration for The Palette
+ */
+struct PaletteConfig {
+    static constexpr int WAVETABLE_SIZE = 2048;
+    static constexpr int NUM_WAVETABLES = 4;  // Sine, Saw, Square, Noise
+    static constexpr int MAX_VOICES = 8;
+    static constexpr float MAX_FM_AMOUNT = 1000.0f;  // Hz deviation
+};
+
+/**
+ * Wavetable types
+ */
+enum class WavetableType {
+    SINE,
+    SAW,
+    SQUARE,
+    NOISE,
+    CUSTOM
+};
+
+/**
+ * ADSR Envelope
+ */
+struct ADSREnvelope {
+    float attack = 0.01f;    // seconds
+    float decay = 0.1f;      // seconds
+    float sustain = 0.7f;    // level (0-1)
+    float release = 0.3f;    // seconds
+
+    // State
+    enum class Stage { IDLE, ATTACK, DECAY, SUSTAIN, RELEASE };
+    Stage stage = Stage::IDLE;
+    float level = 0.0f;
+    float releaseLevel = 0.0f;
+};
+
+/**
+ * Oscillator settings shared by all voices for one block
+ */
+struct OscillatorParameters {
+    WavetableType osc1Type = WavetableType::SINE;
+    WavetableType osc2Type = WavetableType::SAW;
+    float osc1Level = 0.7f;
+    float osc2Level = 0.5f;
+    float osc1DetuneCents = 0.0f;
+    float osc2DetuneCents = 0.0f;
+    float osc1Position = 0.0f;   // 0-1 morph toward the next table
+    float osc2Position = 0.0f;
+    float fmAmountHz = 0.0f;     // Osc1 -> Osc2 frequency deviation
+};
+
+class WavetableVoiceEngine {
+public:
+    static constexpr int NUM_VOICES = PaletteConfig::MAX_VOICES;
+
+    /** Level k holds harmonics 1..(WAVETABLE_SIZE / 2 >> k); the last is a pure sine */
+    static constexpr int NUM_MIP_LEVELS = 11;
+
+    WavetableVoiceEngine();
+
+    /** Allocate for blocks of up to maxBlockSize samples. Not RT-safe. */
+    void prepare(double sampleRate, int maxBlockSize);
+
+    /** Silence all voices */
+    void reset() noexcept;
+
+    /** Start a voice (steals voice 0 when all are busy) */
+    void noteOn(int note, float velocity, const ADSREnvelope& ampEnvelope) noexcept;
+
+    /** Release every voice playing note */
+    void noteOff(int note) noexcept;
+
+    int getNumActiveVoices() const noexcept;
+
+    /**
+     * Write the sum of all voices to output (numSamples <= prepared size;
+     * larger blocks are rendered in chunks).
+     */
+    void render(float* output, int numSamples, const OscillatorParameters& params) noexcept;
+
+    /**
+     * Single linear-interpolated read (for LFOs). phaseIncrement (cycles per
+     * sample) selects the mip level; 0 reads the full-band table. CUSTOM
+     * reads as silence.
+     */
+    float readWavetable(WavetableType type, float phase, float phaseIncrement = 0.0f) const noexcept;
+
+    /** Mip level read at a phase increment (cycles per sample) */
+    static int mipLevelFor(float phaseIncrement) noexcept;
+
+private:
+    void generateWavetables();
+
+    /** Level 0 of a type's mip chain, or nullptr for CUSTOM */
+    const float* tableFor(WavetableType type) const noexcept;
+
+    void renderChunk(float* output, int numSamples, const OscillatorParameters& params) noexcept;
+
+    /** Fill m_gains[i * NUM_VOICES + voice] and retire finished voices */
+    void renderEnvelopes(int numSamples) noexcept;
+
+    // Levels are WAVETABLE_SIZE + TABLE_GUARD long (guard = wrapped start),
+    // stored [type][level] in one allocation
+    static constexpr int TABLE_GUARD = 2;
+    static constexpr int MIP_STRIDE = PaletteConfig::WAVETABLE_SIZE + TABLE_GUARD;
+    std::vector<float> m_mipmaps;
+
+    double m_sampleRate = 44100.0;
+    int m_maxBlockSize = 0;
+
+    // Voice state, one lane per voice
+    alignas(32) float m_phase1[NUM_VOICES] = {};
+    alignas(32) float m_phase2[NUM_VOICES] = {};
+    alignas(32) float m_frequency[NUM_VOICES] = {};
+    alignas(32) float m_velocity[NUM_VOICES] = {};
+    std::array<int, NUM_VOICES> m_noteNumber = {};
+    std::array<bool, NUM_VOICES> m_active = {};
+    std::array<ADSREnvelope, NUM_VOICES> m_ampEnvelope;
+
+    // Per-sample envelope * velocity, [sample][voice]
+    std::vector<float> m_gains;
+};
+
+} // namespace iDAW
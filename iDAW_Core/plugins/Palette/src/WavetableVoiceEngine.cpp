@@ -0,0 +1,412 @@
+/**
+ * WavetableVoiceEngine.cpp - Polyphonic oscillator core of "The Palette"
+ */
+
+#include "WavetableVoiceEngine.h"
+#include "daiw/fft.hpp"
+#include "daiw/simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace iDAW {
+
+namespace {
+
+constexpr int TABLE_SIZE = PaletteConfig::WAVETABLE_SIZE;
+constexpr double TWO_PI = 6.283185307179586;
+
+static_assert(daiw::dsp::is_valid_fft_size(TABLE_SIZE), "mip levels are built with a shared FFT plan");
+
+static_assert((TABLE_SIZE / 2) >> (WavetableVoiceEngine::NUM_MIP_LEVELS - 1) == 1,
+              "the top mip level holds the fundamental only");
+
+/**
+ * Advance one envelope over a block, writing level * gain every `stride`
+ * floats. Same per-sample recurrences as a switch per sample, but each
+ * stage runs as its own tight loop.
+ */
+void renderEnvelope(ADSREnvelope& env, float gain, float sampleTime,
+                    float* out, int stride, int numSamples) noexcept {
+    using Stage = ADSREnvelope::Stage;
+    int i = 0;
+
+    while (i < numSamples) {
+        switch (env.stage) {
+            case Stage::ATTACK: {
+                const float step = sampleTime / env.attack;
+                while (i < numSamples && env.stage == Stage::ATTACK) {
+                    env.level += step;
+                    if (env.level >= 1.0f) {
+                        env.level = 1.0f;
+                        env.stage = Stage::DECAY;
+                    }
+                    out[i++ * stride] = env.level * gain;
+                }
+                break;
+            }
+
+            case Stage::DECAY: {
+                const float step = (1.0f - env.sustain) * sampleTime / env.decay;
+                while (i < numSamples && env.stage == Stage::DECAY) {
+                    env.level -= step;
+                    if (env.level <= env.sustain) {
+                        env.level = env.sustain;
+                        env.stage = Stage::SUSTAIN;
+                    }
+                    out[i++ * stride] = env.level * gain;
+                }
+                break;
+            }
+
+            case Stage::SUSTAIN:
+                env.level = env.sustain;
+                for (; i < numSamples; ++i) out[i * stride] = env.level * gain;
+                break;
+
+            case Stage::RELEASE: {
+                const float step = env.releaseLevel * sampleTime / env.release;
+                while (i < numSamples && env.stage == Stage::RELEASE) {
+                    env.level -= step;
+                    if (env.level <= 0.0f) {
+                        env.level = 0.0f;
+                        env.stage = Stage::IDLE;
+                    }
+                    out[i++ * stride] = env.level * gain;
+                }
+                break;
+            }
+
+            case Stage::IDLE:
+            default:
+                env.level = 0.0f;
+                for (; i < numSamples; ++i) out[i * stride] = 0.0f;
+                break;
+        }
+    }
+}
+
+/** Linear-interpolated read of one level in [0, 1] */
+inline float readTable(const float* table, float phase) noexcept {
+    const float scaled = phase * static_cast<float>(TABLE_SIZE);
+    const int index = static_cast<int>(scaled);
+    const float frac = scaled - static_cast<float>(index);
+    return table[index] + (table[index + 1] - table[index]) * frac;
+}
+
+#if defined(DAIW_AVX2) || defined(DAIW_AVX512)
+
+/** Linear-interpolated read of 8 phases in [0, 1], each lane from its own mip level */
+inline __m256 readTable8(const float* table, __m256 phase, __m256i levelOffset) noexcept {
+    const __m256 scaled = _mm256_mul_ps(phase, _mm256_set1_ps(static_cast<float>(TABLE_SIZE)));
+    const __m256i index = _mm256_cvttps_epi32(scaled);
+    const __m256 frac = _mm256_sub_ps(scaled, _mm256_cvtepi32_ps(index));
+    const __m256i tap = _mm256_add_epi32(index, levelOffset);
+    const __m256 a = _mm256_i32gather_ps(table, tap, 4);
+    const __m256 b = _mm256_i32gather_ps(table + 1, tap, 4);
+    return _mm256_fmadd_ps(_mm256_sub_ps(b, a), frac, a);
+}
+
+inline float horizontalSum(__m256 v) noexcept {
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+    return _mm_cvtss_f32(sum);
+}
+
+/** Wrap phases into [0, 1) (also for the negative steps deep FM produces) */
+inline __m256 wrapPhase(__m256 phase) noexcept {
+    return _mm256_sub_ps(phase, _mm256_floor_ps(phase));
+}
+
+#endif
+
+} // namespace
+
+WavetableVoiceEngine::WavetableVoiceEngine() {
+    generateWavetables();
+    for (auto& env : m_ampEnvelope) {
+        env.stage = ADSREnvelope::Stage::IDLE;
+    }
+}
+
+void WavetableVoiceEngine::generateWavetables() {
+    const int size = TABLE_SIZE;
+    m_mipmaps.assign(static_cast<size_t>(PaletteConfig::NUM_WAVETABLES * NUM_MIP_LEVELS * MIP_STRIDE), 0.0f);
+
+    // Fixed seed: every instance (and every session) gets the same noise
+    std::minstd_rand noise(0x5eed);
+    const double noiseScale = 2.0 / static_cast<double>(std::minstd_rand::max());
+
+    const daiw::dsp::FftPlan& plan = *daiw::dsp::fft_plan(static_cast<size_t>(size));
+    std::vector<float> shape(static_cast<size_t>(size));
+    std::vector<daiw::dsp::Complex> spectrum(plan.num_bins());
+    std::vector<daiw::dsp::Complex> level(plan.num_bins());
+
+    for (int type = 0; type < PaletteConfig::NUM_WAVETABLES; ++type) {
+        // Naive single-cycle shape
+        for (int i = 0; i < size; ++i) {
+            const double phase = static_cast<double>(i) / size;
+            double value = 0.0;
+            switch (static_cast<WavetableType>(type)) {
+                case WavetableType::SINE:   value = std::sin(TWO_PI * phase); break;
+                case WavetableType::SAW:    value = 2.0 * phase - 1.0; break;
+                case WavetableType::SQUARE: value = phase < 0.5 ? 1.0 : -1.0; break;
+                default:                    value = static_cast<double>(noise()) * noiseScale - 1.0; break;
+            }
+            shape[i] = static_cast<float>(value);
+        }
+        plan.forward_real(shape.data(), spectrum.data());
+
+        // No DC, no Nyquist bin
+        spectrum[0] = 0.0f;
+        spectrum[size / 2] = 0.0f;
+
+        float* levels = m_mipmaps.data() + static_cast<size_t>(type) * NUM_MIP_LEVELS * MIP_STRIDE;
+        for (int k = 0; k < NUM_MIP_LEVELS; ++k) {
+            const size_t maxHarmonic = static_cast<size_t>((size / 2) >> k);
+            for (size_t bin = 0; bin < level.size(); ++bin) {
+                level[bin] = bin <= maxHarmonic ? spectrum[bin] : 0.0f;
+            }
+
+            float* table = levels + k * MIP_STRIDE;
+            plan.inverse_real(level.data(), table);
+
+            // Guard samples repeat the start so index + 1 never wraps
+            for (int g = 0; g < TABLE_GUARD; ++g) {
+                table[size + g] = table[g];
+            }
+        }
+
+        // Noise keeps the same loudness as the other shapes (full-band peak of 1)
+        if (static_cast<WavetableType>(type) == WavetableType::NOISE) {
+            float peak = 0.0f;
+            for (int i = 0; i < size; ++i) peak = std::max(peak, std::abs(levels[i]));
+            if (peak > 0.0f) {
+                for (int i = 0; i < NUM_MIP_LEVELS * MIP_STRIDE; ++i) levels[i] /= peak;
+            }
+        }
+    }
+}
+
+void WavetableVoiceEngine::prepare(double sampleRate, int maxBlockSize) {
+    m_sampleRate = sampleRate;
+    m_maxBlockSize = std::max(1, maxBlockSize);
+    m_gains.assign(static_cast<size_t>(m_maxBlockSize) * NUM_VOICES, 0.0f);
+    reset();
+}
+
+void WavetableVoiceEngine::reset() noexcept {
+    for (int v = 0; v < NUM_VOICES; ++v) {
+        m_active[v] = false;
+        m_phase1[v] = 0.0f;
+        m_phase2[v] = 0.0f;
+        m_ampEnvelope[v].stage = ADSREnvelope::Stage::IDLE;
+        m_ampEnvelope[v].level = 0.0f;
+    }
+}
+
+void WavetableVoiceEngine::noteOn(int note, float velocity, const ADSREnvelope& ampEnvelope) noexcept {
+    // Find free voice; otherwise steal the oldest (voice 0), keeping its
+    // envelope settings
+    int voice = 0;
+    for (int v = 0; v < NUM_VOICES; ++v) {
+        if (!m_active[v]) {
+            voice = v;
+            m_ampEnvelope[v] = ampEnvelope;
+            break;
+        }
+    }
+
+    m_active[voice] = true;
+    m_noteNumber[voice] = note;
+    m_velocity[voice] = velocity;
+    m_frequency[voice] = 440.0f * std::pow(2.0f, (note - 69) / 12.0f);
+    m_phase1[voice] = 0.0f;
+    m_phase2[voice] = 0.0f;
+    m_ampEnvelope[voice].stage = ADSREnvelope::Stage::ATTACK;
+    m_ampEnvelope[voice].level = 0.0f;
+}
+
+void WavetableVoiceEngine::noteOff(int note) noexcept {
+    for (int v = 0; v < NUM_VOICES; ++v) {
+        if (m_active[v] && m_noteNumber[v] == note) {
+            m_ampEnvelope[v].stage = ADSREnvelope::Stage::RELEASE;
+            m_ampEnvelope[v].releaseLevel = m_ampEnvelope[v].level;
+        }
+    }
+}
+
+int WavetableVoiceEngine::getNumActiveVoices() const noexcept {
+    return static_cast<int>(std::count(m_active.begin(), m_active.end(), true));
+}
+
+const float* WavetableVoiceEngine::tableFor(WavetableType type) const noexcept {
+    const int idx = static_cast<int>(type);
+    if (idx < 0 || idx >= PaletteConfig::NUM_WAVETABLES) return nullptr;
+    return m_mipmaps.data() + static_cast<size_t>(idx) * NUM_MIP_LEVELS * MIP_STRIDE;
+}
+
+int WavetableVoiceEngine::mipLevelFor(float phaseIncrement) noexcept {
+    // Level k is alias-free while (TABLE_SIZE / 2 >> k) * increment <= 0.5
+    const float harmonicsPerCycle = std::abs(phaseIncrement) * static_cast<float>(TABLE_SIZE);
+    int level = 0;
+    while (level < NUM_MIP_LEVELS - 1 && harmonicsPerCycle > static_cast<float>(1 << level)) {
+        ++level;
+    }
+    return level;
+}
+
+float WavetableVoiceEngine::readWavetable(WavetableType type, float phase, float phaseIncrement) const noexcept {
+    const float* table = tableFor(type);
+    return table ? readTable(table + mipLevelFor(phaseIncrement) * MIP_STRIDE, phase) : 0.0f;
+}
+
+void WavetableVoiceEngine::render(float* output, int numSamples, const OscillatorParameters& params) noexcept {
+    if (m_maxBlockSize == 0) return;
+
+    for (int offset = 0; offset < numSamples; offset += m_maxBlockSize) {
+        const int chunk = std::min(m_maxBlockSize, numSamples - offset);
+        renderChunk(output + offset, chunk, params);
+    }
+}
+
+void WavetableVoiceEngine::renderEnvelopes(int numSamples) noexcept {
+    const float sampleTime = 1.0f / static_cast<float>(m_sampleRate);
+
+    for (int v = 0; v < NUM_VOICES; ++v) {
+        float* gains = m_gains.data() + v;
+        if (!m_active[v]) {
+            for (int i = 0; i < numSamples; ++i) gains[i * NUM_VOICES] = 0.0f;
+            continue;
+        }
+
+        renderEnvelope(m_ampEnvelope[v], m_velocity[v], sampleTime, gains, NUM_VOICES, numSamples);
+        if (m_ampEnvelope[v].stage == ADSREnvelope::Stage::IDLE) {
+            m_active[v] = false;
+        }
+    }
+}
+
+void WavetableVoiceEngine::renderChunk(float* output, int numSamples, const OscillatorParameters& params) noexcept {
+    std::fill(output, output + numSamples, 0.0f);
+
+    // Voices active at the block start (renderEnvelopes() may retire some)
+    [[maybe_unused]] int sounding[NUM_VOICES];
+    int numSounding = 0;
+    for (int v = 0; v < NUM_VOICES; ++v) {
+        if (m_active[v]) sounding[numSounding++] = v;
+    }
+    if (numSounding == 0) return;
+
+    renderEnvelopes(numSamples);
+
+    // Pitch and detune once per block
+    const float invSampleRate = 1.0f / static_cast<float>(m_sampleRate);
+    const float detune1 = std::pow(2.0f, params.osc1DetuneCents / 1200.0f) * invSampleRate;
+    const float detune2 = std::pow(2.0f, params.osc2DetuneCents / 1200.0f) * invSampleRate;
+    alignas(32) float increment1[NUM_VOICES];
+    alignas(32) float increment2[NUM_VOICES];
+    for (int v = 0; v < NUM_VOICES; ++v) {
+        increment1[v] = m_frequency[v] * detune1;
+        increment2[v] = m_frequency[v] * detune2;
+    }
+
+    // CUSTOM has no table yet: read any table at zero level
+    const float* table1 = tableFor(params.osc1Type);
+    const float* table2 = tableFor(params.osc2Type);
+    const float level1 = table1 ? params.osc1Level : 0.0f;
+    const float level2 = table2 ? params.osc2Level : 0.0f;
+    if (!table1) table1 = m_mipmaps.data();
+    if (!table2) table2 = m_mipmaps.data();
+
+    // Position morphs toward the following table in memory (Noise wraps to Sine)
+    const float* const mipEnd = m_mipmaps.data() + m_mipmaps.size();
+    const int typeStride = NUM_MIP_LEVELS * MIP_STRIDE;
+    const float* morph1 = table1 + typeStride < mipEnd ? table1 + typeStride : m_mipmaps.data();
+    const float* morph2 = table2 + typeStride < mipEnd ? table2 + typeStride : m_mipmaps.data();
+    const float position1 = std::clamp(params.osc1Position, 0.0f, 1.0f);
+    const float position2 = std::clamp(params.osc2Position, 0.0f, 1.0f);
+
+    // FM: Osc1 (after level) deviates Osc2 by fmAmountHz per unit
+    const float fmScale = params.fmAmountHz * invSampleRate;
+
+    // Mip level per voice; Osc2 allows for the widest FM swing
+    const float fmDeviation = std::abs(fmScale * level1);
+    alignas(32) int levelOffset1[NUM_VOICES];
+    alignas(32) int levelOffset2[NUM_VOICES];
+    for (int v = 0; v < NUM_VOICES; ++v) {
+        levelOffset1[v] = mipLevelFor(increment1[v]) * MIP_STRIDE;
+        levelOffset2[v] = mipLevelFor(std::abs(increment2[v]) + fmDeviation) * MIP_STRIDE;
+    }
+    const float* gains = m_gains.data();
+    int i = 0;
+
+#if defined(DAIW_AVX2) || defined(DAIW_AVX512)
+    static_assert(NUM_VOICES == 8, "one AVX lane per voice");
+
+    __m256 phase1 = _mm256_load_ps(m_phase1);
+    __m256 phase2 = _mm256_load_ps(m_phase2);
+    const __m256 inc1 = _mm256_load_ps(increment1);
+    const __m256 inc2 = _mm256_load_ps(increment2);
+    const __m256 gain1 = _mm256_set1_ps(level1);
+    const __m256 gain2 = _mm256_set1_ps(level2);
+    const __m256 fm = _mm256_set1_ps(fmScale);
+    const __m256i offset1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(levelOffset1));
+    const __m256i offset2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(levelOffset2));
+    const __m256 morph1Amount = _mm256_set1_ps(position1);
+    const __m256 morph2Amount = _mm256_set1_ps(position2);
+
+    for (; i < numSamples; ++i) {
+        __m256 wave1 = readTable8(table1, phase1, offset1);
+        __m256 wave2 = readTable8(table2, phase2, offset2);
+        if (position1 > 0.0f) {
+            const __m256 next = readTable8(morph1, phase1, offset1);
+            wave1 = _mm256_fmadd_ps(_mm256_sub_ps(next, wave1), morph1Amount, wave1);
+        }
+        if (position2 > 0.0f) {
+            const __m256 next = readTable8(morph2, phase2, offset2);
+            wave2 = _mm256_fmadd_ps(_mm256_sub_ps(next, wave2), morph2Amount, wave2);
+        }
+
+        const __m256 osc1 = _mm256_mul_ps(wave1, gain1);
+        const __m256 osc2 = _mm256_mul_ps(wave2, gain2);
+        const __m256 gain = _mm256_loadu_ps(gains + i * NUM_VOICES);
+        output[i] = horizontalSum(_mm256_mul_ps(_mm256_add_ps(osc1, osc2), gain));
+
+        phase1 = wrapPhase(_mm256_add_ps(phase1, inc1));
+        phase2 = wrapPhase(_mm256_add_ps(phase2, _mm256_fmadd_ps(osc1, fm, inc2)));
+    }
+
+    _mm256_store_ps(m_phase1, phase1);
+    _mm256_store_ps(m_phase2, phase2);
+#else
+    // Without lanes to fill, only voices that sound this block are run
+    for (; i < numSamples; ++i) {
+        float sum = 0.0f;
+        for (int k = 0; k < numSounding; ++k) {
+            const int v = sounding[k];
+            float wave1 = readTable(table1 + levelOffset1[v], m_phase1[v]);
+            float wave2 = readTable(table2 + levelOffset2[v], m_phase2[v]);
+            if (position1 > 0.0f) {
+                wave1 += (readTable(morph1 + levelOffset1[v], m_phase1[v]) - wave1) * position1;
+            }
+            if (position2 > 0.0f) {
+                wave2 += (readTable(morph2 + levelOffset2[v], m_phase2[v]) - wave2) * position2;
+            }
+
+            const float osc1 = wave1 * level1;
+            const float osc2 = wave2 * level2;
+            sum += (osc1 + osc2) * gains[i * NUM_VOICES + v];
+
+            const float next1 = m_phase1[v] + increment1[v];
+            const float next2 = m_phase2[v] + increment2[v] + osc1 * fmScale;
+            m_phase1[v] = next1 - std::floor(next1);
+            m_phase2[v] = next2 - std::floor(next2);
+        }
+        output[i] = sum;
+    }
+#endif
+}
+
+} // namespace iDAW
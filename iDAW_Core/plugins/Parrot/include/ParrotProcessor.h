@@ -15,6 +15,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "YinPitchTracker.h"
 #include <atomic>
 #include <array>
 #include <vector>
@@ -31,6 +32,7 @@ namespace iDAW {
 struct ParrotConfig {
     static constexpr int FFT_SIZE = 4096;           // For pitch detection
     static constexpr int HOP_SIZE = 512;            // Analysis hop
+    static constexpr int HARMONY_HOP_SIZE = 128;    // Faster pitch tracking in Harmony mode
     static constexpr int MAX_PHRASE_SECONDS = 30;   // Max recording length
     static constexpr int MAX_HARMONY_VOICES = 4;    // Harmony stack
     static constexpr float MIN_PITCH_HZ = 50.0f;    // Lowest detectable
@@ -214,7 +216,6 @@ private:
     // === Pitch Detection ===
     float detectPitch(const float* samples, int numSamples);
     float autocorrelationPitch(const float* samples, int numSamples);
-    float yinPitchDetection(const float* samples, int numSamples);
     int frequencyToMidi(float freq);
     float midiToFrequency(int midiNote);
 
@@ -292,9 +293,8 @@ private:
     // Visual state
     FeatherVisualState visualState;
 
-    // FFT for pitch detection
-    std::vector<float> fftBuffer;
-    std::vector<float> yinBuffer;
+    // Streaming YIN pitch detection (FFT difference function)
+    YinPitchTracker pitchTracker;
 
     // Parameter IDs
     static constexpr const char* PARAM_MODE = "mode";
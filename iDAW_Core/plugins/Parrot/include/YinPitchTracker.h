@@ -0,0 +1,123 @@
+/**
+ * YinPitchTracker.h - Streaming YIN pitch detector for "The Parrot"
+ *
+ * YIN (de Cheveigné & Kawahara) on a frame of N samples with W = N / 2:
+ *
+ *   d(tau)  = sum_{j<W} (x[j] - x[j + tau])^2
+ *           = E(0) + E(tau) - 2 r(tau)
+ *   d'(tau) = d(tau) * tau / sum_{k=1..tau} d(k)          (CMNDF)
+ *
+ * where E(tau) is the energy of x[tau .. tau + W) and r(tau) the
+ * cross-correlation of the first half of the frame with the whole frame.
+ *
+ * Two ways to get d(tau):
+ * - Method::Direct evaluates the sum for every lag: O(N^2), kept as the
+ *   reference implementation.
+ * - Method::FFT gets r(tau) for all lags from one complex FFT (the frame and
+ *   its first half packed as real/imaginary parts) and one real inverse FFT,
+ *   and E(tau) from a running sum of squares: O(N log N).
+ *   Lags stay below W, so circular correlation of size N never wraps.
+ *   Transforms come from the shared daiw::dsp plan for size N.
+ *
+ * Streaming: pushSamples() writes into a double-written ring and runs one
+ * analysis every hopSize samples, so frames overlap by N - hop without any
+ * per-block copying or zero padding. All memory is allocated in prepare();
+ * pushSamples() is RT-safe.
+ */
+
+#pragma once
+
+#include "daiw/fft.hpp"
+#include <complex>
+#include <vector>
+
+namespace iDAW {
+
+class YinPitchTracker {
+public:
+    enum class Method {
+        Direct,     // O(N^2) difference function (reference)
+        FFT         // O(N log N) via autocorrelation
+    };
+
+    static constexpr float DEFAULT_THRESHOLD = 0.1f;
+
+    YinPitchTracker() = default;
+    ~YinPitchTracker() = default;
+
+    YinPitchTracker(const YinPitchTracker&) = delete;
+    YinPitchTracker& operator=(const YinPitchTracker&) = delete;
+
+    /**
+     * Allocate buffers for a frame of frameSize samples (power of two)
+     * analysed every hopSize samples. Not RT-safe.
+     */
+    void prepare(double sampleRate, int frameSize, int hopSize);
+
+    /** Clear input history and the current estimate. */
+    void reset() noexcept;
+
+    void setMethod(Method method) noexcept { m_method = method; }
+    Method getMethod() const noexcept { return m_method; }
+
+    void setThreshold(float threshold) noexcept { m_threshold = threshold; }
+    void setPitchRange(float minHz, float maxHz) noexcept { m_minHz = minHz; m_maxHz = maxHz; }
+
+    /** Change the analysis hop without reallocating (RT-safe). */
+    void setHopSize(int hopSize) noexcept;
+
+    /**
+     * Feed input. Runs an analysis on the latest frameSize samples each time
+     * another hopSize samples have arrived.
+     * @return Number of frames analysed during this call
+     */
+    int pushSamples(const float* samples, int numSamples) noexcept;
+
+    /**
+     * Analyse one complete frame of frameSize samples.
+     * @return Pitch in Hz, or 0 if no pitch was found in range
+     */
+    float analyzeFrame(const float* frame) noexcept;
+
+    /** Latest estimate (0 = unvoiced) and its confidence (1 - CMNDF at the dip) */
+    float getPitch() const noexcept { return m_pitch; }
+    float getConfidence() const noexcept { return m_confidence; }
+
+    /** CMNDF of the last analysed frame, getNumLags() values */
+    const float* getCMNDF() const noexcept { return m_yin.data(); }
+    int getNumLags() const noexcept { return m_frameSize / 2; }
+
+    int getFrameSize() const noexcept { return m_frameSize; }
+    int getHopSize() const noexcept { return m_hopSize; }
+
+private:
+    void differenceDirect(const float* frame) noexcept;
+    void differenceFFT(const float* frame) noexcept;
+    float pickPitch() noexcept;
+
+    Method m_method = Method::FFT;
+    double m_sampleRate = 44100.0;
+    float m_threshold = DEFAULT_THRESHOLD;
+    float m_minHz = 50.0f;
+    float m_maxHz = 2000.0f;
+
+    int m_frameSize = 0;
+    int m_hopSize = 0;
+
+    // Streaming input
+    std::vector<float> m_history;                  // 2 * frameSize, written twice
+    int m_writePos = 0;
+    int m_samplesSinceHop = 0;
+
+    // Analysis
+    const daiw::dsp::FftPlan* m_fft = nullptr;     // Shared, size frameSize
+    std::vector<std::complex<float>> m_packed;     // frame + i * firstHalf, transformed in place
+    std::vector<std::complex<float>> m_spectrum;   // R, frameSize / 2 + 1 bins
+    std::vector<float> m_correlation;              // r(tau), frameSize
+    std::vector<float> m_yin;                      // d(tau), then d'(tau) in place
+
+    float m_pitch = 0.0f;
+    float m_confidence = 0.0f;
+};
+
+} // namespace iDAW
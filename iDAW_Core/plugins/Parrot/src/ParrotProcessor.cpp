@@ -42,9 +42,8 @@ ParrotProcessor::ParrotProcessor()
         .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
       parameters(*this, nullptr, "ParrotParams", createParameterLayout())
 {
-    // Initialize FFT buffers
-    fftBuffer.resize(ParrotConfig::FFT_SIZE, 0.0f);
-    yinBuffer.resize(ParrotConfig::FFT_SIZE / 2, 0.0f);
+    // Pitch tracker buffers are allocated in prepareToPlay
+    pitchTracker.setPitchRange(ParrotConfig::MIN_PITCH_HZ, ParrotConfig::MAX_PITCH_HZ);
     
     // Reserve recording buffer for max phrase length
     recordBuffer.reserve(ParrotConfig::MAX_PHRASE_SECONDS * 48000);
@@ -99,6 +98,9 @@ void ParrotProcessor::prepareToPlay(double sr, int spb)
     recordBuffer.clear();
     recordBuffer.reserve(static_cast<size_t>(ParrotConfig::MAX_PHRASE_SECONDS * sampleRate));
     
+    // Pitch tracker
+    pitchTracker.prepare(sampleRate, ParrotConfig::FFT_SIZE, ParrotConfig::HOP_SIZE);
+    
     // Reset states
     recordPosition = 0;
     silenceCounter = 0;
@@ -132,6 +134,11 @@ void ParrotProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiB
     targetInstrument = static_cast<TargetInstrument>(
         parameters.getRawParameterValue(PARAM_TARGET_INSTRUMENT)->load());
     
+    // Harmony voices follow the input closely; note capture can use longer hops
+    pitchTracker.setHopSize(currentMode == ParrotMode::HARMONY
+                                ? ParrotConfig::HARMONY_HOP_SIZE
+                                : ParrotConfig::HOP_SIZE);
+    
     // Process based on mode
     switch (currentMode) {
         case ParrotMode::ECHO:
@@ -403,75 +410,9 @@ void ParrotProcessor::processSamplerMode(juce::AudioBuffer<float>& buffer)
 
 float ParrotProcessor::detectPitch(const float* samples, int numSamples)
 {
-    // Copy to FFT buffer
-    int copyLen = std::min(numSamples, ParrotConfig::FFT_SIZE);
-    std::fill(fftBuffer.begin(), fftBuffer.end(), 0.0f);
-    std::copy(samples, samples + copyLen, fftBuffer.begin());
-    
-    return yinPitchDetection(fftBuffer.data(), ParrotConfig::FFT_SIZE);
-}
-
-float ParrotProcessor::yinPitchDetection(const float* samples, int numSamples)
-{
-    const int halfSize = numSamples / 2;
-    const float threshold = 0.1f;
-    
-    // Step 1: Calculate difference function
-    std::fill(yinBuffer.begin(), yinBuffer.end(), 0.0f);
-    
-    for (int tau = 1; tau < halfSize; ++tau) {
-        float sum = 0.0f;
-        for (int j = 0; j < halfSize; ++j) {
-            float delta = samples[j] - samples[j + tau];
-            sum += delta * delta;
-        }
-        yinBuffer[tau] = sum;
-    }
-    
-    // Step 2: Cumulative mean normalized difference
-    yinBuffer[0] = 1.0f;
-    float runningSum = 0.0f;
-    
-    for (int tau = 1; tau < halfSize; ++tau) {
-        runningSum += yinBuffer[tau];
-        yinBuffer[tau] *= static_cast<float>(tau) / runningSum;
-    }
-    
-    // Step 3: Absolute threshold
-    int tauEstimate = -1;
-    for (int tau = 2; tau < halfSize; ++tau) {
-        if (yinBuffer[tau] < threshold) {
-            while (tau + 1 < halfSize && yinBuffer[tau + 1] < yinBuffer[tau]) {
-                ++tau;
-            }
-            tauEstimate = tau;
-            break;
-        }
-    }
-    
-    if (tauEstimate < 0) {
-        return 0.0f;  // No pitch detected
-    }
-    
-    // Step 4: Parabolic interpolation
-    float betterTau;
-    if (tauEstimate > 0 && tauEstimate < halfSize - 1) {
-        float s0 = yinBuffer[tauEstimate - 1];
-        float s1 = yinBuffer[tauEstimate];
-        float s2 = yinBuffer[tauEstimate + 1];
-        betterTau = tauEstimate + (s2 - s0) / (2.0f * (2.0f * s1 - s2 - s0));
-    } else {
-        betterTau = static_cast<float>(tauEstimate);
-    }
-    
-    float pitch = static_cast<float>(sampleRate) / betterTau;
-    
-    // Validate pitch range
-    if (pitch < ParrotConfig::MIN_PITCH_HZ || pitch > ParrotConfig::MAX_PITCH_HZ) {
-        return 0.0f;
-    }
-    
-    return pitch;
+    // Overlapping FFT_SIZE frames, re-analysed every hop; holds the latest estimate
+    pitchTracker.pushSamples(samples, numSamples);
+    return pitchTracker.getPitch();
 }
 
 // === Formant Synthesis ===
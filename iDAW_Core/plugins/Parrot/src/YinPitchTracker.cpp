@@ -0,0 +1,191 @@
+/**
+ * YinPitchTracker.cpp - Streaming YIN pitch detector for "The Parrot"
+ */
+
+#include "../include/YinPitchTracker.h"
+
+#include <algorithm>
+
+namespace iDAW {
+
+namespace {
+
+int log2Int(int value) noexcept {
+    int order = 0;
+    while ((1 << order) < value) ++order;
+    return order;
+}
+
+} // namespace
+
+void YinPitchTracker::prepare(double sampleRate, int frameSize, int hopSize) {
+    m_sampleRate = sampleRate;
+    m_frameSize = 1 << log2Int(std::clamp(frameSize, 4, static_cast<int>(daiw::dsp::FFT_MAX_SIZE)));
+    m_hopSize = std::clamp(hopSize, 1, m_frameSize);
+
+    m_history.assign(static_cast<size_t>(2 * m_frameSize), 0.0f);
+
+    m_fft = daiw::dsp::fft_plan(static_cast<size_t>(m_frameSize));
+    m_packed.assign(static_cast<size_t>(m_frameSize), {});
+    m_spectrum.assign(static_cast<size_t>(m_frameSize / 2 + 1), {});
+    m_correlation.assign(static_cast<size_t>(m_frameSize), 0.0f);
+    m_yin.assign(static_cast<size_t>(m_frameSize / 2), 0.0f);
+
+    reset();
+}
+
+void YinPitchTracker::reset() noexcept {
+    std::fill(m_history.begin(), m_history.end(), 0.0f);
+    m_writePos = 0;
+    m_samplesSinceHop = 0;
+    m_pitch = 0.0f;
+    m_confidence = 0.0f;
+}
+
+void YinPitchTracker::setHopSize(int hopSize) noexcept {
+    if (m_frameSize == 0) return;
+    m_hopSize = std::clamp(hopSize, 1, m_frameSize);
+    m_samplesSinceHop = std::min(m_samplesSinceHop, m_hopSize - 1);
+}
+
+int YinPitchTracker::pushSamples(const float* samples, int numSamples) noexcept {
+    if (m_frameSize == 0) return 0;
+
+    const int mask = m_frameSize - 1;
+    int framesAnalysed = 0;
+
+    for (int i = 0; i < numSamples; ++i) {
+        m_history[static_cast<size_t>(m_writePos)] = samples[i];
+        m_history[static_cast<size_t>(m_writePos + m_frameSize)] = samples[i];
+        m_writePos = (m_writePos + 1) & mask;
+
+        if (++m_samplesSinceHop == m_hopSize) {
+            // Oldest sample sits at the write position; the double write keeps the frame contiguous
+            analyzeFrame(m_history.data() + m_writePos);
+            m_samplesSinceHop = 0;
+            ++framesAnalysed;
+        }
+    }
+
+    return framesAnalysed;
+}
+
+float YinPitchTracker::analyzeFrame(const float* frame) noexcept {
+    if (m_frameSize == 0) return 0.0f;
+
+    if (m_method == Method::FFT) {
+        differenceFFT(frame);
+    } else {
+        differenceDirect(frame);
+    }
+
+    m_pitch = pickPitch();
+    return m_pitch;
+}
+
+void YinPitchTracker::differenceDirect(const float* frame) noexcept {
+    const int halfSize = m_frameSize / 2;
+
+    m_yin[0] = 0.0f;
+    for (int tau = 1; tau < halfSize; ++tau) {
+        float sum = 0.0f;
+        for (int j = 0; j < halfSize; ++j) {
+            const float delta = frame[j] - frame[j + tau];
+            sum += delta * delta;
+        }
+        m_yin[static_cast<size_t>(tau)] = sum;
+    }
+}
+
+void YinPitchTracker::differenceFFT(const float* frame) noexcept {
+    const int size = m_frameSize;
+    const int halfSize = size / 2;
+    const int mask = size - 1;
+
+    // z = x + i * a, where a is x truncated to its first half
+    for (int j = 0; j < size; ++j) {
+        m_packed[static_cast<size_t>(j)] = { frame[j], j < halfSize ? frame[j] : 0.0f };
+    }
+    m_fft->forward(m_packed.data());
+
+    // Unpack X and A, then R = conj(A) * X, stored as a half spectrum
+    for (int k = 0; k <= halfSize; ++k) {
+        const std::complex<float> zk = m_packed[static_cast<size_t>(k)];
+        const std::complex<float> zn = std::conj(m_packed[static_cast<size_t>((size - k) & mask)]);
+        const std::complex<float> x = 0.5f * (zk + zn);
+        const std::complex<float> a = std::complex<float>(0.0f, -0.5f) * (zk - zn);
+        m_spectrum[static_cast<size_t>(k)] = std::conj(a) * x;
+    }
+    m_fft->inverse_real(m_spectrum.data(), m_correlation.data());
+
+    // d(tau) = E(0) + E(tau) - 2 r(tau), sliding the window energy in double
+    double energy0 = 0.0;
+    for (int j = 0; j < halfSize; ++j) {
+        energy0 += static_cast<double>(frame[j]) * frame[j];
+    }
+
+    double energyTau = energy0;
+    m_yin[0] = 0.0f;
+    for (int tau = 1; tau < halfSize; ++tau) {
+        const double leaving = frame[tau - 1];
+        const double entering = frame[tau - 1 + halfSize];
+        energyTau += entering * entering - leaving * leaving;
+
+        const double d = energy0 + energyTau - 2.0 * m_correlation[static_cast<size_t>(tau)];
+        m_yin[static_cast<size_t>(tau)] = static_cast<float>(std::max(0.0, d));
+    }
+}
+
+float YinPitchTracker::pickPitch() noexcept {
+    const int halfSize = m_frameSize / 2;
+
+    // Cumulative mean normalized difference
+    m_yin[0] = 1.0f;
+    float runningSum = 0.0f;
+    for (int tau = 1; tau < halfSize; ++tau) {
+        runningSum += m_yin[static_cast<size_t>(tau)];
+        m_yin[static_cast<size_t>(tau)] = runningSum > 0.0f
+            ? m_yin[static_cast<size_t>(tau)] * static_cast<float>(tau) / runningSum
+            : 1.0f;
+    }
+
+    // Absolute threshold, then walk down to the bottom of the dip
+    int tauEstimate = -1;
+    for (int tau = 2; tau < halfSize; ++tau) {
+        if (m_yin[static_cast<size_t>(tau)] < m_threshold) {
+            while (tau + 1 < halfSize && m_yin[static_cast<size_t>(tau + 1)] < m_yin[static_cast<size_t>(tau)]) {
+                ++tau;
+            }
+            tauEstimate = tau;
+            break;
+        }
+    }
+
+    if (tauEstimate < 0) {
+        m_confidence = 0.0f;
+        return 0.0f;
+    }
+
+    m_confidence = 1.0f - m_yin[static_cast<size_t>(tauEstimate)];
+
+    // Parabolic interpolation
+    float betterTau = static_cast<float>(tauEstimate);
+    if (tauEstimate < halfSize - 1) {
+        const float s0 = m_yin[static_cast<size_t>(tauEstimate - 1)];
+        const float s1 = m_yin[static_cast<size_t>(tauEstimate)];
+        const float s2 = m_yin[static_cast<size_t>(tauEstimate + 1)];
+        const float denom = 2.0f * (2.0f * s1 - s2 - s0);
+        if (denom != 0.0f) {
+            betterTau += (s2 - s0) / denom;
+        }
+    }
+
+    const float pitch = static_cast<float>(m_sampleRate) / betterTau;
+    if (pitch < m_minHz || pitch > m_maxHz) {
+        return 0.0f;
+    }
+
+    return pitch;
+}
+
+} // namespace iDAW
@@ -0,0 +1,66 @@
+/**
+ * BiquadBank.h - The Pencil's three bandpass biquads for both channels at once
+ *
+ * Lane layout (one 8-wide vector per sample on AVX2/AVX-512 builds):
+ *
+ *   [ L low | L mid | L high | pad | R low | R mid | R high | pad ]
+ *
+ * Every lane is an independent transposed direct form II section, so one
+ * fused multiply-add chain advances all six filters per sample. Outputs are
+ * transposed back to one buffer per channel and band in tiles of 8 samples.
+ * Builds without AVX run the same recursion with scalar lanes.
+ */
+
+#pragma once
+
+#include <array>
+
+namespace iDAW {
+
+/**
+ * Biquad filter coefficients
+ */
+struct BiquadCoeffs {
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;  // Numerator
+    float a1 = 0.0f, a2 = 0.0f;              // Denominator (a0 normalized to 1)
+};
+
+class BiquadBank {
+public:
+    static constexpr int NUM_BANDS = 3;
+    static constexpr int NUM_CHANNELS = 2;
+    static constexpr int LANES_PER_CHANNEL = 4;
+    static constexpr int NUM_LANES = NUM_CHANNELS * LANES_PER_CHANNEL;
+
+    using ChannelOutputs = std::array<float*, NUM_BANDS>;
+
+    /** All band lanes pass through, pad lanes are silent */
+    BiquadBank();
+
+    /** Set one band's coefficients (shared by both channels) */
+    void setCoefficients(int band, const BiquadCoeffs& coeffs) noexcept;
+
+    /** Clear filter history */
+    void reset() noexcept;
+
+    /**
+     * Filter both channels through all bands.
+     * @param left, right numSamples inputs (right may equal left)
+     * @param leftOut, rightOut One numSamples buffer per band
+     */
+    void process(const float* left, const float* right,
+                 const ChannelOutputs& leftOut, const ChannelOutputs& rightOut,
+                 int numSamples) noexcept;
+
+private:
+    // Structure of arrays: one coefficient/state per lane
+    alignas(32) float m_b0[NUM_LANES];
+    alignas(32) float m_b1[NUM_LANES];
+    alignas(32) float m_b2[NUM_LANES];
+    alignas(32) float m_a1[NUM_LANES];
+    alignas(32) float m_a2[NUM_LANES];
+    alignas(32) float m_z1[NUM_LANES];
+    alignas(32) float m_z2[NUM_LANES];
+};
+
+} // namespace iDAW
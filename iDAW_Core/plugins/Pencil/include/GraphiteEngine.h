@@ -0,0 +1,122 @@
+/**
+ * GraphiteEngine.h - Block DSP core of "The Pencil"
+ *
+ * Per block:
+ *
+ *   input -> upsample (1x/2x/4x) -> 3 bandpass biquads -> TubeDrive
+ *         -> parallel dry/wet per band -> sum with dry -> downsample
+ *
+ * Both channels go through one call so the six band filters run together
+ * as a SIMD biquad bank (BiquadBank.h).
+ *
+ * Everything between the oversampler's up and down paths runs at the
+ * oversampled rate, so the drive's harmonics above the base Nyquist are
+ * filtered out instead of folding back, and every path sees the same
+ * (integer) latency.
+ */
+
+#pragma once
+
+#include "BiquadBank.h"
+#include "PolyphaseOversampler.h"
+#include <array>
+#include <vector>
+
+namespace iDAW {
+
+/**
+ * Configuration for The Pencil processor
+ */
+struct PencilConfig {
+    // Band frequency crossovers
+    static constexpr float LOW_CROSSOVER = 250.0f;    // Hz
+    static constexpr float HIGH_CROSSOVER = 4000.0f;  // Hz
+
+    // Default Q factors for bandpass filters
+    static constexpr float LOW_Q = 0.707f;
+    static constexpr float MID_Q = 1.0f;
+    static constexpr float HIGH_Q = 0.707f;
+
+    // Saturation parameters
+    static constexpr float MAX_DRIVE = 10.0f;         // Maximum drive amount
+    static constexpr float HEADROOM_DB = -6.0f;       // Headroom to prevent clipping
+};
+
+/**
+ * Oversampling around the drive section
+ */
+enum class PencilOversampling {
+    Off = 1,
+    X2 = 2,
+    X4 = 4
+};
+
+/**
+ * Band parameters for each frequency band
+ */
+struct BandParameters {
+    float frequency = 1000.0f;  // Center frequency (Hz)
+    float q = 1.0f;             // Q factor
+    float drive = 1.0f;         // Drive amount (1.0 = unity, >1 = saturation)
+    float mix = 0.5f;           // Dry/wet mix (0 = dry, 1 = wet)
+    bool enabled = true;        // Band enable/bypass
+};
+
+class GraphiteEngine {
+public:
+    static constexpr int NUM_BANDS = BiquadBank::NUM_BANDS;
+    static constexpr int MAX_CHANNELS = BiquadBank::NUM_CHANNELS;
+
+    GraphiteEngine() = default;
+
+    /** Allocate for blocks of up to maxBlockSize samples. Not RT-safe. */
+    void prepare(double sampleRate, int maxBlockSize);
+
+    /** Clear filter and oversampler history */
+    void reset() noexcept;
+
+    /**
+     * Switch oversampling (RT-safe). Recomputes band filters for the new
+     * rate and clears history.
+     */
+    void setOversampling(PencilOversampling mode) noexcept;
+    PencilOversampling getOversampling() const noexcept { return m_oversampling; }
+
+    /** Delay added by oversampling, in base-rate samples */
+    int getLatencySamples() const noexcept { return m_oversamplers[0].getLatencySamples(); }
+
+    /** Recompute one band's bandpass (RBJ) at the current processing rate */
+    void setBandFilter(int bandIndex, float frequency, float q) noexcept;
+
+    /**
+     * Process up to MAX_CHANNELS channels in place (extra channels are
+     * left untouched).
+     * @param bands Drive/mix/enable per band (frequency/q are taken from
+     *        the last setBandFilter() call)
+     * @param bandPeaks Per-band running max of |band output|, updated
+     */
+    void process(float* const* channels, int numChannels, int numSamples,
+                 const std::array<BandParameters, NUM_BANDS>& bands,
+                 std::array<float, NUM_BANDS>& bandPeaks) noexcept;
+
+private:
+    void processChunk(float* const* channels, int numChannels, int offset, int numSamples,
+                      const std::array<BandParameters, NUM_BANDS>& bands,
+                      std::array<float, NUM_BANDS>& bandPeaks) noexcept;
+
+    double m_sampleRate = 44100.0;
+    int m_maxBlockSize = 0;
+    PencilOversampling m_oversampling = PencilOversampling::X2;
+
+    std::array<float, NUM_BANDS> m_bandFrequency = {120.0f, 1000.0f, 8000.0f};
+    std::array<float, NUM_BANDS> m_bandQ = {PencilConfig::LOW_Q, PencilConfig::MID_Q, PencilConfig::HIGH_Q};
+    BiquadBank m_filters;
+
+    std::array<PolyphaseOversampler, MAX_CHANNELS> m_oversamplers;
+
+    // Oversampled-rate scratch per channel (maxBlockSize * MAX_FACTOR)
+    std::array<std::vector<float>, MAX_CHANNELS> m_mixBuffers;
+    std::array<std::array<std::vector<float>, NUM_BANDS>, MAX_CHANNELS> m_bandBuffers;
+};
+
+} // namespace iDAW
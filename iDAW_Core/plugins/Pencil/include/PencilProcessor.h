@@ -9,6 +9,7 @@
  * Features:
  * - 3 Parallel Bandpass Filters (Low, Mid, High)
  * - TubeDrive per band with tanh/polynomial saturation
+ * - Selectable 2x/4x polyphase oversampling around the drive section
  * - Parallel dry/wet mixing
  * - Ghost Hands AI integration for "Warmth" suggestions
  * - Visual feedback: Drive → LineThickness/LineNoise mapping
@@ -17,41 +18,13 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "GraphiteEngine.h"
 #include <array>
 #include <atomic>
 #include <cmath>
 
 namespace iDAW {
 
-/**
- * Configuration for The Pencil processor
- */
-struct PencilConfig {
-    // Band frequency crossovers
-    static constexpr float LOW_CROSSOVER = 250.0f;    // Hz
-    static constexpr float HIGH_CROSSOVER = 4000.0f;  // Hz
-    
-    // Default Q factors for bandpass filters
-    static constexpr float LOW_Q = 0.707f;
-    static constexpr float MID_Q = 1.0f;
-    static constexpr float HIGH_Q = 0.707f;
-    
-    // Saturation parameters
-    static constexpr float MAX_DRIVE = 10.0f;         // Maximum drive amount
-    static constexpr float HEADROOM_DB = -6.0f;       // Headroom to prevent clipping
-};
-
-/**
- * Band parameters for each frequency band
- */
-struct BandParameters {
-    float frequency = 1000.0f;  // Center frequency (Hz)
-    float q = 1.0f;             // Q factor
-    float drive = 1.0f;         // Drive amount (1.0 = unity, >1 = saturation)
-    float mix = 0.5f;           // Dry/wet mix (0 = dry, 1 = wet)
-    bool enabled = true;        // Band enable/bypass
-};
-
 /**
  * Visual feedback state for OpenGL shader
  */
@@ -62,30 +35,15 @@ struct GraphiteVisualState {
     std::array<float, 3> bandLevels = {0.0f, 0.0f, 0.0f};  // Per-band output levels
 };
 
-/**
- * Biquad filter state for each band
- */
-struct BiquadState {
-    float x1 = 0.0f, x2 = 0.0f;  // Input history
-    float y1 = 0.0f, y2 = 0.0f;  // Output history
-};
-
-/**
- * Biquad filter coefficients
- */
-struct BiquadCoeffs {
-    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;  // Numerator
-    float a1 = 0.0f, a2 = 0.0f;              // Denominator (a0 normalized to 1)
-};
-
 /**
  * PencilProcessor - Tube Saturation / Additive EQ Processor
  * 
  * Algorithm:
- * 1. Split input into 3 frequency bands (Low, Mid, High)
- * 2. Apply TubeDrive saturation to each band
- * 3. Mix saturated bands back with dry signal (parallel processing)
- * 4. Sum all bands to output
+ * 1. Upsample (off / 2x / 4x) so the drive's harmonics do not alias
+ * 2. Split into 3 frequency bands (Low, Mid, High)
+ * 3. Apply TubeDrive saturation to each band
+ * 4. Mix saturated bands back with dry signal (parallel processing)
+ * 5. Sum all bands to output and downsample
  * 
  * Saturation uses tanh-based soft clipping with asymmetric
  * characteristics to generate even (2nd order) harmonics.
@@ -158,6 +116,13 @@ public:
     void setOutputGain(float gainDb);
     float getOutputGain() const { return m_outputGainDb.load(); }
     
+    /**
+     * Set oversampling around the drive section (applied on the next block).
+     * Changes the reported latency.
+     */
+    void setOversampling(PencilOversampling mode);
+    PencilOversampling getOversampling() const { return m_oversampling.load(); }
+    
     //==========================================================================
     // Ghost Hands Integration
     //==========================================================================
@@ -196,27 +161,6 @@ private:
     // DSP Processing
     //==========================================================================
     
-    /**
-     * Process a single sample through all bands
-     */
-    float processSample(float input, int channel);
-    
-    /**
-     * Apply bandpass filter
-     */
-    float applyBandpass(float input, int bandIndex, int channel);
-    
-    /**
-     * Apply tube drive saturation
-     * Generates 2nd order harmonics using asymmetric tanh
-     */
-    float applyTubeDrive(float input, float drive);
-    
-    /**
-     * Tanh-based soft saturation with asymmetry for even harmonics
-     */
-    float tubeSaturate(float x, float drive);
-    
     /**
      * Calculate biquad coefficients for bandpass filter
      */
@@ -228,12 +172,10 @@ private:
     void updateVisualState();
     
     //==========================================================================
-    // Filter State
+    // DSP
     //==========================================================================
     
-    // 3 bands x 2 channels
-    std::array<std::array<BiquadState, 2>, 3> m_filterState;
-    std::array<BiquadCoeffs, 3> m_filterCoeffs;
+    GraphiteEngine m_engine;
     
     //==========================================================================
     // Parameters
@@ -242,6 +184,7 @@ private:
     std::array<BandParameters, 3> m_bandParams;
     std::atomic<float> m_outputGainDb{0.0f};
     std::atomic<float> m_outputGainLinear{1.0f};
+    std::atomic<PencilOversampling> m_oversampling{PencilOversampling::X2};
     
     //==========================================================================
     // Visual State
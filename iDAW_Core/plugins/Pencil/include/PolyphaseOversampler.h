@@ -0,0 +1,96 @@
+/**
+ * PolyphaseOversampler.h - 1x/2x/4x oversampling for "The Pencil" drive stage
+ *
+ * Cascade of linear-phase halfband FIR stages, each run in polyphase form:
+ *
+ *   up:   x[n] -> (FIR phase, delayed copy) -> 2 samples   per stage
+ *   down: 2 samples -> 1 FIR output (only the kept phase is computed)
+ *
+ * Halfband taps are zero at every even offset from the centre, so each
+ * stage costs one symmetric M-tap FIR per base-rate sample. Stage 1 runs the
+ * steep filter (it guards the audio band); stage 2 only has to reject
+ * images above the already band-limited 2x spectrum and is much shorter.
+ *
+ * The up/down round trip is a pure integer delay (getLatencySamples()), so
+ * callers that mix in the oversampled domain stay phase aligned.
+ *
+ * All memory is allocated in prepare(); upsample()/downsample() are RT-safe.
+ */
+
+#pragma once
+
+#include <vector>
+
+namespace iDAW {
+
+class PolyphaseOversampler {
+public:
+    static constexpr int MAX_FACTOR = 4;
+
+    PolyphaseOversampler() = default;
+
+    /**
+     * Allocate for blocks of up to maxBlockSize base-rate samples at any
+     * factor. Not RT-safe.
+     */
+    void prepare(int maxBlockSize);
+
+    /** Clear filter history (keeps configuration) */
+    void reset() noexcept;
+
+    /**
+     * Select 1x, 2x or 4x (other values round down to one of these).
+     * RT-safe; clears history when the factor changes.
+     */
+    void setFactor(int factor) noexcept;
+
+    int getFactor() const noexcept { return m_factor; }
+
+    /** Round-trip delay of upsample() + downsample() in base-rate samples */
+    int getLatencySamples() const noexcept { return m_latency; }
+
+    /**
+     * Upsample numSamples base-rate samples.
+     * @return Pointer to numSamples * getFactor() samples, valid until the
+     *         next upsample() call
+     */
+    const float* upsample(const float* input, int numSamples) noexcept;
+
+    /**
+     * Downsample numSamples * getFactor() samples into numSamples outputs.
+     * input may be the buffer returned by upsample().
+     */
+    void downsample(const float* input, float* output, int numSamples) noexcept;
+
+private:
+    /** One 2x halfband stage with its own up and down histories */
+    struct Stage {
+        int halfLength = 0;            // M: taps per side of the FIR phase
+        std::vector<float> taps;       // a[m] at offsets +-(2m+1) from centre
+        std::vector<float> upHistory;  // [2M-1 past inputs | block]
+        std::vector<float> downHistory;// [4M-2 past inputs | block]
+
+        void prepare(int halfLength, float kaiserBeta, int maxInput);
+        void reset() noexcept;
+        void upsample(const float* input, float* output, int numInput) noexcept;
+        void downsample(const float* input, float* output, int numOutput) noexcept;
+    };
+
+    int m_factor = 1;
+    int m_latency = 0;
+    int m_maxBlockSize = 0;
+
+    Stage m_stage1;
+    Stage m_stage2;
+
+    // Whole-sample delay at 4x that makes the stage 2 round trip a multiple
+    // of the base-rate period
+    std::vector<float> m_padHistory;
+    int m_padLength = 0;
+
+    std::vector<float> m_upBuffer1;   // 2x signal
+    std::vector<float> m_upBuffer2;   // 4x signal
+    std::vector<float> m_downBuffer;  // 2x signal on the way down
+};
+
+} // namespace iDAW
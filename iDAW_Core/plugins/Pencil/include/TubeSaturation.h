@@ -0,0 +1,156 @@
+/**
+ * TubeSaturation.h - TubeDrive transfer curve for "The Pencil"
+ *
+ * The asymmetric triode curve (tanh halves with different slopes, an added
+ * 2nd-harmonic term, and a cubic soft knee blended in by drive) evaluated
+ * without branches or libm calls:
+ *
+ * - tanh is a [7/6] Lambert continued-fraction rational, |error| < 1e-4
+ * - the positive/negative halves are selected with masks
+ * - per-drive constants (blend, makeup gain) are hoisted out of the loop
+ * - tubeDriveMix() runs 8 samples per step on AVX2/AVX-512 builds
+ *
+ * tubeSaturateReference() keeps the original std::tanh form for tests and
+ * benchmarks.
+ */
+
+#pragma once
+
+#include "daiw/simd.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace iDAW {
+
+/**
+ * Rational tanh approximation, exact to 1e-4 over the whole real line
+ */
+inline float fastTanh(float x) noexcept {
+    // Beyond +-4.97 the rational overshoots 1; tanh is 1 - 1e-4 there
+    x = std::min(std::max(x, -4.97f), 4.97f);
+    const float x2 = x * x;
+    const float num = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+    const float den = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + 28.0f * x2));
+    return num / den;
+}
+
+/**
+ * Per-drive constants of the TubeDrive curve
+ */
+struct TubeDriveShape {
+    float drive = 1.0f;
+    float blend = 0.0f;         // tanh share; the cubic knee gets 1 - blend
+    float compensation = 1.0f;  // Makeup for the level lost to drive
+
+    TubeDriveShape() = default;
+
+    TubeDriveShape(float driveAmount, float maxDrive)
+        : drive(driveAmount)
+        , blend(std::min((driveAmount - 1.0f) / (maxDrive - 1.0f), 1.0f))
+        , compensation(1.0f / std::sqrt(driveAmount)) {}
+
+    /** Branch-free curve for one sample */
+    float operator()(float x) const noexcept {
+        const float scaled = x * drive;
+
+        // Positive half: softer (tanh(0.8x)); negative half: 0.95 tanh(x)
+        const bool positive = scaled >= 0.0f;
+        const float slope = positive ? 0.8f : 1.0f;
+        const float gain = positive ? 1.0f : 0.95f;
+        float saturated = gain * fastTanh(scaled * slope);
+
+        // Explicit 2nd harmonic for warmth
+        saturated += scaled * scaled * 0.05f * (1.0f - std::abs(saturated));
+
+        const float polynomial = scaled - (scaled * scaled * scaled) / 3.0f;
+        return (saturated * blend + polynomial * (1.0f - blend)) * compensation;
+    }
+};
+
+/**
+ * Parallel drive in place: samples[i] = samples[i] * dry + shape(samples[i]) * wet
+ */
+inline void tubeDriveMix(float* samples, int numSamples, const TubeDriveShape& shape,
+                         float dry, float wet) noexcept {
+    int i = 0;
+
+#if defined(DAIW_AVX2) || defined(DAIW_AVX512)
+    const __m256 drive = _mm256_set1_ps(shape.drive);
+    const __m256 blend = _mm256_set1_ps(shape.blend);
+    const __m256 knee = _mm256_set1_ps(1.0f - shape.blend);
+    const __m256 compensation = _mm256_set1_ps(shape.compensation);
+    const __m256 dryGain = _mm256_set1_ps(dry);
+    const __m256 wetGain = _mm256_set1_ps(wet);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 limit = _mm256_set1_ps(4.97f);
+    const __m256 third = _mm256_set1_ps(1.0f / 3.0f);
+
+    for (; i + 8 <= numSamples; i += 8) {
+        const __m256 x = _mm256_loadu_ps(samples + i);
+        const __m256 scaled = _mm256_mul_ps(x, drive);
+
+        // Positive half: tanh(0.8x); negative half: 0.95 tanh(x)
+        const __m256 positive = _mm256_cmp_ps(scaled, zero, _CMP_GE_OQ);
+        const __m256 slope = _mm256_blendv_ps(one, _mm256_set1_ps(0.8f), positive);
+        const __m256 gain = _mm256_blendv_ps(_mm256_set1_ps(0.95f), one, positive);
+
+        __m256 t = _mm256_mul_ps(scaled, slope);
+        t = _mm256_min_ps(_mm256_max_ps(t, _mm256_sub_ps(zero, limit)), limit);
+        const __m256 t2 = _mm256_mul_ps(t, t);
+        __m256 num = _mm256_add_ps(t2, _mm256_set1_ps(378.0f));
+        num = _mm256_fmadd_ps(num, t2, _mm256_set1_ps(17325.0f));
+        num = _mm256_fmadd_ps(num, t2, _mm256_set1_ps(135135.0f));
+        num = _mm256_mul_ps(num, t);
+        __m256 den = _mm256_fmadd_ps(_mm256_set1_ps(28.0f), t2, _mm256_set1_ps(3150.0f));
+        den = _mm256_fmadd_ps(den, t2, _mm256_set1_ps(62370.0f));
+        den = _mm256_fmadd_ps(den, t2, _mm256_set1_ps(135135.0f));
+        __m256 saturated = _mm256_mul_ps(gain, _mm256_div_ps(num, den));
+
+        // Explicit 2nd harmonic for warmth
+        const __m256 scaled2 = _mm256_mul_ps(scaled, scaled);
+        const __m256 headroom = _mm256_sub_ps(one, _mm256_andnot_ps(signMask, saturated));
+        saturated = _mm256_fmadd_ps(_mm256_mul_ps(scaled2, _mm256_set1_ps(0.05f)), headroom, saturated);
+
+        // Cubic soft knee, blended by drive
+        const __m256 polynomial = _mm256_fnmadd_ps(_mm256_mul_ps(scaled2, scaled), third, scaled);
+        __m256 shaped = _mm256_fmadd_ps(saturated, blend, _mm256_mul_ps(polynomial, knee));
+        shaped = _mm256_mul_ps(shaped, compensation);
+
+        _mm256_storeu_ps(samples + i, _mm256_fmadd_ps(x, dryGain, _mm256_mul_ps(shaped, wetGain)));
+    }
+#endif
+
+    for (; i < numSamples; ++i) {
+        samples[i] = samples[i] * dry + shape(samples[i]) * wet;
+    }
+}
+
+/**
+ * Original per-sample curve using std::tanh (reference for tests/benchmarks)
+ */
+inline float tubeSaturateReference(float x, float drive, float maxDrive) noexcept {
+    float scaled = x * drive;
+
+    float saturated;
+    if (scaled >= 0.0f) {
+        saturated = std::tanh(scaled * 0.8f);
+    } else {
+        saturated = std::tanh(scaled * 1.0f) * 0.95f;
+    }
+
+    float secondHarmonic = scaled * scaled * 0.05f;
+    saturated += secondHarmonic * (1.0f - std::abs(saturated));
+
+    float polynomial = scaled - (scaled * scaled * scaled) / 3.0f;
+
+    float blendFactor = std::min((drive - 1.0f) / (maxDrive - 1.0f), 1.0f);
+    float result = saturated * blendFactor + polynomial * (1.0f - blendFactor);
+
+    float compensation = 1.0f / std::sqrt(drive);
+
+    return result * compensation;
+}
+
+} // namespace iDAW
@@ -0,0 +1,104 @@
+/**
+ * BiquadBank.cpp - Stereo three-band TDF-II biquad bank for "The Pencil"
+ */
+
+#include "BiquadBank.h"
+#include "daiw/simd.hpp"
+
+namespace iDAW {
+
+BiquadBank::BiquadBank() {
+    for (int lane = 0; lane < NUM_LANES; ++lane) {
+        const bool pad = lane % LANES_PER_CHANNEL == NUM_BANDS;
+        m_b0[lane] = pad ? 0.0f : 1.0f;
+        m_b1[lane] = m_b2[lane] = m_a1[lane] = m_a2[lane] = 0.0f;
+    }
+    reset();
+}
+
+void BiquadBank::setCoefficients(int band, const BiquadCoeffs& coeffs) noexcept {
+    if (band < 0 || band >= NUM_BANDS) return;
+
+    for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+        const int lane = channel * LANES_PER_CHANNEL + band;
+        m_b0[lane] = coeffs.b0;
+        m_b1[lane] = coeffs.b1;
+        m_b2[lane] = coeffs.b2;
+        m_a1[lane] = coeffs.a1;
+        m_a2[lane] = coeffs.a2;
+    }
+}
+
+void BiquadBank::reset() noexcept {
+    for (int lane = 0; lane < NUM_LANES; ++lane) {
+        m_z1[lane] = 0.0f;
+        m_z2[lane] = 0.0f;
+    }
+}
+
+void BiquadBank::process(const float* left, const float* right,
+                         const ChannelOutputs& leftOut, const ChannelOutputs& rightOut,
+                         int numSamples) noexcept {
+    int i = 0;
+
+#if defined(DAIW_AVX2) || defined(DAIW_AVX512)
+    const __m256 b0 = _mm256_load_ps(m_b0);
+    const __m256 b1 = _mm256_load_ps(m_b1);
+    const __m256 b2 = _mm256_load_ps(m_b2);
+    const __m256 a1 = _mm256_load_ps(m_a1);
+    const __m256 a2 = _mm256_load_ps(m_a2);
+    __m256 z1 = _mm256_load_ps(m_z1);
+    __m256 z2 = _mm256_load_ps(m_z2);
+
+    // y = b0 x + z1;  z1 = b1 x - a1 y + z2;  z2 = b2 x - a2 y
+    auto step = [&](int n) noexcept {
+        const __m256 x = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(left[n])),
+                                              _mm_set1_ps(right[n]), 1);
+        const __m256 y = _mm256_fmadd_ps(b0, x, z1);
+        z1 = _mm256_fnmadd_ps(a1, y, _mm256_fmadd_ps(b1, x, z2));
+        z2 = _mm256_fnmadd_ps(a2, y, _mm256_mul_ps(b2, x));
+        return y;
+    };
+
+    for (; i + 8 <= numSamples; i += 8) {
+        __m256 tile[8];
+        for (int k = 0; k < 8; ++k) {
+            tile[k] = step(i + k);
+        }
+        daiw::simd::transpose8x8(tile);
+
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            _mm256_storeu_ps(leftOut[band] + i, tile[band]);
+            _mm256_storeu_ps(rightOut[band] + i, tile[LANES_PER_CHANNEL + band]);
+        }
+    }
+
+    for (; i < numSamples; ++i) {
+        alignas(32) float y[NUM_LANES];
+        _mm256_store_ps(y, step(i));
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            leftOut[band][i] = y[band];
+            rightOut[band][i] = y[LANES_PER_CHANNEL + band];
+        }
+    }
+
+    _mm256_store_ps(m_z1, z1);
+    _mm256_store_ps(m_z2, z2);
+#else
+    for (; i < numSamples; ++i) {
+        for (int channel = 0; channel < NUM_CHANNELS; ++channel) {
+            const float x = channel == 0 ? left[i] : right[i];
+            const ChannelOutputs& out = channel == 0 ? leftOut : rightOut;
+            for (int band = 0; band < NUM_BANDS; ++band) {
+                const int lane = channel * LANES_PER_CHANNEL + band;
+                const float y = m_b0[lane] * x + m_z1[lane];
+                m_z1[lane] = m_b1[lane] * x - m_a1[lane] * y + m_z2[lane];
+                m_z2[lane] = m_b2[lane] * x - m_a2[lane] * y;
+                out[band][i] = y;
+            }
+        }
+    }
+#endif
+}
+
+} // namespace iDAW
@@ -0,0 +1,148 @@
+/**
+ * GraphiteEngine.cpp - Block DSP core of "The Pencil"
+ */
+
+#include "GraphiteEngine.h"
+#include "TubeSaturation.h"
+#include "daiw/simd.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace iDAW {
+
+void GraphiteEngine::prepare(double sampleRate, int maxBlockSize) {
+    m_sampleRate = sampleRate;
+    m_maxBlockSize = std::max(1, maxBlockSize);
+
+    for (auto& oversampler : m_oversamplers) {
+        oversampler.prepare(m_maxBlockSize);
+        oversampler.setFactor(static_cast<int>(m_oversampling));
+    }
+
+    const size_t scratchSize = static_cast<size_t>(m_maxBlockSize) * PolyphaseOversampler::MAX_FACTOR;
+    for (int channel = 0; channel < MAX_CHANNELS; ++channel) {
+        m_mixBuffers[channel].assign(scratchSize, 0.0f);
+        for (auto& bandBuffer : m_bandBuffers[channel]) {
+            bandBuffer.assign(scratchSize, 0.0f);
+        }
+    }
+
+    for (int band = 0; band < NUM_BANDS; ++band) {
+        setBandFilter(band, m_bandFrequency[band], m_bandQ[band]);
+    }
+    reset();
+}
+
+void GraphiteEngine::reset() noexcept {
+    m_filters.reset();
+    for (auto& oversampler : m_oversamplers) {
+        oversampler.reset();
+    }
+}
+
+void GraphiteEngine::setOversampling(PencilOversampling mode) noexcept {
+    if (mode == m_oversampling) return;
+
+    m_oversampling = mode;
+    for (auto& oversampler : m_oversamplers) {
+        oversampler.setFactor(static_cast<int>(mode));
+    }
+    for (int band = 0; band < NUM_BANDS; ++band) {
+        setBandFilter(band, m_bandFrequency[band], m_bandQ[band]);
+    }
+    reset();
+}
+
+void GraphiteEngine::setBandFilter(int bandIndex, float frequency, float q) noexcept {
+    if (bandIndex < 0 || bandIndex >= NUM_BANDS) return;
+
+    m_bandFrequency[bandIndex] = frequency;
+    m_bandQ[bandIndex] = q;
+
+    // Bandpass filter coefficient calculation (RBJ Audio EQ Cookbook),
+    // designed at the oversampled rate the filters actually run at
+    const float processRate = static_cast<float>(m_sampleRate) * static_cast<float>(m_oversampling);
+    const float w0 = 2.0f * 3.14159265358979f * frequency / processRate;
+    const float cosW0 = std::cos(w0);
+    const float sinW0 = std::sin(w0);
+    const float alpha = sinW0 / (2.0f * q);
+
+    // Bandpass (constant skirt gain, peak gain = Q)
+    const float b0 = alpha;
+    const float b1 = 0.0f;
+    const float b2 = -alpha;
+    const float a0 = 1.0f + alpha;
+    const float a1 = -2.0f * cosW0;
+    const float a2 = 1.0f - alpha;
+
+    // Normalize coefficients
+    BiquadCoeffs coeffs;
+    coeffs.b0 = b0 / a0;
+    coeffs.b1 = b1 / a0;
+    coeffs.b2 = b2 / a0;
+    coeffs.a1 = a1 / a0;
+    coeffs.a2 = a2 / a0;
+    m_filters.setCoefficients(bandIndex, coeffs);
+}
+
+void GraphiteEngine::process(float* const* channels, int numChannels, int numSamples,
+                             const std::array<BandParameters, NUM_BANDS>& bands,
+                             std::array<float, NUM_BANDS>& bandPeaks) noexcept {
+    numChannels = std::min(numChannels, MAX_CHANNELS);
+    if (numChannels <= 0 || m_maxBlockSize == 0) return;
+
+    // The oversampler and scratch buffers hold m_maxBlockSize base-rate samples
+    for (int offset = 0; offset < numSamples; offset += m_maxBlockSize) {
+        const int chunk = std::min(m_maxBlockSize, numSamples - offset);
+        processChunk(channels, numChannels, offset, chunk, bands, bandPeaks);
+    }
+}
+
+void GraphiteEngine::processChunk(float* const* channels, int numChannels, int offset, int numSamples,
+                                  const std::array<BandParameters, NUM_BANDS>& bands,
+                                  std::array<float, NUM_BANDS>& bandPeaks) noexcept {
+    const int numOversampled = numSamples * static_cast<int>(m_oversampling);
+    const size_t n = static_cast<size_t>(numOversampled);
+
+    std::array<const float*, MAX_CHANNELS> input{};
+    std::array<BiquadBank::ChannelOutputs, MAX_CHANNELS> filtered;
+    for (int channel = 0; channel < MAX_CHANNELS; ++channel) {
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            filtered[channel][band] = m_bandBuffers[channel][band].data();
+        }
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        input[channel] = m_oversamplers[channel].upsample(channels[channel] + offset, numSamples);
+
+        // Original signal provides foundation, bands add color
+        daiw::simd::copy_with_gain(m_mixBuffers[channel].data(), input[channel], n, 0.5f);
+    }
+
+    // Mono feeds the right lanes a copy; their output goes unused
+    m_filters.process(input[0], input[numChannels - 1], filtered[0], filtered[1], numOversampled);
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        float* mix = m_mixBuffers[channel].data();
+
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            const BandParameters& params = bands[band];
+            if (!params.enabled) continue;
+
+            float* bandOutput = filtered[channel][band];
+            if (params.drive > 1.0f) {
+                // Parallel mix of the band and its saturated copy
+                const TubeDriveShape shape(params.drive, PencilConfig::MAX_DRIVE);
+                tubeDriveMix(bandOutput, numOversampled, shape, 1.0f - params.mix, params.mix);
+            }
+            // (unity drive: wet and dry are the same signal)
+
+            bandPeaks[band] = std::max(bandPeaks[band], daiw::simd::find_peak(bandOutput, n));
+            daiw::simd::mix_buffers(mix, bandOutput, n, 0.5f);
+        }
+
+        m_oversamplers[channel].downsample(mix, channels[channel] + offset, numSamples);
+    }
+}
+
+} // namespace iDAW
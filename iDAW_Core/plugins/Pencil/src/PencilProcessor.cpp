@@ -4,8 +4,10 @@
  * Profile: 'Graphite' (Tube Saturation / Additive EQ)
  * 
  * Implements parallel multi-band saturation with:
- * - 3 Parallel Bandpass Filters (Low, Mid, High)
+ * - 3 Parallel Bandpass Filters (Low, Mid, High), both channels in one
+ *   SIMD biquad bank
  * - TubeDrive per band generating 2nd order harmonics
+ * - 2x/4x polyphase oversampling with a rational tanh (no aliasing, no libm)
  * - Parallel dry/wet processing
  * - Ghost Hands AI integration
  */
@@ -59,15 +61,13 @@ PencilProcessor::~PencilProcessor() = default;
 // AudioProcessor Interface
 //==============================================================================
 
-void PencilProcessor::prepareToPlay(double sampleRate, int /*samplesPerBlock*/) {
+void PencilProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
     m_sampleRate = sampleRate;
     
-    // Clear filter states
-    for (auto& bandState : m_filterState) {
-        for (auto& channelState : bandState) {
-            channelState = BiquadState();
-        }
-    }
+    // Allocates oversampling buffers and clears filter states
+    m_engine.setOversampling(m_oversampling.load());
+    m_engine.prepare(sampleRate, samplesPerBlock);
+    setLatencySamples(m_engine.getLatencySamples());
     
     // Calculate filter coefficients for each band
     for (int band = 0; band < 3; ++band) {
@@ -90,13 +90,23 @@ void PencilProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
     
-    // Process each sample
-    for (int channel = 0; channel < std::min(numChannels, 2); ++channel) {
-        float* channelData = buffer.getWritePointer(channel);
-        
-        for (int sample = 0; sample < numSamples; ++sample) {
-            channelData[sample] = processSample(channelData[sample], channel);
-        }
+    // Pick up an oversampling change between blocks
+    const PencilOversampling oversampling = m_oversampling.load();
+    if (oversampling != m_engine.getOversampling()) {
+        m_engine.setOversampling(oversampling);
+        setLatencySamples(m_engine.getLatencySamples());
+    }
+    
+    // Both channels run through the band/drive engine together
+    std::array<float, 3> bandPeaks = {0.0f, 0.0f, 0.0f};
+    m_engine.process(buffer.getArrayOfWritePointers(), numChannels, numSamples,
+                     m_bandParams, bandPeaks);
+    
+    // Track levels for metering (peak hold with per-sample decay)
+    const float blockDecay = std::pow(LEVEL_DECAY, static_cast<float>(numSamples));
+    for (int band = 0; band < 3; ++band) {
+        const float currentLevel = m_bandLevels[band].load();
+        m_bandLevels[band].store(std::max(bandPeaks[band], currentLevel * blockDecay));
     }
     
     // Apply output gain
@@ -109,131 +119,8 @@ void PencilProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     updateVisualState();
 }
 
-float PencilProcessor::processSample(float input, int channel) {
-    float output = 0.0f;
-    float drySignal = input;
-    
-    // Process each band in parallel
-    for (int band = 0; band < 3; ++band) {
-        if (!m_bandParams[band].enabled) continue;
-        
-        // 1. Bandpass filter
-        float filtered = applyBandpass(input, band, channel);
-        
-        // 2. Apply tube drive saturation
-        float saturated = applyTubeDrive(filtered, m_bandParams[band].drive);
-        
-        // 3. Parallel mix (dry + wet)
-        float bandOutput = filtered * (1.0f - m_bandParams[band].mix) + 
-                          saturated * m_bandParams[band].mix;
-        
-        // 4. Track level for metering
-        float level = std::abs(bandOutput);
-        float currentLevel = m_bandLevels[band].load();
-        m_bandLevels[band].store(std::max(level, currentLevel * LEVEL_DECAY));
-        
-        // 5. Sum to output
-        output += bandOutput;
-    }
-    
-    // Mix parallel bands with original signal for additive EQ effect
-    // Original signal provides foundation, bands add color
-    output = drySignal * 0.5f + output * 0.5f;
-    
-    return output;
-}
-
-float PencilProcessor::applyBandpass(float input, int bandIndex, int channel) {
-    auto& state = m_filterState[bandIndex][channel];
-    auto& coeffs = m_filterCoeffs[bandIndex];
-    
-    // Direct Form I biquad
-    float output = coeffs.b0 * input + 
-                   coeffs.b1 * state.x1 + 
-                   coeffs.b2 * state.x2 -
-                   coeffs.a1 * state.y1 - 
-                   coeffs.a2 * state.y2;
-    
-    // Update state
-    state.x2 = state.x1;
-    state.x1 = input;
-    state.y2 = state.y1;
-    state.y1 = output;
-    
-    return output;
-}
-
-float PencilProcessor::applyTubeDrive(float input, float drive) {
-    if (drive <= 1.0f) {
-        return input;
-    }
-    
-    // Apply tube saturation
-    return tubeSaturate(input, drive);
-}
-
-float PencilProcessor::tubeSaturate(float x, float drive) {
-    // Asymmetric soft clipping to generate 2nd order harmonics
-    // Based on triode tube characteristics
-    
-    // Scale input by drive
-    float scaled = x * drive;
-    
-    // Asymmetric tanh with different curves for positive/negative
-    // This generates even harmonics (2nd, 4th, etc.)
-    float saturated;
-    
-    if (scaled >= 0.0f) {
-        // Positive half: softer clipping (triode-like)
-        saturated = std::tanh(scaled * 0.8f);
-    } else {
-        // Negative half: slightly harder clipping
-        // The asymmetry creates 2nd order harmonics
-        saturated = std::tanh(scaled * 1.0f) * 0.95f;
-    }
-    
-    // Add subtle 2nd harmonic explicitly for extra warmth
-    float secondHarmonic = scaled * scaled * 0.05f;
-    saturated += secondHarmonic * (1.0f - std::abs(saturated));
-    
-    // Soft knee polynomial for smoother transition
-    // Adds subtle compression character
-    float polynomial = scaled - (scaled * scaled * scaled) / 3.0f;
-    
-    // Blend tanh and polynomial based on drive amount
-    float blendFactor = std::min((drive - 1.0f) / (PencilConfig::MAX_DRIVE - 1.0f), 1.0f);
-    float result = saturated * blendFactor + polynomial * (1.0f - blendFactor);
-    
-    // Output gain compensation (drive reduces level)
-    float compensation = 1.0f / std::sqrt(drive);
-    
-    return result * compensation;
-}
-
 void PencilProcessor::calculateBandpassCoeffs(int bandIndex) {
-    const float freq = m_bandParams[bandIndex].frequency;
-    const float q = m_bandParams[bandIndex].q;
-    
-    // Bandpass filter coefficient calculation (RBJ Audio EQ Cookbook)
-    const float w0 = 2.0f * juce::MathConstants<float>::pi * freq / static_cast<float>(m_sampleRate);
-    const float cosW0 = std::cos(w0);
-    const float sinW0 = std::sin(w0);
-    const float alpha = sinW0 / (2.0f * q);
-    
-    // Bandpass (constant skirt gain, peak gain = Q)
-    const float b0 = alpha;
-    const float b1 = 0.0f;
-    const float b2 = -alpha;
-    const float a0 = 1.0f + alpha;
-    const float a1 = -2.0f * cosW0;
-    const float a2 = 1.0f - alpha;
-    
-    // Normalize coefficients
-    m_filterCoeffs[bandIndex].b0 = b0 / a0;
-    m_filterCoeffs[bandIndex].b1 = b1 / a0;
-    m_filterCoeffs[bandIndex].b2 = b2 / a0;
-    m_filterCoeffs[bandIndex].a1 = a1 / a0;
-    m_filterCoeffs[bandIndex].a2 = a2 / a0;
+    m_engine.setBandFilter(bandIndex, m_bandParams[bandIndex].frequency, m_bandParams[bandIndex].q);
 }
 
 //==============================================================================
@@ -275,6 +162,10 @@ void PencilProcessor::setOutputGain(float gainDb) {
     m_outputGainLinear.store(std::pow(10.0f, gainDb / 20.0f));
 }
 
+void PencilProcessor::setOversampling(PencilOversampling mode) {
+    m_oversampling.store(mode);
+}
+
 //==============================================================================
 // Ghost Hands Integration
 //==============================================================================
@@ -368,6 +259,10 @@ void PencilProcessor::getStateInformation(juce::MemoryBlock& destData) {
     // Save output gain
     float outputGain = m_outputGainDb.load();
     destData.append(&outputGain, sizeof(float));
+    
+    // Save oversampling factor (optional trailing field)
+    float oversampling = static_cast<float>(m_oversampling.load());
+    destData.append(&oversampling, sizeof(float));
 }
 
 void PencilProcessor::setStateInformation(const void* data, int sizeInBytes) {
@@ -388,7 +283,14 @@ void PencilProcessor::setStateInformation(const void* data, int sizeInBytes) {
             }
         }
         
-        setOutputGain(floatData[idx]);
+        setOutputGain(floatData[idx++]);
+        
+        if (sizeInBytes >= expectedSize + static_cast<int>(sizeof(float))) {
+            const int factor = static_cast<int>(floatData[idx]);
+            setOversampling(factor >= 4 ? PencilOversampling::X4
+                          : factor >= 2 ? PencilOversampling::X2
+                                        : PencilOversampling::Off);
+        }
     }
 }
 
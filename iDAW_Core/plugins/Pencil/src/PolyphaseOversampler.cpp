@@ -0,0 +1,198 @@
+/**
+ * PolyphaseOversampler.cpp - Halfband polyphase oversampling
+ */
+
+#include "PolyphaseOversampler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace iDAW {
+
+namespace {
+
+// Stage 1: 47 taps, Kaiser beta 8 (~-80 dB images, flat to ~0.42 fs)
+constexpr int STAGE1_HALF_LENGTH = 12;
+constexpr float STAGE1_BETA = 8.0f;
+
+// Stage 2: 15 taps; images land above the band-limited 2x spectrum
+constexpr int STAGE2_HALF_LENGTH = 4;
+constexpr float STAGE2_BETA = 6.0f;
+
+constexpr double PI = 3.14159265358979323846;
+
+/** Zeroth-order modified Bessel function (series) for the Kaiser window */
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; ++k) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < 1e-12 * sum) break;
+    }
+    return sum;
+}
+
+} // namespace
+
+//==============================================================================
+// Halfband Stage
+//==============================================================================
+
+void PolyphaseOversampler::Stage::prepare(int halfLen, float kaiserBeta, int maxInput) {
+    halfLength = halfLen;
+    taps.resize(static_cast<size_t>(halfLength));
+
+    // Windowed ideal halfband: h[d] = sin(pi d / 2) / (pi d) at odd d = 2m+1
+    const double i0Beta = besselI0(kaiserBeta);
+    double sum = 0.0;
+    for (int m = 0; m < halfLength; ++m) {
+        const double d = 2.0 * m + 1.0;
+        const double ratio = d / (2.0 * halfLength);
+        const double window = besselI0(kaiserBeta * std::sqrt(1.0 - ratio * ratio)) / i0Beta;
+        const double ideal = ((m & 1) ? -1.0 : 1.0) / (PI * d);
+        taps[m] = static_cast<float>(ideal * window);
+        sum += ideal * window;
+    }
+
+    // Unity DC gain: 0.5 (centre) + 2 * sum(a) = 1
+    for (auto& tap : taps) {
+        tap = static_cast<float>(tap * 0.25 / sum);
+    }
+
+    upHistory.assign(static_cast<size_t>(2 * halfLength - 1 + maxInput), 0.0f);
+    downHistory.assign(static_cast<size_t>(4 * halfLength - 2 + 2 * maxInput), 0.0f);
+}
+
+void PolyphaseOversampler::Stage::reset() noexcept {
+    std::fill(upHistory.begin(), upHistory.end(), 0.0f);
+    std::fill(downHistory.begin(), downHistory.end(), 0.0f);
+}
+
+void PolyphaseOversampler::Stage::upsample(const float* input, float* output, int numInput) noexcept {
+    const int M = halfLength;
+    const int historyLength = 2 * M - 1;
+    float* h = upHistory.data();
+    std::copy_n(input, numInput, h + historyLength);
+
+    // x[n - k] lives at h[historyLength + n - k]
+    const float* a = taps.data();
+    for (int n = 0; n < numInput; ++n) {
+        const float* x = h + historyLength + n;
+        float acc = 0.0f;
+        for (int m = 0; m < M; ++m) {
+            acc += a[m] * (x[-(M - 1 - m)] + x[-(M + m)]);
+        }
+        output[2 * n] = 2.0f * acc;
+        output[2 * n + 1] = x[-(M - 1)];
+    }
+
+    std::copy_n(h + numInput, historyLength, h);
+}
+
+void PolyphaseOversampler::Stage::downsample(const float* input, float* output, int numOutput) noexcept {
+    const int M = halfLength;
+    const int historyLength = 4 * M - 2;
+    float* d = downHistory.data();
+    std::copy_n(input, 2 * numOutput, d + historyLength);
+
+    // y[n] = (h * v)[2n]: centre tap on d[2M - 1 + 2n], side taps pair up
+    // around it on the other phase
+    const float* a = taps.data();
+    for (int n = 0; n < numOutput; ++n) {
+        const float* v = d + 2 * n;
+        float acc = 0.5f * v[2 * M - 1];
+        for (int m = 0; m < M; ++m) {
+            acc += a[m] * (v[2 * M + 2 * m] + v[2 * M - 2 - 2 * m]);
+        }
+        output[n] = acc;
+    }
+
+    std::copy_n(d + 2 * numOutput, historyLength, d);
+}
+
+//==============================================================================
+// Oversampler
+//==============================================================================
+
+void PolyphaseOversampler::prepare(int maxBlockSize) {
+    m_maxBlockSize = std::max(1, maxBlockSize);
+
+    m_stage1.prepare(STAGE1_HALF_LENGTH, STAGE1_BETA, m_maxBlockSize);
+    m_stage2.prepare(STAGE2_HALF_LENGTH, STAGE2_BETA, 2 * m_maxBlockSize);
+
+    // Each stage round trip delays by 2 * (2M - 1) samples at its own rate.
+    // Stage 2 gets 2 extra samples so its delay is whole at the 2x rate, and
+    // the total is whole at the base rate.
+    m_padLength = 2;
+    m_padHistory.assign(static_cast<size_t>(m_padLength), 0.0f);
+
+    m_upBuffer1.assign(static_cast<size_t>(2 * m_maxBlockSize), 0.0f);
+    m_upBuffer2.assign(static_cast<size_t>(4 * m_maxBlockSize), 0.0f);
+    m_downBuffer.assign(static_cast<size_t>(2 * m_maxBlockSize), 0.0f);
+
+    setFactor(m_factor);
+    reset();
+}
+
+void PolyphaseOversampler::setFactor(int factor) noexcept {
+    const int newFactor = factor >= 4 ? 4 : (factor >= 2 ? 2 : 1);
+    if (newFactor != m_factor) {
+        m_factor = newFactor;
+        reset();
+    }
+
+    if (m_factor == 1) {
+        m_latency = 0;
+    } else if (m_factor == 2) {
+        m_latency = 2 * STAGE1_HALF_LENGTH - 1;
+    } else {
+        m_latency = 2 * STAGE1_HALF_LENGTH - 1 + STAGE2_HALF_LENGTH;
+    }
+}
+
+void PolyphaseOversampler::reset() noexcept {
+    m_stage1.reset();
+    m_stage2.reset();
+    std::fill(m_padHistory.begin(), m_padHistory.end(), 0.0f);
+}
+
+const float* PolyphaseOversampler::upsample(const float* input, int numSamples) noexcept {
+    if (m_factor == 1 || numSamples <= 0) {
+        return m_factor == 1 ? input : m_upBuffer1.data();
+    }
+
+    m_stage1.upsample(input, m_upBuffer1.data(), numSamples);
+    if (m_factor == 2) {
+        return m_upBuffer1.data();
+    }
+
+    float* out = m_upBuffer2.data();
+    const int numOut = 4 * numSamples;
+    m_stage2.upsample(m_upBuffer1.data(), out, 2 * numSamples);
+
+    // Delay by m_padLength samples in place
+    float carry[2];
+    std::copy_n(out + numOut - m_padLength, m_padLength, carry);
+    std::copy_backward(out, out + numOut - m_padLength, out + numOut);
+    std::copy_n(m_padHistory.data(), m_padLength, out);
+    std::copy_n(carry, m_padLength, m_padHistory.data());
+
+    return out;
+}
+
+void PolyphaseOversampler::downsample(const float* input, float* output, int numSamples) noexcept {
+    if (m_factor == 1) {
+        if (input != output) std::copy_n(input, numSamples, output);
+        return;
+    }
+
+    if (m_factor == 2) {
+        m_stage1.downsample(input, output, numSamples);
+        return;
+    }
+
+    m_stage2.downsample(input, m_downBuffer.data(), 2 * numSamples);
+    m_stage1.downsample(m_downBuffer.data(), output, numSamples);
+}
+
+} // namespace iDAW
@@ -0,0 +1,154 @@
+/**
+ * CompressorEngine.h - Block-processing core of "The Press"
+ *
+ * Feed-forward RMS compressor, processed a block at a time:
+ *
+ *   1. Detector: channel-averaged squares for the whole block (SIMD), then
+ *      the running RMS window (one add/subtract per sample, no modulo)
+ *   2. Gain computer in the log domain: level and gain reduction stay in
+ *      log2 units, so there is no sqrt, log10 or pow per sample; the
+ *      conversions use daiw::simd::fast_log2 / fast_exp2 over the block
+ *   3. Attack/release smoothing of the linear gain (the only serial step)
+ *   4. Gain (with makeup) applied per channel with simd::apply_envelope
+ *
+ * Reproduces the former per-sample path (RMS window, soft knee, one-pole
+ * attack/release on linear gain) to within the approximation error. An
+ * optional external key (sidechain) replaces the input in step 1 only.
+ */
+
+#pragma once
+
+#include <vector>
+
+namespace iDAW {
+
+/**
+ * Configuration for The Press compressor
+ */
+struct PressConfig {
+    // Parameter ranges
+    static constexpr float MIN_THRESHOLD_DB = -60.0f;
+    static constexpr float MAX_THRESHOLD_DB = 0.0f;
+    static constexpr float MIN_RATIO = 1.0f;
+    static constexpr float MAX_RATIO = 20.0f;
+    static constexpr float MIN_ATTACK_MS = 0.1f;
+    static constexpr float MAX_ATTACK_MS = 100.0f;
+    static constexpr float MIN_RELEASE_MS = 10.0f;
+    static constexpr float MAX_RELEASE_MS = 2000.0f;
+    static constexpr float MIN_GAIN_DB = -12.0f;
+    static constexpr float MAX_GAIN_DB = 24.0f;
+
+    // RMS detection window
+    static constexpr float RMS_WINDOW_MS = 10.0f;
+
+    // Detector floor (an RMS of 1e-10, -200 dB)
+    static constexpr float MIN_MEAN_SQUARE = 1e-20f;
+
+    // Knee width in dB (soft knee)
+    static constexpr float KNEE_WIDTH_DB = 6.0f;
+
+    // Multiband mode
+    static constexpr int MAX_BANDS = 4;
+    static constexpr float MIN_CROSSOVER_HZ = 20.0f;
+    static constexpr float MAX_CROSSOVER_HZ = 18000.0f;
+};
+
+/**
+ * Compressor parameters structure
+ */
+struct CompressorParams {
+    float thresholdDb = -20.0f;  // Threshold in dB
+    float ratio = 4.0f;          // Compression ratio (N:1)
+    float attackMs = 10.0f;      // Attack time in ms
+    float releaseMs = 100.0f;    // Release time in ms
+    float makeupGainDb = 0.0f;   // Makeup gain in dB
+    bool autoMakeup = false;     // Auto makeup gain
+};
+
+class CompressorEngine {
+public:
+    static constexpr int MAX_CHANNELS = 8;
+
+    CompressorEngine() = default;
+
+    /** Allocate for blocks of up to maxBlockSize samples. Not RT-safe. */
+    void prepare(double sampleRate, int maxBlockSize);
+
+    /** Clear the RMS window and release the gain to unity */
+    void reset() noexcept;
+
+    /** Update settings (recomputes attack/release coefficients on change) */
+    void setParameters(const CompressorParams& params) noexcept;
+    const CompressorParams& getParameters() const noexcept { return m_params; }
+
+    /**
+     * Compress up to MAX_CHANNELS channels in place, all sharing one
+     * detector. When sidechain is given, its channels (numSamples each)
+     * drive the detector instead of the input.
+     */
+    void process(float* const* channels, int numChannels, int numSamples,
+                 const float* const* sidechain = nullptr, int numSidechainChannels = 0) noexcept;
+
+    /** Largest gain reduction (dB, >= 0) during the last process() call */
+    float getGainReductionDb() const noexcept { return m_gainReductionDb; }
+
+    /** Input / output peaks (linear) of the last process() call */
+    float getInputPeak() const noexcept { return m_inputPeak; }
+    float getOutputPeak() const noexcept { return m_outputPeak; }
+
+    /**
+     * Static soft-knee curve: gain change in dB (<= 0) for a detector level
+     * in dB. The block path evaluates the same curve in log2 units.
+     */
+    static float gainReductionDb(float inputDb, float thresholdDb, float ratio) noexcept;
+
+    /** Makeup gain (dB) the auto-makeup option applies */
+    static float autoMakeupDb(float thresholdDb, float ratio) noexcept;
+
+    /** Threshold/ratio pattern length of meanSquareToGain() */
+    static constexpr int GAIN_PARAMETER_PERIOD = 4;
+
+    /**
+     * Log-domain gain computer over a buffer: mean squares in, target
+     * linear gains out. Element i uses thresholdDb/ratio[i % 4], so
+     * interleaved per-band detectors ([sample][band]) run in one pass.
+     */
+    static void meanSquareToGain(float* values, int count, const float* thresholdDb,
+                                 const float* ratio) noexcept;
+
+private:
+    void updateEnvelopeCoeffs() noexcept;
+
+    void processChunk(float* const* channels, int numChannels, const float* const* key, int numKeyChannels,
+                      int numSamples) noexcept;
+
+    /** Channel-averaged squares of the key -> windowed mean square, in m_detector */
+    void computeDetector(const float* const* key, int numKeyChannels, int numSamples) noexcept;
+
+    CompressorParams m_params;
+    double m_sampleRate = 44100.0;
+    int m_maxBlockSize = 0;
+
+    // Envelope coefficients
+    float m_attackCoeff = 1.0f;
+    float m_releaseCoeff = 1.0f;
+
+    // Envelope state (gain in linear)
+    float m_envelopeState = 1.0f;
+
+    // RMS window of per-sample mean squares
+    std::vector<float> m_rmsBuffer;
+    int m_rmsBufferIndex = 0;
+    float m_rmsSum = 0.0f;
+
+    // Per-block work buffers
+    std::vector<float> m_detector;
+    std::vector<float> m_gain;
+
+    // Metering of the last process() call
+    float m_gainReductionDb = 0.0f;
+    float m_inputPeak = 0.0f;
+    float m_outputPeak = 0.0f;
+};
+
+} // namespace iDAW
@@ -0,0 +1,83 @@
+/**
+ * LinkwitzRileyCrossover.h - Up to 4-band LR4 band splitter for "The Press"
+ *
+ * A tree of 4th-order Linkwitz-Riley splits, with allpass compensation on
+ * the bands split off earlier so all bands stay phase-aligned and sum to an
+ * allpass (flat magnitude). For split point s the filters are:
+ *
+ *   lane 0: lowpass  (rest)   -> band s
+ *   lane 1: highpass (rest)   -> rest (becomes the top band after the last split)
+ *   lane 2: allpass  (band 0) -> band 0        (from the 2nd split on)
+ *   lane 3: allpass  (band 1) -> band 1        (from the 3rd split on)
+ *
+ * Those 4 lanes for both channels fill one 8-wide vector, so each split
+ * point is one FMA chain per sample, run over tiles of 8 samples that are
+ * transposed in and out of lane order. Every lane is two cascaded TDF-II
+ * sections (Butterworth squared; the allpass uses one). SSE builds run one
+ * channel's 4 lanes per vector over tiles of 4; scalar builds run the lanes
+ * one at a time. All filter state is held inline; nothing is allocated.
+ */
+
+#pragma once
+
+#include <array>
+
+namespace iDAW {
+
+class LinkwitzRileyCrossover {
+public:
+    static constexpr int MAX_BANDS = 4;
+    static constexpr int MAX_CHANNELS = 2;
+    static constexpr int LANES_PER_CHANNEL = 4;
+    static constexpr int NUM_LANES = MAX_CHANNELS * LANES_PER_CHANNEL;
+    static constexpr int SECTIONS = 2;
+
+    /** bands[band][channel]: one numSamples buffer each */
+    using BandBuffers = std::array<std::array<float*, MAX_CHANNELS>, MAX_BANDS>;
+
+    LinkwitzRileyCrossover();
+
+    /**
+     * Design the splits: numBands (2..MAX_BANDS) bands separated by the
+     * numBands - 1 ascending frequencies. Clears the filter history when
+     * the band count changes.
+     */
+    void setCrossovers(double sampleRate, const float* frequencies, int numBands) noexcept;
+
+    int getNumBands() const noexcept { return m_numBands; }
+
+    /** Clear filter history */
+    void reset() noexcept;
+
+    /**
+     * Split numChannels (<= MAX_CHANNELS) inputs into getNumBands() bands.
+     * Band buffers must not alias the inputs.
+     */
+    void process(const float* const* input, int numChannels, const BandBuffers& bands,
+                 int numSamples) noexcept;
+
+private:
+    static constexpr int MAX_SPLITS = MAX_BANDS - 1;
+
+    struct Coeffs {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+    };
+
+    void setLane(int split, int laneInChannel, int section, const Coeffs& coeffs) noexcept;
+
+    /** Run one lane's cascade over a buffer (tails and scalar builds) */
+    void processLane(int split, int lane, const float* in, float* out, int numSamples) noexcept;
+
+    int m_numBands = 2;
+
+    // Structure of arrays: [split][section][lane]
+    alignas(32) float m_b0[MAX_SPLITS][SECTIONS][NUM_LANES];
+    alignas(32) float m_b1[MAX_SPLITS][SECTIONS][NUM_LANES];
+    alignas(32) float m_b2[MAX_SPLITS][SECTIONS][NUM_LANES];
+    alignas(32) float m_a1[MAX_SPLITS][SECTIONS][NUM_LANES];
+    alignas(32) float m_a2[MAX_SPLITS][SECTIONS][NUM_LANES];
+    alignas(32) float m_z1[MAX_SPLITS][SECTIONS][NUM_LANES];
+    alignas(32) float m_z2[MAX_SPLITS][SECTIONS][NUM_LANES];
+};
+
+} // namespace iDAW
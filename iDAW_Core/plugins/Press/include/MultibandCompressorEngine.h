@@ -0,0 +1,118 @@
+/**
+ * MultibandCompressorEngine.h - Multiband mode of "The Press"
+ *
+ * Splits the input into 2-4 phase-aligned bands with LinkwitzRileyCrossover
+ * and compresses each band with its own threshold, ratio, times and makeup,
+ * then sums the bands. The per-band work is vectorized across bands:
+ *
+ *   detector:  per sample, one 4-wide vector of band mean squares and one
+ *              running RMS window update for all bands ([sample][band])
+ *   gain:      CompressorEngine::meanSquareToGain over the interleaved
+ *              buffer (per-band parameters repeat every 4 lanes)
+ *   envelope:  one 4-wide attack/release step per sample for all bands
+ *
+ * An optional external key (sidechain) is split by a second crossover and
+ * drives each band's detector in place of that band of the input.
+ */
+
+#pragma once
+
+#include "CompressorEngine.h"
+#include "LinkwitzRileyCrossover.h"
+#include <array>
+#include <vector>
+
+namespace iDAW {
+
+/**
+ * Multiband settings
+ */
+struct MultibandParams {
+    int numBands = 3;                                                       // 2..MAX_BANDS
+    std::array<float, PressConfig::MAX_BANDS - 1> crossoverHz = {200.0f, 2000.0f, 8000.0f};
+    std::array<CompressorParams, PressConfig::MAX_BANDS> bands;             // autoMakeup per band
+};
+
+class MultibandCompressorEngine {
+public:
+    static constexpr int MAX_BANDS = PressConfig::MAX_BANDS;
+    static constexpr int MAX_CHANNELS = LinkwitzRileyCrossover::MAX_CHANNELS;
+
+    static_assert(MAX_BANDS == CompressorEngine::GAIN_PARAMETER_PERIOD,
+                  "bands are interleaved one per gain-computer lane");
+
+    MultibandCompressorEngine() = default;
+
+    /** Allocate for blocks of up to maxBlockSize samples. Not RT-safe. */
+    void prepare(double sampleRate, int maxBlockSize);
+
+    /** Clear crossovers, RMS windows and envelopes */
+    void reset() noexcept;
+
+    /** Update bands, crossover points and per-band settings */
+    void setParameters(const MultibandParams& params) noexcept;
+    const MultibandParams& getParameters() const noexcept { return m_params; }
+
+    /**
+     * Compress up to MAX_CHANNELS channels in place. When sidechain is
+     * given, its bands drive the detectors instead of the input's.
+     */
+    void process(float* const* channels, int numChannels, int numSamples,
+                 const float* const* sidechain = nullptr, int numSidechainChannels = 0) noexcept;
+
+    /** Largest gain reduction (dB, >= 0) of a band during the last process() call */
+    float getGainReductionDb(int band) const noexcept;
+
+    /** Input / output peaks (linear) of the last process() call */
+    float getInputPeak() const noexcept { return m_inputPeak; }
+    float getOutputPeak() const noexcept { return m_outputPeak; }
+
+private:
+    void updateEnvelopeCoeffs() noexcept;
+
+    void processChunk(float* const* channels, int numChannels, const float* const* key, int numKeyChannels,
+                      int numSamples) noexcept;
+
+    /** Interleaved per-band windowed mean squares of the key bands, in m_detector */
+    void computeDetector(const LinkwitzRileyCrossover::BandBuffers& key, int numKeyChannels,
+                         int numSamples) noexcept;
+
+    /** Attack/release across bands; band-major gains (with makeup) in m_gain */
+    void computeEnvelopes(int numSamples) noexcept;
+
+    MultibandParams m_params;
+    double m_sampleRate = 44100.0;
+    int m_maxBlockSize = 0;
+
+    LinkwitzRileyCrossover m_crossover;
+    LinkwitzRileyCrossover m_keyCrossover;
+
+    // Band signals: [band][channel] blocks, input then key
+    std::vector<float> m_bandStorage;
+    std::vector<float> m_keyStorage;
+    LinkwitzRileyCrossover::BandBuffers m_bands{};
+    LinkwitzRileyCrossover::BandBuffers m_keyBands{};
+
+    // Per-band state, one lane per band
+    alignas(16) float m_attackCoeff[MAX_BANDS] = {};
+    alignas(16) float m_releaseCoeff[MAX_BANDS] = {};
+    alignas(16) float m_envelope[MAX_BANDS] = {};
+    alignas(16) float m_rmsSum[MAX_BANDS] = {};
+
+    // RMS windows, [slot][band]
+    std::vector<float> m_rmsBuffer;
+    int m_rmsWindow = 1;
+    int m_rmsBufferIndex = 0;
+
+    // Per-block work buffers
+    std::vector<float> m_detector;    // [sample][band]
+    std::vector<float> m_gain;        // [band][sample]
+    std::vector<float> m_silence;
+
+    // Metering of the last process() call
+    std::array<float, MAX_BANDS> m_gainReductionDb = {};
+    float m_inputPeak = 0.0f;
+    float m_outputPeak = 0.0f;
+};
+
+} // namespace iDAW
@@ -9,52 +9,21 @@
  * - Accurate gain reduction metering
  * - Ghost Hands AI integration (Punchy/Glue presets)
  * - Heartbeat visualization mapping GR to heart animation
+ * - External sidechain bus keying the detector
+ * - Multiband mode: 2-4 Linkwitz-Riley bands, each with its own settings
  */
 
 #pragma once
 
 #include <JuceHeader.h>
+#include "CompressorEngine.h"
+#include "MultibandCompressorEngine.h"
 #include <atomic>
 #include <cmath>
 #include <array>
 
 namespace iDAW {
 
-/**
- * Configuration for The Press compressor
- */
-struct PressConfig {
-    // Parameter ranges
-    static constexpr float MIN_THRESHOLD_DB = -60.0f;
-    static constexpr float MAX_THRESHOLD_DB = 0.0f;
-    static constexpr float MIN_RATIO = 1.0f;
-    static constexpr float MAX_RATIO = 20.0f;
-    static constexpr float MIN_ATTACK_MS = 0.1f;
-    static constexpr float MAX_ATTACK_MS = 100.0f;
-    static constexpr float MIN_RELEASE_MS = 10.0f;
-    static constexpr float MAX_RELEASE_MS = 2000.0f;
-    static constexpr float MIN_GAIN_DB = -12.0f;
-    static constexpr float MAX_GAIN_DB = 24.0f;
-    
-    // RMS detection window
-    static constexpr float RMS_WINDOW_MS = 10.0f;
-    
-    // Knee width in dB (soft knee)
-    static constexpr float KNEE_WIDTH_DB = 6.0f;
-};
-
-/**
- * Compressor parameters structure
- */
-struct CompressorParams {
-    float thresholdDb = -20.0f;  // Threshold in dB
-    float ratio = 4.0f;          // Compression ratio (N:1)
-    float attackMs = 10.0f;      // Attack time in ms
-    float releaseMs = 100.0f;    // Release time in ms
-    float makeupGainDb = 0.0f;   // Makeup gain in dB
-    bool autoMakeup = false;     // Auto makeup gain
-};
-
 /**
  * Visual state for Heartbeat shader
  */
@@ -85,6 +54,10 @@ enum class CompressorPreset {
  * 4. Apply attack/release envelope to gain reduction
  * 5. Apply gain reduction to input signal
  * 6. Apply makeup gain
+ *
+ * The DSP runs a block at a time in CompressorEngine, or in
+ * MultibandCompressorEngine when more than one band is selected. Either
+ * engine may be keyed by the "Sidechain" input bus instead of the input.
  */
 class PressProcessor : public juce::AudioProcessor {
 public:
@@ -101,6 +74,7 @@ public:
     
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
     void processBlock(juce::AudioBuffer<float>& buffer, 
                       juce::MidiBuffer& midiMessages) override;
     
@@ -147,6 +121,32 @@ public:
     void setAutoMakeup(bool enabled);
     bool getAutoMakeup() const { return m_params.autoMakeup; }
     
+    //==========================================================================
+    // Sidechain / Multiband
+    //==========================================================================
+    
+    /** Key the detector from the sidechain bus (when the host connects it) */
+    void setSidechainEnabled(bool enabled) { m_sidechainEnabled = enabled; }
+    bool getSidechainEnabled() const { return m_sidechainEnabled; }
+    
+    /**
+     * Number of bands: 1 is the single-band compressor, 2-4 the multiband
+     * mode. The single-band parameters above stay independent of the bands.
+     */
+    void setBandCount(int numBands);
+    int getBandCount() const { return m_bandCount; }
+    
+    /** Crossover between band index and index + 1 (Hz) */
+    void setCrossover(int index, float frequencyHz);
+    float getCrossover(int index) const;
+    
+    /** Threshold, ratio, times and makeup of one band (clamped like the above) */
+    void setBandParameters(int band, const CompressorParams& params);
+    CompressorParams getBandParameters(int band) const;
+    
+    /** Gain reduction of one band in multiband mode (dB, >= 0) */
+    float getBandGainReduction(int band) const;
+    
     //==========================================================================
     // Ghost Hands Integration
     //==========================================================================
@@ -188,25 +188,8 @@ public:
     HeartbeatVisualState getVisualState() const;
     
 private:
-    //==========================================================================
-    // DSP Processing
-    //==========================================================================
-    
-    /**
-     * Calculate RMS level of a buffer
-     */
-    float calculateRMS(const float* samples, int numSamples);
-    
-    /**
-     * Calculate gain reduction for a given input level
-     * Uses soft knee for smoother compression
-     */
-    float calculateGainReduction(float inputDb);
-    
-    /**
-     * Apply attack/release envelope to gain value
-     */
-    float applyEnvelope(float targetGain, float currentGain);
+    /** Clamp every field to the PressConfig ranges */
+    static CompressorParams clampParams(const CompressorParams& params);
     
     /**
      * Convert linear to dB
@@ -215,56 +198,29 @@ private:
         return 20.0f * std::log10(std::max(linear, 1e-10f));
     }
     
-    /**
-     * Convert dB to linear
-     */
-    static float dbToLinear(float db) {
-        return std::pow(10.0f, db / 20.0f);
-    }
-    
-    /**
-     * Calculate auto makeup gain based on threshold and ratio
-     */
-    float calculateAutoMakeup() const;
-    
-    /**
-     * Update envelope coefficients based on attack/release times
-     */
-    void updateEnvelopeCoeffs();
-    
     //==========================================================================
     // Parameters
     //==========================================================================
     
     CompressorParams m_params;
-    
-    // Envelope coefficients
-    float m_attackCoeff = 0.0f;
-    float m_releaseCoeff = 0.0f;
-    
-    // RMS window size in samples
-    int m_rmsWindowSamples = 0;
+    MultibandParams m_multibandParams;
+    int m_bandCount = 1;
+    bool m_sidechainEnabled = false;
     
     //==========================================================================
     // State
     //==========================================================================
     
-    double m_sampleRate = 44100.0;
+    CompressorEngine m_engine;
+    MultibandCompressorEngine m_multiband;
     bool m_prepared = false;
     
-    // Envelope state (gain in linear)
-    float m_envelopeState = 1.0f;
-    
-    // RMS calculation buffer
-    std::vector<float> m_rmsBuffer;
-    int m_rmsBufferIndex = 0;
-    float m_rmsSum = 0.0f;
-    
     //==========================================================================
     // Metering (atomic for thread safety)
     //==========================================================================
     
     std::atomic<float> m_gainReductionDb{0.0f};
+    std::array<std::atomic<float>, PressConfig::MAX_BANDS> m_bandGainReductionDb{};
     std::atomic<float> m_inputLevelDb{-100.0f};
     std::atomic<float> m_outputLevelDb{-100.0f};
     
@@ -0,0 +1,250 @@
+/**
+ * CompressorEngine.cpp - Block-processing core of "The Press"
+ */
+
+#include "CompressorEngine.h"
+#include "daiw/simd.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace iDAW {
+
+namespace {
+
+constexpr float DB_PER_LOG2_POWER = 3.0102999566f;   // 10 * log10(2): mean square -> dB
+constexpr float LOG2_PER_DB_GAIN = 0.1660964047f;    // log2(10) / 20: gain dB -> log2
+
+} // namespace
+
+void CompressorEngine::prepare(double sampleRate, int maxBlockSize) {
+    m_sampleRate = sampleRate;
+    m_maxBlockSize = std::max(1, maxBlockSize);
+
+    const int windowSamples = std::max(1, static_cast<int>(PressConfig::RMS_WINDOW_MS * sampleRate / 1000.0));
+    m_rmsBuffer.assign(static_cast<size_t>(windowSamples), 0.0f);
+    m_detector.assign(static_cast<size_t>(m_maxBlockSize), 0.0f);
+    m_gain.assign(static_cast<size_t>(m_maxBlockSize), 0.0f);
+
+    updateEnvelopeCoeffs();
+    reset();
+}
+
+void CompressorEngine::reset() noexcept {
+    std::fill(m_rmsBuffer.begin(), m_rmsBuffer.end(), 0.0f);
+    m_rmsBufferIndex = 0;
+    m_rmsSum = 0.0f;
+    m_envelopeState = 1.0f;
+    m_gainReductionDb = 0.0f;
+    m_inputPeak = 0.0f;
+    m_outputPeak = 0.0f;
+}
+
+void CompressorEngine::setParameters(const CompressorParams& params) noexcept {
+    const bool timesChanged = params.attackMs != m_params.attackMs || params.releaseMs != m_params.releaseMs;
+    m_params = params;
+
+    // Enforce minimum release time to prevent aliasing/distortion
+    m_params.releaseMs = std::max(m_params.releaseMs, PressConfig::MIN_RELEASE_MS);
+
+    if (timesChanged) updateEnvelopeCoeffs();
+}
+
+void CompressorEngine::updateEnvelopeCoeffs() noexcept {
+    // Time constant formula: coeff = 1 - exp(-1 / (time * sampleRate))
+    // This gives ~63% of the way to target in the specified time
+    const float attackTimeSamples = m_params.attackMs * static_cast<float>(m_sampleRate) / 1000.0f;
+    const float releaseTimeSamples = m_params.releaseMs * static_cast<float>(m_sampleRate) / 1000.0f;
+
+    m_attackCoeff = 1.0f - std::exp(-1.0f / attackTimeSamples);
+    m_releaseCoeff = 1.0f - std::exp(-1.0f / releaseTimeSamples);
+}
+
+float CompressorEngine::gainReductionDb(float inputDb, float thresholdDb, float ratio) noexcept {
+    const float kneeWidth = PressConfig::KNEE_WIDTH_DB;
+    const float kneeStart = thresholdDb - kneeWidth / 2.0f;
+    const float overThreshold = inputDb - thresholdDb;
+
+    // Below threshold: no compression
+    if (inputDb < kneeStart) return 0.0f;
+
+    // Above threshold + knee: full compression
+    if (inputDb > thresholdDb + kneeWidth / 2.0f) {
+        return overThreshold / ratio - overThreshold;
+    }
+
+    // In knee region: quadratic interpolation of the ratio
+    const float kneePosition = (inputDb - kneeStart) / kneeWidth;  // 0 to 1
+    const float kneeRatio = 1.0f + (ratio - 1.0f) * kneePosition * kneePosition;
+    return overThreshold / kneeRatio - overThreshold;
+}
+
+float CompressorEngine::autoMakeupDb(float thresholdDb, float ratio) noexcept {
+    // Assumes program material averages around -18 dBFS
+    const float averageLevel = -18.0f;
+
+    if (averageLevel > thresholdDb) {
+        const float overThreshold = averageLevel - thresholdDb;
+        const float reduction = overThreshold - overThreshold / ratio;
+        return reduction * 0.7f;  // Apply 70% of calculated makeup
+    }
+
+    return 0.0f;
+}
+
+void CompressorEngine::process(float* const* channels, int numChannels, int numSamples,
+                               const float* const* sidechain, int numSidechainChannels) noexcept {
+    m_gainReductionDb = 0.0f;
+    m_inputPeak = 0.0f;
+    m_outputPeak = 0.0f;
+    if (m_maxBlockSize == 0 || numChannels <= 0) return;
+
+    numChannels = std::min(numChannels, MAX_CHANNELS);
+    const bool external = sidechain != nullptr && numSidechainChannels > 0;
+    const int numKeyChannels = external ? std::min(numSidechainChannels, MAX_CHANNELS) : numChannels;
+
+    float* chunk[MAX_CHANNELS] = {};
+    const float* key[MAX_CHANNELS] = {};
+    for (int offset = 0; offset < numSamples; offset += m_maxBlockSize) {
+        for (int ch = 0; ch < numChannels; ++ch) chunk[ch] = channels[ch] + offset;
+        for (int ch = 0; ch < numKeyChannels; ++ch) key[ch] = (external ? sidechain[ch] : channels[ch]) + offset;
+        processChunk(chunk, numChannels, key, numKeyChannels, std::min(m_maxBlockSize, numSamples - offset));
+    }
+}
+
+void CompressorEngine::computeDetector(const float* const* channels, int numChannels, int numSamples) noexcept {
+    float* detector = m_detector.data();
+    const float channelScale = 1.0f / static_cast<float>(numChannels);
+
+    // Sum of squares across channels, averaged
+    int i = 0;
+#if defined(DAIW_AVX2) || defined(DAIW_AVX512)
+    const __m256 scale = _mm256_set1_ps(channelScale);
+    for (; i + 8 <= numSamples; i += 8) {
+        __m256 sum = _mm256_setzero_ps();
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const __m256 x = _mm256_loadu_ps(channels[ch] + i);
+            sum = _mm256_fmadd_ps(x, x, sum);
+        }
+        _mm256_storeu_ps(detector + i, _mm256_mul_ps(sum, scale));
+    }
+#endif
+    for (; i < numSamples; ++i) {
+        float sum = 0.0f;
+        for (int ch = 0; ch < numChannels; ++ch) {
+            sum += channels[ch][i] * channels[ch][i];
+        }
+        detector[i] = sum * channelScale;
+    }
+
+    // Running RMS window (running sum; the wrap is a compare, not a modulo)
+    const int window = static_cast<int>(m_rmsBuffer.size());
+    const float invWindow = 1.0f / static_cast<float>(window);
+    float* ring = m_rmsBuffer.data();
+    float sum = m_rmsSum;
+    int index = m_rmsBufferIndex;
+
+    for (i = 0; i < numSamples; ++i) {
+        const float meanSquare = detector[i];
+        sum = (sum - ring[index]) + meanSquare;
+        ring[index] = meanSquare;
+        if (++index == window) index = 0;
+
+        // Float drift can leave the running sum slightly negative
+        detector[i] = std::max(sum * invWindow, PressConfig::MIN_MEAN_SQUARE);
+    }
+
+    m_rmsSum = sum;
+    m_rmsBufferIndex = index;
+}
+
+void CompressorEngine::meanSquareToGain(float* values, int count, const float* thresholdDb,
+                                        const float* ratio) noexcept {
+    daiw::simd::fast_log2(values, values, static_cast<size_t>(count));
+
+    // Gain computer on log2(mean square); result in log2(linear gain)
+    int i = 0;
+#if defined(DAIW_AVX2) || defined(DAIW_AVX512)
+    static_assert(GAIN_PARAMETER_PERIOD == 4, "two periods per AVX vector");
+    const float kneeWidth = PressConfig::KNEE_WIDTH_DB;
+    const __m256 toDb = _mm256_set1_ps(DB_PER_LOG2_POWER);
+    const __m256 toLog2 = _mm256_set1_ps(LOG2_PER_DB_GAIN);
+    const __m256 invKneeWidth = _mm256_set1_ps(1.0f / kneeWidth);
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    alignas(32) float kneeStartLanes[8], kneeEndLanes[8], slopeLanes[8], ratioMinusOneLanes[8], thresholdLanes[8];
+    for (int lane = 0; lane < 8; ++lane) {
+        const int k = lane % GAIN_PARAMETER_PERIOD;
+        thresholdLanes[lane] = thresholdDb[k];
+        kneeStartLanes[lane] = thresholdDb[k] - kneeWidth / 2.0f;
+        kneeEndLanes[lane] = thresholdDb[k] + kneeWidth / 2.0f;
+        slopeLanes[lane] = 1.0f / ratio[k] - 1.0f;
+        ratioMinusOneLanes[lane] = ratio[k] - 1.0f;
+    }
+    const __m256 threshold = _mm256_load_ps(thresholdLanes);
+    const __m256 kneeStart = _mm256_load_ps(kneeStartLanes);
+    const __m256 kneeEnd = _mm256_load_ps(kneeEndLanes);
+    const __m256 slope = _mm256_load_ps(slopeLanes);
+    const __m256 ratioMinusOne = _mm256_load_ps(ratioMinusOneLanes);
+
+    for (; i + 8 <= count; i += 8) {
+        const __m256 inputDb = _mm256_mul_ps(_mm256_loadu_ps(values + i), toDb);
+        const __m256 over = _mm256_sub_ps(inputDb, threshold);
+
+        const __m256 full = _mm256_mul_ps(over, slope);
+        const __m256 kneePosition = _mm256_mul_ps(_mm256_sub_ps(inputDb, kneeStart), invKneeWidth);
+        const __m256 kneeRatio = _mm256_fmadd_ps(ratioMinusOne, _mm256_mul_ps(kneePosition, kneePosition), one);
+        const __m256 knee = _mm256_sub_ps(_mm256_div_ps(over, kneeRatio), over);
+
+        __m256 gainDb = _mm256_blendv_ps(knee, full, _mm256_cmp_ps(inputDb, kneeEnd, _CMP_GT_OQ));
+        gainDb = _mm256_and_ps(gainDb, _mm256_cmp_ps(inputDb, kneeStart, _CMP_GE_OQ));
+        _mm256_storeu_ps(values + i, _mm256_mul_ps(gainDb, toLog2));
+    }
+#endif
+    for (; i < count; ++i) {
+        const int k = i % GAIN_PARAMETER_PERIOD;
+        values[i] = gainReductionDb(values[i] * DB_PER_LOG2_POWER, thresholdDb[k], ratio[k]) * LOG2_PER_DB_GAIN;
+    }
+
+    daiw::simd::fast_exp2(values, values, static_cast<size_t>(count));
+}
+
+void CompressorEngine::processChunk(float* const* channels, int numChannels, const float* const* key,
+                                    int numKeyChannels, int numSamples) noexcept {
+    for (int ch = 0; ch < numChannels; ++ch) {
+        m_inputPeak = std::max(m_inputPeak, daiw::simd::find_peak(channels[ch], static_cast<size_t>(numSamples)));
+    }
+
+    computeDetector(key, numKeyChannels, numSamples);
+
+    const float thresholds[GAIN_PARAMETER_PERIOD] = {m_params.thresholdDb, m_params.thresholdDb,
+                                                     m_params.thresholdDb, m_params.thresholdDb};
+    const float ratios[GAIN_PARAMETER_PERIOD] = {m_params.ratio, m_params.ratio, m_params.ratio, m_params.ratio};
+    meanSquareToGain(m_detector.data(), numSamples, thresholds, ratios);
+
+    const float makeupDb = m_params.autoMakeup ? autoMakeupDb(m_params.thresholdDb, m_params.ratio)
+                                               : m_params.makeupGainDb;
+    const float makeup = std::pow(10.0f, makeupDb / 20.0f);
+
+    // Attack when gain is decreasing (compressing more), release otherwise
+    const float* target = m_detector.data();
+    float* gain = m_gain.data();
+    float envelope = m_envelopeState;
+    float minEnvelope = 1.0f;
+
+    for (int i = 0; i < numSamples; ++i) {
+        const float coeff = target[i] < envelope ? m_attackCoeff : m_releaseCoeff;
+        envelope += coeff * (target[i] - envelope);
+        minEnvelope = std::min(minEnvelope, envelope);
+        gain[i] = envelope * makeup;
+    }
+    m_envelopeState = envelope;
+
+    for (int ch = 0; ch < numChannels; ++ch) {
+        daiw::simd::apply_envelope(channels[ch], gain, static_cast<size_t>(numSamples));
+        m_outputPeak = std::max(m_outputPeak, daiw::simd::find_peak(channels[ch], static_cast<size_t>(numSamples)));
+    }
+
+    m_gainReductionDb = std::max(m_gainReductionDb, -20.0f * std::log10(std::max(minEnvelope, 1e-10f)));
+}
+
+} // namespace iDAW
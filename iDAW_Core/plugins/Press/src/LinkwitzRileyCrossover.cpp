@@ -0,0 +1,272 @@
+/**
+ * LinkwitzRileyCrossover.cpp - Up to 4-band LR4 band splitter for "The Press"
+ */
+
+#include "LinkwitzRileyCrossover.h"
+#include "daiw/simd.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace iDAW {
+
+namespace {
+
+enum class Response { Lowpass, Highpass, Allpass };
+
+/** Q = 1/sqrt(2) bilinear section (RBJ cookbook), normalized by a0 */
+template<typename Coeffs>
+Coeffs designSection(Response response, double sampleRate, double frequency) noexcept {
+    const double w0 = 2.0 * M_PI * frequency / sampleRate;
+    const double cosw = std::cos(w0);
+    const double alpha = std::sin(w0) / std::sqrt(2.0);
+    const double a0 = 1.0 + alpha;
+
+    double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+    switch (response) {
+        case Response::Lowpass:
+            b0 = b2 = (1.0 - cosw) / 2.0;
+            b1 = 1.0 - cosw;
+            break;
+        case Response::Highpass:
+            b0 = b2 = (1.0 + cosw) / 2.0;
+            b1 = -(1.0 + cosw);
+            break;
+        case Response::Allpass:
+            b0 = 1.0 - alpha;
+            b1 = -2.0 * cosw;
+            b2 = 1.0 + alpha;
+            break;
+    }
+
+    Coeffs c;
+    c.b0 = static_cast<float>(b0 / a0);
+    c.b1 = static_cast<float>(b1 / a0);
+    c.b2 = static_cast<float>(b2 / a0);
+    c.a1 = static_cast<float>(-2.0 * cosw / a0);
+    c.a2 = static_cast<float>((1.0 - alpha) / a0);
+    return c;
+}
+
+} // namespace
+
+LinkwitzRileyCrossover::LinkwitzRileyCrossover() {
+    // Every lane passes through until setCrossovers()
+    for (int split = 0; split < MAX_SPLITS; ++split) {
+        for (int lane = 0; lane < LANES_PER_CHANNEL; ++lane) {
+            for (int section = 0; section < SECTIONS; ++section) {
+                setLane(split, lane, section, Coeffs{});
+            }
+        }
+    }
+    reset();
+}
+
+void LinkwitzRileyCrossover::setLane(int split, int laneInChannel, int section, const Coeffs& coeffs) noexcept {
+    for (int channel = 0; channel < MAX_CHANNELS; ++channel) {
+        const int lane = channel * LANES_PER_CHANNEL + laneInChannel;
+        m_b0[split][section][lane] = coeffs.b0;
+        m_b1[split][section][lane] = coeffs.b1;
+        m_b2[split][section][lane] = coeffs.b2;
+        m_a1[split][section][lane] = coeffs.a1;
+        m_a2[split][section][lane] = coeffs.a2;
+    }
+}
+
+void LinkwitzRileyCrossover::setCrossovers(double sampleRate, const float* frequencies, int numBands) noexcept {
+    numBands = std::clamp(numBands, 2, MAX_BANDS);
+    if (numBands != m_numBands) {
+        m_numBands = numBands;
+        reset();
+    }
+
+    const double nyquistLimit = 0.45 * sampleRate;
+    double previous = 0.0;
+
+    for (int split = 0; split < numBands - 1; ++split) {
+        // Ascending, below Nyquist
+        const double frequency = std::clamp(std::max(static_cast<double>(frequencies[split]), previous * 1.01),
+                                            10.0, nyquistLimit);
+        previous = frequency;
+
+        const auto lowpass = designSection<Coeffs>(Response::Lowpass, sampleRate, frequency);
+        const auto highpass = designSection<Coeffs>(Response::Highpass, sampleRate, frequency);
+        const auto allpass = designSection<Coeffs>(Response::Allpass, sampleRate, frequency);
+
+        for (int section = 0; section < SECTIONS; ++section) {
+            setLane(split, 0, section, lowpass);
+            setLane(split, 1, section, highpass);
+
+            // LR4 lowpass + highpass = one second-order allpass
+            const Coeffs compensation = section == 0 ? allpass : Coeffs{};
+            setLane(split, 2, section, split >= 1 ? compensation : Coeffs{});
+            setLane(split, 3, section, split >= 2 ? compensation : Coeffs{});
+        }
+    }
+}
+
+void LinkwitzRileyCrossover::reset() noexcept {
+    for (int split = 0; split < MAX_SPLITS; ++split) {
+        for (int section = 0; section < SECTIONS; ++section) {
+            for (int lane = 0; lane < NUM_LANES; ++lane) {
+                m_z1[split][section][lane] = 0.0f;
+                m_z2[split][section][lane] = 0.0f;
+            }
+        }
+    }
+}
+
+void LinkwitzRileyCrossover::processLane(int split, int lane, const float* in, float* out,
+                                         int numSamples) noexcept {
+    // Locals so the state stays in registers (out may alias in)
+    float b0[SECTIONS], b1[SECTIONS], b2[SECTIONS], a1[SECTIONS], a2[SECTIONS], z1[SECTIONS], z2[SECTIONS];
+    for (int section = 0; section < SECTIONS; ++section) {
+        b0[section] = m_b0[split][section][lane];
+        b1[section] = m_b1[split][section][lane];
+        b2[section] = m_b2[split][section][lane];
+        a1[section] = m_a1[split][section][lane];
+        a2[section] = m_a2[split][section][lane];
+        z1[section] = m_z1[split][section][lane];
+        z2[section] = m_z2[split][section][lane];
+    }
+
+    for (int i = 0; i < numSamples; ++i) {
+        float x = in[i];
+        for (int section = 0; section < SECTIONS; ++section) {
+            const float y = b0[section] * x + z1[section];
+            z1[section] = b1[section] * x - a1[section] * y + z2[section];
+            z2[section] = b2[section] * x - a2[section] * y;
+            x = y;
+        }
+        out[i] = x;
+    }
+
+    for (int section = 0; section < SECTIONS; ++section) {
+        m_z1[split][section][lane] = z1[section];
+        m_z2[split][section][lane] = z2[section];
+    }
+}
+
+void LinkwitzRileyCrossover::process(const float* const* input, int numChannels, const BandBuffers& bands,
+                                     int numSamples) noexcept {
+    numChannels = std::min(numChannels, MAX_CHANNELS);
+    const int top = m_numBands - 1;
+
+    for (int split = 0; split < m_numBands - 1; ++split) {
+        // Lane routing for this split point; unused lanes read silence
+        const float* in[NUM_LANES] = {};
+        float* out[NUM_LANES] = {};
+        for (int channel = 0; channel < numChannels; ++channel) {
+            const float* rest = split == 0 ? input[channel] : bands[top][channel];
+            const int base = channel * LANES_PER_CHANNEL;
+            in[base + 0] = rest;
+            out[base + 0] = bands[split][channel];
+            in[base + 1] = rest;
+            out[base + 1] = bands[top][channel];
+            if (split >= 1) in[base + 2] = out[base + 2] = bands[0][channel];
+            if (split >= 2) in[base + 3] = out[base + 3] = bands[1][channel];
+        }
+
+        int i = 0;
+
+#if defined(DAIW_AVX2) || defined(DAIW_AVX512)
+        __m256 b0[SECTIONS], b1[SECTIONS], b2[SECTIONS], a1[SECTIONS], a2[SECTIONS], z1[SECTIONS], z2[SECTIONS];
+        for (int section = 0; section < SECTIONS; ++section) {
+            b0[section] = _mm256_load_ps(m_b0[split][section]);
+            b1[section] = _mm256_load_ps(m_b1[split][section]);
+            b2[section] = _mm256_load_ps(m_b2[split][section]);
+            a1[section] = _mm256_load_ps(m_a1[split][section]);
+            a2[section] = _mm256_load_ps(m_a2[split][section]);
+            z1[section] = _mm256_load_ps(m_z1[split][section]);
+            z2[section] = _mm256_load_ps(m_z2[split][section]);
+        }
+
+        for (; i + 8 <= numSamples; i += 8) {
+            // Every lane's input is loaded before any output is stored, so
+            // lanes may filter their own buffer in place
+            __m256 tile[8];
+            for (int lane = 0; lane < NUM_LANES; ++lane) {
+                tile[lane] = in[lane] ? _mm256_loadu_ps(in[lane] + i) : _mm256_setzero_ps();
+            }
+            daiw::simd::transpose8x8(tile);
+
+            // y = b0 x + z1;  z1 = b1 x - a1 y + z2;  z2 = b2 x - a2 y
+            for (int k = 0; k < 8; ++k) {
+                __m256 x = tile[k];
+                for (int section = 0; section < SECTIONS; ++section) {
+                    const __m256 y = _mm256_fmadd_ps(b0[section], x, z1[section]);
+                    z1[section] = _mm256_fnmadd_ps(a1[section], y, _mm256_fmadd_ps(b1[section], x, z2[section]));
+                    z2[section] = _mm256_fnmadd_ps(a2[section], y, _mm256_mul_ps(b2[section], x));
+                    x = y;
+                }
+                tile[k] = x;
+            }
+
+            daiw::simd::transpose8x8(tile);
+            for (int lane = 0; lane < NUM_LANES; ++lane) {
+                if (out[lane]) _mm256_storeu_ps(out[lane] + i, tile[lane]);
+            }
+        }
+
+        for (int section = 0; section < SECTIONS; ++section) {
+            _mm256_store_ps(m_z1[split][section], z1[section]);
+            _mm256_store_ps(m_z2[split][section], z2[section]);
+        }
+#elif defined(DAIW_SSE42)
+        // One channel's 4 lanes per vector, tiles of 4 samples
+        const int tiled = numSamples & ~3;
+        for (int channel = 0; channel < numChannels; ++channel) {
+            const int base = channel * LANES_PER_CHANNEL;
+            __m128 b0[SECTIONS], b1[SECTIONS], b2[SECTIONS], a1[SECTIONS], a2[SECTIONS], z1[SECTIONS], z2[SECTIONS];
+            for (int section = 0; section < SECTIONS; ++section) {
+                b0[section] = _mm_load_ps(m_b0[split][section] + base);
+                b1[section] = _mm_load_ps(m_b1[split][section] + base);
+                b2[section] = _mm_load_ps(m_b2[split][section] + base);
+                a1[section] = _mm_load_ps(m_a1[split][section] + base);
+                a2[section] = _mm_load_ps(m_a2[split][section] + base);
+                z1[section] = _mm_load_ps(m_z1[split][section] + base);
+                z2[section] = _mm_load_ps(m_z2[split][section] + base);
+            }
+
+            for (int j = 0; j < tiled; j += 4) {
+                __m128 tile[4];
+                for (int lane = 0; lane < LANES_PER_CHANNEL; ++lane) {
+                    const float* src = in[base + lane];
+                    tile[lane] = src ? _mm_loadu_ps(src + j) : _mm_setzero_ps();
+                }
+                _MM_TRANSPOSE4_PS(tile[0], tile[1], tile[2], tile[3]);
+
+                for (int k = 0; k < 4; ++k) {
+                    __m128 x = tile[k];
+                    for (int section = 0; section < SECTIONS; ++section) {
+                        const __m128 y = _mm_add_ps(_mm_mul_ps(b0[section], x), z1[section]);
+                        z1[section] = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(b1[section], x), z2[section]),
+                                                 _mm_mul_ps(a1[section], y));
+                        z2[section] = _mm_sub_ps(_mm_mul_ps(b2[section], x), _mm_mul_ps(a2[section], y));
+                        x = y;
+                    }
+                    tile[k] = x;
+                }
+
+                _MM_TRANSPOSE4_PS(tile[0], tile[1], tile[2], tile[3]);
+                for (int lane = 0; lane < LANES_PER_CHANNEL; ++lane) {
+                    if (out[base + lane]) _mm_storeu_ps(out[base + lane] + j, tile[lane]);
+                }
+            }
+
+            for (int section = 0; section < SECTIONS; ++section) {
+                _mm_store_ps(m_z1[split][section] + base, z1[section]);
+                _mm_store_ps(m_z2[split][section] + base, z2[section]);
+            }
+        }
+        i = tiled;
+#endif
+
+        // Remaining samples (or all of them without SIMD) lane by lane; the
+        // lowpass reads the rest before the highpass overwrites it
+        for (int lane = 0; lane < NUM_LANES; ++lane) {
+            if (in[lane]) processLane(split, lane, in[lane] + i, out[lane] + i, numSamples - i);
+        }
+    }
+}
+
+} // namespace iDAW
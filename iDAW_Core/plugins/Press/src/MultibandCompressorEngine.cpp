@@ -0,0 +1,261 @@
+/**
+ * MultibandCompressorEngine.cpp - Multiband mode of "The Press"
+ */
+
+#include "MultibandCompressorEngine.h"
+#include "daiw/simd.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(DAIW_AVX2) || defined(DAIW_AVX512) || defined(DAIW_SSE42)
+#define IDAW_PRESS_BAND_LANES 1
+#endif
+
+namespace iDAW {
+
+void MultibandCompressorEngine::prepare(double sampleRate, int maxBlockSize) {
+    m_sampleRate = sampleRate;
+    m_maxBlockSize = std::max(1, maxBlockSize);
+    const size_t block = static_cast<size_t>(m_maxBlockSize);
+
+    m_bandStorage.assign(MAX_BANDS * MAX_CHANNELS * block, 0.0f);
+    m_keyStorage.assign(MAX_BANDS * MAX_CHANNELS * block, 0.0f);
+    for (int band = 0; band < MAX_BANDS; ++band) {
+        for (int ch = 0; ch < MAX_CHANNELS; ++ch) {
+            const size_t offset = static_cast<size_t>(band * MAX_CHANNELS + ch) * block;
+            m_bands[band][ch] = m_bandStorage.data() + offset;
+            m_keyBands[band][ch] = m_keyStorage.data() + offset;
+        }
+    }
+
+    m_rmsWindow = std::max(1, static_cast<int>(PressConfig::RMS_WINDOW_MS * sampleRate / 1000.0));
+    m_rmsBuffer.assign(static_cast<size_t>(m_rmsWindow) * MAX_BANDS, 0.0f);
+    m_detector.assign(block * MAX_BANDS, 0.0f);
+    m_gain.assign(block * MAX_BANDS, 0.0f);
+    m_silence.assign(block, 0.0f);
+
+    setParameters(m_params);
+    reset();
+}
+
+void MultibandCompressorEngine::reset() noexcept {
+    m_crossover.reset();
+    m_keyCrossover.reset();
+    std::fill(m_rmsBuffer.begin(), m_rmsBuffer.end(), 0.0f);
+    m_rmsBufferIndex = 0;
+    for (int band = 0; band < MAX_BANDS; ++band) {
+        m_rmsSum[band] = 0.0f;
+        m_envelope[band] = 1.0f;
+        m_gainReductionDb[band] = 0.0f;
+    }
+    m_inputPeak = 0.0f;
+    m_outputPeak = 0.0f;
+}
+
+void MultibandCompressorEngine::setParameters(const MultibandParams& params) noexcept {
+    m_params = params;
+    m_params.numBands = std::clamp(m_params.numBands, 2, MAX_BANDS);
+    for (auto& hz : m_params.crossoverHz) {
+        hz = std::clamp(hz, PressConfig::MIN_CROSSOVER_HZ, PressConfig::MAX_CROSSOVER_HZ);
+    }
+    for (auto& band : m_params.bands) {
+        band.releaseMs = std::max(band.releaseMs, PressConfig::MIN_RELEASE_MS);
+    }
+
+    m_crossover.setCrossovers(m_sampleRate, m_params.crossoverHz.data(), m_params.numBands);
+    m_keyCrossover.setCrossovers(m_sampleRate, m_params.crossoverHz.data(), m_params.numBands);
+    updateEnvelopeCoeffs();
+}
+
+void MultibandCompressorEngine::updateEnvelopeCoeffs() noexcept {
+    // Same time constants as CompressorEngine, one per band
+    const float samplesPerMs = static_cast<float>(m_sampleRate) / 1000.0f;
+    for (int band = 0; band < MAX_BANDS; ++band) {
+        m_attackCoeff[band] = 1.0f - std::exp(-1.0f / (m_params.bands[band].attackMs * samplesPerMs));
+        m_releaseCoeff[band] = 1.0f - std::exp(-1.0f / (m_params.bands[band].releaseMs * samplesPerMs));
+    }
+}
+
+float MultibandCompressorEngine::getGainReductionDb(int band) const noexcept {
+    return band >= 0 && band < MAX_BANDS ? m_gainReductionDb[band] : 0.0f;
+}
+
+void MultibandCompressorEngine::process(float* const* channels, int numChannels, int numSamples,
+                                        const float* const* sidechain, int numSidechainChannels) noexcept {
+    m_gainReductionDb.fill(0.0f);
+    m_inputPeak = 0.0f;
+    m_outputPeak = 0.0f;
+    if (m_maxBlockSize == 0 || numChannels <= 0) return;
+
+    numChannels = std::min(numChannels, MAX_CHANNELS);
+    const bool external = sidechain != nullptr && numSidechainChannels > 0;
+    const int numKeyChannels = external ? std::min(numSidechainChannels, MAX_CHANNELS) : 0;
+
+    float* chunk[MAX_CHANNELS] = {};
+    const float* key[MAX_CHANNELS] = {};
+    for (int offset = 0; offset < numSamples; offset += m_maxBlockSize) {
+        for (int ch = 0; ch < numChannels; ++ch) chunk[ch] = channels[ch] + offset;
+        for (int ch = 0; ch < numKeyChannels; ++ch) key[ch] = sidechain[ch] + offset;
+        processChunk(chunk, numChannels, external ? key : nullptr, numKeyChannels,
+                     std::min(m_maxBlockSize, numSamples - offset));
+    }
+}
+
+void MultibandCompressorEngine::computeDetector(const LinkwitzRileyCrossover::BandBuffers& key,
+                                                int numKeyChannels, int numSamples) noexcept {
+    // Bands past numBands read silence and sit at the floor (unity gain)
+    const float* source[MAX_BANDS][MAX_CHANNELS];
+    for (int band = 0; band < MAX_BANDS; ++band) {
+        for (int ch = 0; ch < MAX_CHANNELS; ++ch) {
+            source[band][ch] = band < m_params.numBands && ch < numKeyChannels ? key[band][ch] : m_silence.data();
+        }
+    }
+
+    const float channelScale = 1.0f / static_cast<float>(numKeyChannels);
+    const float invWindow = 1.0f / static_cast<float>(m_rmsWindow);
+    float* detector = m_detector.data();
+    float* ring = m_rmsBuffer.data();
+    int index = m_rmsBufferIndex;
+
+#if defined(IDAW_PRESS_BAND_LANES)
+    const __m128 scale = _mm_set1_ps(channelScale);
+    const __m128 scaleWindow = _mm_set1_ps(invWindow);
+    const __m128 floor = _mm_set1_ps(PressConfig::MIN_MEAN_SQUARE);
+    __m128 sum = _mm_load_ps(m_rmsSum);
+
+    for (int i = 0; i < numSamples; ++i) {
+        __m128 meanSquare = _mm_setzero_ps();
+        for (int ch = 0; ch < numKeyChannels; ++ch) {
+            const __m128 x = _mm_setr_ps(source[0][ch][i], source[1][ch][i], source[2][ch][i], source[3][ch][i]);
+            meanSquare = _mm_add_ps(meanSquare, _mm_mul_ps(x, x));
+        }
+        meanSquare = _mm_mul_ps(meanSquare, scale);
+
+        float* slot = ring + index * MAX_BANDS;
+        sum = _mm_add_ps(_mm_sub_ps(sum, _mm_loadu_ps(slot)), meanSquare);
+        _mm_storeu_ps(slot, meanSquare);
+        if (++index == m_rmsWindow) index = 0;
+
+        _mm_storeu_ps(detector + i * MAX_BANDS, _mm_max_ps(_mm_mul_ps(sum, scaleWindow), floor));
+    }
+
+    _mm_store_ps(m_rmsSum, sum);
+#else
+    for (int i = 0; i < numSamples; ++i) {
+        float* slot = ring + index * MAX_BANDS;
+        for (int band = 0; band < MAX_BANDS; ++band) {
+            float meanSquare = 0.0f;
+            for (int ch = 0; ch < numKeyChannels; ++ch) {
+                meanSquare += source[band][ch][i] * source[band][ch][i];
+            }
+            meanSquare *= channelScale;
+
+            m_rmsSum[band] = (m_rmsSum[band] - slot[band]) + meanSquare;
+            slot[band] = meanSquare;
+            detector[i * MAX_BANDS + band] = std::max(m_rmsSum[band] * invWindow, PressConfig::MIN_MEAN_SQUARE);
+        }
+        if (++index == m_rmsWindow) index = 0;
+    }
+#endif
+
+    m_rmsBufferIndex = index;
+}
+
+void MultibandCompressorEngine::computeEnvelopes(int numSamples) noexcept {
+    alignas(16) float makeup[MAX_BANDS];
+    for (int band = 0; band < MAX_BANDS; ++band) {
+        const CompressorParams& p = m_params.bands[band];
+        const float makeupDb = p.autoMakeup ? CompressorEngine::autoMakeupDb(p.thresholdDb, p.ratio) : p.makeupGainDb;
+        makeup[band] = std::pow(10.0f, makeupDb / 20.0f);
+    }
+
+    const float* target = m_detector.data();
+    float* gain[MAX_BANDS];
+    for (int band = 0; band < MAX_BANDS; ++band) {
+        gain[band] = m_gain.data() + static_cast<size_t>(band) * m_maxBlockSize;
+    }
+    alignas(16) float minEnvelope[MAX_BANDS] = {1.0f, 1.0f, 1.0f, 1.0f};
+
+#if defined(IDAW_PRESS_BAND_LANES)
+    // Attack where the band's gain is decreasing, release otherwise
+    const __m128 attack = _mm_load_ps(m_attackCoeff);
+    const __m128 release = _mm_load_ps(m_releaseCoeff);
+    const __m128 makeupGain = _mm_load_ps(makeup);
+    __m128 envelope = _mm_load_ps(m_envelope);
+    __m128 lowest = _mm_load_ps(minEnvelope);
+
+    for (int i = 0; i < numSamples; ++i) {
+        const __m128 t = _mm_loadu_ps(target + i * MAX_BANDS);
+        const __m128 coeff = _mm_blendv_ps(release, attack, _mm_cmplt_ps(t, envelope));
+        envelope = _mm_add_ps(envelope, _mm_mul_ps(coeff, _mm_sub_ps(t, envelope)));
+        lowest = _mm_min_ps(lowest, envelope);
+
+        alignas(16) float g[MAX_BANDS];
+        _mm_store_ps(g, _mm_mul_ps(envelope, makeupGain));
+        for (int band = 0; band < MAX_BANDS; ++band) gain[band][i] = g[band];
+    }
+
+    _mm_store_ps(m_envelope, envelope);
+    _mm_store_ps(minEnvelope, lowest);
+#else
+    for (int band = 0; band < MAX_BANDS; ++band) {
+        float envelope = m_envelope[band];
+        for (int i = 0; i < numSamples; ++i) {
+            const float t = target[i * MAX_BANDS + band];
+            const float coeff = t < envelope ? m_attackCoeff[band] : m_releaseCoeff[band];
+            envelope += coeff * (t - envelope);
+            minEnvelope[band] = std::min(minEnvelope[band], envelope);
+            gain[band][i] = envelope * makeup[band];
+        }
+        m_envelope[band] = envelope;
+    }
+#endif
+
+    for (int band = 0; band < m_params.numBands; ++band) {
+        m_gainReductionDb[band] = std::max(m_gainReductionDb[band],
+                                           -20.0f * std::log10(std::max(minEnvelope[band], 1e-10f)));
+    }
+}
+
+void MultibandCompressorEngine::processChunk(float* const* channels, int numChannels, const float* const* key,
+                                             int numKeyChannels, int numSamples) noexcept {
+    const size_t n = static_cast<size_t>(numSamples);
+    for (int ch = 0; ch < numChannels; ++ch) {
+        m_inputPeak = std::max(m_inputPeak, daiw::simd::find_peak(channels[ch], n));
+    }
+
+    m_crossover.process(channels, numChannels, m_bands, numSamples);
+
+    if (key) {
+        m_keyCrossover.process(key, numKeyChannels, m_keyBands, numSamples);
+        computeDetector(m_keyBands, numKeyChannels, numSamples);
+    } else {
+        computeDetector(m_bands, numChannels, numSamples);
+    }
+
+    alignas(16) float thresholds[MAX_BANDS];
+    alignas(16) float ratios[MAX_BANDS];
+    for (int band = 0; band < MAX_BANDS; ++band) {
+        thresholds[band] = m_params.bands[band].thresholdDb;
+        ratios[band] = m_params.bands[band].ratio;
+    }
+    CompressorEngine::meanSquareToGain(m_detector.data(), numSamples * MAX_BANDS, thresholds, ratios);
+
+    computeEnvelopes(numSamples);
+
+    // Sum the gained bands back into the channels
+    for (int ch = 0; ch < numChannels; ++ch) {
+        for (int band = 0; band < m_params.numBands; ++band) {
+            float* signal = m_bands[band][ch];
+            daiw::simd::apply_envelope(signal, m_gain.data() + static_cast<size_t>(band) * m_maxBlockSize, n);
+            if (band == 0) {
+                std::copy(signal, signal + n, channels[ch]);
+            } else {
+                daiw::simd::mix_buffers(channels[ch], signal, n);
+            }
+        }
+        m_outputPeak = std::max(m_outputPeak, daiw::simd::find_peak(channels[ch], n));
+    }
+}
+
+} // namespace iDAW
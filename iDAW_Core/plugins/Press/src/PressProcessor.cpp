@@ -8,15 +8,12 @@
  * - Feed-forward topology
  * - Soft knee compression
  * - Accurate gain reduction metering
+ * - Optional sidechain key and 2-4 band multiband mode
  */
 
 #include "PressProcessor.h"
 #include <algorithm>
-
-// x86 SIMD intrinsics for denormal protection
-#if defined(__SSE__) || defined(_M_X64) || defined(_M_IX86)
-#include <xmmintrin.h>
-#endif
+#include <cstring>
 
 namespace iDAW {
 
@@ -27,7 +24,8 @@ namespace iDAW {
 PressProcessor::PressProcessor()
     : AudioProcessor(BusesProperties()
                      .withInput("Input", juce::AudioChannelSet::stereo(), true)
-                     .withOutput("Output", juce::AudioChannelSet::stereo(), true))
+                     .withOutput("Output", juce::AudioChannelSet::stereo(), true)
+                     .withInput("Sidechain", juce::AudioChannelSet::stereo(), false))
 {
     // Default parameters (neutral compression)
     m_params.thresholdDb = -20.0f;
@@ -36,6 +34,9 @@ PressProcessor::PressProcessor()
     m_params.releaseMs = 100.0f;
     m_params.makeupGainDb = 0.0f;
     m_params.autoMakeup = false;
+    
+    // Each band starts from the same neutral settings
+    m_multibandParams.bands.fill(m_params);
 }
 
 PressProcessor::~PressProcessor() = default;
@@ -44,26 +45,16 @@ PressProcessor::~PressProcessor() = default;
 // AudioProcessor Interface
 //==============================================================================
 
-void PressProcessor::prepareToPlay(double sampleRate, int /*samplesPerBlock*/) {
-    m_sampleRate = sampleRate;
-    
-    // Calculate RMS window size
-    m_rmsWindowSamples = static_cast<int>(PressConfig::RMS_WINDOW_MS * sampleRate / 1000.0);
-    m_rmsWindowSamples = std::max(m_rmsWindowSamples, 1);
-    
-    // Initialize RMS buffer
-    m_rmsBuffer.resize(m_rmsWindowSamples, 0.0f);
-    m_rmsBufferIndex = 0;
-    m_rmsSum = 0.0f;
-    
-    // Initialize envelope
-    m_envelopeState = 1.0f;
-    
-    // Calculate envelope coefficients
-    updateEnvelopeCoeffs();
+void PressProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
+    // RMS window, envelope state and work buffers
+    m_engine.setParameters(m_params);
+    m_engine.prepare(sampleRate, samplesPerBlock);
+    m_multiband.setParameters(m_multibandParams);
+    m_multiband.prepare(sampleRate, samplesPerBlock);
     
     // Reset meters
     m_gainReductionDb.store(0.0f);
+    for (auto& bandGr : m_bandGainReductionDb) bandGr.store(0.0f);
     m_inputLevelDb.store(-100.0f);
     m_outputLevelDb.store(-100.0f);
     m_inputPeak = 0.0f;
@@ -73,10 +64,23 @@ void PressProcessor::prepareToPlay(double sampleRate, int /*samplesPerBlock*/) {
 }
 
 void PressProcessor::releaseResources() {
-    m_rmsBuffer.clear();
     m_prepared = false;
 }
 
+bool PressProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
+    // Main bus: mono or stereo, in == out. Sidechain: off, mono or stereo.
+    const auto mainOut = layouts.getMainOutputChannelSet();
+    if (mainOut != juce::AudioChannelSet::mono() && mainOut != juce::AudioChannelSet::stereo()) return false;
+    if (layouts.getMainInputChannelSet() != mainOut) return false;
+    
+    if (layouts.inputBuses.size() > 1) {
+        const auto sidechain = layouts.getChannelSet(true, 1);
+        return sidechain.isDisabled() || sidechain == juce::AudioChannelSet::mono() ||
+               sidechain == juce::AudioChannelSet::stereo();
+    }
+    return true;
+}
+
 void PressProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                    juce::MidiBuffer& /*midiMessages*/) {
     if (!m_prepared) return;
@@ -86,158 +90,52 @@ void PressProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     // ==========================================================================
     juce::ScopedNoDenormals noDenormals;
     
-    // Additional x86 denormal protection (belt and suspenders)
-    #if defined(__SSE__) || defined(_M_X64) || defined(_M_IX86)
-    unsigned int mxcsr = _mm_getcsr();
-    _mm_setcsr(mxcsr | 0x8040);  // DAZ and FTZ bits
-    #endif
+    auto mainBus = getBusBuffer(buffer, true, 0);
     
-    // ==========================================================================
-    // SAFETY: Enforce minimum release time to prevent aliasing/distortion
-    // ==========================================================================
-    const float safeReleaseMs = std::max(m_params.releaseMs, 10.0f);
-    if (safeReleaseMs != m_params.releaseMs) {
-        m_params.releaseMs = safeReleaseMs;
-        updateEnvelopeCoeffs();
+    // External key, when enabled and connected by the host
+    const float* const* key = nullptr;
+    int numKeyChannels = 0;
+    juce::AudioBuffer<float> sidechainBus;
+    if (m_sidechainEnabled && getBusCount(true) > 1 && getBus(true, 1)->isEnabled()) {
+        sidechainBus = getBusBuffer(buffer, true, 1);
+        key = sidechainBus.getArrayOfReadPointers();
+        numKeyChannels = sidechainBus.getNumChannels();
     }
     
-    const int numChannels = buffer.getNumChannels();
-    const int numSamples = buffer.getNumSamples();
-    
-    // Get makeup gain (auto or manual)
-    float makeupGain = m_params.autoMakeup ? 
-                       dbToLinear(calculateAutoMakeup()) : 
-                       dbToLinear(m_params.makeupGainDb);
+    // Detector, gain computer and gain for the whole block
+    float inputPeak = 0.0f;
+    float outputPeak = 0.0f;
+    float gainReduction = 0.0f;
     
-    // Track peak levels for metering
-    float blockInputPeak = 0.0f;
-    float blockOutputPeak = 0.0f;
-    float blockGainReduction = 0.0f;
-    
-    // Process sample by sample for accurate envelope following
-    for (int sample = 0; sample < numSamples; ++sample) {
-        // Calculate input level (sum of squares across channels)
-        float sumSquares = 0.0f;
-        for (int channel = 0; channel < numChannels; ++channel) {
-            float inputSample = buffer.getSample(channel, sample);
-            sumSquares += inputSample * inputSample;
-            blockInputPeak = std::max(blockInputPeak, std::abs(inputSample));
-        }
-        
-        // Update RMS buffer (running sum for efficiency)
-        m_rmsSum -= m_rmsBuffer[m_rmsBufferIndex];
-        m_rmsBuffer[m_rmsBufferIndex] = sumSquares / numChannels;
-        m_rmsSum += m_rmsBuffer[m_rmsBufferIndex];
-        m_rmsBufferIndex = (m_rmsBufferIndex + 1) % m_rmsWindowSamples;
-        
-        // Calculate RMS level
-        float rmsLevel = std::sqrt(m_rmsSum / m_rmsWindowSamples);
-        float inputDb = linearToDb(rmsLevel);
-        
-        // Calculate target gain reduction
-        float targetGainDb = calculateGainReduction(inputDb);
-        float targetGainLinear = dbToLinear(targetGainDb);
-        
-        // Apply envelope (attack/release)
-        m_envelopeState = applyEnvelope(targetGainLinear, m_envelopeState);
+    if (m_bandCount > 1) {
+        m_multiband.setParameters(m_multibandParams);
+        m_multiband.process(mainBus.getArrayOfWritePointers(), mainBus.getNumChannels(),
+                            mainBus.getNumSamples(), key, numKeyChannels);
         
-        // Calculate actual gain reduction in dB
-        float actualGainReductionDb = -linearToDb(m_envelopeState);
-        blockGainReduction = std::max(blockGainReduction, actualGainReductionDb);
-        
-        // Apply gain reduction and makeup gain to all channels
-        float totalGain = m_envelopeState * makeupGain;
-        
-        for (int channel = 0; channel < numChannels; ++channel) {
-            float* channelData = buffer.getWritePointer(channel);
-            channelData[sample] *= totalGain;
-            blockOutputPeak = std::max(blockOutputPeak, std::abs(channelData[sample]));
+        for (int band = 0; band < PressConfig::MAX_BANDS; ++band) {
+            const float bandGr = m_multiband.getGainReductionDb(band);
+            m_bandGainReductionDb[band].store(bandGr);
+            gainReduction = std::max(gainReduction, bandGr);
         }
+        inputPeak = m_multiband.getInputPeak();
+        outputPeak = m_multiband.getOutputPeak();
+    } else {
+        m_engine.setParameters(m_params);
+        m_engine.process(mainBus.getArrayOfWritePointers(), mainBus.getNumChannels(),
+                         mainBus.getNumSamples(), key, numKeyChannels);
+        
+        gainReduction = m_engine.getGainReductionDb();
+        inputPeak = m_engine.getInputPeak();
+        outputPeak = m_engine.getOutputPeak();
     }
     
     // Update meters with decay
-    m_inputPeak = std::max(blockInputPeak, m_inputPeak * METER_DECAY);
-    m_outputPeak = std::max(blockOutputPeak, m_outputPeak * METER_DECAY);
+    m_inputPeak = std::max(inputPeak, m_inputPeak * METER_DECAY);
+    m_outputPeak = std::max(outputPeak, m_outputPeak * METER_DECAY);
     
     m_inputLevelDb.store(linearToDb(m_inputPeak));
     m_outputLevelDb.store(linearToDb(m_outputPeak));
-    m_gainReductionDb.store(blockGainReduction);
-}
-
-float PressProcessor::calculateRMS(const float* samples, int numSamples) {
-    float sum = 0.0f;
-    for (int i = 0; i < numSamples; ++i) {
-        sum += samples[i] * samples[i];
-    }
-    return std::sqrt(sum / numSamples);
-}
-
-float PressProcessor::calculateGainReduction(float inputDb) {
-    const float threshold = m_params.thresholdDb;
-    const float ratio = m_params.ratio;
-    const float kneeWidth = PressConfig::KNEE_WIDTH_DB;
-    
-    // Below threshold: no compression
-    if (inputDb < threshold - kneeWidth / 2.0f) {
-        return 0.0f;  // 0 dB gain reduction
-    }
-    
-    // Above threshold + knee: full compression
-    if (inputDb > threshold + kneeWidth / 2.0f) {
-        float overThreshold = inputDb - threshold;
-        float targetOutput = threshold + overThreshold / ratio;
-        return targetOutput - inputDb;  // Negative value (gain reduction)
-    }
-    
-    // In knee region: soft knee compression
-    float kneeStart = threshold - kneeWidth / 2.0f;
-    float kneePosition = (inputDb - kneeStart) / kneeWidth;  // 0 to 1
-    
-    // Quadratic interpolation for soft knee
-    float kneeRatio = 1.0f + (ratio - 1.0f) * kneePosition * kneePosition;
-    float overThreshold = inputDb - threshold;
-    float targetOutput = threshold + overThreshold / kneeRatio;
-    
-    return targetOutput - inputDb;
-}
-
-float PressProcessor::applyEnvelope(float targetGain, float currentGain) {
-    // Feed-forward: target gain is what we want to apply
-    // Use attack when gain is decreasing (compressing more)
-    // Use release when gain is increasing (compressing less)
-    
-    if (targetGain < currentGain) {
-        // Attack: compressing more
-        return currentGain + m_attackCoeff * (targetGain - currentGain);
-    } else {
-        // Release: compressing less
-        return currentGain + m_releaseCoeff * (targetGain - currentGain);
-    }
-}
-
-void PressProcessor::updateEnvelopeCoeffs() {
-    // Time constant formula: coeff = 1 - exp(-1 / (time * sampleRate))
-    // This gives ~63% of the way to target in the specified time
-    
-    float attackTimeSamples = m_params.attackMs * static_cast<float>(m_sampleRate) / 1000.0f;
-    float releaseTimeSamples = m_params.releaseMs * static_cast<float>(m_sampleRate) / 1000.0f;
-    
-    m_attackCoeff = 1.0f - std::exp(-1.0f / attackTimeSamples);
-    m_releaseCoeff = 1.0f - std::exp(-1.0f / releaseTimeSamples);
-}
-
-float PressProcessor::calculateAutoMakeup() const {
-    // Estimate makeup gain based on threshold and ratio
-    // Assumes program material averages around -18 dBFS
-    float averageLevel = -18.0f;
-    
-    if (averageLevel > m_params.thresholdDb) {
-        float overThreshold = averageLevel - m_params.thresholdDb;
-        float reduction = overThreshold - (overThreshold / m_params.ratio);
-        return reduction * 0.7f;  // Apply 70% of calculated makeup
-    }
-    
-    return 0.0f;
+    m_gainReductionDb.store(gainReduction);
 }
 
 //==============================================================================
@@ -260,18 +158,12 @@ void PressProcessor::setAttack(float attackMs) {
     m_params.attackMs = std::clamp(attackMs, 
                                     PressConfig::MIN_ATTACK_MS, 
                                     PressConfig::MAX_ATTACK_MS);
-    if (m_prepared) {
-        updateEnvelopeCoeffs();
-    }
 }
 
 void PressProcessor::setRelease(float releaseMs) {
     m_params.releaseMs = std::clamp(releaseMs, 
                                      PressConfig::MIN_RELEASE_MS, 
                                      PressConfig::MAX_RELEASE_MS);
-    if (m_prepared) {
-        updateEnvelopeCoeffs();
-    }
 }
 
 void PressProcessor::setMakeupGain(float gainDb) {
@@ -284,6 +176,52 @@ void PressProcessor::setAutoMakeup(bool enabled) {
     m_params.autoMakeup = enabled;
 }
 
+//==============================================================================
+// Sidechain / Multiband
+//==============================================================================
+
+CompressorParams PressProcessor::clampParams(const CompressorParams& params) {
+    CompressorParams clamped = params;
+    clamped.thresholdDb = std::clamp(params.thresholdDb, PressConfig::MIN_THRESHOLD_DB, PressConfig::MAX_THRESHOLD_DB);
+    clamped.ratio = std::clamp(params.ratio, PressConfig::MIN_RATIO, PressConfig::MAX_RATIO);
+    clamped.attackMs = std::clamp(params.attackMs, PressConfig::MIN_ATTACK_MS, PressConfig::MAX_ATTACK_MS);
+    clamped.releaseMs = std::clamp(params.releaseMs, PressConfig::MIN_RELEASE_MS, PressConfig::MAX_RELEASE_MS);
+    clamped.makeupGainDb = std::clamp(params.makeupGainDb, PressConfig::MIN_GAIN_DB, PressConfig::MAX_GAIN_DB);
+    return clamped;
+}
+
+void PressProcessor::setBandCount(int numBands) {
+    m_bandCount = std::clamp(numBands, 1, PressConfig::MAX_BANDS);
+    m_multibandParams.numBands = std::max(m_bandCount, 2);
+}
+
+void PressProcessor::setCrossover(int index, float frequencyHz) {
+    if (index < 0 || index >= PressConfig::MAX_BANDS - 1) return;
+    m_multibandParams.crossoverHz[index] = std::clamp(frequencyHz,
+                                                      PressConfig::MIN_CROSSOVER_HZ,
+                                                      PressConfig::MAX_CROSSOVER_HZ);
+}
+
+float PressProcessor::getCrossover(int index) const {
+    if (index < 0 || index >= PressConfig::MAX_BANDS - 1) return 0.0f;
+    return m_multibandParams.crossoverHz[index];
+}
+
+void PressProcessor::setBandParameters(int band, const CompressorParams& params) {
+    if (band < 0 || band >= PressConfig::MAX_BANDS) return;
+    m_multibandParams.bands[band] = clampParams(params);
+}
+
+CompressorParams PressProcessor::getBandParameters(int band) const {
+    if (band < 0 || band >= PressConfig::MAX_BANDS) return {};
+    return m_multibandParams.bands[band];
+}
+
+float PressProcessor::getBandGainReduction(int band) const {
+    if (band < 0 || band >= PressConfig::MAX_BANDS || m_bandCount == 1) return 0.0f;
+    return m_bandGainReductionDb[band].load();
+}
+
 //==============================================================================
 // Ghost Hands Integration
 //==============================================================================
@@ -362,6 +300,23 @@ void PressProcessor::getStateInformation(juce::MemoryBlock& destData) {
     
     int autoMakeup = m_params.autoMakeup ? 1 : 0;
     destData.append(&autoMakeup, sizeof(int));
+    
+    // Sidechain / multiband (appended; older states end above)
+    int sidechain = m_sidechainEnabled ? 1 : 0;
+    destData.append(&sidechain, sizeof(int));
+    destData.append(&m_bandCount, sizeof(int));
+    for (float hz : m_multibandParams.crossoverHz) {
+        destData.append(&hz, sizeof(float));
+    }
+    for (const auto& band : m_multibandParams.bands) {
+        destData.append(&band.thresholdDb, sizeof(float));
+        destData.append(&band.ratio, sizeof(float));
+        destData.append(&band.attackMs, sizeof(float));
+        destData.append(&band.releaseMs, sizeof(float));
+        destData.append(&band.makeupGainDb, sizeof(float));
+        int bandAutoMakeup = band.autoMakeup ? 1 : 0;
+        destData.append(&bandAutoMakeup, sizeof(int));
+    }
 }
 
 void PressProcessor::setStateInformation(const void* data, int sizeInBytes) {
@@ -389,9 +344,42 @@ void PressProcessor::setStateInformation(const void* data, int sizeInBytes) {
         int autoMakeup;
         std::memcpy(&autoMakeup, byteData + offset, sizeof(int));
         m_params.autoMakeup = (autoMakeup != 0);
+        offset += sizeof(int);
+        
+        const int bandSize = 5 * sizeof(float) + sizeof(int);
+        const int multibandSize = 2 * sizeof(int) + (PressConfig::MAX_BANDS - 1) * sizeof(float) +
+                                  PressConfig::MAX_BANDS * bandSize;
+        if (sizeInBytes < offset + multibandSize) return;
+        
+        int sidechain;
+        std::memcpy(&sidechain, byteData + offset, sizeof(int));
+        m_sidechainEnabled = (sidechain != 0);
+        offset += sizeof(int);
+        
+        int bandCount;
+        std::memcpy(&bandCount, byteData + offset, sizeof(int));
+        setBandCount(bandCount);
+        offset += sizeof(int);
+        
+        for (int index = 0; index < PressConfig::MAX_BANDS - 1; ++index) {
+            float hz;
+            std::memcpy(&hz, byteData + offset, sizeof(float));
+            setCrossover(index, hz);
+            offset += sizeof(float);
+        }
         
-        if (m_prepared) {
-            updateEnvelopeCoeffs();
+        for (int band = 0; band < PressConfig::MAX_BANDS; ++band) {
+            CompressorParams params;
+            std::memcpy(&params.thresholdDb, byteData + offset, sizeof(float));
+            std::memcpy(&params.ratio, byteData + offset + sizeof(float), sizeof(float));
+            std::memcpy(&params.attackMs, byteData + offset + 2 * sizeof(float), sizeof(float));
+            std::memcpy(&params.releaseMs, byteData + offset + 3 * sizeof(float), sizeof(float));
+            std::memcpy(&params.makeupGainDb, byteData + offset + 4 * sizeof(float), sizeof(float));
+            int bandAutoMakeup;
+            std::memcpy(&bandAutoMakeup, byteData + offset + 5 * sizeof(float), sizeof(int));
+            params.autoMakeup = (bandAutoMakeup != 0);
+            setBandParameters(band, params);
+            offset += bandSize;
         }
     }
 }
@@ -0,0 +1,111 @@
+/**
+ * PartitionedConvolver.h - Zero-latency convolution engine for "The Smudge"
+ *
+ * Non-uniformly partitioned overlap-save (NUPOLS) convolution:
+ *
+ *   IR:  [ head |  stage 1 (64)  |    stage 2 (512)    |  stage 3 (4096) ... ]
+ *          0    64              512                   4096
+ *
+ * - The head (first HEAD_LENGTH taps) is convolved directly in the time
+ *   domain, so the dry-to-wet path has zero latency.
+ * - Every FFT stage uses block size B and starts at IR offset B, so the
+ *   B-sample latency of its overlap-save block is exactly hidden by the
+ *   part of the IR in front of it.
+ * - Each stage keeps a frequency-domain delay line (FDL) of past input
+ *   spectra. Only the newest partition is multiplied at a block boundary;
+ *   the remaining partitions are accumulated a slice at a time on every
+ *   64-sample tick in between, so long tails cost a flat amount per block
+ *   instead of one large spike every B samples.
+ *
+ * Stage transforms use the shared daiw::dsp plans. All memory is allocated
+ * in setImpulseResponse(); process() is RT-safe.
+ */
+
+#pragma once
+
+#include "daiw/fft.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace iDAW {
+
+class PartitionedConvolver {
+public:
+    static constexpr int HEAD_LENGTH = 64;        // Direct-form taps (zero latency)
+    static constexpr int MIN_BLOCK_SIZE = 64;     // First FFT stage block size
+    static constexpr int MAX_BLOCK_SIZE = 4096;   // Tail stage block size
+    static constexpr int STAGE_GROWTH = 8;        // Block size ratio between stages
+
+    PartitionedConvolver() = default;
+    ~PartitionedConvolver() = default;
+
+    PartitionedConvolver(const PartitionedConvolver&) = delete;
+    PartitionedConvolver& operator=(const PartitionedConvolver&) = delete;
+
+    /**
+     * Partition and transform an impulse response.
+     * Allocates all state for numChannels independent channels that share
+     * the IR spectra. Not RT-safe - call from the message thread.
+     */
+    void setImpulseResponse(const float* ir, int irLength, int numChannels);
+
+    /** Clear all channel history (keeps the IR). */
+    void reset() noexcept;
+
+    /**
+     * Convolve numSamples of input for one channel.
+     * input and output may point to the same buffer.
+     */
+    void process(int channel, const float* input, float* output, int numSamples) noexcept;
+
+    int getImpulseResponseLength() const noexcept { return m_irLength; }
+    int getNumChannels() const noexcept { return static_cast<int>(m_channels.size()); }
+    int getNumStages() const noexcept { return static_cast<int>(m_stages.size()); }
+    bool isReady() const noexcept { return m_irLength > 0 && !m_channels.empty(); }
+
+private:
+    /** Interleaved complex spectrum size (bins 0..B) for block size B */
+    static int spectrumSize(int blockSize) noexcept { return 2 * blockSize + 2; }
+
+    /** IR partition spectra for one block size (shared by all channels) */
+    struct Stage {
+        int blockSize = 0;
+        int numPartitions = 0;
+        int ticksPerBlock = 0;                 // blockSize / MIN_BLOCK_SIZE
+        const daiw::dsp::FftPlan* fft = nullptr;  // Shared, size 2 * blockSize
+        std::vector<float> partitions;         // numPartitions spectra
+    };
+
+    /** Per-channel running state of one stage */
+    struct StageState {
+        std::vector<float> fdl;                // numPartitions input spectra (ring)
+        std::vector<float> tailAccum;          // Sum of partitions 1..P-1 for next block
+        std::vector<float> fftBuffer;          // Spectrum, then 2 * blockSize inverse output
+        int fdlIndex = 0;                      // Slot holding the newest spectrum
+        int tick = 0;                          // 64-sample ticks since last boundary
+        int nextPartition = 1;                 // Next tail partition to accumulate
+    };
+
+    struct Channel {
+        std::vector<float> history;            // Input, written twice for contiguous reads
+        std::vector<float> outputAccum;        // Future wet output (ring)
+        std::vector<StageState> stages;
+        int position = 0;                      // Write position, masked by m_ringMask
+    };
+
+    void processChunk(Channel& ch, const float* input, float* output, int numSamples) noexcept;
+    void accumulateTail(const Stage& stage, StageState& state, int lastPartition) noexcept;
+    void processBoundary(const Stage& stage, StageState& state, Channel& ch) noexcept;
+
+    static void multiplyAccumulate(float* acc, const float* a, const float* b, int numBins) noexcept;
+
+    std::vector<float> m_head;                 // First HEAD_LENGTH taps
+    std::vector<Stage> m_stages;
+    std::vector<Channel> m_channels;
+
+    int m_irLength = 0;
+    int m_ringSize = 0;                        // Power of two >= 2 * largest block
+    int m_ringMask = 0;
+};
+
+} // namespace iDAW
@@ -4,7 +4,7 @@
  * Profile: 'Convolution Reverb' with Scrapbook UI
  * 
  * A zero-latency convolution engine with:
- * - FFT partitioning for efficient convolution
+ * - Non-uniform FFT partitioning for full-length IRs at a flat CPU cost
  * - IR library with .wav loading
  * - Time stretching for decay control
  * - Ghost Hands AI for space selection
@@ -13,9 +13,11 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "PartitionedConvolver.h"
+#include <array>
 #include <atomic>
+#include <memory>
 #include <vector>
-#include <complex>
 #include <map>
 
 namespace iDAW {
@@ -24,8 +26,7 @@ namespace iDAW {
  * Configuration for The Smudge
  */
 struct SmudgeConfig {
-    static constexpr int FFT_ORDER = 10;           // 2^10 = 1024 samples
-    static constexpr int FFT_SIZE = 1 << FFT_ORDER;
+    static constexpr int MAX_CHANNELS = 2;         // True stereo (shared IR)
     static constexpr int MAX_IR_LENGTH = 48000 * 10; // 10 seconds at 48kHz
     static constexpr float MAX_PREDELAY_MS = 200.0f;
     static constexpr float MAX_DECAY = 3.0f;       // Time stretch factor
@@ -55,13 +56,13 @@ struct ScrapbookVisualState {
 /**
  * SmudgeProcessor - Zero-Latency Convolution Reverb
  * 
- * Algorithm (Uniformly Partitioned Convolution):
- * 1. Partition IR into FFT-sized blocks
- * 2. For each audio block:
- *    a. FFT the input
- *    b. Multiply with all IR partitions (frequency domain)
- *    c. Accumulate in overlap-add buffer
- *    d. IFFT and output
+ * Algorithm (Non-Uniformly Partitioned Convolution, see PartitionedConvolver):
+ * 1. Convolve the first 64 IR taps directly (zero latency)
+ * 2. Cover the rest with overlap-save stages of 64 / 512 / 4096 samples,
+ *    each starting at an IR offset equal to its own block size
+ * 3. Each stage multiplies its frequency-domain delay line against the
+ *    IR partitions, spread evenly across audio blocks
+ * 4. Sum the stages into the wet signal and mix with dry
  */
 class SmudgeProcessor : public juce::AudioProcessor {
 public:
@@ -116,29 +117,25 @@ public:
     void setPhotoCorner(float x, float y);
     
 private:
-    void processConvolution(float* input, float* output, int numSamples);
+    void processConvolution(int channel, const float* input, float* output, int numSamples);
     void prepareIR();
     void applyTimeStretch(float stretchFactor);
     void updateHighCutFilter();
     
-    // FFT
-    std::unique_ptr<juce::dsp::FFT> m_fft;
-    
     // IR data
     ImpulseResponse m_currentIR;
-    std::vector<std::vector<std::complex<float>>> m_irPartitions;
     juce::String m_currentIRName;
     
-    // Convolution buffers
-    std::vector<float> m_inputBuffer;
-    std::vector<float> m_outputBuffer;
-    std::vector<std::complex<float>> m_fftBuffer;
-    std::vector<std::vector<std::complex<float>>> m_fdlBuffer; // Frequency-domain delay line
-    int m_fdlIndex = 0;
+    // Convolution engine - rebuilt off the audio thread and swapped in
+    std::unique_ptr<PartitionedConvolver> m_convolver;
+    juce::SpinLock m_convolverLock;
+    
+    // Wet scratch (sized in prepareToPlay)
+    juce::AudioBuffer<float> m_wetBuffer;
     
-    // Pre-delay
-    std::vector<float> m_preDelayBuffer;
-    int m_preDelayWriteIndex = 0;
+    // Pre-delay (per channel)
+    std::array<std::vector<float>, SmudgeConfig::MAX_CHANNELS> m_preDelayBuffers;
+    std::array<int, SmudgeConfig::MAX_CHANNELS> m_preDelayWriteIndex{};
     int m_preDelaySamples = 0;
     
     // High-cut filter
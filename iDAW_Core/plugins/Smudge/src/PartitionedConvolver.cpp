@@ -0,0 +1,237 @@
+/**
+ * PartitionedConvolver.cpp - Zero-latency NUPOLS convolution for "The Smudge"
+ */
+
+#include "PartitionedConvolver.h"
+
+#include <algorithm>
+
+namespace iDAW {
+
+static_assert(PartitionedConvolver::HEAD_LENGTH == PartitionedConvolver::MIN_BLOCK_SIZE,
+              "Stage 1 must start exactly where the direct-form head ends");
+static_assert(PartitionedConvolver::MAX_BLOCK_SIZE ==
+              PartitionedConvolver::MIN_BLOCK_SIZE * PartitionedConvolver::STAGE_GROWTH
+                                                   * PartitionedConvolver::STAGE_GROWTH,
+              "Each stage must start at an IR offset equal to its block size");
+
+static_assert(daiw::dsp::is_valid_fft_size(2 * PartitionedConvolver::MIN_BLOCK_SIZE) &&
+              daiw::dsp::is_valid_fft_size(2 * PartitionedConvolver::MAX_BLOCK_SIZE),
+              "Every stage's transform size must have a shared plan");
+
+namespace {
+
+std::complex<float>* asSpectrum(float* interleaved) noexcept {
+    return reinterpret_cast<std::complex<float>*>(interleaved);
+}
+
+} // namespace
+
+void PartitionedConvolver::setImpulseResponse(const float* ir, int irLength, int numChannels) {
+    m_stages.clear();
+    m_channels.clear();
+    m_head.clear();
+    m_irLength = std::max(0, irLength);
+
+    if (ir == nullptr || m_irLength == 0 || numChannels <= 0) {
+        m_irLength = 0;
+        return;
+    }
+
+    // Direct-form head
+    m_head.assign(ir, ir + std::min(m_irLength, HEAD_LENGTH));
+
+    // FFT stages: block B covers IR [B, B * STAGE_GROWTH), the last stage covers the rest
+    int largestBlock = MIN_BLOCK_SIZE;
+    for (int blockSize = MIN_BLOCK_SIZE, start = HEAD_LENGTH; start < m_irLength;
+         blockSize *= STAGE_GROWTH) {
+        const bool lastStage = blockSize >= MAX_BLOCK_SIZE;
+        const int end = lastStage ? m_irLength : std::min(m_irLength, blockSize * STAGE_GROWTH);
+
+        Stage stage;
+        stage.blockSize = blockSize;
+        stage.numPartitions = (end - start + blockSize - 1) / blockSize;
+        stage.ticksPerBlock = blockSize / MIN_BLOCK_SIZE;
+        stage.fft = daiw::dsp::fft_plan(static_cast<size_t>(2 * blockSize));
+
+        const int specSize = spectrumSize(blockSize);
+        stage.partitions.assign(static_cast<size_t>(stage.numPartitions * specSize), 0.0f);
+
+        std::vector<float> buffer(static_cast<size_t>(2 * blockSize));
+        for (int p = 0; p < stage.numPartitions; ++p) {
+            std::fill(buffer.begin(), buffer.end(), 0.0f);
+            const int partStart = start + p * blockSize;
+            const int partLength = std::min(blockSize, end - partStart);
+            std::copy(ir + partStart, ir + partStart + partLength, buffer.begin());
+
+            stage.fft->forward_real(buffer.data(), asSpectrum(stage.partitions.data() + p * specSize));
+        }
+
+        largestBlock = blockSize;
+        m_stages.push_back(std::move(stage));
+        start = end;
+    }
+
+    m_ringSize = 2 * largestBlock;
+    m_ringMask = m_ringSize - 1;
+
+    m_channels.resize(static_cast<size_t>(numChannels));
+    for (auto& ch : m_channels) {
+        ch.history.assign(static_cast<size_t>(2 * m_ringSize), 0.0f);
+        ch.outputAccum.assign(static_cast<size_t>(m_ringSize), 0.0f);
+        ch.stages.resize(m_stages.size());
+
+        for (size_t s = 0; s < m_stages.size(); ++s) {
+            const Stage& stage = m_stages[s];
+            StageState& state = ch.stages[s];
+            const int specSize = spectrumSize(stage.blockSize);
+            state.fdl.assign(static_cast<size_t>(stage.numPartitions * specSize), 0.0f);
+            state.tailAccum.assign(static_cast<size_t>(specSize), 0.0f);
+            state.fftBuffer.assign(static_cast<size_t>(specSize + 2 * stage.blockSize), 0.0f);
+        }
+    }
+
+    reset();
+}
+
+void PartitionedConvolver::reset() noexcept {
+    for (auto& ch : m_channels) {
+        std::fill(ch.history.begin(), ch.history.end(), 0.0f);
+        std::fill(ch.outputAccum.begin(), ch.outputAccum.end(), 0.0f);
+        ch.position = 0;
+
+        for (auto& state : ch.stages) {
+            std::fill(state.fdl.begin(), state.fdl.end(), 0.0f);
+            std::fill(state.tailAccum.begin(), state.tailAccum.end(), 0.0f);
+            state.fdlIndex = 0;
+            state.tick = 0;
+            state.nextPartition = 1;
+        }
+    }
+}
+
+void PartitionedConvolver::process(int channel, const float* input, float* output,
+                                   int numSamples) noexcept {
+    if (channel < 0 || channel >= static_cast<int>(m_channels.size())) {
+        std::fill(output, output + numSamples, 0.0f);
+        return;
+    }
+
+    Channel& ch = m_channels[static_cast<size_t>(channel)];
+    int done = 0;
+
+    while (done < numSamples) {
+        // Never cross a 64-sample tick inside a chunk
+        const int untilTick = MIN_BLOCK_SIZE - (ch.position & (MIN_BLOCK_SIZE - 1));
+        const int chunk = std::min(untilTick, numSamples - done);
+
+        processChunk(ch, input + done, output + done, chunk);
+        done += chunk;
+
+        if ((ch.position & (MIN_BLOCK_SIZE - 1)) != 0) continue;
+
+        for (size_t s = 0; s < m_stages.size(); ++s) {
+            const Stage& stage = m_stages[s];
+            StageState& state = ch.stages[s];
+
+            // Spread the tail partitions evenly over the ticks of one block
+            ++state.tick;
+            accumulateTail(stage, state, (stage.numPartitions - 1) * state.tick / stage.ticksPerBlock);
+
+            if (state.tick == stage.ticksPerBlock) {
+                processBoundary(stage, state, ch);
+                state.tick = 0;
+            }
+        }
+    }
+}
+
+void PartitionedConvolver::processChunk(Channel& ch, const float* input, float* output,
+                                        int numSamples) noexcept {
+    const int pos = ch.position;
+    float* history = ch.history.data();
+
+    for (int i = 0; i < numSamples; ++i) {
+        const int idx = (pos + i) & m_ringMask;
+        history[idx] = input[i];
+        history[idx + m_ringSize] = input[i];
+    }
+
+    // Wet output already scheduled by the FFT stages (a chunk never wraps the ring)
+    float* scheduled = ch.outputAccum.data() + pos;
+    for (int i = 0; i < numSamples; ++i) {
+        output[i] = scheduled[i];
+        scheduled[i] = 0.0f;
+    }
+
+    // Direct-form head, one axpy per tap
+    const int headLength = static_cast<int>(m_head.size());
+    for (int j = 0; j < headLength; ++j) {
+        const float tap = m_head[static_cast<size_t>(j)];
+        const float* x = history + ((pos - j) & m_ringMask);
+        for (int i = 0; i < numSamples; ++i) {
+            output[i] += tap * x[i];
+        }
+    }
+
+    ch.position = (pos + numSamples) & m_ringMask;
+}
+
+void PartitionedConvolver::accumulateTail(const Stage& stage, StageState& state,
+                                          int lastPartition) noexcept {
+    const int specSize = spectrumSize(stage.blockSize);
+    const int numBins = stage.blockSize + 1;
+
+    for (; state.nextPartition <= lastPartition; ++state.nextPartition) {
+        // Partition p pairs with the input spectrum p - 1 blocks older than the newest
+        const int p = state.nextPartition;
+        const int slot = (state.fdlIndex - (p - 1) + stage.numPartitions) % stage.numPartitions;
+        multiplyAccumulate(state.tailAccum.data(),
+                           state.fdl.data() + slot * specSize,
+                           stage.partitions.data() + p * specSize,
+                           numBins);
+    }
+}
+
+void PartitionedConvolver::processBoundary(const Stage& stage, StageState& state,
+                                           Channel& ch) noexcept {
+    const int blockSize = stage.blockSize;
+    const int specSize = spectrumSize(blockSize);
+    float* buffer = state.fftBuffer.data();
+
+    // Overlap-save input: the last 2B samples, transformed straight into the FDL
+    const float* x = ch.history.data() + ((ch.position - 2 * blockSize) & m_ringMask);
+    state.fdlIndex = (state.fdlIndex + 1) % stage.numPartitions;
+    float* newest = state.fdl.data() + state.fdlIndex * specSize;
+    stage.fft->forward_real(x, asSpectrum(newest));
+
+    // Y = X * H0 + (pre-accumulated older partitions)
+    std::copy(state.tailAccum.begin(), state.tailAccum.end(), buffer);
+    multiplyAccumulate(buffer, newest, stage.partitions.data(), blockSize + 1);
+    std::fill(state.tailAccum.begin(), state.tailAccum.end(), 0.0f);
+    state.nextPartition = 1;
+
+    float* result = buffer + specSize;
+    stage.fft->inverse_real(asSpectrum(buffer), result);
+
+    // The second half is valid; the stage starts at IR offset B, so it lands
+    // exactly on the next B output samples.
+    float* out = ch.outputAccum.data();
+    for (int i = 0; i < blockSize; ++i) {
+        out[(ch.position + i) & m_ringMask] += result[blockSize + i];
+    }
+}
+
+void PartitionedConvolver::multiplyAccumulate(float* acc, const float* a, const float* b,
+                                              int numBins) noexcept {
+    for (int k = 0; k < numBins; ++k) {
+        const float ar = a[2 * k];
+        const float ai = a[2 * k + 1];
+        const float br = b[2 * k];
+        const float bi = b[2 * k + 1];
+        acc[2 * k] += ar * br - ai * bi;
+        acc[2 * k + 1] += ar * bi + ai * br;
+    }
+}
+
+} // namespace iDAW
@@ -13,8 +13,6 @@ SmudgeProcessor::SmudgeProcessor()
                      .withInput("Input", juce::AudioChannelSet::stereo(), true)
                      .withOutput("Output", juce::AudioChannelSet::stereo(), true))
 {
-    m_fft = std::make_unique<juce::dsp::FFT>(SmudgeConfig::FFT_ORDER);
-    
     // Initialize IR library mapping
     m_irLibrary["Cave"] = "IR_Cave.wav";
     m_irLibrary["Room"] = "IR_Studio.wav";
@@ -28,15 +26,21 @@ SmudgeProcessor::~SmudgeProcessor() = default;
 void SmudgeProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
     m_sampleRate = sampleRate;
     
-    // Initialize buffers
-    m_inputBuffer.resize(SmudgeConfig::FFT_SIZE * 2, 0.0f);
-    m_outputBuffer.resize(SmudgeConfig::FFT_SIZE * 2, 0.0f);
-    m_fftBuffer.resize(SmudgeConfig::FFT_SIZE + 1);
+    // Wet scratch buffer
+    m_wetBuffer.setSize(SmudgeConfig::MAX_CHANNELS, std::max(1, samplesPerBlock));
     
-    // Pre-delay buffer
+    // Pre-delay buffers
     int maxPreDelaySamples = static_cast<int>(SmudgeConfig::MAX_PREDELAY_MS * sampleRate / 1000.0);
-    m_preDelayBuffer.resize(maxPreDelaySamples, 0.0f);
-    m_preDelayWriteIndex = 0;
+    for (int ch = 0; ch < SmudgeConfig::MAX_CHANNELS; ++ch) {
+        m_preDelayBuffers[ch].assign(std::max(1, maxPreDelaySamples), 0.0f);
+        m_preDelayWriteIndex[ch] = 0;
+    }
+    
+    // Clear convolution history
+    {
+        const juce::SpinLock::ScopedLockType lock(m_convolverLock);
+        if (m_convolver) m_convolver->reset();
+    }
     
     // High-cut filter
     updateHighCutFilter();
@@ -45,105 +49,83 @@ void SmudgeProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
 }
 
 void SmudgeProcessor::releaseResources() {
-    m_inputBuffer.clear();
-    m_outputBuffer.clear();
+    m_wetBuffer.setSize(0, 0);
     m_prepared = false;
 }
 
 void SmudgeProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) {
-    if (!m_prepared || m_irPartitions.empty()) {
-        // Pass through if no IR loaded
+    if (!m_prepared) return;
+    
+    // Pass through if no IR is loaded (or a new one is being swapped in)
+    const juce::SpinLock::ScopedTryLockType lock(m_convolverLock);
+    if (!lock.isLocked() || m_convolver == nullptr || !m_convolver->isReady()) {
         return;
     }
     
     juce::ScopedNoDenormals noDenormals;
     
     const int numSamples = buffer.getNumSamples();
-    float mix = m_mix.load();
-    
-    // Process left channel (mono convolution for simplicity)
-    const float* inputL = buffer.getReadPointer(0);
-    float* outputL = buffer.getWritePointer(0);
+    const int numChannels = std::min(buffer.getNumChannels(), SmudgeConfig::MAX_CHANNELS);
+    const int scratchSize = m_wetBuffer.getNumSamples();
+    const float mix = m_mix.load();
     
-    // Temporary buffers
-    std::vector<float> wetSignal(numSamples, 0.0f);
+    int preDelaySamples = static_cast<int>(m_preDelayMs.load() * m_sampleRate / 1000.0);
+    m_preDelaySamples = std::clamp(preDelaySamples, 0, static_cast<int>(m_preDelayBuffers[0].size()) - 1);
     
-    // Process convolution
-    processConvolution(const_cast<float*>(inputL), wetSignal.data(), numSamples);
-    
-    // Mix dry/wet
-    for (int i = 0; i < numSamples; ++i) {
-        outputL[i] = inputL[i] * (1.0f - mix) + wetSignal[i] * mix;
-    }
-    
-    // Copy to right channel
-    if (buffer.getNumChannels() > 1) {
-        float* outputR = buffer.getWritePointer(1);
-        std::memcpy(outputR, outputL, numSamples * sizeof(float));
+    // Hosts may exceed the prepared block size - work through it in scratch-sized chunks
+    for (int start = 0; start < numSamples; start += scratchSize) {
+        const int count = std::min(scratchSize, numSamples - start);
+        
+        for (int ch = 0; ch < numChannels; ++ch) {
+            float* io = buffer.getWritePointer(ch, start);
+            float* wet = m_wetBuffer.getWritePointer(ch);
+            
+            processConvolution(ch, io, wet, count);
+            
+            // Mix dry/wet
+            for (int i = 0; i < count; ++i) {
+                io[i] = io[i] * (1.0f - mix) + wet[i] * mix;
+            }
+        }
     }
 }
 
-void SmudgeProcessor::processConvolution(float* input, float* output, int numSamples) {
-    // Simplified uniformly-partitioned convolution
+void SmudgeProcessor::processConvolution(int channel, const float* input, float* output, int numSamples) {
+    // Apply pre-delay into the wet buffer
+    auto& delayLine = m_preDelayBuffers[channel];
+    const int delaySize = static_cast<int>(delayLine.size());
+    int writeIndex = m_preDelayWriteIndex[channel];
+    
     for (int i = 0; i < numSamples; ++i) {
-        // Apply pre-delay
-        int preDelaySamples = static_cast<int>(m_preDelayMs.load() * m_sampleRate / 1000.0);
-        preDelaySamples = std::min(preDelaySamples, static_cast<int>(m_preDelayBuffer.size()) - 1);
+        delayLine[writeIndex] = input[i];
         
-        int readIndex = (m_preDelayWriteIndex - preDelaySamples + m_preDelayBuffer.size()) % m_preDelayBuffer.size();
-        float delayedSample = m_preDelayBuffer[readIndex];
-        m_preDelayBuffer[m_preDelayWriteIndex] = input[i];
-        m_preDelayWriteIndex = (m_preDelayWriteIndex + 1) % m_preDelayBuffer.size();
+        int readIndex = writeIndex - m_preDelaySamples;
+        if (readIndex < 0) readIndex += delaySize;
+        output[i] = delayLine[readIndex];
         
-        // Simple convolution (first partition only for demo)
-        if (!m_currentIR.samples.empty()) {
-            // Direct convolution for short IRs
-            float sum = 0.0f;
-            int irLen = std::min(static_cast<int>(m_currentIR.samples.size()), 512);
-            
-            for (int j = 0; j < irLen && (i - j) >= 0; ++j) {
-                sum += input[i - j] * m_currentIR.samples[j];
-            }
-            output[i] = sum;
-        } else {
-            output[i] = delayedSample;
-        }
+        if (++writeIndex == delaySize) writeIndex = 0;
     }
+    m_preDelayWriteIndex[channel] = writeIndex;
+    
+    // Convolve in place with the full IR
+    m_convolver->process(channel, output, output, numSamples);
 }
 
 void SmudgeProcessor::prepareIR() {
     if (m_currentIR.samples.empty()) return;
     
-    // Partition IR for FFT convolution
-    int numPartitions = (static_cast<int>(m_currentIR.samples.size()) + SmudgeConfig::FFT_SIZE - 1) / SmudgeConfig::FFT_SIZE;
-    m_irPartitions.resize(numPartitions);
+    // Partition + FFT the IR on this (non-audio) thread
+    auto convolver = std::make_unique<PartitionedConvolver>();
+    convolver->setImpulseResponse(m_currentIR.samples.data(),
+                                  static_cast<int>(m_currentIR.samples.size()),
+                                  SmudgeConfig::MAX_CHANNELS);
     
-    for (int p = 0; p < numPartitions; ++p) {
-        m_irPartitions[p].resize(SmudgeConfig::FFT_SIZE + 1);
-        
-        std::vector<float> partitionData(SmudgeConfig::FFT_SIZE * 2, 0.0f);
-        int startIdx = p * SmudgeConfig::FFT_SIZE;
-        int copyLen = std::min(SmudgeConfig::FFT_SIZE, static_cast<int>(m_currentIR.samples.size()) - startIdx);
-        
-        for (int i = 0; i < copyLen; ++i) {
-            partitionData[i] = m_currentIR.samples[startIdx + i];
-        }
-        
-        // FFT the partition
-        m_fft->performRealOnlyForwardTransform(partitionData.data());
-        
-        // Store as complex
-        for (int i = 0; i <= SmudgeConfig::FFT_SIZE / 2; ++i) {
-            m_irPartitions[p][i] = std::complex<float>(partitionData[i * 2], partitionData[i * 2 + 1]);
-        }
+    {
+        const juce::SpinLock::ScopedLockType lock(m_convolverLock);
+        m_convolver.swap(convolver);
     }
     
-    // Initialize FDL buffer
-    m_fdlBuffer.resize(numPartitions);
-    for (auto& fdl : m_fdlBuffer) {
-        fdl.resize(SmudgeConfig::FFT_SIZE + 1, std::complex<float>(0, 0));
-    }
-    m_fdlIndex = 0;
+    // The previous engine is destroyed here, outside the lock
 }
 
 bool SmudgeProcessor::loadIR(const juce::File& file) {
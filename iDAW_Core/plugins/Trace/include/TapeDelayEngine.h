@@ -0,0 +1,91 @@
+/**
+ * TapeDelayEngine.h - Block delay core of "The Trace"
+ *
+ * Per block:
+ *
+ *   1. LFO -> modulated delay trajectory (one value per sample, computed
+ *      with a rotating phasor instead of a sin() per sample)
+ *   2. One interpolation kernel for the whole block (linear, 4-point cubic
+ *      or first-order allpass), selected outside the sample loop
+ *   3. Read, tape-saturate and write back each channel over power-of-two
+ *      circular buffers (index & mask, no modulo or wrap loops)
+ *
+ * Ping-pong feeds each channel the other channel's (single) delayed read.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace iDAW {
+
+/**
+ * Fractional delay read kernel
+ */
+enum class DelayInterpolation {
+    Linear,     // 2 taps; cheapest, slight high-frequency loss
+    Cubic,      // 4-point Hermite; best for modulated delays
+    Allpass     // First-order Thiran; flat magnitude for static delays
+};
+
+/**
+ * Per-block delay settings
+ */
+struct TapeDelayParameters {
+    float delaySamples = 0.0f;      // Base delay
+    float feedback = 0.0f;          // 0..1
+    float mix = 0.5f;               // Dry/wet mix (0 = dry, 1 = wet)
+    float modDepthSamples = 0.0f;   // LFO depth
+    float modRateHz = 0.5f;         // LFO rate
+    bool pingPong = false;          // Cross-feed feedback between channels
+    bool tapeSaturation = true;     // Saturate the delayed signal
+    DelayInterpolation interpolation = DelayInterpolation::Linear;
+};
+
+class TapeDelayEngine {
+public:
+    static constexpr int MAX_CHANNELS = 2;
+
+    TapeDelayEngine() = default;
+
+    /**
+     * Allocate for delays up to maxDelaySamples and blocks of up to
+     * maxBlockSize samples. Not RT-safe.
+     */
+    void prepare(double sampleRate, int maxBlockSize, float maxDelaySamples);
+
+    /** Clear the delay lines, LFO phase and interpolator state */
+    void reset() noexcept;
+
+    /** Process up to MAX_CHANNELS channels in place */
+    void process(float* const* channels, int numChannels, int numSamples,
+                 const TapeDelayParameters& params) noexcept;
+
+    /** Circular buffer length (a power of two) */
+    int getBufferSize() const noexcept { return static_cast<int>(m_mask + 1); }
+
+private:
+    /** Fill m_trajectory with the clamped, modulated delay for each sample */
+    void computeTrajectory(int numSamples, const TapeDelayParameters& params) noexcept;
+
+    template<DelayInterpolation Interpolation>
+    void processChunk(float* const* channels, int numChannels, int offset, int numSamples,
+                      const TapeDelayParameters& params) noexcept;
+
+    double m_sampleRate = 44100.0;
+    int m_maxBlockSize = 0;
+    float m_maxDelaySamples = 0.0f;
+
+    std::array<std::vector<float>, MAX_CHANNELS> m_buffers;
+    uint32_t m_mask = 0;
+    uint32_t m_writePos = 0;
+
+    std::vector<float> m_trajectory;
+    double m_lfoPhase = 0.0;  // Cycles, [0, 1)
+
+    std::array<float, MAX_CHANNELS> m_allpassState = {0.0f, 0.0f};
+};
+
+} // namespace iDAW
@@ -4,7 +4,8 @@
  * Profile: 'Tape/Digital Delay' with Spirograph UI
  * 
  * Features:
- * - Circular buffer delay line
+ * - Block-based circular buffer delay line (TapeDelayEngine)
+ * - Linear / cubic / allpass fractional delay interpolation
  * - Ping-pong stereo mode
  * - Tape saturation on feedback
  * - LFO modulation for wow/flutter
@@ -14,6 +15,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "TapeDelayEngine.h"
 #include <atomic>
 #include <array>
 #include <cmath>
@@ -63,11 +65,11 @@ struct SpirographVisualState {
 /**
  * TraceProcessor - Tape/Digital Delay
  * 
- * Algorithm:
- * 1. Write input to circular buffer
- * 2. Read from buffer with modulated delay time
+ * Algorithm (per block, see TapeDelayEngine):
+ * 1. Compute the LFO-modulated delay for every sample of the block
+ * 2. Read from buffer with the block's interpolation kernel
  * 3. Apply tape saturation to delayed signal
- * 4. Mix feedback into buffer
+ * 4. Write input + feedback to circular buffer
  * 5. Output dry + wet blend
  */
 class TraceProcessor : public juce::AudioProcessor {
@@ -121,6 +123,10 @@ public:
     void setTapeSaturation(bool enabled);
     bool getTapeSaturation() const { return m_tapeSaturation.load(); }
     
+    /** Fractional delay interpolation (applied on the next block) */
+    void setInterpolation(DelayInterpolation mode);
+    DelayInterpolation getInterpolation() const { return m_interpolation.load(); }
+    
     // Ghost Hands
     void applyAISuggestion(const juce::String& suggestion);
     
@@ -131,20 +137,10 @@ public:
     void updateFromPlayHead(juce::AudioPlayHead* playHead);
     
 private:
-    float readFromBuffer(int channel, float delaySamples);
-    void writeToBuffer(int channel, float sample);
-    float applyTapeSaturation(float sample);
     float calculateSyncedDelay(double bpm);
-    void updateLFO();
-    
-    // Circular delay buffer (stereo)
-    std::array<std::vector<float>, 2> m_delayBuffer;
-    std::array<int, 2> m_writeIndex;
-    int m_bufferSize = 0;
     
-    // LFO for modulation
-    float m_lfoPhase = 0.0f;
-    float m_currentModulation = 0.0f;
+    // Delay lines, LFO and interpolation
+    TapeDelayEngine m_engine;
     
     // Parameters
     std::atomic<float> m_delayTimeMs{300.0f};
@@ -154,6 +150,7 @@ private:
     std::atomic<float> m_modRateHz{0.5f};
     std::atomic<bool> m_pingPong{false};
     std::atomic<bool> m_tapeSaturation{true};
+    std::atomic<DelayInterpolation> m_interpolation{DelayInterpolation::Linear};
     SyncNote m_syncNote = SyncNote::FREE;
     
     // Host tempo
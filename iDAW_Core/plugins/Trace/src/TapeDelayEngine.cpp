@@ -0,0 +1,219 @@
+/**
+ * TapeDelayEngine.cpp - Block delay core of "The Trace"
+ */
+
+#include "TapeDelayEngine.h"
+#include <algorithm>
+#include <cmath>
+
+namespace iDAW {
+
+namespace {
+
+constexpr double TWO_PI = 6.283185307179586;
+constexpr float TAPE_DRIVE = 2.0f;
+constexpr float TAPE_NORMALIZATION = 1.0373147f;  // 1 / tanh(TAPE_DRIVE)
+
+// Cubic and allpass reads need one tap newer than the integer delay
+constexpr float MIN_DELAY_SAMPLES = 2.0f;
+
+// Taps past the integer delay (cubic reads D-1 .. D+2)
+constexpr uint32_t GUARD_SAMPLES = 3;
+
+uint32_t nextPowerOfTwo(uint32_t n) {
+    uint32_t size = 1;
+    while (size < n) size <<= 1;
+    return size;
+}
+
+inline float tapeSaturate(float sample) noexcept {
+    // Soft saturation using tanh, normalized so +-1 maps to +-1
+    return std::tanh(sample * TAPE_DRIVE) * TAPE_NORMALIZATION;
+}
+
+/**
+ * Read kernels. `index` is the buffer position of the tap at the integer
+ * delay D (older taps sit at lower positions); frac moves from D toward D + 1.
+ */
+template<DelayInterpolation Interpolation>
+struct DelayRead;
+
+template<>
+struct DelayRead<DelayInterpolation::Linear> {
+    static float read(const float* buffer, uint32_t mask, uint32_t index, float frac, float&) noexcept {
+        const float a = buffer[index & mask];
+        const float b = buffer[(index - 1) & mask];
+        return a + (b - a) * frac;
+    }
+};
+
+template<>
+struct DelayRead<DelayInterpolation::Cubic> {
+    static float read(const float* buffer, uint32_t mask, uint32_t index, float frac, float&) noexcept {
+        // 4-point, 3rd-order Hermite over delays D-1 .. D+2
+        const float xm1 = buffer[(index + 1) & mask];
+        const float x0 = buffer[index & mask];
+        const float x1 = buffer[(index - 1) & mask];
+        const float x2 = buffer[(index - 2) & mask];
+
+        const float c1 = 0.5f * (x1 - xm1);
+        const float c2 = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+        const float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+        return ((c3 * frac + c2) * frac + c1) * frac + x0;
+    }
+};
+
+template<>
+struct DelayRead<DelayInterpolation::Allpass> {
+    static float read(const float* buffer, uint32_t mask, uint32_t index, float frac, float& state) noexcept {
+        // First-order Thiran, fractional part kept in [0.5, 1.5) so the
+        // pole stays well inside the unit circle
+        const bool shift = frac < 0.5f;
+        const uint32_t tap = shift ? index + 1 : index;
+        const float delta = shift ? frac + 1.0f : frac;
+        const float a = (1.0f - delta) / (1.0f + delta);
+
+        const float y = a * buffer[tap & mask] + buffer[(tap - 1) & mask] - a * state;
+        state = y;
+        return y;
+    }
+};
+
+} // namespace
+
+void TapeDelayEngine::prepare(double sampleRate, int maxBlockSize, float maxDelaySamples) {
+    m_sampleRate = sampleRate;
+    m_maxBlockSize = std::max(1, maxBlockSize);
+    m_maxDelaySamples = std::max(maxDelaySamples, MIN_DELAY_SAMPLES);
+
+    const uint32_t size = nextPowerOfTwo(static_cast<uint32_t>(std::ceil(m_maxDelaySamples)) + GUARD_SAMPLES);
+    m_mask = size - 1;
+    for (auto& buffer : m_buffers) {
+        buffer.assign(size, 0.0f);
+    }
+    m_trajectory.assign(static_cast<size_t>(m_maxBlockSize), 0.0f);
+
+    reset();
+}
+
+void TapeDelayEngine::reset() noexcept {
+    for (auto& buffer : m_buffers) {
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+    }
+    m_writePos = 0;
+    m_lfoPhase = 0.0;
+    m_allpassState = {0.0f, 0.0f};
+}
+
+void TapeDelayEngine::process(float* const* channels, int numChannels, int numSamples,
+                              const TapeDelayParameters& params) noexcept {
+    numChannels = std::min(numChannels, MAX_CHANNELS);
+    if (numChannels <= 0 || m_maxBlockSize == 0) return;
+
+    // m_trajectory holds one chunk of m_maxBlockSize samples
+    for (int offset = 0; offset < numSamples; offset += m_maxBlockSize) {
+        const int chunk = std::min(m_maxBlockSize, numSamples - offset);
+        computeTrajectory(chunk, params);
+
+        switch (params.interpolation) {
+            case DelayInterpolation::Cubic:
+                processChunk<DelayInterpolation::Cubic>(channels, numChannels, offset, chunk, params);
+                break;
+            case DelayInterpolation::Allpass:
+                processChunk<DelayInterpolation::Allpass>(channels, numChannels, offset, chunk, params);
+                break;
+            default:
+                processChunk<DelayInterpolation::Linear>(channels, numChannels, offset, chunk, params);
+                break;
+        }
+    }
+}
+
+void TapeDelayEngine::computeTrajectory(int numSamples, const TapeDelayParameters& params) noexcept {
+    const float maxDelay = m_maxDelaySamples;
+    float* trajectory = m_trajectory.data();
+
+    const double increment = params.modRateHz / m_sampleRate;
+
+    if (params.modDepthSamples <= 0.0f) {
+        const float delay = std::clamp(params.delaySamples, MIN_DELAY_SAMPLES, maxDelay);
+        std::fill(trajectory, trajectory + numSamples, delay);
+    } else {
+        // Rotating phasor: exact at the block start, one complex multiply
+        // per sample after that (the LFO advances before each sample)
+        const double start = TWO_PI * (m_lfoPhase + increment);
+        const double step = TWO_PI * increment;
+        double sine = std::sin(start);
+        double cosine = std::cos(start);
+        const double stepSin = std::sin(step);
+        const double stepCos = std::cos(step);
+
+        for (int i = 0; i < numSamples; ++i) {
+            const float delay = params.delaySamples + params.modDepthSamples * static_cast<float>(sine);
+            trajectory[i] = std::clamp(delay, MIN_DELAY_SAMPLES, maxDelay);
+
+            const double nextSine = sine * stepCos + cosine * stepSin;
+            cosine = cosine * stepCos - sine * stepSin;
+            sine = nextSine;
+        }
+    }
+
+    m_lfoPhase += increment * numSamples;
+    m_lfoPhase -= std::floor(m_lfoPhase);
+}
+
+template<DelayInterpolation Interpolation>
+void TapeDelayEngine::processChunk(float* const* channels, int numChannels, int offset, int numSamples,
+                                   const TapeDelayParameters& params) noexcept {
+    const uint32_t mask = m_mask;
+    const float* trajectory = m_trajectory.data();
+    const float feedback = params.feedback;
+    const float wet = params.mix;
+    const float dry = 1.0f - params.mix;
+    const bool useTape = params.tapeSaturation;
+    const bool pingPong = params.pingPong && numChannels > 1;
+
+    float* left = channels[0] + offset;
+    float* right = channels[numChannels - 1] + offset;
+    float* leftLine = m_buffers[0].data();
+    float* rightLine = m_buffers[1].data();
+
+    uint32_t writePos = m_writePos;
+    float leftState = m_allpassState[0];
+    float rightState = m_allpassState[1];
+
+    for (int i = 0; i < numSamples; ++i) {
+        const float delay = trajectory[i];
+        const auto whole = static_cast<uint32_t>(delay);
+        const float frac = delay - static_cast<float>(whole);
+        const uint32_t index = writePos - whole;
+
+        float delayedLeft = DelayRead<Interpolation>::read(leftLine, mask, index, frac, leftState);
+        float delayedRight = numChannels > 1
+            ? DelayRead<Interpolation>::read(rightLine, mask, index, frac, rightState) : 0.0f;
+
+        if (useTape) {
+            delayedLeft = tapeSaturate(delayedLeft);
+            delayedRight = tapeSaturate(delayedRight);
+        }
+
+        const float inLeft = left[i];
+        const float inRight = right[i];
+
+        // Ping-pong: feed opposite channel
+        leftLine[writePos] = inLeft + (pingPong ? delayedRight : delayedLeft) * feedback;
+        left[i] = inLeft * dry + delayedLeft * wet;
+
+        if (numChannels > 1) {
+            rightLine[writePos] = inRight + (pingPong ? delayedLeft : delayedRight) * feedback;
+            right[i] = inRight * dry + delayedRight * wet;
+        }
+
+        writePos = (writePos + 1) & mask;
+    }
+
+    m_writePos = writePos;
+    m_allpassState = {leftState, rightState};
+}
+
+} // namespace iDAW
@@ -20,21 +20,14 @@ TraceProcessor::~TraceProcessor() = default;
 void TraceProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
     m_sampleRate = sampleRate;
     
-    // Calculate buffer size for max delay
-    m_bufferSize = static_cast<int>(TraceConfig::MAX_DELAY_MS * sampleRate / 1000.0) + 1;
+    // Size delay lines for max delay plus modulation swing
+    const float maxDelayMs = TraceConfig::MAX_DELAY_MS + TraceConfig::MAX_MODULATION_DEPTH;
+    m_engine.prepare(sampleRate, samplesPerBlock, maxDelayMs * static_cast<float>(sampleRate) / 1000.0f);
     
-    // Initialize delay buffers
-    for (int ch = 0; ch < 2; ++ch) {
-        m_delayBuffer[ch].resize(m_bufferSize, 0.0f);
-        m_writeIndex[ch] = 0;
-    }
-    
-    m_lfoPhase = 0.0f;
     m_prepared = true;
 }
 
 void TraceProcessor::releaseResources() {
-    for (auto& buf : m_delayBuffer) buf.clear();
     m_prepared = false;
 }
 
@@ -51,55 +44,25 @@ void TraceProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBu
     const int numSamples = buffer.getNumSamples();
     float delayMs = m_delayTimeMs.load();
     float feedback = m_feedback.load();
-    float mix = m_mix.load();
-    bool pingPong = m_pingPong.load();
-    bool useTape = m_tapeSaturation.load();
     
     // Sync to host if needed
     if (m_syncNote != SyncNote::FREE) {
         delayMs = static_cast<float>(calculateSyncedDelay(m_hostBPM));
     }
     
-    float delaySamples = delayMs * static_cast<float>(m_sampleRate) / 1000.0f;
+    // Parameters are read once per block
+    const float samplesPerMs = static_cast<float>(m_sampleRate) / 1000.0f;
+    TapeDelayParameters params;
+    params.delaySamples = delayMs * samplesPerMs;
+    params.feedback = feedback;
+    params.mix = m_mix.load();
+    params.modDepthSamples = m_modDepthMs.load() * samplesPerMs;
+    params.modRateHz = m_modRateHz.load();
+    params.pingPong = m_pingPong.load();
+    params.tapeSaturation = m_tapeSaturation.load();
+    params.interpolation = m_interpolation.load();
     
-    for (int sample = 0; sample < numSamples; ++sample) {
-        // Update LFO
-        updateLFO();
-        
-        // Apply modulation to delay time
-        float modulatedDelay = delaySamples + m_currentModulation;
-        modulatedDelay = std::clamp(modulatedDelay, 1.0f, static_cast<float>(m_bufferSize - 1));
-        
-        for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
-            float* channelData = buffer.getWritePointer(channel);
-            float inputSample = channelData[sample];
-            
-            // Read from delay buffer with interpolation
-            float delayedSample = readFromBuffer(channel, modulatedDelay);
-            
-            // Apply tape saturation if enabled
-            if (useTape) {
-                delayedSample = applyTapeSaturation(delayedSample);
-            }
-            
-            // Calculate feedback input
-            float feedbackSample;
-            if (pingPong && buffer.getNumChannels() > 1) {
-                // Ping-pong: feed opposite channel
-                int otherChannel = 1 - channel;
-                feedbackSample = readFromBuffer(otherChannel, modulatedDelay);
-                if (useTape) feedbackSample = applyTapeSaturation(feedbackSample);
-            } else {
-                feedbackSample = delayedSample;
-            }
-            
-            // Write to buffer: input + feedback
-            writeToBuffer(channel, inputSample + feedbackSample * feedback);
-            
-            // Mix output
-            channelData[sample] = inputSample * (1.0f - mix) + delayedSample * mix;
-        }
-    }
+    m_engine.process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), numSamples, params);
     
     // Update visual state
     {
@@ -110,46 +73,6 @@ void TraceProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBu
     }
 }
 
-float TraceProcessor::readFromBuffer(int channel, float delaySamples) {
-    // Linear interpolation for fractional delay
-    int indexA = m_writeIndex[channel] - static_cast<int>(delaySamples);
-    int indexB = indexA - 1;
-    
-    while (indexA < 0) indexA += m_bufferSize;
-    while (indexB < 0) indexB += m_bufferSize;
-    
-    indexA %= m_bufferSize;
-    indexB %= m_bufferSize;
-    
-    float frac = delaySamples - std::floor(delaySamples);
-    
-    return m_delayBuffer[channel][indexA] * (1.0f - frac) + 
-           m_delayBuffer[channel][indexB] * frac;
-}
-
-void TraceProcessor::writeToBuffer(int channel, float sample) {
-    m_delayBuffer[channel][m_writeIndex[channel]] = sample;
-    m_writeIndex[channel] = (m_writeIndex[channel] + 1) % m_bufferSize;
-}
-
-float TraceProcessor::applyTapeSaturation(float sample) {
-    // Soft saturation using tanh
-    float drive = TraceConfig::TAPE_DRIVE;
-    return std::tanh(sample * drive) / std::tanh(drive);
-}
-
-void TraceProcessor::updateLFO() {
-    float rate = m_modRateHz.load();
-    float depth = m_modDepthMs.load();
-    
-    m_lfoPhase += rate / static_cast<float>(m_sampleRate);
-    if (m_lfoPhase >= 1.0f) m_lfoPhase -= 1.0f;
-    
-    // Sine LFO for wow/flutter
-    m_currentModulation = std::sin(m_lfoPhase * 2.0f * juce::MathConstants<float>::pi) * 
-                          depth * static_cast<float>(m_sampleRate) / 1000.0f;
-}
-
 float TraceProcessor::calculateSyncedDelay(double bpm) {
     if (bpm <= 0) bpm = 120.0;
     
@@ -191,6 +114,7 @@ void TraceProcessor::applyAISuggestion(const juce::String& suggestion) {
         setFeedback(0.6f);
         setModulationDepth(20.0f);
         setModulationRate(0.3f);
+        setInterpolation(DelayInterpolation::Cubic);
     }
 }
 
@@ -203,6 +127,7 @@ void TraceProcessor::setModulationRate(float hz) { m_modRateHz.store(std::clamp(
 void TraceProcessor::setPingPong(bool enabled) { m_pingPong.store(enabled); }
 void TraceProcessor::setSync(SyncNote note) { m_syncNote = note; }
 void TraceProcessor::setTapeSaturation(bool enabled) { m_tapeSaturation.store(enabled); }
+void TraceProcessor::setInterpolation(DelayInterpolation mode) { m_interpolation.store(mode); }
 
 SpirographVisualState TraceProcessor::getVisualState() const {
     std::lock_guard<std::mutex> lock(m_visualMutex);
@@ -221,12 +146,16 @@ void TraceProcessor::getStateInformation(juce::MemoryBlock& destData) {
     float mix = m_mix.load();
     float modDepth = m_modDepthMs.load();
     float modRate = m_modRateHz.load();
+    float interpolation = static_cast<float>(m_interpolation.load());
     
     destData.append(&delayTime, sizeof(float));
     destData.append(&feedback, sizeof(float));
     destData.append(&mix, sizeof(float));
     destData.append(&modDepth, sizeof(float));
     destData.append(&modRate, sizeof(float));
+    
+    // Interpolation mode (optional trailing field)
+    destData.append(&interpolation, sizeof(float));
 }
 
 void TraceProcessor::setStateInformation(const void* data, int sizeInBytes) {
@@ -237,6 +166,13 @@ void TraceProcessor::setStateInformation(const void* data, int sizeInBytes) {
         m_mix.store(floatData[2]);
         m_modDepthMs.store(floatData[3]);
         m_modRateHz.store(floatData[4]);
+        
+        if (sizeInBytes >= 6 * sizeof(float)) {
+            const int mode = static_cast<int>(floatData[5]);
+            setInterpolation(mode == static_cast<int>(DelayInterpolation::Cubic) ? DelayInterpolation::Cubic
+                           : mode == static_cast<int>(DelayInterpolation::Allpass) ? DelayInterpolation::Allpass
+                                                                                  : DelayInterpolation::Linear);
+        }
     }
 }
 
@@ -0,0 +1,125 @@
+/**
+ * ThreadPool.cpp - Worker pool for offline batch processing
+ */
+
+#include "ThreadPool.h"
+#include <algorithm>
+#include <utility>
+
+namespace iDAW {
+
+namespace {
+// Set while a thread is executing pool work, so nested parallelFor runs inline
+thread_local bool t_insidePoolJob = false;
+}
+
+ThreadPool::ThreadPool(size_t numThreads) {
+    if (numThreads == 0) {
+        numThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    m_threads.reserve(numThreads - 1);
+    for (size_t i = 1; i < numThreads; ++i) {
+        m_threads.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t, size_t)>& fn,
+                             size_t maxWorkers) {
+    if (count == 0) return;
+
+    const size_t workers = workerCount(maxWorkers);
+    if (t_insidePoolJob || workers == 1 || count == 1) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i, 0);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> submitLock(m_submitMutex);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &fn;
+        m_jobCount = count;
+        m_jobWorkers = workers;
+        m_nextIndex.store(0, std::memory_order_relaxed);
+        m_activeWorkers = m_threads.size();
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    runJob(0);
+
+    // Workers still hold m_job until they check in, even after a throw
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return m_activeWorkers == 0; });
+        m_job = nullptr;
+        std::swap(error, m_error);
+    }
+
+    if (error) std::rethrow_exception(error);
+}
+
+void ThreadPool::workerLoop(size_t worker) {
+    uint64_t seenGeneration = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stopping || m_generation != seenGeneration; });
+            if (m_stopping) return;
+            seenGeneration = m_generation;
+        }
+
+        runJob(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_activeWorkers;
+        }
+        m_done.notify_one();
+    }
+}
+
+void ThreadPool::runJob(size_t worker) {
+    if (worker >= m_jobWorkers) return;  // Capped out of this job; just check in
+
+    t_insidePoolJob = true;
+
+    try {
+        for (;;) {
+            const size_t index = m_nextIndex.fetch_add(1, std::memory_order_relaxed);
+            if (index >= m_jobCount) break;
+            (*m_job)(index, worker);
+        }
+    } catch (...) {
+        // Keep the first exception for the caller and hand out no more indices
+        m_nextIndex.store(m_jobCount, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_error) m_error = std::current_exception();
+    }
+
+    t_insidePoolJob = false;
+}
+
+} // namespace iDAW
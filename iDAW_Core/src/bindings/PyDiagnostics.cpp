@@ -3,12 +3,52 @@
  */
 
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
 #include "diagnostics/DiagnosticsEngine.h"
 
+#include <cstddef>
+#include <type_traits>
+
 namespace py = pybind11;
 
+namespace {
+
+using iDAW::diagnostics::BatchDiagnosis;
+
+/**
+ * Read-only numpy view of part of a BatchDiagnosis column, without a copy.
+ * The array keeps owner (the Python batch) alive. Each element is the
+ * Scalar at byte offset within the column's element.
+ */
+template<typename Scalar, typename T>
+py::array columnView(py::handle owner, const std::vector<T>& column, size_t offset = 0) {
+    if (column.empty()) return py::array_t<Scalar>(py::ssize_t{0});
+
+    const auto* first = reinterpret_cast<const char*>(column.data()) + offset;
+    py::array_t<Scalar> view({column.size()}, {sizeof(T)}, reinterpret_cast<const Scalar*>(first), owner);
+    py::detail::array_proxy(view.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+    return view;
+}
+
+/** numpy element type of a column: enums are exposed as their underlying integers */
+template<typename T, bool = std::is_enum_v<T>>
+struct ColumnScalar { using type = T; };
+template<typename T>
+struct ColumnScalar<T, true> { using type = std::underlying_type_t<T>; };
+
+/** Property getter for a whole column */
+template<typename T>
+auto column(std::vector<T> BatchDiagnosis::*member) {
+    using Scalar = typename ColumnScalar<T>::type;
+    return [member](py::object self) {
+        return columnView<Scalar>(self, self.cast<const BatchDiagnosis&>().*member);
+    };
+}
+
+} // namespace
+
 void init_diagnostics_bindings(py::module_& m) {
     using namespace iDAW::diagnostics;
     
@@ -146,6 +186,64 @@ void init_diagnostics_bindings(py::module_& m) {
                    " rule_breaks=" + std::to_string(r.ruleBreaks.size()) + ">";
         });
     
+    // FindingCode enum
+    py::enum_<FindingCode>(m, "FindingCode")
+        .value("ParseError", FindingCode::ParseError)
+        .value("ModalInterchange", FindingCode::ModalInterchange)
+        .value("ParallelMotion", FindingCode::ParallelMotion)
+        .value("AvoidedResolution", FindingCode::AvoidedResolution)
+        .value("TritoneMotion", FindingCode::TritoneMotion)
+        .value("ResolveToTonic", FindingCode::ResolveToTonic)
+        .value("AddDominant", FindingCode::AddDominant)
+        .value("PassingChord", FindingCode::PassingChord);
+    
+    // EmotionalCharacter enum
+    py::enum_<EmotionalCharacter>(m, "EmotionalCharacter")
+        .value("Unknown", EmotionalCharacter::Unknown)
+        .value("ComplexAmbiguous", EmotionalCharacter::ComplexAmbiguous)
+        .value("DarkIntrospective", EmotionalCharacter::DarkIntrospective)
+        .value("BittersweetMelancholic", EmotionalCharacter::BittersweetMelancholic)
+        .value("DrivingTension", EmotionalCharacter::DrivingTension)
+        .value("BrightUplifting", EmotionalCharacter::BrightUplifting)
+        .value("BalancedVersatile", EmotionalCharacter::BalancedVersatile);
+    
+    // BatchDiagnosis (columnar batch result). Columns are read-only numpy
+    // views into the batch; enum columns hold the enum's integer value.
+    using iDAW::harmony::Key;
+    py::class_<BatchDiagnosis>(m, "BatchDiagnosis")
+        .def_property_readonly("success", column(&BatchDiagnosis::success))
+        .def_property_readonly("key_root", [](py::object self) {
+            return columnView<int>(self, self.cast<const BatchDiagnosis&>().keys, offsetof(Key, root));
+        })
+        .def_property_readonly("key_mode", [](py::object self) {
+            return columnView<uint8_t>(self, self.cast<const BatchDiagnosis&>().keys, offsetof(Key, mode));
+        })
+        .def_property_readonly("complexity", column(&BatchDiagnosis::complexity))
+        .def_property_readonly("has_resolution", column(&BatchDiagnosis::hasResolution))
+        .def_property_readonly("character", column(&BatchDiagnosis::character))
+        .def_property_readonly("chord_start", column(&BatchDiagnosis::chordStart))
+        .def_property_readonly("finding_start", column(&BatchDiagnosis::findingStart))
+        .def_property_readonly("chord_root", column(&BatchDiagnosis::chordRoot))
+        .def_property_readonly("chord_quality", column(&BatchDiagnosis::chordQuality))
+        .def_property_readonly("chord_bass", column(&BatchDiagnosis::chordBass))
+        .def_property_readonly("finding_code", column(&BatchDiagnosis::findingCode))
+        .def_property_readonly("finding_chord", column(&BatchDiagnosis::findingChord))
+        .def("key", [](const BatchDiagnosis& b, size_t progression) { return b.keys.at(progression); },
+             py::arg("progression"))
+        .def("__len__", &BatchDiagnosis::size)
+        .def("chord_count", &BatchDiagnosis::chordCount, py::arg("progression"))
+        .def("finding_count", &BatchDiagnosis::findingCount, py::arg("progression"))
+        .def("chord", &BatchDiagnosis::chord, py::arg("progression"), py::arg("index"))
+        .def("chord_name", &BatchDiagnosis::chordName, py::arg("progression"), py::arg("index"))
+        .def("describe", &BatchDiagnosis::describe, py::arg("progression"), py::arg("finding"),
+             "Text of one finding of a progression")
+        .def("report", &BatchDiagnosis::report, py::arg("progression"),
+             "Full DiagnosticReport for one progression, rendered on request")
+        .def("__repr__", [](const BatchDiagnosis& b) {
+            return "<BatchDiagnosis progressions=" + std::to_string(b.size()) +
+                   " findings=" + std::to_string(b.findingCode.size()) + ">";
+        });
+    
     // DiagnosticsEngine singleton access
     m.def("get_engine", []() -> DiagnosticsEngine& {
         return DiagnosticsEngine::getInstance();
@@ -163,6 +261,16 @@ void init_diagnostics_bindings(py::module_& m) {
     }, py::arg("progression"),
     "Diagnose a Progression object");
     
+    m.def("diagnose_batch", [](
+        const std::vector<std::string>& progressions,
+        size_t numThreads) {
+        py::gil_scoped_release release;
+        return DiagnosticsEngine::getInstance().diagnoseBatch(progressions, numThreads);
+    },
+    py::arg("progressions"),
+    py::arg("num_threads") = 0,
+    "Diagnose many progression strings in parallel (columnar result, input order preserved)");
+    
     m.def("identify_rule_breaks", [](
         const iDAW::harmony::Progression& progression,
         const iDAW::harmony::Key& key) {
@@ -7,6 +7,7 @@
 
 #include "groove/GrooveEngine.h"
 #include "groove/GrooveTemplate.h"
+#include "groove/GrooveLibrary.h"
 
 namespace py = pybind11;
 
@@ -86,6 +87,16 @@ void init_groove_bindings(py::module_& m) {
         .def("is_valid", &GrooveTemplate::isValid)
         .def("to_map", &GrooveTemplate::toMap)
         .def_static("from_map", &GrooveTemplate::fromMap, py::arg("data"))
+        .def("to_binary", [](const GrooveTemplate& g) {
+            const auto bytes = g.toBinary();
+            return py::bytes(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        })
+        .def_static("from_binary", [](const py::bytes& data) {
+            const std::string bytes = data;
+            return GrooveTemplate::fromBinary(
+                reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+        }, py::arg("data"),
+        "Deserialize a binary groove (None if the data is invalid)")
         .def("time_signature", &GrooveTemplate::timeSignature)
         .def("set_time_signature", &GrooveTemplate::setTimeSignature,
              py::arg("numerator"), py::arg("denominator"))
@@ -146,6 +157,49 @@ void init_groove_bindings(py::module_& m) {
     py::arg("settings") = ExtractionSettings{},
     "Extract groove template from MIDI notes");
     
+    m.def("extract_groove_batch", [](
+        const std::vector<std::vector<MidiNote>>& noteSets,
+        int ppq,
+        float tempo,
+        const ExtractionSettings& settings,
+        size_t numThreads) {
+        py::gil_scoped_release release;
+        return GrooveEngine::getInstance().extractGrooveBatch(
+            noteSets, ppq, tempo, settings, numThreads);
+    },
+    py::arg("note_sets"),
+    py::arg("ppq") = 480,
+    py::arg("tempo") = 120.0f,
+    py::arg("settings") = ExtractionSettings{},
+    py::arg("num_threads") = 0,
+    "Extract groove templates from many note sets in parallel (input order preserved)");
+    
+    m.def("extract_groove_from_files", [](
+        const std::vector<std::string>& paths,
+        const ExtractionSettings& settings,
+        size_t numThreads) {
+        std::vector<FileGrooveResult> results;
+        {
+            py::gil_scoped_release release;
+            results = GrooveEngine::getInstance().extractGrooveFromFiles(paths, settings, numThreads);
+        }
+        
+        // None for files that could not be read
+        py::list grooves;
+        for (auto& result : results) {
+            if (result.ok) {
+                grooves.append(py::cast(std::move(result.groove)));
+            } else {
+                grooves.append(py::none());
+            }
+        }
+        return grooves;
+    },
+    py::arg("paths"),
+    py::arg("settings") = ExtractionSettings{},
+    py::arg("num_threads") = 0,
+    "Load MIDI files and extract their grooves in parallel (None for unreadable files)");
+    
     m.def("apply_groove", [](
         std::vector<MidiNote>& notes,
         const GrooveTemplate& groove,
@@ -164,15 +218,19 @@ void init_groove_bindings(py::module_& m) {
         float complexity,
         float vulnerability,
         int ppq,
-        int seed) {
-        GrooveEngine::getInstance().humanize(notes, complexity, vulnerability, ppq, seed);
+        int seed,
+        size_t firstNoteIndex) {
+        GrooveEngine::getInstance().humanize(notes, complexity, vulnerability, ppq, seed, firstNoteIndex);
     },
     py::arg("notes"),
     py::arg("complexity") = 0.5f,
     py::arg("vulnerability") = 0.5f,
     py::arg("ppq") = 480,
     py::arg("seed") = -1,
-    "Humanize MIDI notes by adding timing/velocity variations (in-place)");
+    py::arg("first_note_index") = 0,
+    "Humanize MIDI notes by adding timing/velocity variations (in-place).\n"
+    "Variations depend only on (seed, note index): pass each block's offset as\n"
+    "first_note_index to get the same result as humanizing the whole track.");
     
     m.def("calculate_swing", [](const std::vector<MidiNote>& notes, int ppq) {
         return GrooveEngine::getInstance().calculateSwing(notes, ppq);
@@ -211,4 +269,21 @@ void init_groove_bindings(py::module_& m) {
     
     m.def("get_genre_preset_by_name", &getGenrePresetByName, py::arg("name"),
         "Get GenrePreset enum value from string name");
+    
+    m.def("save_groove_library", [](const std::string& path,
+                                    const std::vector<GrooveTemplate>& grooves) {
+        py::gil_scoped_release release;
+        return saveGrooveLibrary(path, grooves);
+    }, py::arg("path"), py::arg("grooves"),
+    "Write grooves with their full payload to a binary library file");
+    
+    m.def("load_groove_library", [](const std::string& path) {
+        std::optional<std::vector<GrooveTemplate>> grooves;
+        {
+            py::gil_scoped_release release;
+            grooves = loadGrooveLibrary(path);
+        }
+        return grooves;
+    }, py::arg("path"),
+    "Load every groove from a binary library file (None if missing or invalid)");
 }
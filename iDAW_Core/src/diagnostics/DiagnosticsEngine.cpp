@@ -3,7 +3,10 @@
  */
 
 #include "diagnostics/DiagnosticsEngine.h"
+#include "ThreadPool.h"
 #include <algorithm>
+#include <array>
+#include <bitset>
 #include <map>
 
 namespace iDAW {
@@ -11,173 +14,105 @@ namespace diagnostics {
 
 using namespace harmony;
 
+namespace {
+
 // ============================================================================
-// DiagnosticsEngine Implementation
+// Analysis core (shared by diagnose() and diagnoseBatch())
 // ============================================================================
 
-DiagnosticsEngine& DiagnosticsEngine::getInstance() {
-    static DiagnosticsEngine instance;
-    return instance;
+struct Finding {
+    FindingCode code;
+    int32_t chordIndex;
+};
+
+/**
+ * Scale degrees of a mode as a bitmask (bit n = n semitones above the root)
+ */
+uint16_t scaleMask(Mode mode) {
+    static const std::array<uint16_t, 7> masks = [] {
+        std::array<uint16_t, 7> m{};
+        for (size_t i = 0; i < m.size(); i++) {
+            for (int degree : getScaleDegrees(static_cast<Mode>(i))) {
+                m[i] |= static_cast<uint16_t>(1u << degree);
+            }
+        }
+        return m;
+    }();
+    const auto index = static_cast<size_t>(mode);
+    return index < masks.size() ? masks[index] : masks[0];
 }
 
-DiagnosticReport DiagnosticsEngine::diagnose(const std::string& progressionStr) const {
-    auto progOpt = Progression::fromString(progressionStr);
-    if (!progOpt) {
-        DiagnosticReport report;
-        report.success = false;
-        report.errorMessage = "Could not parse chord progression";
-        report.issues.push_back({
-            "Could not parse chord progression",
-            "",
-            -1,
-            false,
-            std::nullopt
-        });
-        report.suggestions.push_back({
-            "Check chord spelling",
-            "Ensure chord names are valid (e.g., Am, Cmaj7, F#dim)",
-            1
-        });
-        return report;
-    }
-    
-    return diagnose(*progOpt);
+int degreeInKey(const Chord& chord, const Key& key) {
+    return (chord.root() - key.root + 12) % 12;
 }
 
-DiagnosticReport DiagnosticsEngine::diagnose(const Progression& progression) const {
-    DiagnosticReport report;
-    
-    if (progression.empty()) {
-        report.success = false;
-        report.errorMessage = "Empty progression";
-        return report;
-    }
-    
-    // Detect key
-    report.detectedKey = progression.key();
-    
-    // Get chord names and Roman numerals
-    for (const auto& chord : progression.chords()) {
-        report.chordNames.push_back(chord.name());
-    }
-    report.romanNumerals = progression.romanNumerals();
-    
-    // Identify rule breaks
-    report.ruleBreaks = identifyRuleBreaks(progression, report.detectedKey);
-    
-    // Identify borrowed chords
-    report.borrowedChords = progression.identifyBorrowedChords();
-    
-    // Analyze voice leading and issues
-    analyzeVoiceLeading(progression, report.issues);
-    
-    // Analyze borrowed chords as rule breaks
-    analyzeBorrowedChords(progression, report.detectedKey, report.ruleBreaks);
-    
-    // Generate suggestions
-    generateSuggestions(progression, report.detectedKey, report.issues, report.suggestions);
-    
-    // Calculate complexity
-    report.harmonyComplexity = calculateComplexity(progression);
-    
-    // Check resolution
-    report.hasResolution = hasResolution(progression, report.detectedKey);
-    
-    // Get emotional character
-    report.emotionalCharacter = getEmotionalCharacter(progression, report.detectedKey);
-    
-    report.success = true;
-    return report;
+bool isDiatonicDegree(uint16_t mask, int degree) {
+    return (mask >> degree) & 1u;
 }
 
-std::vector<RuleBreak> DiagnosticsEngine::identifyRuleBreaks(
-    const Progression& progression,
-    const Key& key) const {
-    
-    std::vector<RuleBreak> ruleBreaks;
-    
-    auto scale = getScaleDegrees(key.mode);
+/**
+ * Emit every finding for a parsed progression, in report order: rule
+ * breaks, issues, suggestions
+ */
+template <typename Emit>
+void collectFindings(const Chord* chords, size_t count, const Key& key, Emit&& emit) {
+    if (count == 0) return;
+    const uint16_t scale = scaleMask(key.mode);
     
-    for (size_t i = 0; i < progression.size(); i++) {
-        const auto& chord = progression.at(i);
-        int interval = (chord.root() - key.root + 12) % 12;
+    for (size_t i = 0; i < count; i++) {
+        const auto index = static_cast<int32_t>(i);
         
-        // Check for modal interchange (borrowed chords)
-        if (std::find(scale.begin(), scale.end(), interval) == scale.end()) {
-            RuleBreak rb;
-            rb.category = RuleBreakCategory::HarmonyModalInterchange;
-            rb.chordName = chord.name();
-            
-            if (interval == 3 && key.mode == Mode::Major) {
-                rb.context = "bIII chord borrowed from parallel minor";
-                rb.emotionalEffect = "Creates bittersweet, melancholic color";
-                rb.justification = "Common in pop/rock for emotional depth";
-            } else if (interval == 8 && key.mode == Mode::Major) {
-                rb.context = "bVI chord borrowed from parallel minor";
-                rb.emotionalEffect = "Creates darkness, drama, or nostalgia";
-                rb.justification = "Classic Hollywood dramatic move";
-            } else if (interval == 10 && key.mode == Mode::Major) {
-                rb.context = "bVII chord from mixolydian/parallel minor";
-                rb.emotionalEffect = "Creates rock/blues power, avoids dominant tension";
-                rb.justification = "Standard in rock and blues progressions";
-            } else if (interval == 5 && chord.quality() == ChordQuality::Minor) {
-                rb.context = "iv chord borrowed from parallel minor";
-                rb.emotionalEffect = "Creates sadness, resignation, bittersweet feeling";
-                rb.justification = "The 'heart-wrenching' sound in pop ballads";
-            } else {
-                rb.context = "Non-diatonic chord";
-                rb.emotionalEffect = "Creates tension or color outside the key";
-                rb.justification = "Intentional chromatic movement";
-            }
-            
-            ruleBreaks.push_back(rb);
+        // Modal interchange (borrowed chords)
+        if (!isDiatonicDegree(scale, degreeInKey(chords[i], key))) {
+            emit(FindingCode::ModalInterchange, index);
         }
         
-        // Check for parallel motion (consecutive chords with same quality)
-        if (i > 0) {
-            const auto& prevChord = progression.at(i - 1);
-            if (chord.quality() == prevChord.quality()) {
-                int motion = (chord.root() - prevChord.root() + 12) % 12;
-                
-                // Parallel fifths/fourths (power chord movement)
-                if (motion == 5 || motion == 7) {
-                    RuleBreak rb;
-                    rb.category = RuleBreakCategory::HarmonyParallelMotion;
-                    rb.chordName = prevChord.name() + " → " + chord.name();
-                    rb.context = "Parallel " + (motion == 5 ? "fourth" : "fifth") + " motion";
-                    rb.emotionalEffect = "Creates power, unity, medieval quality";
-                    rb.justification = "Common in rock, metal, and cinematic music";
-                    ruleBreaks.push_back(rb);
-                }
+        // Parallel motion (consecutive chords with same quality)
+        if (i > 0 && chords[i].quality() == chords[i - 1].quality()) {
+            int motion = (chords[i].root() - chords[i - 1].root() + 12) % 12;
+            if (motion == 5 || motion == 7) {
+                emit(FindingCode::ParallelMotion, index);
             }
         }
     }
     
-    // Check for avoided tonic resolution
-    if (progression.size() > 0) {
-        const auto& lastChord = progression.at(progression.size() - 1);
-        int lastInterval = (lastChord.root() - key.root + 12) % 12;
-        
-        if (lastInterval != 0) {
-            RuleBreak rb;
-            rb.category = RuleBreakCategory::HarmonyAvoidTonicResolution;
-            rb.chordName = lastChord.name();
-            rb.context = "Progression does not resolve to tonic";
-            rb.emotionalEffect = "Creates unresolved yearning, open-ended feeling";
-            rb.justification = "Used in emo/lo-fi for emotional ambiguity";
-            ruleBreaks.push_back(rb);
+    const int lastInterval = degreeInKey(chords[count - 1], key);
+    if (lastInterval != 0) {
+        emit(FindingCode::AvoidedResolution, static_cast<int32_t>(count - 1));
+    }
+    
+    for (size_t i = 1; i < count; i++) {
+        if ((chords[i].root() - chords[i - 1].root() + 12) % 12 == 6) {
+            emit(FindingCode::TritoneMotion, static_cast<int32_t>(i));
         }
     }
     
-    return ruleBreaks;
+    if (lastInterval != 0 && lastInterval != 7) {
+        emit(FindingCode::ResolveToTonic, static_cast<int32_t>(count - 1));
+    }
+    
+    bool hasDominant = false;
+    bool hasTonic = false;
+    for (size_t i = 0; i < count; i++) {
+        int interval = degreeInKey(chords[i], key);
+        if (interval == 7) hasDominant = true;
+        if (interval == 0) hasTonic = true;
+    }
+    if (!hasDominant && hasTonic) {
+        emit(FindingCode::AddDominant, -1);
+    }
+    
+    // A passing chord for each tritone issue
+    for (size_t i = 1; i < count; i++) {
+        if ((chords[i].root() - chords[i - 1].root() + 12) % 12 == 6) {
+            emit(FindingCode::PassingChord, static_cast<int32_t>(i));
+        }
+    }
 }
 
-std::string DiagnosticsEngine::getEmotionalCharacter(
-    const Progression& progression,
-    const Key& key) const {
-    
-    if (progression.empty()) {
-        return "unknown";
+EmotionalCharacter classifyCharacter(const Chord* chords, size_t count, const Key& key) {
+    if (count == 0) {
+        return EmotionalCharacter::Unknown;
     }
     
     // Count different characteristics
@@ -186,9 +121,11 @@ std::string DiagnosticsEngine::getEmotionalCharacter(
     int dominantCount = 0;
     int nonDiatonicCount = 0;
     
-    auto scale = getScaleDegrees(key.mode);
+    const uint16_t scale = scaleMask(key.mode);
     
-    for (const auto& chord : progression.chords()) {
+    for (size_t i = 0; i < count; i++) {
+        const Chord& chord = chords[i];
+        
         // Quality counts
         if (chord.quality() == ChordQuality::Major ||
             chord.quality() == ChordQuality::Major7) {
@@ -201,111 +138,422 @@ std::string DiagnosticsEngine::getEmotionalCharacter(
         }
         
         // Diatonic check
-        int interval = (chord.root() - key.root + 12) % 12;
-        if (std::find(scale.begin(), scale.end(), interval) == scale.end()) {
+        if (!isDiatonicDegree(scale, degreeInKey(chord, key))) {
             nonDiatonicCount++;
         }
     }
     
-    float total = static_cast<float>(progression.size());
+    float total = static_cast<float>(count);
     float minorRatio = minorCount / total;
     float nonDiatonicRatio = nonDiatonicCount / total;
     
-    // Determine character
-    std::string character;
-    
     if (nonDiatonicRatio > 0.3f) {
-        character = "complex, emotionally ambiguous";
+        return EmotionalCharacter::ComplexAmbiguous;
     } else if (minorRatio > 0.5f) {
-        if (key.mode == Mode::Minor) {
-            character = "dark, introspective";
-        } else {
-            character = "bittersweet, melancholic";
-        }
+        return key.mode == Mode::Minor ? EmotionalCharacter::DarkIntrospective
+                                       : EmotionalCharacter::BittersweetMelancholic;
     } else if (dominantCount > 0) {
-        character = "driving, tension-filled";
+        return EmotionalCharacter::DrivingTension;
     } else if (key.mode == Mode::Major && majorCount > minorCount) {
-        character = "bright, uplifting";
-    } else {
-        character = "balanced, versatile";
+        return EmotionalCharacter::BrightUplifting;
     }
-    
-    return character;
+    return EmotionalCharacter::BalancedVersatile;
 }
 
-float DiagnosticsEngine::calculateComplexity(const Progression& progression) const {
-    if (progression.empty()) {
+/**
+ * Distinct id per chord name (Chord::name() is a function of these fields)
+ */
+constexpr size_t CHORD_NAME_IDS = 1 + 12 * 15 * 13;
+
+size_t chordNameId(const Chord& chord) {
+    if (!chord.isValid()) return 0;  // Every invalid chord is named "?"
+    const size_t bass = chord.hasBass() ? static_cast<size_t>(chord.bass() % 12) + 1 : 0;
+    return 1 + (static_cast<size_t>(chord.root()) * 15 + static_cast<size_t>(chord.quality())) * 13 + bass;
+}
+
+float complexityOf(const Chord* chords, size_t count, const Key& key) {
+    if (count == 0) {
         return 0.0f;
     }
     
     float complexity = 0.0f;
     
     // Unique chord count contributes to complexity
-    std::set<std::string> uniqueChords;
-    for (const auto& chord : progression.chords()) {
-        uniqueChords.insert(chord.name());
+    std::bitset<CHORD_NAME_IDS> seen;
+    size_t uniqueChords = 0;
+    for (size_t i = 0; i < count; i++) {
+        const size_t id = chordNameId(chords[i]);
+        if (!seen.test(id)) {
+            seen.set(id);
+            uniqueChords++;
+        }
     }
-    complexity += std::min(1.0f, uniqueChords.size() / 8.0f) * 0.3f;
+    complexity += std::min(1.0f, uniqueChords / 8.0f) * 0.3f;
     
     // Extended chords contribute
     int extendedCount = 0;
-    for (const auto& chord : progression.chords()) {
-        if (chord.quality() == ChordQuality::Major7 ||
-            chord.quality() == ChordQuality::Minor7 ||
-            chord.quality() == ChordQuality::Dominant7 ||
-            chord.quality() == ChordQuality::Dim7 ||
-            chord.quality() == ChordQuality::HalfDim7) {
+    for (size_t i = 0; i < count; i++) {
+        const ChordQuality quality = chords[i].quality();
+        if (quality == ChordQuality::Major7 ||
+            quality == ChordQuality::Minor7 ||
+            quality == ChordQuality::Dominant7 ||
+            quality == ChordQuality::Dim7 ||
+            quality == ChordQuality::HalfDim7) {
             extendedCount++;
         }
     }
-    complexity += (extendedCount / static_cast<float>(progression.size())) * 0.3f;
+    complexity += (extendedCount / static_cast<float>(count)) * 0.3f;
     
     // Non-diatonic chords contribute
-    auto scale = getScaleDegrees(progression.key().mode);
+    const uint16_t scale = scaleMask(key.mode);
     int nonDiatonicCount = 0;
-    for (const auto& chord : progression.chords()) {
-        int interval = (chord.root() - progression.key().root + 12) % 12;
-        if (std::find(scale.begin(), scale.end(), interval) == scale.end()) {
+    for (size_t i = 0; i < count; i++) {
+        if (!isDiatonicDegree(scale, degreeInKey(chords[i], key))) {
             nonDiatonicCount++;
         }
     }
-    complexity += (nonDiatonicCount / static_cast<float>(progression.size())) * 0.4f;
+    complexity += (nonDiatonicCount / static_cast<float>(count)) * 0.4f;
     
     return std::clamp(complexity, 0.0f, 1.0f);
 }
 
-bool DiagnosticsEngine::hasResolution(
-    const Progression& progression,
-    const Key& key) const {
+bool resolves(const Chord* chords, size_t count, const Key& key) {
+    if (count == 0) {
+        return false;
+    }
     
+    // Resolves to tonic
+    return degreeInKey(chords[count - 1], key) == 0;
+}
+
+// ============================================================================
+// Rendering (codes to report text)
+// ============================================================================
+
+RuleBreak renderRuleBreak(FindingCode code, const Chord* chords, int32_t index, const Key& key) {
+    const Chord& chord = chords[index];
+    RuleBreak rb;
+    
+    if (code == FindingCode::ModalInterchange) {
+        int interval = degreeInKey(chord, key);
+        rb.category = RuleBreakCategory::HarmonyModalInterchange;
+        rb.chordName = chord.name();
+        
+        if (interval == 3 && key.mode == Mode::Major) {
+            rb.context = "bIII chord borrowed from parallel minor";
+            rb.emotionalEffect = "Creates bittersweet, melancholic color";
+            rb.justification = "Common in pop/rock for emotional depth";
+        } else if (interval == 8 && key.mode == Mode::Major) {
+            rb.context = "bVI chord borrowed from parallel minor";
+            rb.emotionalEffect = "Creates darkness, drama, or nostalgia";
+            rb.justification = "Classic Hollywood dramatic move";
+        } else if (interval == 10 && key.mode == Mode::Major) {
+            rb.context = "bVII chord from mixolydian/parallel minor";
+            rb.emotionalEffect = "Creates rock/blues power, avoids dominant tension";
+            rb.justification = "Standard in rock and blues progressions";
+        } else if (interval == 5 && chord.quality() == ChordQuality::Minor) {
+            rb.context = "iv chord borrowed from parallel minor";
+            rb.emotionalEffect = "Creates sadness, resignation, bittersweet feeling";
+            rb.justification = "The 'heart-wrenching' sound in pop ballads";
+        } else {
+            rb.context = "Non-diatonic chord";
+            rb.emotionalEffect = "Creates tension or color outside the key";
+            rb.justification = "Intentional chromatic movement";
+        }
+    } else if (code == FindingCode::ParallelMotion) {
+        const Chord& prevChord = chords[index - 1];
+        int motion = (chord.root() - prevChord.root() + 12) % 12;
+        rb.category = RuleBreakCategory::HarmonyParallelMotion;
+        rb.chordName = prevChord.name() + " → " + chord.name();
+        rb.context = std::string("Parallel ") + (motion == 5 ? "fourth" : "fifth") + " motion";
+        rb.emotionalEffect = "Creates power, unity, medieval quality";
+        rb.justification = "Common in rock, metal, and cinematic music";
+    } else {
+        rb.category = RuleBreakCategory::HarmonyAvoidTonicResolution;
+        rb.chordName = chord.name();
+        rb.context = "Progression does not resolve to tonic";
+        rb.emotionalEffect = "Creates unresolved yearning, open-ended feeling";
+        rb.justification = "Used in emo/lo-fi for emotional ambiguity";
+    }
+    
+    return rb;
+}
+
+std::string transitionName(const Chord* chords, int32_t index) {
+    return chords[index - 1].name() + " → " + chords[index].name();
+}
+
+DiagnosticIssue parseErrorIssue() {
+    return {"Could not parse chord progression", "", -1, false, std::nullopt};
+}
+
+DiagnosticSuggestion parseErrorSuggestion() {
+    return {"Check chord spelling", "Ensure chord names are valid (e.g., Am, Cmaj7, F#dim)", 1};
+}
+
+/**
+ * Append the text form of one finding to the matching report list
+ */
+void renderFinding(const Finding& finding, const Chord* chords, const Key& key,
+                   DiagnosticReport& report) {
+    switch (finding.code) {
+        case FindingCode::ParseError:
+            report.issues.push_back(parseErrorIssue());
+            report.suggestions.push_back(parseErrorSuggestion());
+            break;
+        case FindingCode::ModalInterchange:
+        case FindingCode::ParallelMotion:
+        case FindingCode::AvoidedResolution:
+            report.ruleBreaks.push_back(renderRuleBreak(finding.code, chords, finding.chordIndex, key));
+            break;
+        case FindingCode::TritoneMotion: {
+            const Chord& prev = chords[finding.chordIndex - 1];
+            const Chord& curr = chords[finding.chordIndex];
+            DiagnosticIssue issue;
+            issue.description = "Tritone motion between " + prev.name() +
+                               " and " + curr.name() + " - can feel unstable";
+            issue.chordInvolved = transitionName(chords, finding.chordIndex);
+            issue.chordIndex = finding.chordIndex;
+            issue.isWarning = true;
+            report.issues.push_back(issue);
+            break;
+        }
+        case FindingCode::ResolveToTonic:
+            report.suggestions.push_back({
+                "Progression ends on " + chords[finding.chordIndex].name() +
+                " - consider resolving to " + std::string(NOTE_NAMES[key.root]),
+                "Traditional progressions typically resolve to the tonic for closure",
+                2
+            });
+            break;
+        case FindingCode::AddDominant:
+            report.suggestions.push_back({
+                "No dominant (V) chord - consider adding for stronger resolution",
+                "The V-I movement is the strongest harmonic resolution",
+                2
+            });
+            break;
+        case FindingCode::PassingChord:
+            report.suggestions.push_back({
+                "Consider adding a passing chord between " + transitionName(chords, finding.chordIndex),
+                "A chromatic approach chord can smooth the transition",
+                3
+            });
+            break;
+    }
+}
+
+DiagnosticReport parseErrorReport() {
+    DiagnosticReport report;
+    report.success = false;
+    report.errorMessage = "Could not parse chord progression";
+    report.issues.push_back(parseErrorIssue());
+    report.suggestions.push_back(parseErrorSuggestion());
+    return report;
+}
+
+DiagnosticReport renderReport(const Progression& progression,
+                              const Finding* findings, size_t findingCount,
+                              float complexity, bool hasResolution,
+                              EmotionalCharacter character) {
+    DiagnosticReport report;
+    report.detectedKey = progression.key();
+    
+    for (const auto& chord : progression.chords()) {
+        report.chordNames.push_back(chord.name());
+    }
+    report.romanNumerals = progression.romanNumerals();
+    report.borrowedChords = progression.identifyBorrowedChords();
+    
+    const Chord* chords = progression.chords().data();
+    for (size_t i = 0; i < findingCount; i++) {
+        renderFinding(findings[i], chords, report.detectedKey, report);
+    }
+    
+    report.harmonyComplexity = complexity;
+    report.hasResolution = hasResolution;
+    report.emotionalCharacter = emotionalCharacterToString(character);
+    report.success = true;
+    return report;
+}
+
+} // namespace
+
+// ============================================================================
+// DiagnosticsEngine Implementation
+// ============================================================================
+
+DiagnosticsEngine& DiagnosticsEngine::getInstance() {
+    static DiagnosticsEngine instance;
+    return instance;
+}
+
+DiagnosticReport DiagnosticsEngine::diagnose(const std::string& progressionStr) const {
+    auto progOpt = Progression::fromString(progressionStr);
+    if (!progOpt) {
+        return parseErrorReport();
+    }
+    
+    return diagnose(*progOpt);
+}
+
+DiagnosticReport DiagnosticsEngine::diagnose(const Progression& progression) const {
     if (progression.empty()) {
-        return false;
+        DiagnosticReport report;
+        report.success = false;
+        report.errorMessage = "Empty progression";
+        return report;
     }
     
-    const auto& lastChord = progression.at(progression.size() - 1);
-    int lastInterval = (lastChord.root() - key.root + 12) % 12;
+    const Chord* chords = progression.chords().data();
+    const size_t count = progression.size();
+    const Key& key = progression.key();
     
-    // Resolves to tonic
-    if (lastInterval == 0) {
-        return true;
+    std::vector<Finding> findings;
+    collectFindings(chords, count, key, [&findings](FindingCode code, int32_t index) {
+        findings.push_back({code, index});
+    });
+    
+    return renderReport(progression, findings.data(), findings.size(),
+                        complexityOf(chords, count, key),
+                        resolves(chords, count, key),
+                        classifyCharacter(chords, count, key));
+}
+
+BatchDiagnosis DiagnosticsEngine::diagnoseBatch(
+    const std::vector<std::string>& progressions,
+    size_t numThreads) const {
+    
+    const size_t count = progressions.size();
+    BatchDiagnosis batch;
+    batch.success.resize(count);
+    batch.keys.resize(count);
+    batch.complexity.resize(count);
+    batch.hasResolution.resize(count);
+    batch.character.resize(count);
+    batch.chordStart.assign(count + 1, 0);
+    batch.findingStart.assign(count + 1, 0);
+    
+    ThreadPool& pool = ThreadPool::shared();
+    
+    // Workers append chords and findings to their own columns; each
+    // progression remembers where its slice went, and the slices are
+    // stitched together in input order afterwards
+    struct WorkerColumns {
+        std::vector<Chord> parsed;
+        std::vector<Chord> chords;
+        std::vector<Finding> findings;
+    };
+    struct Slice {
+        uint32_t worker;
+        uint32_t chordBegin;
+        uint32_t findingBegin;
+    };
+    std::vector<WorkerColumns> columns(pool.workerCount(numThreads));
+    std::vector<Slice> slices(count);
+    
+    pool.parallelFor(count, [&](size_t index, size_t worker) {
+        WorkerColumns& wc = columns[worker];
+        slices[index] = {static_cast<uint32_t>(worker),
+                         static_cast<uint32_t>(wc.chords.size()),
+                         static_cast<uint32_t>(wc.findings.size())};
+        
+        wc.parsed.clear();
+        parseProgressionInto(progressions[index], wc.parsed);
+        if (wc.parsed.empty()) {
+            batch.success[index] = 0;
+            batch.keys[index] = Key{0, Mode::Major};
+            wc.findings.push_back({FindingCode::ParseError, -1});
+            batch.findingStart[index + 1] = 1;
+            return;
+        }
+        
+        const Chord* chords = wc.parsed.data();
+        const size_t n = wc.parsed.size();
+        const Key key = Progression::detectKey(wc.parsed);
+        
+        size_t findingCount = 0;
+        collectFindings(chords, n, key, [&wc, &findingCount](FindingCode code, int32_t i) {
+            wc.findings.push_back({code, i});
+            findingCount++;
+        });
+        wc.chords.insert(wc.chords.end(), wc.parsed.begin(), wc.parsed.end());
+        
+        batch.success[index] = 1;
+        batch.keys[index] = key;
+        batch.complexity[index] = complexityOf(chords, n, key);
+        batch.hasResolution[index] = resolves(chords, n, key) ? 1 : 0;
+        batch.character[index] = classifyCharacter(chords, n, key);
+        batch.chordStart[index + 1] = static_cast<uint32_t>(n);
+        batch.findingStart[index + 1] = static_cast<uint32_t>(findingCount);
+    }, numThreads);
+    
+    for (size_t i = 0; i < count; i++) {
+        batch.chordStart[i + 1] += batch.chordStart[i];
+        batch.findingStart[i + 1] += batch.findingStart[i];
     }
     
-    // Check for V-I or IV-I at the end
-    if (progression.size() >= 2) {
-        const auto& secondLast = progression.at(progression.size() - 2);
-        int secondLastInterval = (secondLast.root() - key.root + 12) % 12;
+    const size_t totalChords = batch.chordStart[count];
+    const size_t totalFindings = batch.findingStart[count];
+    batch.chordRoot.resize(totalChords);
+    batch.chordQuality.resize(totalChords);
+    batch.chordBass.resize(totalChords);
+    batch.findingCode.resize(totalFindings);
+    batch.findingChord.resize(totalFindings);
+    
+    for (size_t i = 0; i < count; i++) {
+        const WorkerColumns& wc = columns[slices[i].worker];
         
-        // V → I
-        if (secondLastInterval == 7 && lastInterval == 0) {
-            return true;
+        const Chord* chords = wc.chords.data() + slices[i].chordBegin;
+        for (size_t c = 0, out = batch.chordStart[i]; out < batch.chordStart[i + 1]; c++, out++) {
+            batch.chordRoot[out] = static_cast<uint8_t>(chords[c].root());
+            batch.chordQuality[out] = chords[c].quality();
+            batch.chordBass[out] = static_cast<int8_t>(chords[c].hasBass() ? chords[c].bass() : -1);
         }
-        // IV → I (plagal)
-        if (secondLastInterval == 5 && lastInterval == 0) {
-            return true;
+        
+        const Finding* findings = wc.findings.data() + slices[i].findingBegin;
+        for (size_t f = 0, out = batch.findingStart[i]; out < batch.findingStart[i + 1]; f++, out++) {
+            batch.findingCode[out] = findings[f].code;
+            batch.findingChord[out] = findings[f].chordIndex;
         }
     }
     
-    return false;
+    return batch;
+}
+
+std::vector<RuleBreak> DiagnosticsEngine::identifyRuleBreaks(
+    const Progression& progression,
+    const Key& key) const {
+    
+    std::vector<RuleBreak> ruleBreaks;
+    const Chord* chords = progression.chords().data();
+    
+    collectFindings(chords, progression.size(), key, [&](FindingCode code, int32_t index) {
+        if (code == FindingCode::ModalInterchange ||
+            code == FindingCode::ParallelMotion ||
+            code == FindingCode::AvoidedResolution) {
+            ruleBreaks.push_back(renderRuleBreak(code, chords, index, key));
+        }
+    });
+    
+    return ruleBreaks;
+}
+
+std::string DiagnosticsEngine::getEmotionalCharacter(
+    const Progression& progression,
+    const Key& key) const {
+    return emotionalCharacterToString(
+        classifyCharacter(progression.chords().data(), progression.size(), key));
+}
+
+float DiagnosticsEngine::calculateComplexity(const Progression& progression) const {
+    return complexityOf(progression.chords().data(), progression.size(), progression.key());
+}
+
+bool DiagnosticsEngine::hasResolution(
+    const Progression& progression,
+    const Key& key) const {
+    return resolves(progression.chords().data(), progression.size(), key);
 }
 
 std::vector<RuleBreak> DiagnosticsEngine::suggestRuleBreaks(
@@ -399,86 +647,55 @@ std::vector<RuleBreak> DiagnosticsEngine::suggestRuleBreaks(
     return suggestions;
 }
 
-void DiagnosticsEngine::analyzeVoiceLeading(
-    const Progression& progression,
-    std::vector<DiagnosticIssue>& issues) const {
-    
-    for (size_t i = 1; i < progression.size(); i++) {
-        const auto& prev = progression.at(i - 1);
-        const auto& curr = progression.at(i);
-        
-        int rootMotion = (curr.root() - prev.root() + 12) % 12;
-        
-        // Tritone motion
-        if (rootMotion == 6) {
-            DiagnosticIssue issue;
-            issue.description = "Tritone motion between " + prev.name() + 
-                               " and " + curr.name() + " - can feel unstable";
-            issue.chordInvolved = prev.name() + " → " + curr.name();
-            issue.chordIndex = static_cast<int>(i);
-            issue.isWarning = true;
-            issues.push_back(issue);
-        }
-    }
-}
+// ============================================================================
+// BatchDiagnosis Implementation
+// ============================================================================
 
-void DiagnosticsEngine::analyzeBorrowedChords(
-    const Progression& progression,
-    const Key& key,
-    std::vector<RuleBreak>& ruleBreaks) const {
-    
-    // This is already handled in identifyRuleBreaks
-    // Keep for potential future expansion
+Chord BatchDiagnosis::chord(size_t progression, size_t index) const {
+    const size_t i = chordStart[progression] + index;
+    return Chord(chordRoot[i], chordQuality[i], chordBass[i]);
 }
 
-void DiagnosticsEngine::generateSuggestions(
-    const Progression& progression,
-    const Key& key,
-    const std::vector<DiagnosticIssue>& issues,
-    std::vector<DiagnosticSuggestion>& suggestions) const {
-    
-    if (progression.empty()) return;
-    
-    // Check for resolution
-    const auto& lastChord = progression.at(progression.size() - 1);
-    int lastInterval = (lastChord.root() - key.root + 12) % 12;
+std::string BatchDiagnosis::describe(size_t progression, size_t finding) const {
+    const size_t i = findingStart[progression] + finding;
+    if (findingCode[i] == FindingCode::ParseError) {
+        return parseErrorIssue().description;
+    }
     
-    if (lastInterval != 0 && lastInterval != 7) {
-        suggestions.push_back({
-            "Progression ends on " + lastChord.name() + 
-            " - consider resolving to " + std::string(NOTE_NAMES[key.root]),
-            "Traditional progressions typically resolve to the tonic for closure",
-            2
-        });
+    std::vector<Chord> chords;
+    chords.reserve(chordCount(progression));
+    for (size_t c = 0; c < chordCount(progression); c++) {
+        chords.push_back(chord(progression, c));
     }
     
-    // Check for dominant
-    bool hasDominant = false;
-    bool hasTonic = false;
-    for (const auto& chord : progression.chords()) {
-        int interval = (chord.root() - key.root + 12) % 12;
-        if (interval == 7) hasDominant = true;
-        if (interval == 0) hasTonic = true;
+    DiagnosticReport rendered;
+    renderFinding({findingCode[i], findingChord[i]}, chords.data(), keys[progression], rendered);
+    if (!rendered.ruleBreaks.empty()) return rendered.ruleBreaks.front().toString();
+    if (!rendered.issues.empty()) return rendered.issues.front().description;
+    return rendered.suggestions.front().description;
+}
+
+DiagnosticReport BatchDiagnosis::report(size_t progression) const {
+    if (!success[progression]) {
+        return parseErrorReport();
     }
     
-    if (!hasDominant && hasTonic) {
-        suggestions.push_back({
-            "No dominant (V) chord - consider adding for stronger resolution",
-            "The V-I movement is the strongest harmonic resolution",
-            2
-        });
+    std::vector<Chord> chords;
+    chords.reserve(chordCount(progression));
+    for (size_t c = 0; c < chordCount(progression); c++) {
+        chords.push_back(chord(progression, c));
     }
+    Progression prog(chords);
     
-    // If there are tritone issues, suggest passing chords
-    for (const auto& issue : issues) {
-        if (issue.description.find("Tritone") != std::string::npos) {
-            suggestions.push_back({
-                "Consider adding a passing chord between " + issue.chordInvolved,
-                "A chromatic approach chord can smooth the transition",
-                3
-            });
-        }
+    std::vector<Finding> findings;
+    findings.reserve(findingCount(progression));
+    for (size_t i = findingStart[progression]; i < findingStart[progression + 1]; i++) {
+        findings.push_back({findingCode[i], findingChord[i]});
     }
+    
+    return renderReport(prog, findings.data(), findings.size(),
+                        complexity[progression], hasResolution[progression] != 0,
+                        character[progression]);
 }
 
 } // namespace diagnostics
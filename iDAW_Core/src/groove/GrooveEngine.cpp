@@ -3,9 +3,15 @@
  */
 
 #include "groove/GrooveEngine.h"
+#include "groove/MidiFileLoader.h"
+#include "groove/NoteBuffer.h"
+#include "ThreadPool.h"
+#include "daiw/random.hpp"
+#include "daiw/simd.hpp"
 #include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <cmath>
-#include <random>
 #include <numeric>
 
 namespace iDAW {
@@ -15,6 +21,48 @@ namespace groove {
 constexpr int MIN_VELOCITY = 1;
 constexpr int MAX_VELOCITY = 127;
 
+namespace {
+
+// Independent counter-RNG streams per humanized parameter
+constexpr uint64_t HUMANIZE_TIMING_STREAM = 0;
+constexpr uint64_t HUMANIZE_VELOCITY_STREAM = 1;
+
+/**
+ * Per-note humanization offsets, a pure function of (seed, note index)
+ */
+class HumanizeDraws {
+public:
+    HumanizeDraws(float complexity, float vulnerability, int seed)
+        : HumanizeDraws(complexity, vulnerability,
+                        seed >= 0 ? static_cast<uint64_t>(seed) : daiw::random::random_seed()) {}
+
+    int timingOffset(uint64_t index) const {
+        return static_cast<int>(m_timing.normal(index) * m_timingSigma + m_latencyBias);
+    }
+
+    int velocityOffset(uint64_t index) const {
+        return static_cast<int>(m_velocity.normal(index) * m_velocitySigma);
+    }
+
+private:
+    HumanizeDraws(float complexity, float vulnerability, uint64_t key)
+        : m_timing(key, HUMANIZE_TIMING_STREAM)
+        , m_velocity(key, HUMANIZE_VELOCITY_STREAM)
+        // Up to 30 ticks / ±20 velocity at max, as 3 sigma
+        , m_timingSigma(complexity * 30.0f / 3.0f)
+        , m_velocitySigma(vulnerability * 20.0f / 3.0f)
+        // Human latency bias (slightly behind the beat)
+        , m_latencyBias(5.0f * complexity) {}
+
+    daiw::random::CounterRng m_timing;
+    daiw::random::CounterRng m_velocity;
+    float m_timingSigma;
+    float m_velocitySigma;
+    float m_latencyBias;
+};
+
+} // namespace
+
 // ============================================================================
 // GrooveTemplate Implementation
 // ============================================================================
@@ -244,6 +292,16 @@ GrooveTemplate GrooveEngine::extractGroove(
     int ppq,
     float tempoBpm,
     const ExtractionSettings& settings) const {
+    ExtractionScratch scratch;
+    return extractGroove(notes, ppq, tempoBpm, settings, scratch);
+}
+
+GrooveTemplate GrooveEngine::extractGroove(
+    const std::vector<MidiNote>& notes,
+    int ppq,
+    float tempoBpm,
+    const ExtractionSettings& settings,
+    ExtractionScratch& scratch) const {
     
     GrooveTemplate tmpl;
     tmpl.setPpq(ppq);
@@ -257,8 +315,15 @@ GrooveTemplate GrooveEngine::extractGroove(
     int ticksPerGrid = ppq * 4 / settings.quantizeResolution;
     
     // Extract timing deviations
-    std::vector<float> deviations;
-    std::vector<int> velocities;
+    std::vector<float>& deviations = scratch.deviations;
+    std::vector<int>& velocities = scratch.velocities;
+    deviations.clear();
+    velocities.clear();
+    deviations.reserve(notes.size());
+    velocities.reserve(notes.size());
+    
+    std::vector<NoteEvent> events;
+    events.reserve(notes.size());
     int ghostCount = 0;
     int accentCount = 0;
     
@@ -285,9 +350,10 @@ GrooveTemplate GrooveEngine::extractGroove(
         event.deviationTicks = deviation;
         event.isGhost = (note.velocity < settings.ghostThreshold);
         event.isAccent = (note.velocity > settings.accentThreshold);
-        tmpl.addEvent(event);
+        events.push_back(event);
     }
     
+    tmpl.setEvents(events);
     tmpl.setTimingDeviations(deviations);
     
     // Calculate swing factor
@@ -352,7 +418,8 @@ GrooveTemplate GrooveEngine::extractGroove(
     }
     
     std::vector<int> velocityCurve(totalBeats, 0);
-    std::vector<int> noteCounts(totalBeats, 0);
+    std::vector<int>& noteCounts = scratch.noteCounts;
+    noteCounts.assign(totalBeats, 0);
     
     for (const auto& note : notes) {
         int beat = note.startTick / ppq;
@@ -373,6 +440,59 @@ GrooveTemplate GrooveEngine::extractGroove(
     return tmpl;
 }
 
+std::vector<GrooveTemplate> GrooveEngine::extractGrooveBatch(
+    const std::vector<std::vector<MidiNote>>& noteSets,
+    int ppq,
+    float tempoBpm,
+    const ExtractionSettings& settings,
+    size_t numThreads) const {
+    
+    std::vector<GrooveTemplate> results(noteSets.size());
+    
+    ThreadPool& pool = ThreadPool::shared();
+    
+    // Each result slot is written by exactly one task, so order is deterministic
+    std::vector<ExtractionScratch> scratch(pool.workerCount(numThreads));
+    pool.parallelFor(noteSets.size(), [&](size_t index, size_t worker) {
+        results[index] = extractGroove(noteSets[index], ppq, tempoBpm, settings, scratch[worker]);
+    }, numThreads);
+    
+    return results;
+}
+
+std::vector<FileGrooveResult> GrooveEngine::extractGrooveFromFiles(
+    const std::vector<std::string>& paths,
+    const ExtractionSettings& settings,
+    size_t numThreads) const {
+    
+    std::vector<FileGrooveResult> results(paths.size());
+    
+    ThreadPool& pool = ThreadPool::shared();
+    
+    struct WorkerScratch {
+        ExtractionScratch extraction;
+        MidiFileNotes file;
+    };
+    std::vector<WorkerScratch> scratch(pool.workerCount(numThreads));
+    
+    pool.parallelFor(paths.size(), [&](size_t index, size_t worker) {
+        WorkerScratch& ws = scratch[worker];
+        FileGrooveResult& result = results[index];
+        
+        if (!loadMidiFileNotes(paths[index], ws.file)) {
+            return;
+        }
+        
+        result.groove = extractGroove(ws.file.notes, ws.file.ppq, ws.file.tempoBpm,
+                                      settings, ws.extraction);
+        result.groove.setName(std::filesystem::path(paths[index]).stem().string());
+        result.groove.setSourceFile(paths[index]);
+        result.ok = true;
+    }, numThreads);
+    
+    return results;
+}
+
 void GrooveEngine::applyGroove(
     std::vector<MidiNote>& notes,
     const GrooveTemplate& groove,
@@ -420,50 +540,140 @@ void GrooveEngine::applyGroove(
     }
 }
 
-void GrooveEngine::humanize(
-    std::vector<MidiNote>& notes,
-    float complexity,
-    float vulnerability,
+void GrooveEngine::applyGroove(
+    NoteBuffer& notes,
+    const GrooveTemplate& groove,
     int ppq,
-    int seed) const {
+    const ApplicationSettings& settings) const {
     
-    if (notes.empty()) {
+    const size_t count = notes.size();
+    if (count == 0 || !groove.isValid()) {
         return;
     }
     
-    std::mt19937 rng;
-    if (seed >= 0) {
-        rng.seed(static_cast<unsigned int>(seed));
-    } else {
-        std::random_device rd;
-        rng.seed(rd());
+    int64_t* ticks = notes.startTicks();
+    
+    // Apply timing deviations: the template repeats every deviations.size() notes,
+    // so build one period of offsets and tile it across the scratch lane
+    const auto& deviations = groove.timingDeviations();
+    if (settings.applyTiming && !deviations.empty()) {
+        int16_t* offsets = notes.offsetScratch();
+        const size_t period = std::min(deviations.size(), count);
+        
+        for (size_t i = 0; i < period; i++) {
+            float deviation = deviations[i] * settings.intensity;
+            int offset = static_cast<int>(deviation * settings.intensity);
+            offsets[i] = static_cast<int16_t>(std::clamp(offset, -32768, 32767));
+        }
+        for (size_t filled = period; filled < count;) {
+            size_t chunk = std::min(filled, count - filled);
+            std::memcpy(offsets + filled, offsets, chunk * sizeof(int16_t));
+            filled += chunk;
+        }
+        
+        daiw::simd::apply_timing_offsets(ticks, offsets, count);
+        daiw::simd::clamp_ticks_min(ticks, 0, count);
+    }
+    
+    const auto& velocityCurve = groove.velocityCurve();
+    const bool applyVelocity = settings.applyVelocity && !velocityCurve.empty();
+    const bool applySwing = settings.applySwing && groove.swingFactor() != 0.5f;
+    if (!applyVelocity && !applySwing) {
+        return;
     }
     
-    // Calculate timing range based on complexity
-    float maxTimingDeviation = complexity * 30.0f;  // Up to 30 ticks at max complexity
+    // One pass for the per-beat lookups: velocity targets use the position
+    // before swing, as in the vector overload
+    uint8_t* targets = notes.velocityScratch();
+    const int eighthNoteTicks = ppq / 2;
+    const double swingWindow = ppq * 0.15;
+    const int swingOffset = static_cast<int>(
+        (groove.swingFactor() - 0.5f) * eighthNoteTicks * 2.0f * settings.intensity);
+    
+    // Ticks are non-negative here and fit 32 bits in practice; unsigned 32-bit
+    // division is several times cheaper than signed 64-bit
+    const uint32_t ppqU = static_cast<uint32_t>(ppq);
+    const uint32_t curveSize = static_cast<uint32_t>(velocityCurve.size());
+    
+    for (size_t i = 0; i < count; i++) {
+        const bool narrow = ticks[i] >= 0 && ticks[i] <= UINT32_MAX;
+        const int64_t beat = narrow
+            ? static_cast<int64_t>(static_cast<uint32_t>(ticks[i]) / ppqU)
+            : ticks[i] / ppq;
+        
+        if (applyVelocity) {
+            size_t curveIndex = static_cast<uint64_t>(beat) < curveSize
+                ? static_cast<size_t>(beat)
+                : (narrow ? static_cast<uint32_t>(beat) % curveSize
+                          : static_cast<size_t>(beat % curveSize));
+            targets[i] = static_cast<uint8_t>(std::clamp(velocityCurve[curveIndex], 0, 255));
+        }
+        
+        if (applySwing) {
+            int64_t positionInBeat = ticks[i] - beat * ppq;
+            if (std::abs(positionInBeat - eighthNoteTicks) < swingWindow) {
+                ticks[i] += swingOffset;
+            }
+        }
+    }
     
-    // Calculate velocity range based on vulnerability
-    float velocityRange = vulnerability * 20.0f;  // ±20 velocity at max vulnerability
+    if (applyVelocity) {
+        daiw::simd::blend_velocities(notes.velocities(), targets, settings.intensity, count);
+    }
+}
+
+void GrooveEngine::humanize(
+    std::vector<MidiNote>& notes,
+    float complexity,
+    float vulnerability,
+    int ppq,
+    int seed,
+    size_t firstNoteIndex) const {
     
-    std::normal_distribution<float> timingDist(0.0f, maxTimingDeviation / 3.0f);
-    std::normal_distribution<float> velocityDist(0.0f, velocityRange / 3.0f);
+    if (notes.empty()) {
+        return;
+    }
     
-    // Human latency bias (slightly behind the beat)
-    float latencyBias = 5.0f * complexity;
+    const HumanizeDraws draws(complexity, vulnerability, seed);
     
-    for (auto& note : notes) {
-        // Apply timing humanization
-        float timingOffset = timingDist(rng) + latencyBias;
-        note.startTick += static_cast<int>(timingOffset);
+    for (size_t i = 0; i < notes.size(); ++i) {
+        MidiNote& note = notes[i];
+        const uint64_t index = firstNoteIndex + i;
+        
+        note.startTick += draws.timingOffset(index);
         if (note.startTick < 0) note.startTick = 0;
         
-        // Apply velocity humanization
-        float velocityOffset = velocityDist(rng);
-        note.velocity += static_cast<int>(velocityOffset);
+        note.velocity += draws.velocityOffset(index);
         note.velocity = std::clamp(note.velocity, MIN_VELOCITY, MAX_VELOCITY);
     }
 }
 
+void GrooveEngine::humanize(
+    NoteBuffer& notes,
+    float complexity,
+    float vulnerability,
+    int ppq,
+    int seed,
+    size_t firstNoteIndex) const {
+    
+    const size_t count = notes.size();
+    if (count == 0) {
+        return;
+    }
+    
+    const HumanizeDraws draws(complexity, vulnerability, seed);
+    int64_t* ticks = notes.startTicks();
+    uint8_t* velocities = notes.velocities();
+    
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t index = firstNoteIndex + i;
+        ticks[i] += draws.timingOffset(index);
+        velocities[i] = static_cast<uint8_t>(std::clamp(
+            velocities[i] + draws.velocityOffset(index), MIN_VELOCITY, MAX_VELOCITY));
+    }
+    daiw::simd::clamp_ticks_min(ticks, 0, count);
+}
+
 float GrooveEngine::calculateSwing(const std::vector<MidiNote>& notes, int ppq) const {
     if (notes.size() < 4) {
         return 0.5f;  // Default straight
@@ -471,29 +681,23 @@ float GrooveEngine::calculateSwing(const std::vector<MidiNote>& notes, int ppq)
     
     int eighthNoteTicks = ppq / 2;
     
-    std::vector<MidiNote> offBeatNotes;
+    // Average offset of off-beat notes (near middle of beat)
+    float sumOffset = 0.0f;
+    int offBeatCount = 0;
     for (const auto& note : notes) {
         int positionInBeat = note.startTick % ppq;
         
-        // Off-beat (near middle of beat)
         if (std::abs(positionInBeat - eighthNoteTicks) < ppq * 0.15) {
-            offBeatNotes.push_back(note);
+            sumOffset += static_cast<float>(positionInBeat - eighthNoteTicks) / eighthNoteTicks;
+            offBeatCount++;
         }
     }
     
-    if (offBeatNotes.empty()) {
+    if (offBeatCount == 0) {
         return 0.5f;
     }
     
-    // Calculate average offset of off-beat notes
-    float sumOffset = 0.0f;
-    for (const auto& note : offBeatNotes) {
-        int positionInBeat = note.startTick % ppq;
-        float offset = static_cast<float>(positionInBeat - eighthNoteTicks) / eighthNoteTicks;
-        sumOffset += offset;
-    }
-    
-    float avgOffset = sumOffset / offBeatNotes.size();
+    float avgOffset = sumOffset / offBeatCount;
     
     // Normalize to 0.0-1.0 range
     return std::clamp(avgOffset + 0.5f, 0.0f, 1.0f);
@@ -0,0 +1,503 @@
+/**
+ * GrooveLibrary.cpp - Binary groove template library format
+ */
+
+#include "groove/GrooveLibrary.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+#if defined(_WIN32) || defined(_WIN64)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace iDAW {
+namespace groove {
+
+namespace {
+
+constexpr size_t ALIGNMENT = 8;
+
+size_t alignUp(size_t value) noexcept {
+    return (value + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+/** [offset, offset + count * elementSize) lies inside size bytes and is aligned */
+bool arrayInBounds(uint64_t offset, uint64_t count, size_t elementSize, size_t alignment,
+                   size_t size) noexcept {
+    if (count == 0) return true;
+    if (offset > size || offset % alignment != 0) return false;
+    return count <= (size - offset) / elementSize;
+}
+
+/** Temporary file for one save: unique across processes and across saves in this one */
+std::string uniqueTempPath(const std::string& path) {
+    static std::atomic<uint64_t> saveCounter{0};
+#if defined(_WIN32) || defined(_WIN64)
+    const auto pid = static_cast<unsigned long>(GetCurrentProcessId());
+#else
+    const auto pid = static_cast<long>(getpid());
+#endif
+    return path + ".tmp." + std::to_string(pid) + "." +
+           std::to_string(saveCounter.fetch_add(1, std::memory_order_relaxed));
+}
+
+template<typename T>
+void writeArray(std::vector<uint8_t>& image, size_t offset, const T* data, size_t count) {
+    if (count > 0) {
+        std::memcpy(image.data() + offset, data, count * sizeof(T));
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Writer
+// ============================================================================
+
+std::vector<uint8_t> serializeGrooveLibrary(const std::vector<GrooveTemplate>& grooves) {
+    using namespace binary;
+
+    // Lay out the file: header, directory, payload arrays, string table
+    size_t offset = alignUp(sizeof(FileHeader));
+    const size_t directoryOffset = offset;
+    offset += grooves.size() * sizeof(GrooveRecord);
+
+    std::vector<GrooveRecord> records(grooves.size());
+    std::string strings;
+
+    for (size_t i = 0; i < grooves.size(); ++i) {
+        const GrooveTemplate& groove = grooves[i];
+        GrooveRecord& rec = records[i];
+        std::memset(&rec, 0, sizeof(rec));
+
+        rec.nameOffset = static_cast<uint32_t>(strings.size());
+        rec.nameLength = static_cast<uint32_t>(groove.name().size());
+        strings += groove.name();
+        rec.sourceFileOffset = static_cast<uint32_t>(strings.size());
+        rec.sourceFileLength = static_cast<uint32_t>(groove.sourceFile().size());
+        strings += groove.sourceFile();
+
+        rec.ppq = groove.ppq();
+        rec.tempoBpm = groove.tempoBpm();
+        rec.timeSignatureNum = groove.timeSignature().first;
+        rec.timeSignatureDenom = groove.timeSignature().second;
+        rec.swingFactor = groove.swingFactor();
+
+        const VelocityStats& vs = groove.velocityStats();
+        rec.velocityMin = vs.min;
+        rec.velocityMax = vs.max;
+        rec.velocityMean = vs.mean;
+        rec.velocityStdDev = vs.stdDev;
+        rec.ghostCount = vs.ghostCount;
+        rec.accentCount = vs.accentCount;
+
+        const TimingStats& ts = groove.timingStats();
+        rec.meanDeviationTicks = ts.meanDeviationTicks;
+        rec.meanDeviationMs = ts.meanDeviationMs;
+        rec.maxDeviationTicks = ts.maxDeviationTicks;
+        rec.maxDeviationMs = ts.maxDeviationMs;
+        rec.stdDeviationTicks = ts.stdDeviationTicks;
+        rec.stdDeviationMs = ts.stdDeviationMs;
+
+        offset = alignUp(offset);
+        rec.deviationsOffset = offset;
+        rec.deviationCount = static_cast<uint32_t>(groove.timingDeviations().size());
+        offset += rec.deviationCount * sizeof(float);
+
+        offset = alignUp(offset);
+        rec.velocityCurveOffset = offset;
+        rec.velocityCurveCount = static_cast<uint32_t>(groove.velocityCurve().size());
+        offset += rec.velocityCurveCount * sizeof(int32_t);
+
+        offset = alignUp(offset);
+        rec.eventsOffset = offset;
+        rec.eventCount = static_cast<uint32_t>(groove.events().size());
+        offset += rec.eventCount * sizeof(EventRecord);
+    }
+
+    offset = alignUp(offset);
+    const size_t stringTableOffset = offset;
+    const size_t fileSize = alignUp(stringTableOffset + strings.size());
+
+    std::vector<uint8_t> image(fileSize, 0);
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(FileHeader);
+    header.grooveCount = static_cast<uint32_t>(grooves.size());
+    header.recordSize = sizeof(GrooveRecord);
+    header.eventSize = sizeof(EventRecord);
+    header.endianCheck = ENDIAN_CHECK;
+    header.directoryOffset = directoryOffset;
+    header.stringTableOffset = stringTableOffset;
+    header.stringTableSize = strings.size();
+    header.fileSize = fileSize;
+    std::memcpy(image.data(), &header, sizeof(header));
+
+    writeArray(image, directoryOffset, records.data(), records.size());
+
+    std::vector<EventRecord> events;
+    for (size_t i = 0; i < grooves.size(); ++i) {
+        const GrooveTemplate& groove = grooves[i];
+        const GrooveRecord& rec = records[i];
+
+        writeArray(image, rec.deviationsOffset, groove.timingDeviations().data(), rec.deviationCount);
+
+        static_assert(sizeof(int) == sizeof(int32_t), "Velocity curve is stored as int32");
+        writeArray(image, rec.velocityCurveOffset, groove.velocityCurve().data(), rec.velocityCurveCount);
+
+        events.resize(groove.events().size());
+        for (size_t e = 0; e < events.size(); ++e) {
+            const NoteEvent& src = groove.events()[e];
+            EventRecord& dst = events[e];
+            dst.pitch = src.pitch;
+            dst.velocity = src.velocity;
+            dst.startTick = src.startTick;
+            dst.durationTicks = src.durationTicks;
+            dst.channel = src.channel;
+            dst.deviationTicks = src.deviationTicks;
+            dst.flags = (src.isGhost ? EVENT_GHOST : 0u) | (src.isAccent ? EVENT_ACCENT : 0u);
+            dst.reserved = 0;
+        }
+        writeArray(image, rec.eventsOffset, events.data(), events.size());
+    }
+
+    writeArray(image, stringTableOffset, strings.data(), strings.size());
+    return image;
+}
+
+bool saveGrooveLibrary(const std::string& path, const std::vector<GrooveTemplate>& grooves) {
+    const std::vector<uint8_t> image = serializeGrooveLibrary(grooves);
+    const std::string tempPath = uniqueTempPath(path);
+
+    bool written = false;
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file.write(reinterpret_cast<const char*>(image.data()),
+                   static_cast<std::streamsize>(image.size()));
+        written = static_cast<bool>(file);
+    }
+
+    std::error_code ec;
+    if (written) std::filesystem::rename(tempPath, path, ec);
+    if (!written || ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+std::optional<std::vector<GrooveTemplate>> loadGrooveLibrary(const std::string& path) {
+    GrooveLibraryFile library;
+    if (!library.open(path)) {
+        return std::nullopt;
+    }
+    return library.loadAll();
+}
+
+// ============================================================================
+// Reader
+// ============================================================================
+
+GrooveLibraryFile::~GrooveLibraryFile() {
+    close();
+}
+
+GrooveLibraryFile::GrooveLibraryFile(GrooveLibraryFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+GrooveLibraryFile& GrooveLibraryFile::operator=(GrooveLibraryFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        m_base = std::exchange(other.m_base, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_header = std::exchange(other.m_header, nullptr);
+        m_records = std::exchange(other.m_records, nullptr);
+        m_strings = std::exchange(other.m_strings, nullptr);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+        m_mappingSize = std::exchange(other.m_mappingSize, 0);
+#if defined(_WIN32) || defined(_WIN64)
+        m_fileHandle = std::exchange(other.m_fileHandle, nullptr);
+        m_mapHandle = std::exchange(other.m_mapHandle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+bool GrooveLibraryFile::open(const std::string& path) {
+    close();
+
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_mapHandle = mapping;
+    m_mapping = view;
+    m_mappingSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    const size_t fileSize = static_cast<size_t>(st.st_size);
+    void* view = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file alive
+    if (view == MAP_FAILED) return false;
+
+    m_mapping = view;
+    m_mappingSize = fileSize;
+#endif
+
+    if (!validate(static_cast<const uint8_t*>(m_mapping), m_mappingSize)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool GrooveLibraryFile::openFromMemory(const void* data, size_t size) {
+    close();
+    if (data == nullptr || reinterpret_cast<uintptr_t>(data) % ALIGNMENT != 0) {
+        return false;
+    }
+    return validate(static_cast<const uint8_t*>(data), size);
+}
+
+void GrooveLibraryFile::close() noexcept {
+    unmap();
+    m_base = nullptr;
+    m_size = 0;
+    m_header = nullptr;
+    m_records = nullptr;
+    m_strings = nullptr;
+}
+
+void GrooveLibraryFile::unmap() noexcept {
+    if (m_mapping == nullptr) return;
+
+#if defined(_WIN32) || defined(_WIN64)
+    UnmapViewOfFile(m_mapping);
+    CloseHandle(static_cast<HANDLE>(m_mapHandle));
+    CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    m_mapHandle = nullptr;
+    m_fileHandle = nullptr;
+#else
+    ::munmap(m_mapping, m_mappingSize);
+#endif
+
+    m_mapping = nullptr;
+    m_mappingSize = 0;
+}
+
+bool GrooveLibraryFile::validate(const uint8_t* base, size_t size) noexcept {
+    using namespace binary;
+
+    if (size < sizeof(FileHeader)) return false;
+
+    const auto* header = reinterpret_cast<const FileHeader*>(base);
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) return false;
+    if (header->endianCheck != ENDIAN_CHECK) return false;
+    if (header->version == 0 || header->version > VERSION) return false;
+    if (header->headerSize < sizeof(FileHeader)) return false;
+    if (header->recordSize != sizeof(GrooveRecord) || header->eventSize != sizeof(EventRecord)) {
+        return false;
+    }
+    if (header->fileSize > size) return false;
+
+    const size_t fileSize = static_cast<size_t>(header->fileSize);
+    if (!arrayInBounds(header->directoryOffset, header->grooveCount, sizeof(GrooveRecord),
+                       alignof(GrooveRecord), fileSize) ||
+        !arrayInBounds(header->stringTableOffset, header->stringTableSize, 1, 1, fileSize)) {
+        return false;
+    }
+
+    const auto* records = reinterpret_cast<const GrooveRecord*>(base + header->directoryOffset);
+    for (uint32_t i = 0; i < header->grooveCount; ++i) {
+        const GrooveRecord& rec = records[i];
+        const uint64_t nameEnd = uint64_t{rec.nameOffset} + rec.nameLength;
+        const uint64_t sourceEnd = uint64_t{rec.sourceFileOffset} + rec.sourceFileLength;
+        if (nameEnd > header->stringTableSize || sourceEnd > header->stringTableSize) return false;
+
+        if (!arrayInBounds(rec.deviationsOffset, rec.deviationCount, sizeof(float),
+                           alignof(float), fileSize) ||
+            !arrayInBounds(rec.velocityCurveOffset, rec.velocityCurveCount, sizeof(int32_t),
+                           alignof(int32_t), fileSize) ||
+            !arrayInBounds(rec.eventsOffset, rec.eventCount, sizeof(EventRecord),
+                           alignof(EventRecord), fileSize)) {
+            return false;
+        }
+    }
+
+    m_base = base;
+    m_size = fileSize;
+    m_header = header;
+    m_records = records;
+    m_strings = reinterpret_cast<const char*>(base + header->stringTableOffset);
+    return true;
+}
+
+std::string_view GrooveLibraryFile::name(size_t index) const noexcept {
+    const auto& rec = m_records[index];
+    return {m_strings + rec.nameOffset, rec.nameLength};
+}
+
+std::string_view GrooveLibraryFile::sourceFile(size_t index) const noexcept {
+    const auto& rec = m_records[index];
+    return {m_strings + rec.sourceFileOffset, rec.sourceFileLength};
+}
+
+ArrayView<float> GrooveLibraryFile::timingDeviations(size_t index) const noexcept {
+    const auto& rec = m_records[index];
+    return {reinterpret_cast<const float*>(m_base + rec.deviationsOffset), rec.deviationCount};
+}
+
+ArrayView<int32_t> GrooveLibraryFile::velocityCurve(size_t index) const noexcept {
+    const auto& rec = m_records[index];
+    return {reinterpret_cast<const int32_t*>(m_base + rec.velocityCurveOffset), rec.velocityCurveCount};
+}
+
+ArrayView<binary::EventRecord> GrooveLibraryFile::events(size_t index) const noexcept {
+    const auto& rec = m_records[index];
+    return {reinterpret_cast<const binary::EventRecord*>(m_base + rec.eventsOffset), rec.eventCount};
+}
+
+int GrooveLibraryFile::indexOf(std::string_view grooveName) const noexcept {
+    for (size_t i = 0; i < size(); ++i) {
+        if (name(i) == grooveName) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+GrooveTemplate GrooveLibraryFile::toTemplate(size_t index) const {
+    const binary::GrooveRecord& rec = m_records[index];
+
+    GrooveTemplate groove{std::string(name(index)), std::string(sourceFile(index))};
+    groove.setPpq(rec.ppq);
+    groove.setTempoBpm(rec.tempoBpm);
+    groove.setTimeSignature(rec.timeSignatureNum, rec.timeSignatureDenom);
+    groove.setSwingFactor(rec.swingFactor);
+
+    VelocityStats vs;
+    vs.min = rec.velocityMin;
+    vs.max = rec.velocityMax;
+    vs.mean = rec.velocityMean;
+    vs.stdDev = rec.velocityStdDev;
+    vs.ghostCount = rec.ghostCount;
+    vs.accentCount = rec.accentCount;
+    groove.setVelocityStats(vs);
+
+    TimingStats ts;
+    ts.meanDeviationTicks = rec.meanDeviationTicks;
+    ts.meanDeviationMs = rec.meanDeviationMs;
+    ts.maxDeviationTicks = rec.maxDeviationTicks;
+    ts.maxDeviationMs = rec.maxDeviationMs;
+    ts.stdDeviationTicks = rec.stdDeviationTicks;
+    ts.stdDeviationMs = rec.stdDeviationMs;
+    groove.setTimingStats(ts);
+
+    const auto deviations = timingDeviations(index);
+    groove.setTimingDeviations(std::vector<float>(deviations.begin(), deviations.end()));
+
+    const auto curve = velocityCurve(index);
+    groove.setVelocityCurve(std::vector<int>(curve.begin(), curve.end()));
+
+    const auto records = events(index);
+    std::vector<NoteEvent> noteEvents(records.size);
+    for (size_t e = 0; e < records.size; ++e) {
+        const binary::EventRecord& src = records[e];
+        NoteEvent& dst = noteEvents[e];
+        dst.pitch = src.pitch;
+        dst.velocity = src.velocity;
+        dst.startTick = src.startTick;
+        dst.durationTicks = src.durationTicks;
+        dst.channel = src.channel;
+        dst.deviationTicks = src.deviationTicks;
+        dst.isGhost = (src.flags & binary::EVENT_GHOST) != 0;
+        dst.isAccent = (src.flags & binary::EVENT_ACCENT) != 0;
+    }
+    groove.setEvents(noteEvents);
+
+    return groove;
+}
+
+std::vector<GrooveTemplate> GrooveLibraryFile::loadAll() const {
+    std::vector<GrooveTemplate> grooves;
+    grooves.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        grooves.push_back(toTemplate(i));
+    }
+    return grooves;
+}
+
+// ============================================================================
+// GrooveTemplate binary helpers
+// ============================================================================
+
+std::vector<uint8_t> GrooveTemplate::toBinary() const {
+    return serializeGrooveLibrary({*this});
+}
+
+std::optional<GrooveTemplate> GrooveTemplate::fromBinary(const uint8_t* data, size_t size) {
+    if (data == nullptr) return std::nullopt;
+
+    // Callers may hand us unaligned bytes (e.g. from Python); re-align if needed
+    std::vector<uint64_t> aligned;
+    const void* image = data;
+    if (reinterpret_cast<uintptr_t>(data) % ALIGNMENT != 0) {
+        aligned.resize((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        std::memcpy(aligned.data(), data, size);
+        image = aligned.data();
+    }
+
+    GrooveLibraryFile library;
+    if (!library.openFromMemory(image, size) || library.size() == 0) {
+        return std::nullopt;
+    }
+    return library.toTemplate(0);
+}
+
+} // namespace groove
+} // namespace iDAW
@@ -0,0 +1,105 @@
+/**
+ * MidiFileLoader.cpp - Standard MIDI File note loader for groove extraction
+ *
+ * Chunk indexing and event decoding come from the shared daiw streaming
+ * reader; this file only pairs note-ons with note-offs.
+ */
+
+#include "groove/MidiFileLoader.h"
+#include "daiw/midi_stream.hpp"
+#include <algorithm>
+#include <array>
+
+namespace iDAW {
+namespace groove {
+
+namespace {
+
+constexpr int NO_NOTE = -1;
+
+/**
+ * Decode one track, appending completed notes.
+ * openNotes maps channel*128+pitch to the index of a sounding note.
+ */
+void collectTrackNotes(daiw::midi::TrackDecoder decoder, MidiFileNotes& out,
+                       std::array<int, 16 * 128>& openNotes, bool& tempoFound) {
+    openNotes.fill(NO_NOTE);
+
+    auto closeNote = [&](int key, daiw::Tick tick) {
+        if (openNotes[key] != NO_NOTE) {
+            MidiNote& note = out.notes[openNotes[key]];
+            note.durationTicks = std::max(1, static_cast<int>(tick) - note.startTick);
+            openNotes[key] = NO_NOTE;
+        }
+    };
+
+    daiw::MidiEvent event;
+    while (decoder.next(event)) {
+        const int type = event.status & 0xF0;
+        if (type != 0x80 && type != 0x90) continue;
+
+        const int channel = event.status & 0x0F;
+        const int pitch = event.data1 & 0x7F;
+        const int velocity = event.data2 & 0x7F;
+        const int key = channel * 128 + pitch;
+
+        closeNote(key, event.timestamp);
+        if (type == 0x90 && velocity > 0) {
+            openNotes[key] = static_cast<int>(out.notes.size());
+            out.notes.push_back({pitch, velocity, static_cast<int>(event.timestamp), 0, channel});
+        }
+    }
+
+    // Notes still sounding at the end of the track end there
+    for (int key = 0; key < 16 * 128; ++key) {
+        closeNote(key, decoder.tick());
+    }
+
+    if (!tempoFound && decoder.tempo() > 0) {
+        out.tempoBpm = 60000000.0f / static_cast<float>(decoder.tempo());
+        tempoFound = true;
+    }
+}
+
+bool collectNotes(const daiw::midi::StreamingFileReader& reader, MidiFileNotes& out) {
+    const uint16_t division = reader.ppq();
+    if ((division & 0x8000) || division == 0) {
+        return false;  // SMPTE time division is not supported
+    }
+    out.ppq = division;
+
+    std::array<int, 16 * 128> openNotes;
+    bool tempoFound = false;
+    for (size_t track = 0; track < reader.num_tracks(); ++track) {
+        collectTrackNotes(reader.track(track), out, openNotes, tempoFound);
+    }
+
+    std::stable_sort(out.notes.begin(), out.notes.end(),
+        [](const MidiNote& a, const MidiNote& b) { return a.startTick < b.startTick; });
+    return true;
+}
+
+void resetNotes(MidiFileNotes& out) {
+    out.notes.clear();
+    out.ppq = 480;
+    out.tempoBpm = 120.0f;
+}
+
+} // namespace
+
+bool parseMidiFileNotes(const uint8_t* data, size_t size, MidiFileNotes& out) {
+    resetNotes(out);
+
+    daiw::midi::StreamingFileReader reader;
+    return reader.open(data, size) && collectNotes(reader, out);
+}
+
+bool loadMidiFileNotes(const std::string& path, MidiFileNotes& out) {
+    resetNotes(out);
+
+    daiw::midi::StreamingFileReader reader;
+    return reader.open(path) && collectNotes(reader, out);
+}
+
+} // namespace groove
+} // namespace iDAW
@@ -0,0 +1,84 @@
+/**
+ * NoteBuffer.cpp - Structure-of-arrays note storage
+ */
+
+#include "groove/NoteBuffer.h"
+#include <algorithm>
+#include <limits>
+
+namespace iDAW {
+namespace groove {
+
+void NoteBuffer::reserve(size_t count) {
+    m_startTicks.reserve(count);
+    m_durations.reserve(count);
+    m_pitches.reserve(count);
+    m_velocities.reserve(count);
+    m_channels.reserve(count);
+    m_offsetScratch.reserve(count);
+    m_velocityScratch.reserve(count);
+}
+
+void NoteBuffer::resize(size_t count) {
+    m_startTicks.resize(count);
+    m_durations.resize(count);
+    m_pitches.resize(count);
+    m_velocities.resize(count);
+    m_channels.resize(count);
+    m_offsetScratch.resize(count);
+    m_velocityScratch.resize(count);
+}
+
+void NoteBuffer::clear() noexcept {
+    m_startTicks.clear();
+    m_durations.clear();
+    m_pitches.clear();
+    m_velocities.clear();
+    m_channels.clear();
+    m_offsetScratch.clear();
+    m_velocityScratch.clear();
+}
+
+void NoteBuffer::push_back(const MidiNote& note) {
+    m_startTicks.push_back(note.startTick);
+    m_durations.push_back(note.durationTicks);
+    m_pitches.push_back(static_cast<uint8_t>(std::clamp(note.pitch, 0, 127)));
+    m_velocities.push_back(static_cast<uint8_t>(std::clamp(note.velocity, 0, 127)));
+    m_channels.push_back(static_cast<uint8_t>(note.channel & 0x0F));
+    m_offsetScratch.push_back(0);
+    m_velocityScratch.push_back(0);
+}
+
+void NoteBuffer::assign(const std::vector<MidiNote>& notes) {
+    resize(notes.size());
+    for (size_t i = 0; i < notes.size(); ++i) {
+        const MidiNote& note = notes[i];
+        m_startTicks[i] = note.startTick;
+        m_durations[i] = note.durationTicks;
+        m_pitches[i] = static_cast<uint8_t>(std::clamp(note.pitch, 0, 127));
+        m_velocities[i] = static_cast<uint8_t>(std::clamp(note.velocity, 0, 127));
+        m_channels[i] = static_cast<uint8_t>(note.channel & 0x0F);
+    }
+}
+
+MidiNote NoteBuffer::note(size_t index) const noexcept {
+    MidiNote note;
+    note.pitch = m_pitches[index];
+    note.velocity = m_velocities[index];
+    // Kernels may push a tick past the int range of MidiNote; saturate instead of wrapping
+    note.startTick = static_cast<int>(std::clamp<int64_t>(m_startTicks[index],
+        std::numeric_limits<int>::min(), std::numeric_limits<int>::max()));
+    note.durationTicks = m_durations[index];
+    note.channel = m_channels[index];
+    return note;
+}
+
+void NoteBuffer::copyTo(std::vector<MidiNote>& out) const {
+    out.resize(size());
+    for (size_t i = 0; i < size(); ++i) {
+        out[i] = note(i);
+    }
+}
+
+} // namespace groove
+} // namespace iDAW
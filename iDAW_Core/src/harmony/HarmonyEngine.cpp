@@ -6,7 +6,7 @@
 #include "harmony/Chord.h"
 #include "harmony/Progression.h"
 #include <algorithm>
-#include <regex>
+#include <array>
 #include <sstream>
 #include <cctype>
 #include <cmath>
@@ -98,7 +98,7 @@ Chord::Chord(const std::vector<int>& midiNotes) {
     m_notes = midiNotes;
 }
 
-std::optional<Chord> Chord::fromString(const std::string& chordStr) {
+std::optional<Chord> Chord::fromString(std::string_view chordStr) {
     return parseChordString(chordStr);
 }
 
@@ -152,143 +152,155 @@ std::vector<int> Chord::midiNotes(int octave) const {
 // Chord Parsing
 // ============================================================================
 
-// Flat to sharp conversion
-static const std::map<std::string, std::string> FLAT_TO_SHARP = {
-    {"Db", "C#"}, {"Eb", "D#"}, {"Fb", "E"}, {"Gb", "F#"},
-    {"Ab", "G#"}, {"Bb", "A#"}, {"Cb", "B"}
-};
+namespace {
 
-std::optional<Chord> parseChordString(const std::string& chordStr) {
-    if (chordStr.empty()) {
-        return std::nullopt;
-    }
-    
-    std::string str = chordStr;
-    
-    // Handle slash chords
-    int bass = -1;
-    size_t slashPos = str.find('/');
-    if (slashPos != std::string::npos && slashPos < str.length() - 1) {
-        std::string bassStr = str.substr(slashPos + 1);
-        str = str.substr(0, slashPos);
-        
-        // Parse bass note
-        if (!bassStr.empty()) {
-            char bassRoot = std::toupper(bassStr[0]);
-            if (bassRoot >= 'A' && bassRoot <= 'G') {
-                int bassIdx = 0;
-                for (size_t i = 0; i < 12; i++) {
-                    if (NOTE_NAMES[i][0] == bassRoot) {
-                        bassIdx = i;
-                        break;
-                    }
-                }
-                if (bassStr.length() > 1) {
-                    if (bassStr[1] == '#') bassIdx = (bassIdx + 1) % 12;
-                    else if (bassStr[1] == 'b') bassIdx = (bassIdx + 11) % 12;
-                }
-                bass = bassIdx;
-            }
-        }
-    }
-    
-    // Extract root
-    if (str.empty()) return std::nullopt;
-    
-    char rootChar = std::toupper(str[0]);
-    if (rootChar < 'A' || rootChar > 'G') return std::nullopt;
-    
-    size_t rootLen = 1;
-    int rootIdx = 0;
-    
-    // Find root in note names
-    for (size_t i = 0; i < 12; i++) {
-        if (NOTE_NAMES[i][0] == rootChar) {
-            rootIdx = i;
-            break;
-        }
-    }
-    
-    // Check for sharp/flat
-    if (str.length() > 1) {
+// Progression delimiters: '-', whitespace, '|', ',' and the UTF-8 bytes of
+// en/em dashes (E2 80 93, E2 80 94), each byte a delimiter on its own
+constexpr std::array<bool, 256> makeDelimiterTable() {
+    std::array<bool, 256> table{};
+    for (unsigned char c : {'-', ' ', '\t', '\n', '\v', '\f', '\r', '|', ','}) table[c] = true;
+    for (unsigned char c : {0xE2, 0x80, 0x93, 0x94}) table[c] = true;
+    return table;
+}
+
+constexpr std::array<bool, 256> DELIMITERS = makeDelimiterTable();
+
+inline bool isDelimiter(char c) noexcept {
+    return DELIMITERS[static_cast<unsigned char>(c)];
+}
+
+inline bool startsWith(std::string_view str, std::string_view prefix) noexcept {
+    return str.substr(0, prefix.size()) == prefix;
+}
+
+/** Pitch class of a note letter (either case), -1 if not A - G */
+inline int letterPitchClass(char letter) noexcept {
+    static constexpr int PITCH_CLASSES[7] = {9, 11, 0, 2, 4, 5, 7};  // A - G
+    const char upper = (letter >= 'a' && letter <= 'z') ? static_cast<char>(letter - 'a' + 'A') : letter;
+    return (upper >= 'A' && upper <= 'G') ? PITCH_CLASSES[upper - 'A'] : -1;
+}
+
+/**
+ * Note letter with an optional '#' / 'b'
+ * @return Pitch class, -1 if str does not start with a note
+ */
+int parseNote(std::string_view str, size_t& length) noexcept {
+    length = 0;
+    if (str.empty()) return -1;
+
+    int pitchClass = letterPitchClass(str[0]);
+    if (pitchClass < 0) return -1;
+
+    length = 1;
+    if (str.size() > 1) {
         if (str[1] == '#') {
-            rootIdx = (rootIdx + 1) % 12;
-            rootLen = 2;
+            pitchClass = (pitchClass + 1) % 12;
+            length = 2;
         } else if (str[1] == 'b') {
-            rootIdx = (rootIdx + 11) % 12;
-            rootLen = 2;
+            pitchClass = (pitchClass + 11) % 12;
+            length = 2;
         }
     }
-    
-    std::string remainder = str.substr(rootLen);
-    
-    // Parse quality
-    ChordQuality quality = ChordQuality::Major;
-    
-    // Check for major7 first (before minor check)
-    if (remainder.rfind("maj7", 0) == 0 || remainder.rfind("Maj7", 0) == 0 || 
-        remainder.rfind("M7", 0) == 0) {
-        quality = ChordQuality::Major7;
+    return pitchClass;
+}
+
+/**
+ * Quality from the symbol text after the root. Dispatches on the first
+ * character, then checks the few suffixes that start with it.
+ */
+ChordQuality parseQuality(std::string_view suffix) noexcept {
+    if (suffix.empty()) return ChordQuality::Major;
+
+    // Minor and diminished sevenths are recognized by a 7 anywhere
+    const bool hasSeventh = suffix.find('7') != std::string_view::npos;
+
+    switch (suffix[0]) {
+        case 'm':
+            if (startsWith(suffix, "maj7")) return ChordQuality::Major7;
+            if (startsWith(suffix, "maj")) return ChordQuality::Major;
+            return hasSeventh ? ChordQuality::Minor7 : ChordQuality::Minor;
+        case 'M':
+            if (startsWith(suffix, "M7") || startsWith(suffix, "Maj7")) return ChordQuality::Major7;
+            return ChordQuality::Major;
+        case '-':
+            return hasSeventh ? ChordQuality::Minor7 : ChordQuality::Minor;
+        case 'd':
+            if (!startsWith(suffix, "dim")) return ChordQuality::Major;
+            return hasSeventh ? ChordQuality::Dim7 : ChordQuality::Diminished;
+        case 'o':
+            return hasSeventh ? ChordQuality::Dim7 : ChordQuality::Diminished;
+        case '+':
+            return ChordQuality::Augmented;
+        case 'a':
+            if (startsWith(suffix, "aug")) return ChordQuality::Augmented;
+            if (startsWith(suffix, "add9")) return ChordQuality::Add9;
+            return ChordQuality::Major;
+        case 's':
+            if (startsWith(suffix, "sus2")) return ChordQuality::Sus2;
+            if (startsWith(suffix, "sus")) return ChordQuality::Sus4;
+            return ChordQuality::Major;
+        case '7':
+            return ChordQuality::Dominant7;
+        case '6':
+            return ChordQuality::Major6;
+        default:
+            return ChordQuality::Major;
     }
-    else if (remainder.rfind("maj", 0) == 0 || remainder.rfind("Maj", 0) == 0) {
-        quality = ChordQuality::Major;
+}
+
+} // namespace
+
+bool ProgressionTokenizer::next(std::string_view& symbol) noexcept {
+    const size_t size = m_text.size();
+    while (m_pos < size && isDelimiter(m_text[m_pos])) ++m_pos;
+    if (m_pos >= size) return false;
+
+    const size_t start = m_pos;
+    while (m_pos < size && !isDelimiter(m_text[m_pos])) ++m_pos;
+    symbol = m_text.substr(start, m_pos - start);
+    return true;
+}
+
+std::optional<Chord> parseChordString(std::string_view chordStr) {
+    if (chordStr.empty()) {
+        return std::nullopt;
     }
-    else if (remainder.rfind("min", 0) == 0 || remainder.rfind("m", 0) == 0 || 
-             remainder[0] == '-') {
-        // Check for min7
-        if (remainder.find("7") != std::string::npos) {
-            quality = ChordQuality::Minor7;
-        } else {
-            quality = ChordQuality::Minor;
-        }
+
+    std::string_view str = chordStr;
+
+    // Handle slash chords (a trailing slash is left in the symbol)
+    int bass = -1;
+    const size_t slashPos = str.find('/');
+    if (slashPos != std::string_view::npos && slashPos < str.size() - 1) {
+        size_t bassLength = 0;
+        bass = parseNote(str.substr(slashPos + 1), bassLength);
+        str = str.substr(0, slashPos);
     }
-    else if (remainder.rfind("dim", 0) == 0 || remainder[0] == 'o') {
-        if (remainder.find("7") != std::string::npos) {
-            quality = ChordQuality::Dim7;
-        } else {
-            quality = ChordQuality::Diminished;
+
+    size_t rootLength = 0;
+    const int root = parseNote(str, rootLength);
+    if (root < 0) return std::nullopt;
+
+    return Chord(root, parseQuality(str.substr(rootLength)), bass);
+}
+
+size_t parseProgressionInto(std::string_view progressionStr, std::vector<Chord>& out) {
+    const size_t before = out.size();
+
+    ProgressionTokenizer tokens(progressionStr);
+    std::string_view symbol;
+    while (tokens.next(symbol)) {
+        if (auto chord = parseChordString(symbol)) {
+            out.push_back(*chord);
         }
     }
-    else if (remainder[0] == '+' || remainder.rfind("aug", 0) == 0) {
-        quality = ChordQuality::Augmented;
-    }
-    else if (remainder.rfind("sus2", 0) == 0) {
-        quality = ChordQuality::Sus2;
-    }
-    else if (remainder.rfind("sus4", 0) == 0 || remainder.rfind("sus", 0) == 0) {
-        quality = ChordQuality::Sus4;
-    }
-    else if (remainder.rfind("7", 0) == 0) {
-        quality = ChordQuality::Dominant7;
-    }
-    else if (remainder.rfind("6", 0) == 0) {
-        quality = ChordQuality::Major6;
-    }
-    else if (remainder.rfind("add9", 0) == 0) {
-        quality = ChordQuality::Add9;
-    }
-    
-    return Chord(rootIdx, quality, bass);
+
+    return out.size() - before;
 }
 
-std::vector<Chord> parseProgressionString(const std::string& progressionStr) {
+std::vector<Chord> parseProgressionString(std::string_view progressionStr) {
     std::vector<Chord> result;
-    
-    // Split by common delimiters
-    std::regex delimRegex("[-–—\\s|,]+");
-    std::sregex_token_iterator it(progressionStr.begin(), progressionStr.end(), delimRegex, -1);
-    std::sregex_token_iterator end;
-    
-    for (; it != end; ++it) {
-        std::string chordStr = it->str();
-        if (!chordStr.empty()) {
-            auto chord = parseChordString(chordStr);
-            if (chord) {
-                result.push_back(*chord);
-            }
-        }
-    }
-    
+    parseProgressionInto(progressionStr, result);
     return result;
 }
 
@@ -307,7 +319,7 @@ Progression::Progression(const std::vector<Chord>& chords)
     }
 }
 
-std::optional<Progression> Progression::fromString(const std::string& progressionStr) {
+std::optional<Progression> Progression::fromString(std::string_view progressionStr) {
     auto chords = parseProgressionString(progressionStr);
     if (chords.empty()) {
         return std::nullopt;
@@ -321,34 +333,37 @@ void Progression::addChord(const Chord& chord) {
 }
 
 Key Progression::detectKey() const {
-    if (m_chords.empty()) {
+    return detectKey(m_chords);
+}
+
+Key Progression::detectKey(const std::vector<Chord>& chords) {
+    if (chords.empty()) {
         return Key{0, Mode::Major};
     }
     
     // Weight first and last chords more heavily
-    std::map<int, float> rootWeights;
-    for (size_t i = 0; i < m_chords.size(); i++) {
+    std::array<float, 12> rootWeights{};
+    for (size_t i = 0; i < chords.size(); i++) {
         float weight = 1.0f;
         if (i == 0) weight = 2.0f;
-        else if (i == m_chords.size() - 1) weight = 1.5f;
+        else if (i == chords.size() - 1) weight = 1.5f;
         
-        int root = m_chords[i].root();
-        rootWeights[root] += weight;
+        rootWeights[chords[i].root() % 12] += weight;
     }
     
-    // Find most weighted root
+    // Find most weighted root (lowest pitch class wins ties)
     int likelyRoot = 0;
     float maxWeight = 0.0f;
-    for (const auto& [root, weight] : rootWeights) {
-        if (weight > maxWeight) {
-            maxWeight = weight;
+    for (int root = 0; root < 12; root++) {
+        if (rootWeights[root] > maxWeight) {
+            maxWeight = rootWeights[root];
             likelyRoot = root;
         }
     }
     
     // Determine mode based on tonic chord quality
     Mode mode = Mode::Major;
-    for (const auto& chord : m_chords) {
+    for (const auto& chord : chords) {
         if (chord.root() == likelyRoot) {
             if (chord.quality() == ChordQuality::Minor ||
                 chord.quality() == ChordQuality::Minor7) {
@@ -552,8 +567,7 @@ Key HarmonyEngine::detectKey(const Progression& progression) const {
 }
 
 Key HarmonyEngine::detectKey(const std::vector<Chord>& chords) const {
-    Progression prog(chords);
-    return prog.detectKey();
+    return Progression::detectKey(chords);
 }
 
 std::string HarmonyEngine::getRomanNumeral(const Chord& chord, const Key& key) const {
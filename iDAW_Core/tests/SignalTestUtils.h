@@ -0,0 +1,51 @@
+/**
+ * SignalTestUtils.h - Test signals and measurements for the plugin DSP tests
+ *
+ * Sine generation, RMS and block-wise driving shared by the engine tests,
+ * so each test file only keeps the helpers specific to its engine.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace iDAW {
+namespace TestSignal {
+
+constexpr double TWO_PI = 6.283185307179586;
+
+/** amplitude * sin(2 pi f t), starting at zero phase */
+inline std::vector<float> sine(int length, double frequency, float amplitude = 1.0f,
+                               double sampleRate = 48000.0) {
+    std::vector<float> signal(static_cast<size_t>(length));
+    for (int i = 0; i < length; ++i) {
+        signal[static_cast<size_t>(i)] =
+            amplitude * static_cast<float>(std::sin(TWO_PI * frequency * i / sampleRate));
+    }
+    return signal;
+}
+
+/** RMS of signal[from, end) */
+inline float rms(const std::vector<float>& signal, size_t from = 0) {
+    double sum = 0.0;
+    for (size_t i = from; i < signal.size(); ++i) sum += static_cast<double>(signal[i]) * signal[i];
+    return static_cast<float>(std::sqrt(sum / static_cast<double>(signal.size() - from)));
+}
+
+/**
+ * Calls process(offset, numSamples) for consecutive blocks covering
+ * [0, length); the last block is short when blockSize does not divide it.
+ */
+template <typename Process>
+void processInBlocks(size_t length, int blockSize, Process&& process) {
+    const size_t block = static_cast<size_t>(blockSize);
+    for (size_t offset = 0; offset < length; offset += block) {
+        process(offset, static_cast<int>(std::min(block, length - offset)));
+    }
+}
+
+} // namespace TestSignal
+} // namespace iDAW
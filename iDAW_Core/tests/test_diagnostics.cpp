@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 #include "diagnostics/DiagnosticsEngine.h"
 #include "harmony/Progression.h"
+#include <algorithm>
 
 using namespace iDAW::diagnostics;
 using namespace iDAW::harmony;
@@ -283,6 +284,114 @@ TEST_F(DiagnosticsTest, FullReport) {
     EXPECT_FALSE(report.ruleBreaks.empty());
 }
 
+// ============================================================================
+// Batch Diagnosis Tests
+// ============================================================================
+
+namespace {
+
+void expectSameReport(const DiagnosticReport& a, const DiagnosticReport& b) {
+    ASSERT_EQ(a.success, b.success);
+    EXPECT_EQ(a.errorMessage, b.errorMessage);
+    ASSERT_EQ(a.issues.size(), b.issues.size());
+    for (size_t i = 0; i < a.issues.size(); i++) {
+        EXPECT_EQ(a.issues[i].description, b.issues[i].description);
+        EXPECT_EQ(a.issues[i].chordInvolved, b.issues[i].chordInvolved);
+        EXPECT_EQ(a.issues[i].chordIndex, b.issues[i].chordIndex);
+    }
+    ASSERT_EQ(a.suggestions.size(), b.suggestions.size());
+    for (size_t i = 0; i < a.suggestions.size(); i++) {
+        EXPECT_EQ(a.suggestions[i].description, b.suggestions[i].description);
+        EXPECT_EQ(a.suggestions[i].priority, b.suggestions[i].priority);
+    }
+    if (!a.success) return;
+    
+    EXPECT_EQ(a.detectedKey, b.detectedKey);
+    EXPECT_EQ(a.chordNames, b.chordNames);
+    EXPECT_EQ(a.romanNumerals, b.romanNumerals);
+    EXPECT_EQ(a.borrowedChords, b.borrowedChords);
+    ASSERT_EQ(a.ruleBreaks.size(), b.ruleBreaks.size());
+    for (size_t i = 0; i < a.ruleBreaks.size(); i++) {
+        EXPECT_EQ(a.ruleBreaks[i].toString(), b.ruleBreaks[i].toString());
+        EXPECT_EQ(a.ruleBreaks[i].context, b.ruleBreaks[i].context);
+    }
+    EXPECT_EQ(a.emotionalCharacter, b.emotionalCharacter);
+    EXPECT_FLOAT_EQ(a.harmonyComplexity, b.harmonyComplexity);
+    EXPECT_EQ(a.hasResolution, b.hasResolution);
+}
+
+} // namespace
+
+TEST_F(DiagnosticsTest, BatchMatchesSingleDiagnosis) {
+    const std::vector<std::string> progressions = {
+        "F-C-Am-Dm", "C-Am-F-G", "Am-Dm-E-Am", "F-C-Bbm-F", "", "Xq-Yz",
+        "C-F#-G-C", "C-Eb-Ab-Bb", "Em-Am-Dm-G7", "Cmaj7-Am7-Dm7-G7",
+        "C/E-F-G-C", "G-D-Am-C", "D-A-E-B"
+    };
+    
+    auto batch = engine.diagnoseBatch(progressions, 3);
+    ASSERT_EQ(batch.size(), progressions.size());
+    EXPECT_EQ(batch.chordStart.back(), batch.chordRoot.size());
+    EXPECT_EQ(batch.findingStart.back(), batch.findingCode.size());
+    
+    for (size_t p = 0; p < progressions.size(); p++) {
+        SCOPED_TRACE(progressions[p]);
+        auto single = engine.diagnose(progressions[p]);
+        expectSameReport(single, batch.report(p));
+        
+        EXPECT_EQ(batch.success[p] != 0, single.success);
+        if (!single.success) continue;
+        ASSERT_EQ(batch.chordCount(p), single.chordNames.size());
+        for (size_t c = 0; c < batch.chordCount(p); c++) {
+            EXPECT_EQ(batch.chordName(p, c), single.chordNames[c]);
+        }
+    }
+}
+
+TEST_F(DiagnosticsTest, BatchIsIndependentOfThreadCount) {
+    std::vector<std::string> progressions;
+    const char* chords[] = {"C", "G", "Am", "F", "Bb", "F#", "Dm7", "E7", "Ab"};
+    for (int i = 0; i < 500; i++) {
+        std::string prog;
+        for (int c = 0; c < 2 + i % 5; c++) {
+            if (c > 0) prog += "-";
+            prog += chords[(i * 7 + c * 3) % 9];
+        }
+        progressions.push_back(prog);
+    }
+    
+    auto serial = engine.diagnoseBatch(progressions, 1);
+    auto parallel = engine.diagnoseBatch(progressions, 4);
+    
+    EXPECT_EQ(serial.chordStart, parallel.chordStart);
+    EXPECT_EQ(serial.findingStart, parallel.findingStart);
+    EXPECT_EQ(serial.chordRoot, parallel.chordRoot);
+    EXPECT_EQ(serial.chordQuality, parallel.chordQuality);
+    EXPECT_EQ(serial.findingCode, parallel.findingCode);
+    EXPECT_EQ(serial.findingChord, parallel.findingChord);
+    EXPECT_EQ(serial.complexity, parallel.complexity);
+    EXPECT_EQ(serial.character, parallel.character);
+}
+
+TEST_F(DiagnosticsTest, BatchFindingsAreCodes) {
+    auto batch = engine.diagnoseBatch({"C-F#-G-C", "nope"});
+    
+    // Tritone C → F#: an issue plus a passing-chord suggestion at chord 1
+    std::vector<FindingCode> codes(batch.findingCode.begin() + batch.findingStart[0],
+                                   batch.findingCode.begin() + batch.findingStart[1]);
+    auto tritone = std::find(codes.begin(), codes.end(), FindingCode::TritoneMotion);
+    ASSERT_NE(tritone, codes.end());
+    size_t f = static_cast<size_t>(tritone - codes.begin());
+    EXPECT_EQ(batch.findingChord[batch.findingStart[0] + f], 1);
+    EXPECT_EQ(batch.describe(0, f), "Tritone motion between C and F# - can feel unstable");
+    EXPECT_NE(std::find(codes.begin(), codes.end(), FindingCode::PassingChord), codes.end());
+    
+    EXPECT_EQ(batch.success[1], 0);
+    ASSERT_EQ(batch.findingCount(1), 1u);
+    EXPECT_EQ(batch.findingCode[batch.findingStart[1]], FindingCode::ParseError);
+    EXPECT_EQ(batch.chordCount(1), 0u);
+}
+
 // ============================================================================
 // Utility Function Tests
 // ============================================================================
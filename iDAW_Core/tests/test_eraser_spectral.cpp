@@ -0,0 +1,247 @@
+/**
+ * test_eraser_spectral.cpp - Unit tests for The Eraser's spectral gate
+ *
+ * With nothing erased the STFT must reconstruct its input exactly one FFT
+ * size later in every mode, the stereo packing must keep the channels
+ * apart, the threshold must gate each channel on its own level, and erasure
+ * (cursor, mask) must remove the targeted band from both channels while
+ * leaving the rest.
+ */
+
+#include <gtest/gtest.h>
+#include "SignalTestUtils.h"
+#include "SpectralGateEngine.h"
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace iDAW;
+using TestSignal::rms;
+using TestSignal::sine;
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr int BLOCK = 300;  // Deliberately not a multiple of any hop
+
+SpectralGateParams nothingErased() {
+    SpectralGateParams params;
+    params.thresholdLinear = 1e9f;
+    return params;
+}
+
+void runStereo(SpectralGateEngine& engine, std::vector<float>& left, std::vector<float>& right) {
+    TestSignal::processInBlocks(left.size(), BLOCK, [&](size_t offset, int n) {
+        float* channels[2] = {left.data() + offset, right.data() + offset};
+        engine.process(channels, 2, n);
+    });
+}
+
+} // namespace
+
+// ============================================================================
+// Reconstruction and latency
+// ============================================================================
+
+class EraserFftConfig : public ::testing::TestWithParam<std::pair<int, int>> {};
+
+TEST_P(EraserFftConfig, PassesThroughDelayedByOneFftSize) {
+    const auto [fftSize, overlap] = GetParam();
+
+    SpectralGateEngine engine;
+    ASSERT_TRUE(engine.setFftConfig(fftSize, overlap));
+    engine.prepare(SAMPLE_RATE);
+    engine.setParameters(nothingErased());
+    EXPECT_EQ(engine.getLatencySamples(), fftSize);
+    EXPECT_EQ(engine.getHopSize(), fftSize / overlap);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    std::vector<float> left(20000), right(20000);
+    for (auto& x : left) x = noise(rng);
+    for (auto& x : right) x = 0.5f * noise(rng);
+    const auto dryLeft = left;
+    const auto dryRight = right;
+
+    runStereo(engine, left, right);
+
+    const int latency = engine.getLatencySamples();
+    for (size_t i = 0; i < left.size(); ++i) {
+        const float expectedLeft = i >= static_cast<size_t>(latency) ? dryLeft[i - latency] : 0.0f;
+        const float expectedRight = i >= static_cast<size_t>(latency) ? dryRight[i - latency] : 0.0f;
+        ASSERT_NEAR(left[i], expectedLeft, 1e-4f) << "i = " << i;
+        ASSERT_NEAR(right[i], expectedRight, 1e-4f) << "i = " << i;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Modes, EraserFftConfig,
+                         ::testing::Values(std::make_pair(EraserConfig::DEFAULT_FFT_SIZE, EraserConfig::DEFAULT_OVERLAP),
+                                           std::make_pair(EraserConfig::LOW_LATENCY_FFT_SIZE,
+                                                          EraserConfig::LOW_LATENCY_OVERLAP),
+                                           std::make_pair(1024, 8),
+                                           std::make_pair(EraserConfig::MAX_FFT_SIZE, 4)));
+
+TEST(EraserSpectral, LowLatencyModeIs512Over128) {
+    SpectralGateEngine engine;
+    engine.prepare(SAMPLE_RATE);
+    EXPECT_EQ(engine.getLatencySamples(), 2048);
+
+    ASSERT_TRUE(engine.setFftConfig(EraserConfig::LOW_LATENCY_FFT_SIZE, EraserConfig::LOW_LATENCY_OVERLAP));
+    EXPECT_EQ(engine.getLatencySamples(), 512);
+    EXPECT_EQ(engine.getHopSize(), 128);
+    EXPECT_EQ(engine.getNumBins(), 257);
+    EXPECT_EQ(SpectralGateEngine::latencyForFftSize(512), 512);
+}
+
+TEST(EraserSpectral, RejectsUnsupportedConfigs) {
+    SpectralGateEngine engine;
+    engine.prepare(SAMPLE_RATE);
+
+    EXPECT_FALSE(engine.setFftConfig(256, 4));
+    EXPECT_FALSE(engine.setFftConfig(8192, 4));
+    EXPECT_FALSE(engine.setFftConfig(1000, 4));
+    EXPECT_FALSE(engine.setFftConfig(2048, 2));
+    EXPECT_FALSE(engine.setFftConfig(2048, 16));
+    EXPECT_EQ(engine.getFftSize(), EraserConfig::DEFAULT_FFT_SIZE);
+    EXPECT_EQ(engine.getOverlap(), EraserConfig::DEFAULT_OVERLAP);
+}
+
+// ============================================================================
+// Stereo packing
+// ============================================================================
+
+TEST(EraserSpectral, ChannelsStaySeparate) {
+    SpectralGateEngine engine;
+    engine.prepare(SAMPLE_RATE);
+    engine.setParameters(nothingErased());
+
+    auto left = sine(24000, 440.0, 0.8f);
+    std::vector<float> right(left.size(), 0.0f);
+    runStereo(engine, left, right);
+
+    EXPECT_GT(rms(left, 4096), 0.5f);
+    EXPECT_LT(rms(right, 0), 1e-5f);
+}
+
+TEST(EraserSpectral, MagnitudesMatchAcrossFftSizes) {
+    // Bin-centred in both sizes: 1500 Hz is bin 16 of 512 and bin 64 of 2048
+    std::vector<float> readings;
+    for (int fftSize : {EraserConfig::LOW_LATENCY_FFT_SIZE, EraserConfig::REFERENCE_FFT_SIZE}) {
+        SpectralGateEngine engine;
+        ASSERT_TRUE(engine.setFftConfig(fftSize, 4));
+        engine.prepare(SAMPLE_RATE);
+        engine.setParameters(nothingErased());
+
+        auto left = sine(8192, 1500.0, 0.5f);
+        auto right = left;
+        runStereo(engine, left, right);
+
+        const int bin = engine.frequencyToBin(1500.0f);
+        readings.push_back(engine.getMagnitudes(0)[bin]);
+        EXPECT_FLOAT_EQ(engine.getMagnitudes(1)[bin], engine.getMagnitudes(0)[bin]);
+        EXPECT_NEAR(engine.binToFrequency(bin), 1500.0f, 1e-3f);
+    }
+
+    // The former normalized-Hann 2048-point analysis: amplitude * N / 2
+    EXPECT_NEAR(readings[0], 0.5f * 1024.0f, 5.0f);
+    EXPECT_NEAR(readings[1], 0.5f * 1024.0f, 5.0f);
+}
+
+// ============================================================================
+// Erasure
+// ============================================================================
+
+TEST(EraserSpectral, CursorErasesBandFromBothChannels) {
+    SpectralGateEngine engine;
+    engine.prepare(SAMPLE_RATE);
+
+    SpectralGateParams params = nothingErased();
+    params.cursorActive = true;
+    params.cursorCenterHz = 1000.0f;
+    params.cursorBandwidthHz = 600.0f;
+    params.cursorIntensity = 1.0f;
+    engine.setParameters(params);
+
+    // 1 kHz in both channels, 6 kHz only on the right
+    auto left = sine(48000, 1000.0, 0.5f);
+    auto right = sine(48000, 1000.0, 0.5f);
+    const auto high = sine(48000, 6000.0, 0.5f);
+    for (size_t i = 0; i < right.size(); ++i) right[i] += high[i];
+
+    runStereo(engine, left, right);
+
+    EXPECT_LT(rms(left, 8192), 0.02f);
+    EXPECT_NEAR(rms(right, 8192), 0.5f / std::sqrt(2.0f), 0.03f);
+
+    const int centre = engine.frequencyToBin(1000.0f);
+    for (int channel = 0; channel < 2; ++channel) {
+        EXPECT_FLOAT_EQ(engine.getErasure(channel)[centre], 1.0f);
+        EXPECT_EQ(engine.getErasure(channel)[engine.frequencyToBin(6000.0f)], 0.0f);
+    }
+}
+
+TEST(EraserSpectral, ThresholdGatesEachChannelOnItsOwnLevel) {
+    SpectralGateEngine engine;
+    engine.prepare(SAMPLE_RATE);
+
+    // 1 kHz reads about 0.8 * 1024 on the left and 0.05 * 1024 on the right
+    SpectralGateParams params;
+    params.thresholdLinear = 200.0f;
+    engine.setParameters(params);
+
+    auto left = sine(48000, 1000.0, 0.8f);
+    auto right = sine(48000, 1000.0, 0.05f);
+    runStereo(engine, left, right);
+
+    // The loud left tone is erased; the quiet right one passes untouched
+    EXPECT_LT(rms(left, 8192), 0.02f);
+    EXPECT_NEAR(rms(right, 8192), 0.05f / std::sqrt(2.0f), 0.002f);
+
+    const int bin = engine.frequencyToBin(1000.0f);
+    EXPECT_FLOAT_EQ(engine.getErasure(0)[bin], 1.0f);
+    EXPECT_EQ(engine.getErasure(1)[bin], 0.0f);
+    EXPECT_GT(engine.getMagnitudes(0)[bin], 10.0f * engine.getMagnitudes(1)[bin]);
+}
+
+TEST(EraserSpectral, MaskErasesSelectedBins) {
+    SpectralGateEngine engine;
+    ASSERT_TRUE(engine.setFftConfig(EraserConfig::LOW_LATENCY_FFT_SIZE, EraserConfig::LOW_LATENCY_OVERLAP));
+    engine.prepare(SAMPLE_RATE);
+    engine.setParameters(nothingErased());
+
+    // Hann main lobe of a bin-centred tone: its bin and one either side
+    std::vector<uint8_t> mask(EraserConfig::MAX_BINS, 0);
+    const int bin = engine.frequencyToBin(3000.0f);
+    mask[bin - 1] = mask[bin] = mask[bin + 1] = 1;
+    engine.setErasedBins(mask.data());
+
+    auto left = sine(24000, 3000.0, 0.5f);
+    auto right = sine(24000, 3000.0, 0.25f);
+    runStereo(engine, left, right);
+
+    EXPECT_LT(rms(left, 2048), 1e-4f);
+    EXPECT_LT(rms(right, 2048), 1e-4f);
+}
+
+TEST(EraserSpectral, ConfigChangeMidStreamStaysFinite) {
+    SpectralGateEngine engine;
+    engine.prepare(SAMPLE_RATE);
+    engine.setParameters(nothingErased());
+
+    auto left = sine(4800, 220.0, 0.5f);
+    auto right = left;
+    runStereo(engine, left, right);
+
+    ASSERT_TRUE(engine.setFftConfig(512, 8));
+    left = sine(4800, 220.0, 0.5f);
+    right = left;
+    runStereo(engine, left, right);
+
+    for (size_t i = 0; i < left.size(); ++i) {
+        ASSERT_TRUE(std::isfinite(left[i]) && std::isfinite(right[i]));
+    }
+    // The new mode restarts its FIFOs: its own latency, then the tone again
+    EXPECT_LT(rms(std::vector<float>(left.begin(), left.begin() + 512), 0), 1e-6f);
+    EXPECT_GT(rms(left, 1024), 0.3f);
+}
@@ -5,6 +5,16 @@
 #include <gtest/gtest.h>
 #include "groove/GrooveEngine.h"
 #include "groove/GrooveTemplate.h"
+#include "groove/GrooveLibrary.h"
+#include "groove/MidiFileLoader.h"
+#include "groove/NoteBuffer.h"
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <thread>
 
 using namespace iDAW::groove;
 
@@ -249,6 +259,47 @@ TEST_F(GrooveTemplateTest, Humanize_Reproducible) {
     }
 }
 
+TEST_F(GrooveTemplateTest, Humanize_BlocksMatchWholeTrack) {
+    std::vector<MidiNote> whole;
+    for (int i = 0; i < 100; i++) {
+        whole.push_back({36 + i % 12, 80, i * 120, 120, 0});
+    }
+    std::vector<MidiNote> original = whole;
+    
+    engine.humanize(whole, 0.7f, 0.7f, 480, 7);
+    
+    // Uneven blocks, processed out of order
+    const size_t splits[] = {0, 13, 64, 65, 100};
+    std::vector<MidiNote> blocked;
+    for (int b = 3; b >= 0; b--) {
+        std::vector<MidiNote> block(original.begin() + splits[b], original.begin() + splits[b + 1]);
+        engine.humanize(block, 0.7f, 0.7f, 480, 7, splits[b]);
+        blocked.insert(blocked.begin(), block.begin(), block.end());
+    }
+    
+    ASSERT_EQ(blocked.size(), whole.size());
+    for (size_t i = 0; i < whole.size(); i++) {
+        EXPECT_EQ(blocked[i].startTick, whole[i].startTick);
+        EXPECT_EQ(blocked[i].velocity, whole[i].velocity);
+    }
+}
+
+TEST_F(GrooveTemplateTest, Humanize_NoteBufferMatchesVector) {
+    std::vector<MidiNote> notes;
+    for (int i = 0; i < 50; i++) {
+        notes.push_back({40, 20 + i * 2, i * 240, 120, 0});
+    }
+    NoteBuffer buffer(notes);
+    
+    engine.humanize(notes, 0.9f, 0.9f, 480, 1234, 500);
+    engine.humanize(buffer, 0.9f, 0.9f, 480, 1234, 500);
+    
+    for (size_t i = 0; i < notes.size(); i++) {
+        EXPECT_EQ(buffer.note(i).startTick, notes[i].startTick);
+        EXPECT_EQ(buffer.note(i).velocity, notes[i].velocity);
+    }
+}
+
 // ============================================================================
 // Quantization Tests
 // ============================================================================
@@ -349,3 +400,285 @@ TEST(GenrePresetTest, GetByName) {
     EXPECT_EQ(getGenrePresetByName("lo-fi"), GenrePreset::LoFi);
     EXPECT_EQ(getGenrePresetByName("unknown"), GenrePreset::Straight);
 }
+
+// ============================================================================
+// Binary Groove Library Tests
+// ============================================================================
+
+class GrooveLibraryTest : public GrooveTemplateTest {
+protected:
+    GrooveTemplate makeGroove(const std::string& name) {
+        auto groove = engine.extractGroove(testNotes, 480, 96.0f);
+        groove.setName(name);
+        groove.setSourceFile(name + ".mid");
+        groove.setSwingFactor(0.62f);
+        groove.setVelocityCurve({100, 60, 110, 55, 95, 58, 108, 52});
+        return groove;
+    }
+
+    void expectSameGroove(const GrooveTemplate& a, const GrooveTemplate& b) {
+        EXPECT_EQ(a.name(), b.name());
+        EXPECT_EQ(a.sourceFile(), b.sourceFile());
+        EXPECT_EQ(a.ppq(), b.ppq());
+        EXPECT_FLOAT_EQ(a.tempoBpm(), b.tempoBpm());
+        EXPECT_EQ(a.timeSignature(), b.timeSignature());
+        EXPECT_FLOAT_EQ(a.swingFactor(), b.swingFactor());
+        EXPECT_EQ(a.timingDeviations(), b.timingDeviations());
+        EXPECT_EQ(a.velocityCurve(), b.velocityCurve());
+        EXPECT_EQ(a.velocityStats().min, b.velocityStats().min);
+        EXPECT_EQ(a.velocityStats().max, b.velocityStats().max);
+        EXPECT_FLOAT_EQ(a.velocityStats().mean, b.velocityStats().mean);
+        EXPECT_EQ(a.velocityStats().ghostCount, b.velocityStats().ghostCount);
+        EXPECT_FLOAT_EQ(a.timingStats().stdDeviationMs, b.timingStats().stdDeviationMs);
+
+        ASSERT_EQ(a.events().size(), b.events().size());
+        for (size_t i = 0; i < a.events().size(); ++i) {
+            EXPECT_EQ(a.events()[i].pitch, b.events()[i].pitch);
+            EXPECT_EQ(a.events()[i].velocity, b.events()[i].velocity);
+            EXPECT_EQ(a.events()[i].startTick, b.events()[i].startTick);
+            EXPECT_EQ(a.events()[i].durationTicks, b.events()[i].durationTicks);
+            EXPECT_FLOAT_EQ(a.events()[i].deviationTicks, b.events()[i].deviationTicks);
+            EXPECT_EQ(a.events()[i].isGhost, b.events()[i].isGhost);
+            EXPECT_EQ(a.events()[i].isAccent, b.events()[i].isAccent);
+        }
+    }
+};
+
+TEST_F(GrooveLibraryTest, BinaryRoundTrip) {
+    auto groove = makeGroove("Pocket");
+    auto bytes = groove.toBinary();
+    auto restored = GrooveTemplate::fromBinary(bytes.data(), bytes.size());
+
+    ASSERT_TRUE(restored.has_value());
+    expectSameGroove(groove, *restored);
+}
+
+TEST_F(GrooveLibraryTest, ZeroCopyViews) {
+    std::vector<GrooveTemplate> grooves = {makeGroove("A"), makeGroove("B"), GrooveTemplate("Empty")};
+    auto image = serializeGrooveLibrary(grooves);
+
+    GrooveLibraryFile library;
+    ASSERT_TRUE(library.openFromMemory(image.data(), image.size()));
+    EXPECT_EQ(library.size(), 3u);
+    EXPECT_EQ(library.version(), binary::VERSION);
+    EXPECT_EQ(library.name(1), "B");
+    EXPECT_EQ(library.indexOf("Empty"), 2);
+    EXPECT_EQ(library.indexOf("Missing"), -1);
+
+    // Views point straight into the image
+    auto events = library.events(0);
+    ASSERT_EQ(events.size, grooves[0].events().size());
+    EXPECT_GE(reinterpret_cast<const uint8_t*>(events.data), image.data());
+    EXPECT_LT(reinterpret_cast<const uint8_t*>(events.data), image.data() + image.size());
+    EXPECT_EQ(events[2].pitch, 38);
+    EXPECT_EQ(library.velocityCurve(1).size, 8u);
+    EXPECT_TRUE(library.events(2).empty());
+}
+
+TEST_F(GrooveLibraryTest, RejectsCorruptData) {
+    auto image = serializeGrooveLibrary({makeGroove("A")});
+    GrooveLibraryFile library;
+
+    // Truncated
+    EXPECT_FALSE(library.openFromMemory(image.data(), image.size() / 2));
+    EXPECT_FALSE(library.isOpen());
+
+    // Bad magic
+    auto badMagic = image;
+    badMagic[0] = 'X';
+    EXPECT_FALSE(library.openFromMemory(badMagic.data(), badMagic.size()));
+
+    // Future version
+    auto badVersion = image;
+    badVersion[offsetof(binary::FileHeader, version)] = 99;
+    EXPECT_FALSE(library.openFromMemory(badVersion.data(), badVersion.size()));
+
+    // Event array pointing past the end of the file
+    auto badOffset = image;
+    auto* header = reinterpret_cast<binary::FileHeader*>(badOffset.data());
+    auto* record = reinterpret_cast<binary::GrooveRecord*>(badOffset.data() + header->directoryOffset);
+    record->eventsOffset = header->fileSize - 8;
+    EXPECT_FALSE(library.openFromMemory(badOffset.data(), badOffset.size()));
+
+    EXPECT_FALSE(GrooveTemplate::fromBinary(image.data(), 16).has_value());
+    EXPECT_TRUE(library.openFromMemory(image.data(), image.size()));
+}
+
+TEST_F(GrooveLibraryTest, SaveAndLoadFile) {
+    const auto path = (std::filesystem::temp_directory_path() / "idaw_test_grooves.igrv").string();
+    std::vector<GrooveTemplate> grooves = {makeGroove("Verse"), makeGroove("Chorus")};
+
+    ASSERT_TRUE(saveGrooveLibrary(path, grooves));
+
+    {
+        GrooveLibraryFile library;
+        ASSERT_TRUE(library.open(path));
+        EXPECT_EQ(library.size(), 2u);
+        EXPECT_EQ(library.sourceFile(1), "Chorus.mid");
+        expectSameGroove(grooves[1], library.toTemplate(1));
+    }
+
+    auto loaded = loadGrooveLibrary(path);
+    ASSERT_TRUE(loaded.has_value());
+    ASSERT_EQ(loaded->size(), 2u);
+    expectSameGroove(grooves[0], (*loaded)[0]);
+
+    std::remove(path.c_str());
+    EXPECT_FALSE(loadGrooveLibrary(path).has_value());
+}
+
+TEST_F(GrooveLibraryTest, ConcurrentSavesToOnePath) {
+    const auto dir = std::filesystem::temp_directory_path() / "idaw_test_concurrent_saves";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto path = (dir / "grooves.igrv").string();
+
+    // Each writer saves a library of a different size; every save must land whole
+    constexpr int WRITERS = 4;
+    std::vector<std::vector<GrooveTemplate>> libraries(WRITERS);
+    for (int w = 0; w < WRITERS; ++w) {
+        for (int g = 0; g <= w; ++g) libraries[w].push_back(makeGroove("G" + std::to_string(g)));
+    }
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> writers;
+    for (int w = 0; w < WRITERS; ++w) {
+        writers.emplace_back([&, w] {
+            for (int i = 0; i < 20; ++i) {
+                if (!saveGrooveLibrary(path, libraries[w])) ++failures;
+            }
+        });
+    }
+    for (auto& t : writers) t.join();
+    EXPECT_EQ(failures.load(), 0);
+
+    auto loaded = loadGrooveLibrary(path);
+    ASSERT_TRUE(loaded.has_value());
+    ASSERT_GE(loaded->size(), 1u);
+    ASSERT_LE(loaded->size(), static_cast<size_t>(WRITERS));
+    expectSameGroove(libraries[loaded->size() - 1].back(), loaded->back());
+
+    // No temporary files are left behind
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(dir), std::filesystem::directory_iterator()), 1);
+    std::filesystem::remove_all(dir);
+}
+
+// ============================================================================
+// Batch Extraction Tests
+// ============================================================================
+
+TEST_F(GrooveTemplateTest, ExtractGrooveBatch_MatchesSequential) {
+    std::vector<std::vector<MidiNote>> noteSets;
+    for (int i = 0; i < 64; ++i) {
+        auto notes = testNotes;
+        for (auto& note : notes) {
+            note.startTick += (i % 7) - 3;
+            note.velocity = std::max(1, note.velocity - i % 20);
+        }
+        noteSets.push_back(notes);
+    }
+    
+    auto batch = engine.extractGrooveBatch(noteSets, 480, 100.0f, ExtractionSettings{}, 4);
+    
+    ASSERT_EQ(batch.size(), noteSets.size());
+    for (size_t i = 0; i < noteSets.size(); ++i) {
+        auto expected = engine.extractGroove(noteSets[i], 480, 100.0f);
+        EXPECT_EQ(batch[i].timingDeviations(), expected.timingDeviations());
+        EXPECT_EQ(batch[i].velocityCurve(), expected.velocityCurve());
+        EXPECT_FLOAT_EQ(batch[i].swingFactor(), expected.swingFactor());
+    }
+}
+
+TEST_F(GrooveTemplateTest, ExtractGrooveFromFiles) {
+    // Format 0, PPQ 96, 100 BPM: two notes, the second 3 ticks late
+    const std::vector<uint8_t> smf = {
+        'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 0, 0, 1, 0, 96,
+        'M', 'T', 'r', 'k', 0, 0, 0, 27,
+        0x00, 0xFF, 0x51, 0x03, 0x09, 0x27, 0xC0,     // 600000 us/quarter
+        0x00, 0x99, 36, 100,
+        0x30, 0x89, 36, 0,
+        0x33, 0x99, 38, 30,
+        0x30, 38, 0,                                  // Running status
+        0x00, 0xFF, 0x2F, 0x00,
+    };
+    
+    const auto dir = std::filesystem::temp_directory_path();
+    const auto path = (dir / "idaw_test_batch.mid").string();
+    std::ofstream(path, std::ios::binary).write(
+        reinterpret_cast<const char*>(smf.data()), static_cast<std::streamsize>(smf.size()));
+    
+    MidiFileNotes parsed;
+    ASSERT_TRUE(parseMidiFileNotes(smf.data(), smf.size(), parsed));
+    ASSERT_EQ(parsed.notes.size(), 2u);
+    EXPECT_EQ(parsed.ppq, 96);
+    EXPECT_FLOAT_EQ(parsed.tempoBpm, 100.0f);
+    EXPECT_EQ(parsed.notes[1].startTick, 99);
+    EXPECT_EQ(parsed.notes[1].durationTicks, 48);
+    EXPECT_EQ(parsed.notes[1].channel, 9);
+    
+    auto results = engine.extractGrooveFromFiles({path, (dir / "missing.mid").string(), path});
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_TRUE(results[0].ok);
+    EXPECT_FALSE(results[1].ok);
+    EXPECT_TRUE(results[2].ok);
+    EXPECT_EQ(results[0].groove.name(), "idaw_test_batch");
+    EXPECT_EQ(results[0].groove.ppq(), 96);
+    EXPECT_EQ(results[0].groove.events().size(), 2u);
+    EXPECT_FLOAT_EQ(results[0].groove.timingDeviations()[1], 3.0f);
+    
+    std::remove(path.c_str());
+}
+
+// ============================================================================
+// NoteBuffer (SoA) Tests
+// ============================================================================
+
+TEST_F(GrooveTemplateTest, NoteBuffer_RoundTrip) {
+    NoteBuffer buffer(testNotes);
+    ASSERT_EQ(buffer.size(), testNotes.size());
+    
+    std::vector<MidiNote> back;
+    buffer.copyTo(back);
+    for (size_t i = 0; i < testNotes.size(); ++i) {
+        EXPECT_EQ(back[i].pitch, testNotes[i].pitch);
+        EXPECT_EQ(back[i].velocity, testNotes[i].velocity);
+        EXPECT_EQ(back[i].startTick, testNotes[i].startTick);
+        EXPECT_EQ(back[i].durationTicks, testNotes[i].durationTicks);
+    }
+}
+
+TEST_F(GrooveTemplateTest, NoteBuffer_SaturatesWideTicks) {
+    NoteBuffer buffer(testNotes);
+    buffer.startTicks()[0] = int64_t{std::numeric_limits<int>::max()} + 100;
+    buffer.startTicks()[1] = int64_t{std::numeric_limits<int>::min()} - 100;
+    
+    EXPECT_EQ(buffer.note(0).startTick, std::numeric_limits<int>::max());
+    EXPECT_EQ(buffer.note(1).startTick, std::numeric_limits<int>::min());
+    EXPECT_EQ(buffer.note(2).startTick, testNotes[2].startTick);
+}
+
+TEST_F(GrooveTemplateTest, ApplyGroove_NoteBufferMatchesVector) {
+    // Long enough to exercise the SIMD bodies and the tiled offset pattern
+    std::vector<MidiNote> notes;
+    for (int i = 0; i < 1000; ++i) {
+        notes.push_back({36 + i % 12, 40 + (i * 37) % 80, i * 120 + (i % 5), 120, 0});
+    }
+    
+    for (GenrePreset preset : {GenrePreset::Funk, GenrePreset::Dilla, GenrePreset::Jazz}) {
+        auto groove = getGenreTemplate(preset);
+        ApplicationSettings settings;
+        settings.intensity = 0.7f;
+        
+        auto expected = notes;
+        engine.applyGroove(expected, groove, 480, settings);
+        
+        NoteBuffer buffer(notes);
+        engine.applyGroove(buffer, groove, 480, settings);
+        
+        for (size_t i = 0; i < notes.size(); ++i) {
+            MidiNote actual = buffer.note(i);
+            EXPECT_EQ(actual.startTick, expected[i].startTick) << "note " << i;
+            EXPECT_NEAR(actual.velocity, expected[i].velocity, 1) << "note " << i;
+        }
+    }
+}
@@ -183,6 +183,95 @@ TEST_F(ProgressionTest, DiagnosticsDetectsNonDiatonic) {
     EXPECT_FALSE(result.issues.empty());  // Should flag Bbm
 }
 
+// ============================================================================
+// Parsing Tests
+// ============================================================================
+
+TEST(ParsingTest, ChordQualitySuffixes) {
+    const std::pair<const char*, ChordQuality> cases[] = {
+        {"C", ChordQuality::Major},       {"Cmaj", ChordQuality::Major},
+        {"CMaj", ChordQuality::Major},    {"CM", ChordQuality::Major},
+        {"Cmaj7", ChordQuality::Major7},  {"CMaj7", ChordQuality::Major7},
+        {"CM7", ChordQuality::Major7},    {"Cm", ChordQuality::Minor},
+        {"Cmin", ChordQuality::Minor},    {"C-", ChordQuality::Minor},
+        {"Cm7", ChordQuality::Minor7},    {"Cmin7", ChordQuality::Minor7},
+        {"Cm7b5", ChordQuality::Minor7},  {"Cdim", ChordQuality::Diminished},
+        {"Co", ChordQuality::Diminished}, {"Cdim7", ChordQuality::Dim7},
+        {"Co7", ChordQuality::Dim7},      {"C+", ChordQuality::Augmented},
+        {"Caug", ChordQuality::Augmented}, {"Csus2", ChordQuality::Sus2},
+        {"Csus4", ChordQuality::Sus4},    {"Csus", ChordQuality::Sus4},
+        {"C7", ChordQuality::Dominant7},  {"C6", ChordQuality::Major6},
+        {"Cadd9", ChordQuality::Add9},    {"Cadd", ChordQuality::Major},
+        {"Cd", ChordQuality::Major},      {"Cxyz", ChordQuality::Major},
+    };
+
+    for (const auto& [symbol, quality] : cases) {
+        auto chord = parseChordString(symbol);
+        ASSERT_TRUE(chord.has_value()) << symbol;
+        EXPECT_EQ(chord->root(), 0) << symbol;
+        EXPECT_EQ(chord->quality(), quality) << symbol;
+    }
+}
+
+TEST(ParsingTest, ChordRootsAndBass) {
+    EXPECT_EQ(parseChordString("Bb")->root(), 10);
+    EXPECT_EQ(parseChordString("F#m")->root(), 6);
+    EXPECT_EQ(parseChordString("Cb")->root(), 11);
+    EXPECT_EQ(parseChordString("am")->root(), 9);   // Lowercase roots are accepted
+
+    auto slash = parseChordString("Bb/D");
+    ASSERT_TRUE(slash.has_value());
+    EXPECT_EQ(slash->root(), 10);
+    EXPECT_EQ(slash->bass(), 2);
+
+    EXPECT_EQ(parseChordString("C/Eb")->bass(), 3);
+    EXPECT_EQ(parseChordString("C/x")->bass(), -1);
+    EXPECT_EQ(parseChordString("Am/")->quality(), ChordQuality::Minor);
+
+    EXPECT_FALSE(parseChordString("").has_value());
+    EXPECT_FALSE(parseChordString("H7").has_value());
+    EXPECT_FALSE(parseChordString("/E").has_value());
+}
+
+TEST(ParsingTest, TokenizerSplitsOnAllDelimiters) {
+    const std::string text = "  C - Am7|F,\tG/B\u2013Dm\u2014E7  ";
+    ProgressionTokenizer tokens(text);
+
+    std::vector<std::string_view> symbols;
+    std::string_view symbol;
+    while (tokens.next(symbol)) symbols.push_back(symbol);
+
+    const std::vector<std::string_view> expected = {"C", "Am7", "F", "G/B", "Dm", "E7"};
+    EXPECT_EQ(symbols, expected);
+
+    // Symbols are views into the source text
+    EXPECT_GE(symbols.front().data(), text.data());
+    EXPECT_LT(symbols.back().data(), text.data() + text.size());
+}
+
+TEST(ParsingTest, ProgressionSkipsNonChords) {
+    auto chords = parseProgressionString("C | x | G7 -- ?? Am");
+    ASSERT_EQ(chords.size(), 3);
+    EXPECT_EQ(chords[0].name(), "C");
+    EXPECT_EQ(chords[1].name(), "G7");
+    EXPECT_EQ(chords[2].name(), "Am");
+
+    EXPECT_TRUE(parseProgressionString("").empty());
+    EXPECT_TRUE(parseProgressionString(" - | , ").empty());
+}
+
+TEST(ParsingTest, ProgressionIntoReusesBuffer) {
+    std::vector<Chord> chords;
+    chords.reserve(16);
+    const Chord* storage = chords.data();
+
+    EXPECT_EQ(parseProgressionInto("F-C-Am-Dm", chords), 4u);
+    EXPECT_EQ(parseProgressionInto("G D", chords), 2u);   // Appends
+    ASSERT_EQ(chords.size(), 6u);
+    EXPECT_EQ(chords[5].name(), "D");
+    EXPECT_EQ(chords.data(), storage);
+}
+
 // ============================================================================
 // Reharmonization Tests
 // ============================================================================
@@ -0,0 +1,261 @@
+/**
+ * test_palette_voices.cpp - Unit tests for The Palette's voice engine
+ *
+ * The lane-parallel renderer must reproduce the former one-voice-at-a-time
+ * loop (pitch, detune, FM, ADSR) and retire voices once released.
+ */
+
+#include <gtest/gtest.h>
+#include "WavetableVoiceEngine.h"
+#include <array>
+#include <cmath>
+#include <vector>
+
+using namespace iDAW;
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr int TABLE_SIZE = PaletteConfig::WAVETABLE_SIZE;
+
+/** The former processVoice()/processEnvelope() pair for one voice */
+struct ReferenceVoice {
+    int note;
+    float velocity;
+    ADSREnvelope env;
+    float phase1 = 0.0f;
+    float phase2 = 0.0f;
+
+    static float read(const std::vector<float>& table, float phase) {
+        const float scaled = phase * TABLE_SIZE;
+        const int index = static_cast<int>(scaled) % TABLE_SIZE;
+        const int next = (index + 1) % TABLE_SIZE;
+        const float frac = scaled - std::floor(scaled);
+        return table[index] * (1.0f - frac) + table[next] * frac;
+    }
+
+    float envelope() {
+        const float sampleTime = 1.0f / static_cast<float>(SAMPLE_RATE);
+        switch (env.stage) {
+            case ADSREnvelope::Stage::ATTACK:
+                env.level += sampleTime / env.attack;
+                if (env.level >= 1.0f) { env.level = 1.0f; env.stage = ADSREnvelope::Stage::DECAY; }
+                break;
+            case ADSREnvelope::Stage::DECAY:
+                env.level -= (1.0f - env.sustain) * sampleTime / env.decay;
+                if (env.level <= env.sustain) { env.level = env.sustain; env.stage = ADSREnvelope::Stage::SUSTAIN; }
+                break;
+            case ADSREnvelope::Stage::SUSTAIN:
+                env.level = env.sustain;
+                break;
+            case ADSREnvelope::Stage::RELEASE:
+                env.level -= env.releaseLevel * sampleTime / env.release;
+                if (env.level <= 0.0f) { env.level = 0.0f; env.stage = ADSREnvelope::Stage::IDLE; }
+                break;
+            default:
+                env.level = 0.0f;
+        }
+        return env.level;
+    }
+
+    float process(const std::vector<float>& sine, const OscillatorParameters& p) {
+        const float freq = 440.0f * std::pow(2.0f, (note - 69) / 12.0f);
+        const float freq1 = freq * std::pow(2.0f, p.osc1DetuneCents / 1200.0f);
+        const float freq2 = freq * std::pow(2.0f, p.osc2DetuneCents / 1200.0f);
+
+        const float osc1 = read(sine, phase1) * p.osc1Level;
+        const float inc1 = freq1 / static_cast<float>(SAMPLE_RATE);
+        const float inc2 = (freq2 + osc1 * p.fmAmountHz) / static_cast<float>(SAMPLE_RATE);
+        const float osc2 = read(sine, phase2) * p.osc2Level;
+
+        phase1 += inc1;
+        if (phase1 >= 1.0f) phase1 -= 1.0f;
+        phase2 += inc2;
+        while (phase2 >= 1.0f) phase2 -= 1.0f;
+        while (phase2 < 0.0f) phase2 += 1.0f;
+
+        return (osc1 + osc2) * envelope() * velocity;
+    }
+};
+
+} // namespace
+
+TEST(WavetableVoiceEngine, MatchesPerVoiceLoop) {
+    std::vector<float> sine(TABLE_SIZE);
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        const float phase = static_cast<float>(i) / TABLE_SIZE;
+        sine[i] = std::sin(phase * 6.28318530717958647692f);
+    }
+
+    OscillatorParameters params;
+    params.osc1Type = WavetableType::SINE;
+    // Smooth tables: rounding-level phase differences stay rounding-level
+    params.osc2Type = WavetableType::SINE;
+    params.osc1DetuneCents = -5.0f;
+    params.osc2DetuneCents = 7.0f;
+    params.fmAmountHz = 150.0f;
+
+    ADSREnvelope env;
+    env.attack = 0.002f;
+    env.decay = 0.01f;
+    env.sustain = 0.6f;
+    env.release = 0.005f;
+
+    WavetableVoiceEngine engine;
+    engine.prepare(SAMPLE_RATE, 128);
+
+    std::vector<ReferenceVoice> reference;
+    for (int note : {45, 57, 64}) {
+        engine.noteOn(note, 0.8f, env);
+        ReferenceVoice voice{note, 0.8f, env};
+        voice.env.stage = ADSREnvelope::Stage::ATTACK;
+        reference.push_back(voice);
+    }
+
+    // Odd block sizes; the middle note is released part way through
+    const int length = 3000;
+    std::vector<float> output(length);
+    int rendered = 0;
+    for (int block : {100, 333, 1000, 128, 1439}) {
+        if (rendered == 1433) engine.noteOff(57);
+        engine.render(output.data() + rendered, block, params);
+        rendered += block;
+    }
+
+    for (int i = 0; i < length; ++i) {
+        if (i == 1433) {
+            reference[1].env.stage = ADSREnvelope::Stage::RELEASE;
+            reference[1].env.releaseLevel = reference[1].env.level;
+        }
+        float expected = 0.0f;
+        for (auto& voice : reference) {
+            if (voice.env.stage != ADSREnvelope::Stage::IDLE) expected += voice.process(sine, params);
+        }
+        ASSERT_NEAR(output[i], expected, 2e-3f) << "i = " << i;
+    }
+}
+
+TEST(WavetableVoiceEngine, ReleasedVoicesRetire) {
+    ADSREnvelope env;
+    env.release = 0.01f;
+
+    WavetableVoiceEngine engine;
+    engine.prepare(SAMPLE_RATE, 256);
+    for (int note = 60; note < 60 + PaletteConfig::MAX_VOICES; ++note) {
+        engine.noteOn(note, 1.0f, env);
+    }
+    EXPECT_EQ(engine.getNumActiveVoices(), PaletteConfig::MAX_VOICES);
+
+    OscillatorParameters params;
+    std::vector<float> block(256);
+    engine.render(block.data(), 256, params);
+
+    for (int note = 60; note < 60 + PaletteConfig::MAX_VOICES; ++note) {
+        engine.noteOff(note);
+    }
+    for (int b = 0; b < 4; ++b) {
+        engine.render(block.data(), 256, params);
+    }
+    EXPECT_EQ(engine.getNumActiveVoices(), 0);
+
+    engine.render(block.data(), 256, params);
+    for (float s : block) EXPECT_EQ(s, 0.0f);
+}
+
+namespace {
+
+/** Blackman-windowed magnitude of one frequency (Goertzel-style direct sum) */
+double magnitudeAt(const std::vector<float>& signal, double freq) {
+    const size_t n = signal.size();
+    double re = 0.0, im = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const double x = 2.0 * M_PI * i / (n - 1);
+        const double window = 0.42 - 0.5 * std::cos(x) + 0.08 * std::cos(2.0 * x);
+        const double angle = 2.0 * M_PI * freq * i / SAMPLE_RATE;
+        re += signal[i] * window * std::cos(angle);
+        im -= signal[i] * window * std::sin(angle);
+    }
+    return std::sqrt(re * re + im * im);
+}
+
+std::vector<float> renderHeldNote(int note, const OscillatorParameters& params, int length) {
+    ADSREnvelope env;
+    env.attack = 0.001f;
+    env.decay = 0.001f;
+    env.sustain = 1.0f;
+
+    WavetableVoiceEngine engine;
+    engine.prepare(SAMPLE_RATE, 512);
+    engine.noteOn(note, 1.0f, env);
+
+    // Skip the attack
+    std::vector<float> warmup(512);
+    engine.render(warmup.data(), 512, params);
+
+    std::vector<float> output(length);
+    engine.render(output.data(), length, params);
+    return output;
+}
+
+} // namespace
+
+// ============================================================================
+// Band-limited mip levels
+// ============================================================================
+
+TEST(WavetableVoiceEngine, MipLevelKeepsHarmonicsBelowNyquist) {
+    EXPECT_EQ(WavetableVoiceEngine::mipLevelFor(0.0f), 0);
+    EXPECT_EQ(WavetableVoiceEngine::mipLevelFor(1.0f / TABLE_SIZE), 0);
+    EXPECT_EQ(WavetableVoiceEngine::mipLevelFor(0.49f), WavetableVoiceEngine::NUM_MIP_LEVELS - 1);
+
+    for (float increment : {0.0005f, 0.003f, 0.0217f, 0.1f, 0.3f}) {
+        const int level = WavetableVoiceEngine::mipLevelFor(increment);
+        const int topHarmonic = (TABLE_SIZE / 2) >> level;
+        EXPECT_LE(topHarmonic * increment, 0.5f) << "increment " << increment;
+        if (level > 0) {
+            // ...and the level below would alias
+            EXPECT_GT(2 * topHarmonic * increment, 0.5f) << "increment " << increment;
+        }
+    }
+}
+
+TEST(WavetableVoiceEngine, HighSawDoesNotAlias) {
+    OscillatorParameters params;
+    params.osc1Type = WavetableType::SAW;
+    params.osc2Level = 0.0f;
+
+    // C8 (4186 Hz): harmonics 5 and up fold back below 24 kHz on a naive table
+    const double f0 = 440.0 * std::pow(2.0, (108 - 69) / 12.0);
+    const auto output = renderHeldNote(108, params, 8192);
+
+    const double fundamental = magnitudeAt(output, f0);
+    const double fourth = magnitudeAt(output, 4.0 * f0);
+    EXPECT_GT(fourth / fundamental, 0.2);  // Saw harmonic 4 at 1/4
+
+    for (int harmonic = 6; harmonic <= 11; ++harmonic) {
+        const double alias = SAMPLE_RATE - harmonic * f0;
+        if (alias <= 0.0) break;
+        EXPECT_LT(magnitudeAt(output, std::abs(alias)) / fundamental, 1e-3) << "harmonic " << harmonic;
+    }
+}
+
+TEST(WavetableVoiceEngine, PositionMorphsToNextTable) {
+    OscillatorParameters sine;
+    sine.osc1Type = WavetableType::SINE;
+    sine.osc2Level = 0.0f;
+
+    OscillatorParameters saw = sine;
+    saw.osc1Type = WavetableType::SAW;
+
+    OscillatorParameters halfway = sine;
+    halfway.osc1Position = 0.5f;
+
+    const int length = 2048;
+    const auto a = renderHeldNote(60, sine, length);
+    const auto b = renderHeldNote(60, saw, length);
+    const auto mixed = renderHeldNote(60, halfway, length);
+
+    for (int i = 0; i < length; ++i) {
+        ASSERT_NEAR(mixed[i], 0.5f * (a[i] + b[i]), 1e-5f) << "i = " << i;
+    }
+}
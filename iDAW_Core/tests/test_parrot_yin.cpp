@@ -0,0 +1,149 @@
+/**
+ * test_parrot_yin.cpp - Unit tests for The Parrot's YIN pitch tracker
+ *
+ * The FFT difference function must reproduce the direct O(N^2) one closely
+ * enough that both pick the same pitch.
+ */
+
+#include <gtest/gtest.h>
+#include "SignalTestUtils.h"
+#include "YinPitchTracker.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace iDAW;
+using TestSignal::TWO_PI;
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr int FRAME_SIZE = 4096;
+constexpr int HOP_SIZE = 512;
+
+std::vector<float> makeHarmonicTone(float freq, int numSamples, float noiseLevel = 0.0f) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    std::vector<float> signal(static_cast<size_t>(numSamples));
+
+    for (int i = 0; i < numSamples; ++i) {
+        const double t = i / SAMPLE_RATE;
+        double s = 0.0;
+        for (int h = 1; h <= 5; ++h) {
+            s += std::sin(TWO_PI * freq * h * t) / h;
+        }
+        signal[static_cast<size_t>(i)] = static_cast<float>(0.5 * s) + noiseLevel * noise(rng);
+    }
+    return signal;
+}
+
+} // namespace
+
+// ============================================================================
+// Direct vs FFT agreement
+// ============================================================================
+
+class YinAgreementTest : public ::testing::TestWithParam<float> {
+protected:
+    void SetUp() override {
+        direct.prepare(SAMPLE_RATE, FRAME_SIZE, HOP_SIZE);
+        direct.setMethod(YinPitchTracker::Method::Direct);
+        fft.prepare(SAMPLE_RATE, FRAME_SIZE, HOP_SIZE);
+        fft.setMethod(YinPitchTracker::Method::FFT);
+    }
+
+    YinPitchTracker direct;
+    YinPitchTracker fft;
+};
+
+TEST_P(YinAgreementTest, SameCMNDFAndPitch) {
+    const float freq = GetParam();
+    const auto signal = makeHarmonicTone(freq, FRAME_SIZE, 0.05f);
+
+    const float directPitch = direct.analyzeFrame(signal.data());
+    const float fftPitch = fft.analyzeFrame(signal.data());
+
+    for (int tau = 0; tau < direct.getNumLags(); ++tau) {
+        EXPECT_NEAR(direct.getCMNDF()[tau], fft.getCMNDF()[tau], 2e-3f) << "tau = " << tau;
+    }
+
+    ASSERT_GT(directPitch, 0.0f);
+    EXPECT_NEAR(fftPitch, directPitch, directPitch * 1e-3f);
+    EXPECT_NEAR(fftPitch, freq, freq * 0.01f);
+}
+
+INSTANTIATE_TEST_SUITE_P(Frequencies, YinAgreementTest,
+                         ::testing::Values(55.0f, 110.0f, 220.0f, 440.0f, 987.77f, 1760.0f));
+
+TEST(YinTrackerTest, NoiseIsUnvoicedInBothModes) {
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    std::vector<float> signal(FRAME_SIZE);
+    for (auto& s : signal) s = noise(rng);
+
+    YinPitchTracker tracker;
+    tracker.prepare(SAMPLE_RATE, FRAME_SIZE, HOP_SIZE);
+
+    tracker.setMethod(YinPitchTracker::Method::Direct);
+    EXPECT_EQ(tracker.analyzeFrame(signal.data()), 0.0f);
+
+    tracker.setMethod(YinPitchTracker::Method::FFT);
+    EXPECT_EQ(tracker.analyzeFrame(signal.data()), 0.0f);
+}
+
+TEST(YinTrackerTest, SilenceIsUnvoiced) {
+    std::vector<float> silence(FRAME_SIZE, 0.0f);
+
+    YinPitchTracker tracker;
+    tracker.prepare(SAMPLE_RATE, FRAME_SIZE, HOP_SIZE);
+
+    EXPECT_EQ(tracker.analyzeFrame(silence.data()), 0.0f);
+    EXPECT_EQ(tracker.getConfidence(), 0.0f);
+}
+
+// ============================================================================
+// Streaming (hop-based) analysis
+// ============================================================================
+
+TEST(YinTrackerTest, StreamingMatchesLatestFrame) {
+    const int totalSamples = 3 * FRAME_SIZE + 300;
+    const auto signal = makeHarmonicTone(196.0f, totalSamples);
+
+    YinPitchTracker streaming;
+    streaming.prepare(SAMPLE_RATE, FRAME_SIZE, HOP_SIZE);
+
+    // Irregular host block sizes
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> blockSize(1, 700);
+    int framesAnalysed = 0;
+    int pushed = 0;
+    int lastFrameEnd = 0;
+    while (pushed < totalSamples) {
+        const int n = std::min(blockSize(rng), totalSamples - pushed);
+        framesAnalysed += streaming.pushSamples(signal.data() + pushed, n);
+        pushed += n;
+        lastFrameEnd = (pushed / HOP_SIZE) * HOP_SIZE;
+    }
+
+    EXPECT_EQ(framesAnalysed, totalSamples / HOP_SIZE);
+
+    YinPitchTracker offline;
+    offline.prepare(SAMPLE_RATE, FRAME_SIZE, HOP_SIZE);
+    const float expected = offline.analyzeFrame(signal.data() + lastFrameEnd - FRAME_SIZE);
+
+    ASSERT_GT(expected, 0.0f);
+    EXPECT_FLOAT_EQ(streaming.getPitch(), expected);
+}
+
+TEST(YinTrackerTest, HopSizeChangeKeepsTracking) {
+    const auto signal = makeHarmonicTone(330.0f, 2 * FRAME_SIZE);
+
+    YinPitchTracker tracker;
+    tracker.prepare(SAMPLE_RATE, FRAME_SIZE, HOP_SIZE);
+    tracker.pushSamples(signal.data(), FRAME_SIZE);
+
+    tracker.setHopSize(128);
+    EXPECT_EQ(tracker.getHopSize(), 128);
+    EXPECT_EQ(tracker.pushSamples(signal.data() + FRAME_SIZE, 1024), 8);
+    EXPECT_NEAR(tracker.getPitch(), 330.0f, 3.3f);
+}
@@ -0,0 +1,343 @@
+/**
+ * test_press_compressor.cpp - Unit tests for The Press's block compressor
+ *
+ * The log-domain block path (fast log2/exp2, vectorized gain computer) must
+ * track the former per-sample transcendental path within a tight tolerance.
+ * The crossover's bands must sum back to a flat magnitude, and the
+ * multiband and sidechain modes must key each band's detector correctly.
+ */
+
+#include <gtest/gtest.h>
+#include "CompressorEngine.h"
+#include "LinkwitzRileyCrossover.h"
+#include "MultibandCompressorEngine.h"
+#include "SignalTestUtils.h"
+#include "daiw/simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace iDAW;
+using TestSignal::rms;
+using TestSignal::sine;
+using TestSignal::TWO_PI;
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+
+/** The former PressProcessor::processBlock() loop */
+class ReferenceCompressor {
+public:
+    explicit ReferenceCompressor(const CompressorParams& params) : m_params(params) {
+        m_window = static_cast<int>(PressConfig::RMS_WINDOW_MS * SAMPLE_RATE / 1000.0);
+        m_rmsBuffer.assign(static_cast<size_t>(m_window), 0.0f);
+        m_attackCoeff = 1.0f - std::exp(-1.0f / (params.attackMs * static_cast<float>(SAMPLE_RATE) / 1000.0f));
+        m_releaseCoeff = 1.0f - std::exp(-1.0f / (params.releaseMs * static_cast<float>(SAMPLE_RATE) / 1000.0f));
+    }
+
+    /** Returns the block's gain reduction meter */
+    float process(std::vector<std::vector<float>>& channels, int offset, int numSamples) {
+        const int numChannels = static_cast<int>(channels.size());
+        const float makeup = std::pow(10.0f, m_params.makeupGainDb / 20.0f);
+        float blockGainReduction = 0.0f;
+
+        for (int sample = offset; sample < offset + numSamples; ++sample) {
+            float sumSquares = 0.0f;
+            for (auto& channel : channels) sumSquares += channel[sample] * channel[sample];
+
+            m_rmsSum -= m_rmsBuffer[m_index];
+            m_rmsBuffer[m_index] = sumSquares / numChannels;
+            m_rmsSum += m_rmsBuffer[m_index];
+            m_index = (m_index + 1) % m_window;
+
+            const float rms = std::sqrt(m_rmsSum / m_window);
+            const float inputDb = 20.0f * std::log10(std::max(rms, 1e-10f));
+            const float target = std::pow(10.0f, CompressorEngine::gainReductionDb(
+                inputDb, m_params.thresholdDb, m_params.ratio) / 20.0f);
+
+            const float coeff = target < m_envelope ? m_attackCoeff : m_releaseCoeff;
+            m_envelope = m_envelope + coeff * (target - m_envelope);
+            blockGainReduction = std::max(blockGainReduction, -20.0f * std::log10(std::max(m_envelope, 1e-10f)));
+
+            for (auto& channel : channels) channel[sample] *= m_envelope * makeup;
+        }
+        return blockGainReduction;
+    }
+
+private:
+    CompressorParams m_params;
+    int m_window = 0;
+    std::vector<float> m_rmsBuffer;
+    int m_index = 0;
+    float m_rmsSum = 0.0f;
+    float m_attackCoeff = 0.0f;
+    float m_releaseCoeff = 0.0f;
+    float m_envelope = 1.0f;
+};
+
+/** Stereo bursts at stepped levels: exercises attack, knee, release and silence */
+std::vector<std::vector<float>> testSignal(int length) {
+    std::vector<std::vector<float>> channels(2, std::vector<float>(static_cast<size_t>(length)));
+    const float levelsDb[] = {-40.0f, -22.0f, -6.0f, -18.0f, 0.0f, -100.0f};
+    for (int i = 0; i < length; ++i) {
+        const float level = std::pow(10.0f, levelsDb[(i / 4000) % 6] / 20.0f);
+        channels[0][i] = level * static_cast<float>(std::sin(TWO_PI * 220.0 * i / SAMPLE_RATE));
+        channels[1][i] = level * static_cast<float>(std::sin(TWO_PI * 331.0 * i / SAMPLE_RATE + 1.0));
+    }
+    return channels;
+}
+
+} // namespace
+
+// ============================================================================
+// Gain curve
+// ============================================================================
+
+TEST(CompressorEngine, SoftKneeCurve) {
+    // Below the knee, at the threshold (mid-knee), far above
+    EXPECT_FLOAT_EQ(CompressorEngine::gainReductionDb(-40.0f, -20.0f, 4.0f), 0.0f);
+    EXPECT_NEAR(CompressorEngine::gainReductionDb(-20.0f, -20.0f, 4.0f), 0.0f, 1e-6f);
+    EXPECT_NEAR(CompressorEngine::gainReductionDb(0.0f, -20.0f, 4.0f), -15.0f, 1e-5f);
+
+    // Continuous at both knee edges
+    for (float edge : {-23.0f, -17.0f}) {
+        EXPECT_NEAR(CompressorEngine::gainReductionDb(edge - 1e-3f, -20.0f, 4.0f),
+                    CompressorEngine::gainReductionDb(edge + 1e-3f, -20.0f, 4.0f), 1e-2f);
+    }
+}
+
+// ============================================================================
+// Legacy equivalence
+// ============================================================================
+
+class PressSettings : public ::testing::TestWithParam<CompressorParams> {};
+
+TEST_P(PressSettings, MatchesPerSampleLoop) {
+    const CompressorParams params = GetParam();
+    const int length = 6 * 4000 * 2;
+
+    auto expected = testSignal(length);
+    auto actual = expected;
+
+    ReferenceCompressor reference(params);
+    CompressorEngine engine;
+    engine.setParameters(params);
+    engine.prepare(SAMPLE_RATE, 256);
+
+    // Odd host block sizes, including one larger than the prepared size
+    const int blocks[] = {256, 100, 511, 7, 256, 64};
+    int offset = 0;
+    for (int b = 0; offset < length; ++b) {
+        const int n = std::min(blocks[b % 6], length - offset);
+        const float expectedGr = reference.process(expected, offset, n);
+
+        float* channels[2] = {actual[0].data() + offset, actual[1].data() + offset};
+        engine.process(channels, 2, n);
+        ASSERT_NEAR(engine.getGainReductionDb(), expectedGr, 0.01f) << "offset " << offset;
+        offset += n;
+    }
+
+    for (int ch = 0; ch < 2; ++ch) {
+        for (int i = 0; i < length; ++i) {
+            ASSERT_NEAR(actual[ch][i], expected[ch][i], 1e-4f) << "ch " << ch << ", i = " << i;
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Presets, PressSettings, ::testing::Values(
+    CompressorParams{-20.0f, 4.0f, 10.0f, 100.0f, 0.0f, false},   // Default
+    CompressorParams{-20.0f, 4.0f, 30.0f, 150.0f, 3.0f, false},   // Punchy + makeup
+    CompressorParams{-30.0f, 2.0f, 1.0f, 300.0f, 0.0f, false},    // Glue
+    CompressorParams{-10.0f, 20.0f, 0.1f, 10.0f, 0.0f, false}));  // Near-limiting
+
+// ============================================================================
+// Robustness
+// ============================================================================
+
+TEST(CompressorEngine, SilenceAfterLoudPassageStaysFinite) {
+    CompressorEngine engine;
+    engine.prepare(SAMPLE_RATE, 512);
+
+    // Running-sum drift after a loud burst must not reach sqrt/log of a negative
+    std::vector<float> block(512);
+    float* channels[1] = {block.data()};
+    for (int b = 0; b < 400; ++b) {
+        for (int i = 0; i < 512; ++i) {
+            block[i] = b < 20 ? static_cast<float>(std::sin(0.37 * (b * 512 + i))) : 0.0f;
+        }
+        engine.process(channels, 1, 512);
+        ASSERT_TRUE(std::isfinite(engine.getGainReductionDb())) << "block " << b;
+        for (float s : block) ASSERT_TRUE(std::isfinite(s));
+    }
+    EXPECT_LT(engine.getGainReductionDb(), 0.01f);
+}
+
+// ============================================================================
+// Crossover
+// ============================================================================
+
+namespace {
+
+/** Steady-state RMS of the second half of a buffer */
+float tailRms(const std::vector<float>& x) { return rms(x, x.size() / 2); }
+
+} // namespace
+
+TEST(LinkwitzRileyCrossover, BandsSumToFlatMagnitude) {
+    const float crossovers[] = {150.0f, 1500.0f, 9000.0f};
+    const int length = 16384;
+
+    for (int numBands = 2; numBands <= 4; ++numBands) {
+        LinkwitzRileyCrossover crossover;
+        crossover.setCrossovers(SAMPLE_RATE, crossovers, numBands);
+
+        std::vector<std::vector<float>> storage(LinkwitzRileyCrossover::MAX_BANDS * 2,
+                                                std::vector<float>(static_cast<size_t>(length)));
+        LinkwitzRileyCrossover::BandBuffers bands{};
+        for (int b = 0; b < LinkwitzRileyCrossover::MAX_BANDS; ++b) {
+            for (int ch = 0; ch < 2; ++ch) bands[b][ch] = storage[static_cast<size_t>(b * 2 + ch)].data();
+        }
+
+        for (double frequency : {60.0, 150.0, 700.0, 1500.0, 5000.0, 9000.0, 15000.0}) {
+            crossover.reset();
+            const auto left = sine(length, frequency);
+            const auto right = sine(length, frequency * 1.1);
+            const float* input[2] = {left.data(), right.data()};
+
+            // Odd block sizes exercise the tile tails
+            for (int offset = 0; offset < length;) {
+                const int n = std::min(offset % 3 == 0 ? 203 : 64, length - offset);
+                const float* in[2] = {input[0] + offset, input[1] + offset};
+                LinkwitzRileyCrossover::BandBuffers out = bands;
+                for (auto& band : out) for (auto& ch : band) ch += offset;
+                crossover.process(in, 2, out, n);
+                offset += n;
+            }
+
+            for (int ch = 0; ch < 2; ++ch) {
+                std::vector<float> sum(static_cast<size_t>(length), 0.0f);
+                for (int b = 0; b < numBands; ++b) {
+                    for (int i = 0; i < length; ++i) sum[i] += bands[b][ch][i];
+                }
+                EXPECT_NEAR(tailRms(sum), tailRms(ch == 0 ? left : right), 0.01f)
+                    << numBands << " bands, " << frequency << " Hz, ch " << ch;
+            }
+        }
+    }
+}
+
+TEST(LinkwitzRileyCrossover, BandsMeetAtMinusSixDb) {
+    const float crossovers[] = {1000.0f};
+    LinkwitzRileyCrossover crossover;
+    crossover.setCrossovers(SAMPLE_RATE, crossovers, 2);
+
+    const int length = 8192;
+    const auto input = sine(length, 1000.0);
+    std::vector<float> low(static_cast<size_t>(length)), high(static_cast<size_t>(length));
+    const float* in[1] = {input.data()};
+    LinkwitzRileyCrossover::BandBuffers bands{};
+    bands[0][0] = low.data();
+    bands[1][0] = high.data();
+    crossover.process(in, 1, bands, length);
+
+    const float halfAmplitude = 0.5f * tailRms(input);
+    EXPECT_NEAR(tailRms(low), halfAmplitude, 0.005f);
+    EXPECT_NEAR(tailRms(high), halfAmplitude, 0.005f);
+}
+
+// ============================================================================
+// Multiband and sidechain
+// ============================================================================
+
+TEST(MultibandCompressorEngine, UnityBandsMatchCrossoverSum) {
+    MultibandParams params;
+    params.numBands = 4;
+    params.crossoverHz = {120.0f, 1200.0f, 6000.0f};
+    for (auto& band : params.bands) band = CompressorParams{0.0f, 1.0f, 10.0f, 100.0f, 0.0f, false};
+
+    const int length = 8000;
+    auto signal = testSignal(length);
+    auto expected = signal;
+
+    MultibandCompressorEngine engine;
+    engine.setParameters(params);
+    engine.prepare(SAMPLE_RATE, 256);
+
+    LinkwitzRileyCrossover crossover;
+    crossover.setCrossovers(SAMPLE_RATE, params.crossoverHz.data(), params.numBands);
+    std::vector<std::vector<float>> storage(8, std::vector<float>(static_cast<size_t>(length)));
+    LinkwitzRileyCrossover::BandBuffers bands{};
+    for (int b = 0; b < 4; ++b) {
+        for (int ch = 0; ch < 2; ++ch) bands[b][ch] = storage[static_cast<size_t>(b * 2 + ch)].data();
+    }
+    const float* in[2] = {signal[0].data(), signal[1].data()};
+    crossover.process(in, 2, bands, length);
+    for (int ch = 0; ch < 2; ++ch) {
+        for (int i = 0; i < length; ++i) {
+            expected[ch][i] = bands[0][ch][i] + bands[1][ch][i] + bands[2][ch][i] + bands[3][ch][i];
+        }
+    }
+
+    float* channels[2] = {signal[0].data(), signal[1].data()};
+    engine.process(channels, 2, length);
+
+    for (int ch = 0; ch < 2; ++ch) {
+        for (int i = 0; i < length; ++i) {
+            ASSERT_NEAR(signal[ch][i], expected[ch][i], 1e-5f) << "ch " << ch << ", i = " << i;
+        }
+    }
+    for (int b = 0; b < 4; ++b) EXPECT_LT(engine.getGainReductionDb(b), 1e-3f);
+}
+
+TEST(MultibandCompressorEngine, LoudBandIsCompressedAlone) {
+    MultibandParams params;
+    params.numBands = 2;
+    params.crossoverHz[0] = 1000.0f;
+    for (auto& band : params.bands) band = CompressorParams{-30.0f, 8.0f, 1.0f, 100.0f, 0.0f, false};
+
+    MultibandCompressorEngine engine;
+    engine.setParameters(params);
+    engine.prepare(SAMPLE_RATE, 512);
+
+    // Loud bass, quiet treble
+    const auto bass = sine(512, 100.0);
+    const auto treble = sine(512, 8000.0);
+    std::vector<float> block(512);
+    float* channels[1] = {block.data()};
+    for (int b = 0; b < 40; ++b) {
+        for (int i = 0; i < 512; ++i) block[i] = 0.5f * bass[i] + 0.01f * treble[i];
+        engine.process(channels, 1, 512);
+    }
+
+    EXPECT_GT(engine.getGainReductionDb(0), 10.0f);
+    EXPECT_LT(engine.getGainReductionDb(1), 0.01f);
+}
+
+TEST(CompressorEngine, SidechainKeyDrivesGainReduction) {
+    CompressorEngine engine;
+    engine.setParameters(CompressorParams{-20.0f, 4.0f, 1.0f, 50.0f, 0.0f, false});
+    engine.prepare(SAMPLE_RATE, 512);
+
+    // Quiet program, loud key: the program is ducked
+    std::vector<float> program(512), key(512);
+    float* channels[1] = {program.data()};
+    const float* sidechain[1] = {key.data()};
+    for (int b = 0; b < 20; ++b) {
+        for (int i = 0; i < 512; ++i) {
+            program[i] = 0.01f * static_cast<float>(std::sin(0.05 * (b * 512 + i)));
+            key[i] = static_cast<float>(std::sin(0.013 * (b * 512 + i)));
+        }
+        engine.process(channels, 1, 512, sidechain, 1);
+    }
+    EXPECT_GT(engine.getGainReductionDb(), 10.0f);
+    EXPECT_LT(daiw::simd::find_peak(program.data(), program.size()), 0.01f * 0.3f);
+
+    // Without the key, the same quiet program passes untouched
+    engine.reset();
+    for (int b = 0; b < 20; ++b) {
+        for (int i = 0; i < 512; ++i) program[i] = 0.01f * static_cast<float>(std::sin(0.05 * (b * 512 + i)));
+        engine.process(channels, 1, 512);
+    }
+    EXPECT_LT(engine.getGainReductionDb(), 0.01f);
+}
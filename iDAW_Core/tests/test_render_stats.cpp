@@ -0,0 +1,67 @@
+/**
+ * test_render_stats.cpp - Unit tests for the render harness's block statistics
+ *
+ * Percentiles are nearest-rank, the realtime factor compares audio length
+ * with time spent processing, and overruns count blocks over budget.
+ */
+
+#include <gtest/gtest.h>
+#include "RenderStats.h"
+#include <vector>
+
+using namespace iDAW;
+
+// ============================================================================
+// Percentiles
+// ============================================================================
+
+TEST(RenderStats, NearestRankPercentiles) {
+    std::vector<double> sorted;
+    for (int i = 1; i <= 1000; ++i) sorted.push_back(static_cast<double>(i));
+
+    EXPECT_DOUBLE_EQ(RenderStats::percentile(sorted, 50.0), 500.0);
+    EXPECT_DOUBLE_EQ(RenderStats::percentile(sorted, 90.0), 900.0);
+    EXPECT_DOUBLE_EQ(RenderStats::percentile(sorted, 99.9), 999.0);
+    EXPECT_DOUBLE_EQ(RenderStats::percentile(sorted, 100.0), 1000.0);
+    EXPECT_DOUBLE_EQ(RenderStats::percentile(sorted, 0.0), 1.0);
+    EXPECT_DOUBLE_EQ(RenderStats::percentile({}, 50.0), 0.0);
+    EXPECT_DOUBLE_EQ(RenderStats::percentile({7.0}, 99.0), 7.0);
+}
+
+// ============================================================================
+// Reports
+// ============================================================================
+
+TEST(RenderStats, SummarizesBlocksAgainstBudget) {
+    // 480-sample blocks at 48 kHz: a 10 ms budget
+    RenderStats stats;
+    stats.reserve(100);
+    for (int i = 0; i < 98; ++i) stats.record(1000.0);
+    stats.record(12000.0);   // One overrun
+    stats.record(5000.0);
+
+    const RenderReport report = stats.summarize(480, 48000.0);
+    EXPECT_EQ(report.numBlocks, 100);
+    EXPECT_DOUBLE_EQ(report.budgetUs, 10000.0);
+    EXPECT_DOUBLE_EQ(report.audioSeconds, 1.0);
+    EXPECT_NEAR(report.cpuSeconds, 0.115, 1e-12);
+    EXPECT_NEAR(report.realtimeFactor, 1.0 / 0.115, 1e-9);
+
+    EXPECT_NEAR(report.meanUs, 1150.0, 1e-9);
+    EXPECT_DOUBLE_EQ(report.p50Us, 1000.0);
+    EXPECT_DOUBLE_EQ(report.p90Us, 1000.0);
+    EXPECT_DOUBLE_EQ(report.p99Us, 5000.0);
+    EXPECT_DOUBLE_EQ(report.maxUs, 12000.0);
+    EXPECT_DOUBLE_EQ(report.maxCpuPercent, 120.0);
+    EXPECT_EQ(report.overruns, 1);
+}
+
+TEST(RenderStats, EmptyRenderReportsZeros) {
+    RenderStats stats;
+    const RenderReport report = stats.summarize(512, 44100.0);
+    EXPECT_EQ(report.numBlocks, 0);
+    EXPECT_DOUBLE_EQ(report.realtimeFactor, 0.0);
+    EXPECT_DOUBLE_EQ(report.maxUs, 0.0);
+    EXPECT_EQ(report.overruns, 0);
+    EXPECT_GT(report.budgetUs, 0.0);
+}
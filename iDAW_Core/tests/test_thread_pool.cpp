@@ -0,0 +1,120 @@
+/**
+ * test_thread_pool.cpp - Unit tests for the Side B batch worker pool
+ */
+
+#include <gtest/gtest.h>
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace iDAW;
+
+TEST(ThreadPoolTest, VisitsEveryIndexOnce) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4u);
+
+    std::vector<std::atomic<int>> visits(1000);
+    std::atomic<bool> badWorker{false};
+    pool.parallelFor(visits.size(), [&](size_t index, size_t worker) {
+        if (worker >= pool.size()) badWorker = true;
+        ++visits[index];
+    });
+
+    EXPECT_FALSE(badWorker);
+    for (const auto& v : visits) EXPECT_EQ(v.load(), 1);
+}
+
+TEST(ThreadPoolTest, NestedCallsRunInline) {
+    ThreadPool pool(4);
+    std::atomic<int> total{0};
+    pool.parallelFor(8, [&](size_t, size_t) {
+        pool.parallelFor(8, [&](size_t, size_t) { ++total; });
+    });
+    EXPECT_EQ(total.load(), 64);
+}
+
+TEST(ThreadPoolTest, CapsWorkersPerCall) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.workerCount(0), 4u);
+    EXPECT_EQ(pool.workerCount(2), 2u);
+    EXPECT_EQ(pool.workerCount(64), 4u);
+
+    std::vector<std::atomic<int>> visits(1000);
+    std::atomic<bool> badWorker{false};
+    pool.parallelFor(visits.size(), [&](size_t index, size_t worker) {
+        if (worker >= 2) badWorker = true;
+        ++visits[index];
+    }, 2);
+
+    EXPECT_FALSE(badWorker);
+    for (const auto& v : visits) EXPECT_EQ(v.load(), 1);
+
+    // A cap of one runs on the caller
+    const auto caller = std::this_thread::get_id();
+    std::atomic<bool> offCaller{false};
+    pool.parallelFor(100, [&](size_t, size_t) {
+        if (std::this_thread::get_id() != caller) offCaller = true;
+    }, 1);
+    EXPECT_FALSE(offCaller);
+}
+
+TEST(ThreadPoolTest, RethrowsFromAnyWorker) {
+    ThreadPool pool(4);
+
+    // Thrown by every index, so both the caller and the workers throw
+    EXPECT_THROW(pool.parallelFor(1000, [](size_t, size_t) { throw std::runtime_error("all"); }),
+                 std::runtime_error);
+
+    // Thrown by one index only, whichever worker picks it up
+    std::atomic<int> ran{0};
+    EXPECT_THROW(pool.parallelFor(1000, [&](size_t index, size_t) {
+                     ++ran;
+                     if (index == 500) throw std::out_of_range("one");
+                 }),
+                 std::out_of_range);
+    EXPECT_GE(ran.load(), 1);
+
+    // The pool is still usable and no stale exception is reported
+    std::atomic<int> total{0};
+    EXPECT_NO_THROW(pool.parallelFor(100, [&](size_t, size_t) { ++total; }));
+    EXPECT_EQ(total.load(), 100);
+}
+
+TEST(ThreadPoolTest, RethrowsFromWorkerThread) {
+    ThreadPool pool(2);
+
+    // The caller holds its index until a worker has thrown
+    std::atomic<bool> workerThrew{false};
+    EXPECT_THROW(pool.parallelFor(2, [&](size_t, size_t worker) {
+                     if (worker == 0) {
+                         while (!workerThrew) std::this_thread::yield();
+                         return;
+                     }
+                     workerThrew = true;
+                     throw std::runtime_error("worker");
+                 }),
+                 std::runtime_error);
+}
+
+TEST(ThreadPoolTest, CallerThrowWaitsForWorkers) {
+    ThreadPool pool(2);
+
+    // The caller throws while a worker is still inside fn
+    std::atomic<int> inFlight{0};
+    EXPECT_THROW(pool.parallelFor(2, [&](size_t, size_t worker) {
+                     if (worker != 0) {
+                         ++inFlight;
+                         std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                         --inFlight;
+                         return;
+                     }
+                     while (inFlight == 0) std::this_thread::yield();
+                     throw std::runtime_error("caller");
+                 }),
+                 std::runtime_error);
+    EXPECT_EQ(inFlight.load(), 0);
+}
@@ -0,0 +1,146 @@
+/**
+ * test_trace_delay.cpp - Unit tests for The Trace's block delay engine
+ *
+ * Every interpolation kernel must land an impulse at the set delay, and the
+ * linear kernel must reproduce the former per-sample delay line.
+ */
+
+#include <gtest/gtest.h>
+#include "SignalTestUtils.h"
+#include "TapeDelayEngine.h"
+#include <cmath>
+#include <vector>
+
+using namespace iDAW;
+using TestSignal::TWO_PI;
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr int BLOCK = 256;
+
+TapeDelayParameters dryDelay(float delaySamples, DelayInterpolation mode) {
+    TapeDelayParameters params;
+    params.delaySamples = delaySamples;
+    params.feedback = 0.0f;
+    params.mix = 1.0f;
+    params.tapeSaturation = false;
+    params.interpolation = mode;
+    return params;
+}
+
+void runMono(TapeDelayEngine& engine, std::vector<float>& signal, const TapeDelayParameters& params) {
+    TestSignal::processInBlocks(signal.size(), BLOCK, [&](size_t offset, int n) {
+        float* channels[1] = {signal.data() + offset};
+        engine.process(channels, 1, n, params);
+    });
+}
+
+} // namespace
+
+// ============================================================================
+// Integer delays
+// ============================================================================
+
+class TraceInterpolation : public ::testing::TestWithParam<DelayInterpolation> {};
+
+TEST_P(TraceInterpolation, ImpulseArrivesAtDelay) {
+    TapeDelayEngine engine;
+    engine.prepare(SAMPLE_RATE, BLOCK, 4000.0f);
+
+    // Spans several blocks and wraps the power-of-two buffer
+    const int delay = 3001;
+    EXPECT_EQ(engine.getBufferSize() & (engine.getBufferSize() - 1), 0);
+
+    std::vector<float> signal(static_cast<size_t>(engine.getBufferSize() * 2), 0.0f);
+    signal[5000] = 1.0f;
+    runMono(engine, signal, dryDelay(static_cast<float>(delay), GetParam()));
+
+    for (size_t i = 0; i < signal.size(); ++i) {
+        EXPECT_NEAR(signal[i], i == 5000 + delay ? 1.0f : 0.0f, 1e-6f) << "i = " << i;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Kernels, TraceInterpolation,
+                         ::testing::Values(DelayInterpolation::Linear,
+                                           DelayInterpolation::Cubic,
+                                           DelayInterpolation::Allpass));
+
+// ============================================================================
+// Fractional delays
+// ============================================================================
+
+TEST(TapeDelayEngine, FractionalDelayShiftsPhase) {
+    // A low sine delayed by 100.25 samples under each kernel
+    const double freq = 300.0;
+    const float delay = 100.25f;
+
+    for (auto mode : {DelayInterpolation::Linear, DelayInterpolation::Cubic, DelayInterpolation::Allpass}) {
+        TapeDelayEngine engine;
+        engine.prepare(SAMPLE_RATE, BLOCK, 1000.0f);
+
+        std::vector<float> signal = TestSignal::sine(4096, freq);
+        runMono(engine, signal, dryDelay(delay, mode));
+
+        for (size_t i = 1000; i < signal.size(); ++i) {
+            const double expected = std::sin(TWO_PI * freq * (i - delay) / SAMPLE_RATE);
+            EXPECT_NEAR(signal[i], expected, 2e-3) << "mode " << static_cast<int>(mode) << ", i = " << i;
+        }
+    }
+}
+
+// ============================================================================
+// Legacy equivalence
+// ============================================================================
+
+TEST(TapeDelayEngine, LinearMatchesPerSampleDelay) {
+    TapeDelayParameters params;
+    params.delaySamples = 300.0f * 48.0f;
+    params.feedback = 0.5f;
+    params.mix = 0.4f;
+    params.modDepthSamples = 5.0f * 48.0f;
+    params.modRateHz = 2.0f;
+    params.tapeSaturation = true;
+    params.interpolation = DelayInterpolation::Linear;
+
+    const int length = 48000;
+    std::vector<float> input(static_cast<size_t>(length));
+    for (int i = 0; i < length; ++i) {
+        input[i] = static_cast<float>(0.5 * std::sin(TWO_PI * 440.0 * i / SAMPLE_RATE)
+                                      * std::exp(-i / 4000.0));
+    }
+
+    // Former per-sample loop (one channel, no ping-pong)
+    const int bufferSize = 20000;
+    std::vector<float> line(bufferSize, 0.0f);
+    std::vector<float> expected = input;
+    int writeIndex = 0;
+    double lfoPhase = 0.0;
+    for (int i = 0; i < length; ++i) {
+        lfoPhase += params.modRateHz / SAMPLE_RATE;
+        if (lfoPhase >= 1.0) lfoPhase -= 1.0;
+        const float delay = params.delaySamples
+            + static_cast<float>(std::sin(TWO_PI * lfoPhase)) * params.modDepthSamples;
+
+        int indexA = writeIndex - static_cast<int>(delay);
+        int indexB = indexA - 1;
+        while (indexA < 0) indexA += bufferSize;
+        while (indexB < 0) indexB += bufferSize;
+        const float frac = delay - std::floor(delay);
+        float delayed = line[indexA] * (1.0f - frac) + line[indexB] * frac;
+        delayed = std::tanh(delayed * 2.0f) / std::tanh(2.0f);
+
+        line[writeIndex] = expected[i] + delayed * params.feedback;
+        writeIndex = (writeIndex + 1) % bufferSize;
+        expected[i] = expected[i] * (1.0f - params.mix) + delayed * params.mix;
+    }
+
+    TapeDelayEngine engine;
+    engine.prepare(SAMPLE_RATE, BLOCK, static_cast<float>(bufferSize - 1));
+    std::vector<float> actual = input;
+    runMono(engine, actual, params);
+
+    for (int i = 0; i < length; ++i) {
+        ASSERT_NEAR(actual[i], expected[i], 1e-3f) << "i = " << i;
+    }
+}
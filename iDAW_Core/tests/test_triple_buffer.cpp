@@ -0,0 +1,152 @@
+/**
+ * test_triple_buffer.cpp - Unit and stress tests for TripleBuffer
+ */
+
+#include <gtest/gtest.h>
+#include "TripleBuffer.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace iDAW;
+
+// ============================================================================
+// Basic Tests
+// ============================================================================
+
+TEST(TripleBufferTest, InitialState) {
+    TripleBuffer<std::vector<int>> buffer(std::vector<int>(8, 7));
+
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.readBuffer().size(), 8u);
+    EXPECT_EQ(buffer.readBuffer()[0], 7);
+}
+
+TEST(TripleBufferTest, PublishUpdate) {
+    TripleBuffer<int> buffer;
+
+    buffer.writeBuffer() = 1;
+    buffer.publish();
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.readBuffer(), 1);
+
+    // Nothing new since last update
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.readBuffer(), 1);
+}
+
+TEST(TripleBufferTest, ReaderSeesLatestOnly) {
+    TripleBuffer<int> buffer;
+
+    for (int i = 1; i <= 5; i++) {
+        buffer.writeBuffer() = i;
+        buffer.publish();
+    }
+
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.readBuffer(), 5);
+}
+
+// ============================================================================
+// Stress Test: audio thread publishes spectral frames and reads a bin mask
+// while the UI thread hammers both in the other direction
+// ============================================================================
+
+namespace {
+
+constexpr int NUM_BINS = 1025;
+
+struct BinState {
+    float magnitude;
+    float phase;
+    bool erased;
+    float intensity;
+};
+
+} // namespace
+
+TEST(TripleBufferTest, SpectralStateStress) {
+    TripleBuffer<std::vector<BinState>> spectral(std::vector<BinState>(NUM_BINS, BinState{0, 0, false, 0}));
+    TripleBuffer<std::vector<uint8_t>> mask(std::vector<uint8_t>(NUM_BINS, 0));
+
+    constexpr int AUDIO_FRAMES = 20000;
+    std::atomic<bool> uiStarted{false};
+    std::atomic<bool> audioDone{false};
+    std::atomic<int> tornSpectralFrames{0};
+    std::atomic<int> tornMasks{0};
+    std::atomic<int> outOfOrderFrames{0};
+    std::atomic<int> uiSnapshots{0};
+
+    // Audio thread: one frame per hop, every bin stamped with the frame number
+    std::thread audio([&] {
+        while (!uiStarted) {
+            std::this_thread::yield();
+        }
+        for (int frame = 1; frame <= AUDIO_FRAMES; frame++) {
+            mask.update();
+            const auto& bins = mask.readBuffer();
+            const uint8_t stamp = bins[0];
+            for (int b = 0; b < NUM_BINS; b++) {
+                if (bins[b] != stamp) {
+                    tornMasks++;
+                    break;
+                }
+            }
+
+            auto& state = spectral.writeBuffer();
+            for (int b = 0; b < NUM_BINS; b++) {
+                state[b].magnitude = static_cast<float>(frame);
+                state[b].phase = -static_cast<float>(frame);
+                state[b].erased = (frame & 1) != 0;
+                state[b].intensity = static_cast<float>(frame) * 0.5f;
+            }
+            spectral.publish();
+        }
+        audioDone = true;
+    });
+
+    // UI thread: read snapshots as fast as possible, write masks in between
+    std::thread ui([&] {
+        float lastFrame = 0.0f;
+        uint8_t maskStamp = 0;
+        uiStarted = true;
+        while (!audioDone) {
+            if (spectral.update()) {
+                const auto& state = spectral.readBuffer();
+                const float frame = state[0].magnitude;
+                for (int b = 0; b < NUM_BINS; b++) {
+                    if (state[b].magnitude != frame ||
+                        state[b].phase != -frame ||
+                        state[b].erased != ((static_cast<int>(frame) & 1) != 0) ||
+                        state[b].intensity != frame * 0.5f) {
+                        tornSpectralFrames++;
+                        break;
+                    }
+                }
+                if (frame < lastFrame) {
+                    outOfOrderFrames++;
+                }
+                lastFrame = frame;
+                uiSnapshots++;
+            }
+
+            auto& bins = mask.writeBuffer();
+            maskStamp++;
+            std::fill(bins.begin(), bins.end(), maskStamp);
+            mask.publish();
+        }
+    });
+
+    audio.join();
+    ui.join();
+
+    EXPECT_EQ(tornSpectralFrames.load(), 0);
+    EXPECT_EQ(tornMasks.load(), 0);
+    EXPECT_EQ(outOfOrderFrames.load(), 0);
+    EXPECT_GT(uiSnapshots.load(), 0);
+
+    // The reader always ends on the last published frame
+    spectral.update();
+    EXPECT_EQ(spectral.readBuffer()[NUM_BINS - 1].magnitude, static_cast<float>(AUDIO_FRAMES));
+}
@@ -0,0 +1,249 @@
+/**
+ * RenderHarness.cpp - Headless offline render of one iDAW plugin
+ */
+
+#include "RenderHarness.h"
+#include "RenderStats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace iDAW {
+
+namespace {
+
+constexpr int DEFAULT_BLOCK_SIZE = 512;
+constexpr int MAX_BLOCK_SIZE = 65536;
+constexpr double PATTERN_BEAT_SECONDS = 0.5;    // 120 BPM
+
+void printUsage(const juce::String& pluginName) {
+    std::fprintf(stderr,
+                 "Usage: idaw_render_%s input.wav [--block N[,N...]] [--passes N]\n"
+                 "       [--state FILE] [--aux FILE] [--output FILE]\n",
+                 pluginName.toLowerCase().toRawUTF8());
+}
+
+/** Returns false (after printing why) on a malformed command line */
+bool parseOptions(const juce::StringArray& args, RenderOptions& options) {
+    for (int i = 0; i < args.size(); ++i) {
+        const juce::String& arg = args[i];
+
+        if (!arg.startsWith("--")) {
+            if (options.input != juce::File()) {
+                std::fprintf(stderr, "Unexpected argument: %s\n", arg.toRawUTF8());
+                return false;
+            }
+            options.input = juce::File::getCurrentWorkingDirectory().getChildFile(arg);
+            continue;
+        }
+
+        if (i + 1 >= args.size()) {
+            std::fprintf(stderr, "Missing value for %s\n", arg.toRawUTF8());
+            return false;
+        }
+        const juce::String value = args[++i];
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(value);
+
+        if (arg == "--block") {
+            for (const auto& size : juce::StringArray::fromTokens(value, ",", {})) {
+                const int blockSize = size.getIntValue();
+                if (blockSize < 1 || blockSize > MAX_BLOCK_SIZE) {
+                    std::fprintf(stderr, "Block size out of range (1 - %d): %s\n", MAX_BLOCK_SIZE,
+                                 size.toRawUTF8());
+                    return false;
+                }
+                options.blockSizes.add(blockSize);
+            }
+        } else if (arg == "--passes") {
+            options.passes = std::max(1, value.getIntValue());
+        } else if (arg == "--state") {
+            options.state = file;
+        } else if (arg == "--aux") {
+            options.aux = file;
+        } else if (arg == "--output") {
+            options.output = file;
+        } else {
+            std::fprintf(stderr, "Unknown option: %s\n", arg.toRawUTF8());
+            return false;
+        }
+    }
+
+    if (options.input == juce::File()) {
+        std::fprintf(stderr, "No input file\n");
+        return false;
+    }
+    if (options.blockSizes.isEmpty()) options.blockSizes.add(DEFAULT_BLOCK_SIZE);
+    return true;
+}
+
+/** C, Am, F, G: one chord per beat, held for 80% of it */
+void addChordPattern(juce::MidiBuffer& midi, juce::int64 blockStart, int numSamples, double sampleRate) {
+    static constexpr int CHORDS[4][3] = {{60, 64, 67}, {57, 60, 64}, {53, 57, 60}, {55, 59, 62}};
+    const auto beat = std::max<juce::int64>(1, static_cast<juce::int64>(sampleRate * PATTERN_BEAT_SECONDS));
+    const auto noteLength = beat * 4 / 5;
+    const juce::int64 blockEnd = blockStart + numSamples;
+
+    // A note-off can fall in the block after its beat
+    for (juce::int64 k = std::max<juce::int64>(0, blockStart / beat - 1); k * beat < blockEnd; ++k) {
+        const auto& chord = CHORDS[k % 4];
+        const juce::int64 on = k * beat;
+        const juce::int64 off = on + noteLength;
+
+        for (int note : chord) {
+            if (off >= blockStart && off < blockEnd) {
+                midi.addEvent(juce::MidiMessage::noteOff(1, note), static_cast<int>(off - blockStart));
+            }
+            if (on >= blockStart && on < blockEnd) {
+                midi.addEvent(juce::MidiMessage::noteOn(1, note, static_cast<juce::uint8>(100)),
+                              static_cast<int>(on - blockStart));
+            }
+        }
+    }
+}
+
+/**
+ * Stream source through processor in blocks of blockSize (the last block
+ * zero-padded) and time every processBlock() call. The first pass's main
+ * output is kept in rendered when given.
+ */
+RenderReport renderWithBlockSize(juce::AudioProcessor& processor, const juce::AudioBuffer<float>& source,
+                                 double sampleRate, int blockSize, int passes,
+                                 juce::AudioBuffer<float>* rendered) {
+    const int numMainInputs = processor.getMainBusNumInputChannels();
+    const int numMainOutputs = processor.getMainBusNumOutputChannels();
+    const int numChannels = std::max({processor.getTotalNumInputChannels(),
+                                      processor.getTotalNumOutputChannels(), 1});
+    const int totalSamples = source.getNumSamples();
+    const int blocksPerPass = (totalSamples + blockSize - 1) / blockSize;
+
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+    juce::MidiBuffer midi;
+    midi.ensureSize(256);
+
+    RenderStats stats;
+    stats.reserve(static_cast<size_t>(blocksPerPass) * static_cast<size_t>(passes));
+
+    if (rendered != nullptr) rendered->setSize(std::max(numMainOutputs, 1), totalSamples);
+
+    juce::int64 timeline = 0;
+    for (int pass = 0; pass < passes; ++pass) {
+        for (int start = 0; start < totalSamples; start += blockSize) {
+            const int count = std::min(blockSize, totalSamples - start);
+
+            buffer.clear();
+            for (int channel = 0; channel < numMainInputs; ++channel) {
+                buffer.copyFrom(channel, 0, source, channel % source.getNumChannels(), start, count);
+            }
+
+            midi.clear();
+            if (processor.acceptsMidi()) addChordPattern(midi, timeline, blockSize, sampleRate);
+
+            const auto blockStart = std::chrono::high_resolution_clock::now();
+            processor.processBlock(buffer, midi);
+            const auto blockEnd = std::chrono::high_resolution_clock::now();
+            stats.record(std::chrono::duration<double, std::micro>(blockEnd - blockStart).count());
+
+            if (rendered != nullptr && pass == 0) {
+                for (int channel = 0; channel < rendered->getNumChannels() && channel < numChannels; ++channel) {
+                    rendered->copyFrom(channel, start, buffer, channel, 0, count);
+                }
+            }
+            timeline += blockSize;
+        }
+    }
+
+    return stats.summarize(blockSize, sampleRate);
+}
+
+bool writeWav(const juce::File& file, const juce::AudioBuffer<float>& audio, double sampleRate) {
+    file.deleteFile();
+    std::unique_ptr<juce::FileOutputStream> stream(file.createOutputStream());
+    if (stream == nullptr) return false;
+
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(
+        stream.get(), sampleRate, static_cast<unsigned int>(audio.getNumChannels()), 24, {}, 0));
+    if (writer == nullptr) return false;
+
+    stream.release();  // Owned by the writer now
+    return writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples());
+}
+
+} // namespace
+
+int runRenderHarness(int argc, char* argv[], const juce::String& pluginName,
+                     const RenderProcessorFactory& createProcessor, const RenderProcessorSetup& setup) {
+    const juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i) args.add(juce::String::fromUTF8(argv[i]));
+
+    RenderOptions options;
+    if (!parseOptions(args, options)) {
+        printUsage(pluginName);
+        return 1;
+    }
+
+    // Source audio
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(options.input));
+    if (reader == nullptr || reader->lengthInSamples <= 0 || reader->numChannels == 0) {
+        std::fprintf(stderr, "Cannot read audio from %s\n", options.input.getFullPathName().toRawUTF8());
+        return 2;
+    }
+
+    const double sampleRate = reader->sampleRate;
+    juce::AudioBuffer<float> source(static_cast<int>(reader->numChannels),
+                                    static_cast<int>(reader->lengthInSamples));
+    reader->read(&source, 0, source.getNumSamples(), 0, true, true);
+
+    juce::MemoryBlock state;
+    if (options.state != juce::File() && !options.state.loadFileAsData(state)) {
+        std::fprintf(stderr, "Cannot read state from %s\n", options.state.getFullPathName().toRawUTF8());
+        return 2;
+    }
+
+    std::printf("plugin,block_size,sample_rate,channels,latency_samples,blocks,audio_seconds,cpu_seconds,"
+                "realtime_factor,mean_us,p50_us,p90_us,p99_us,p999_us,max_us,max_cpu_percent,overruns\n");
+
+    for (int i = 0; i < options.blockSizes.size(); ++i) {
+        const int blockSize = options.blockSizes[i];
+
+        // A fresh instance per block size, prepared as a host would
+        std::unique_ptr<juce::AudioProcessor> processor = createProcessor();
+        if (state.getSize() > 0) processor->setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        processor->setNonRealtime(true);
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        if (setup && !setup(*processor, options)) {
+            std::fprintf(stderr, "%s setup failed\n", pluginName.toRawUTF8());
+            return 3;
+        }
+
+        const bool keepOutput = i == 0 && options.output != juce::File();
+        juce::AudioBuffer<float> rendered;
+        const RenderReport report = renderWithBlockSize(*processor, source, sampleRate, blockSize, options.passes,
+                                                        keepOutput ? &rendered : nullptr);
+
+        std::printf("%s,%d,%.0f,%d,%d,%d,%.3f,%.4f,%.1f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%d\n",
+                    pluginName.toRawUTF8(), report.blockSize, report.sampleRate, source.getNumChannels(),
+                    processor->getLatencySamples(), report.numBlocks, report.audioSeconds, report.cpuSeconds,
+                    report.realtimeFactor, report.meanUs, report.p50Us, report.p90Us, report.p99Us,
+                    report.p999Us, report.maxUs, report.maxCpuPercent, report.overruns);
+        std::fflush(stdout);
+
+        processor->releaseResources();
+
+        if (keepOutput && !writeWav(options.output, rendered, sampleRate)) {
+            std::fprintf(stderr, "Cannot write %s\n", options.output.getFullPathName().toRawUTF8());
+            return 2;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace iDAW
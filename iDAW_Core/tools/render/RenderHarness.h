@@ -0,0 +1,59 @@
+/**
+ * RenderHarness.h - Headless offline render of one iDAW plugin
+ *
+ * Streams a WAV file through a plugin's processBlock() as fast as possible
+ * and reports how long every block took (RenderStats), so plugins can be
+ * compared against their real-time budget and render farms sized:
+ *
+ *   idaw_render_<plugin> input.wav [options]
+ *
+ *   --block N[,N...]   Block sizes to render (default 512), one report each
+ *   --passes N         Times to stream the file per block size (default 1)
+ *   --state FILE       Plugin state to load (getStateInformation() output)
+ *   --aux FILE         Plugin-specific input (Smudge: impulse response WAV)
+ *   --output FILE      Write the first block size's output as 24-bit WAV
+ *
+ * Output is CSV, one row per block size, like the benchmarks. Processors
+ * that accept MIDI get a repeating chord pattern (C, Am, F, G, one chord
+ * per beat at 120 BPM) so instruments render under load.
+ *
+ * Each processor source defines the plugin entry point, so every plugin
+ * gets its own executable (tools/render/render_<plugin>.cpp) that passes
+ * its factory to runRenderHarness().
+ */
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <memory>
+
+namespace iDAW {
+
+struct RenderOptions {
+    juce::File input;
+    juce::File output;
+    juce::File state;
+    juce::File aux;
+    juce::Array<int> blockSizes;
+    int passes = 1;
+};
+
+using RenderProcessorFactory = std::function<std::unique_ptr<juce::AudioProcessor>()>;
+
+/**
+ * Plugin-specific setup, run after prepareToPlay() (e.g. load an IR).
+ * Return false to abort the render.
+ */
+using RenderProcessorSetup = std::function<bool(juce::AudioProcessor&, const RenderOptions&)>;
+
+/**
+ * Parse the command line, render with a fresh processor per block size and
+ * print the CSV report.
+ * @return Process exit code (0 on success)
+ */
+int runRenderHarness(int argc, char* argv[], const juce::String& pluginName,
+                     const RenderProcessorFactory& createProcessor,
+                     const RenderProcessorSetup& setup = {});
+
+} // namespace iDAW
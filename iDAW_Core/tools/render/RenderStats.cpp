@@ -0,0 +1,56 @@
+/**
+ * RenderStats.cpp - Per-block timing summary for the offline render harness
+ */
+
+#include "RenderStats.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace iDAW {
+
+double RenderStats::percentile(const std::vector<double>& sorted, double percent) noexcept {
+    if (sorted.empty()) return 0.0;
+
+    // Smallest value with at least percent% of the values at or below it
+    // (the epsilon keeps e.g. 99.9% of 1000 from rounding up past rank 999)
+    const double exactRank = std::clamp(percent, 0.0, 100.0) / 100.0 * static_cast<double>(sorted.size());
+    const double rank = std::ceil(exactRank - 1e-9);
+    const size_t index = static_cast<size_t>(std::max(rank, 1.0)) - 1;
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+RenderReport RenderStats::summarize(int blockSize, double sampleRate) const {
+    RenderReport report;
+    report.numBlocks = static_cast<int>(m_blockUs.size());
+    report.blockSize = blockSize;
+    report.sampleRate = sampleRate;
+    report.budgetUs = sampleRate > 0.0 ? 1e6 * blockSize / sampleRate : 0.0;
+
+    if (m_blockUs.empty()) return report;
+
+    std::vector<double> sorted = m_blockUs;
+    std::sort(sorted.begin(), sorted.end());
+
+    const double totalUs = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+    report.audioSeconds = sampleRate > 0.0 ? static_cast<double>(report.numBlocks) * blockSize / sampleRate : 0.0;
+    report.cpuSeconds = totalUs * 1e-6;
+    report.realtimeFactor = report.cpuSeconds > 0.0 ? report.audioSeconds / report.cpuSeconds : 0.0;
+
+    report.meanUs = totalUs / static_cast<double>(sorted.size());
+    report.p50Us = percentile(sorted, 50.0);
+    report.p90Us = percentile(sorted, 90.0);
+    report.p99Us = percentile(sorted, 99.0);
+    report.p999Us = percentile(sorted, 99.9);
+    report.maxUs = sorted.back();
+
+    if (report.budgetUs > 0.0) {
+        report.maxCpuPercent = 100.0 * report.maxUs / report.budgetUs;
+        report.overruns = static_cast<int>(
+            sorted.end() - std::upper_bound(sorted.begin(), sorted.end(), report.budgetUs));
+    }
+
+    return report;
+}
+
+} // namespace iDAW
@@ -0,0 +1,70 @@
+/**
+ * RenderStats.h - Per-block timing summary for the offline render harness
+ *
+ * Collects the wall time of every processBlock() call of a render and
+ * summarizes it against the real-time budget (block size / sample rate):
+ * realtime factor, mean and percentile block times, the worst block and
+ * how many blocks overran their budget.
+ *
+ * Percentiles use the nearest-rank method on the recorded blocks.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace iDAW {
+
+/**
+ * Summary of one render
+ */
+struct RenderReport {
+    int numBlocks = 0;
+    int blockSize = 0;
+    double sampleRate = 0.0;
+
+    double audioSeconds = 0.0;      // Audio rendered
+    double cpuSeconds = 0.0;        // Time spent inside processBlock()
+    double realtimeFactor = 0.0;    // audioSeconds / cpuSeconds (> 1 = faster than real time)
+
+    double budgetUs = 0.0;          // Real-time duration of one block
+    double meanUs = 0.0;
+    double p50Us = 0.0;
+    double p90Us = 0.0;
+    double p99Us = 0.0;
+    double p999Us = 0.0;
+    double maxUs = 0.0;             // Worst-case block
+
+    double maxCpuPercent = 0.0;     // Worst block as a share of its budget
+    int overruns = 0;               // Blocks slower than their budget
+};
+
+class RenderStats {
+public:
+    RenderStats() = default;
+
+    /** Preallocate for numBlocks blocks, so recording never allocates */
+    void reserve(size_t numBlocks) { m_blockUs.reserve(numBlocks); }
+
+    void clear() noexcept { m_blockUs.clear(); }
+
+    /** Wall time (microseconds) of one processBlock() call */
+    void record(double microseconds) { m_blockUs.push_back(microseconds); }
+
+    size_t getNumBlocks() const noexcept { return m_blockUs.size(); }
+
+    /**
+     * Summarize the recorded blocks, each blockSize samples long.
+     * All times are zero when nothing was recorded.
+     */
+    RenderReport summarize(int blockSize, double sampleRate) const;
+
+    /** Nearest-rank percentile (0 - 100) of sorted values */
+    static double percentile(const std::vector<double>& sorted, double percent) noexcept;
+
+private:
+    std::vector<double> m_blockUs;
+};
+
+} // namespace iDAW
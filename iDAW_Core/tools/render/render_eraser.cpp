@@ -0,0 +1,14 @@
+/**
+ * render_eraser.cpp - Offline render harness entry for "The Eraser"
+ *
+ * Usage: see RenderHarness.h
+ */
+
+#include "EraserProcessor.h"
+#include "RenderHarness.h"
+
+int main(int argc, char* argv[]) {
+    return iDAW::runRenderHarness(argc, argv, "Eraser", [] {
+        return std::make_unique<iDAW::EraserProcessor>();
+    });
+}
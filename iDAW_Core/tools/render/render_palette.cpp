@@ -0,0 +1,14 @@
+/**
+ * render_palette.cpp - Offline render harness entry for "The Palette"
+ *
+ * Usage: see RenderHarness.h
+ */
+
+#include "PaletteProcessor.h"
+#include "RenderHarness.h"
+
+int main(int argc, char* argv[]) {
+    return iDAW::runRenderHarness(argc, argv, "Palette", [] {
+        return std::make_unique<iDAW::PaletteProcessor>();
+    });
+}
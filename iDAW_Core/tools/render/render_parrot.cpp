@@ -0,0 +1,14 @@
+/**
+ * render_parrot.cpp - Offline render harness entry for "The Parrot"
+ *
+ * Usage: see RenderHarness.h
+ */
+
+#include "ParrotProcessor.h"
+#include "RenderHarness.h"
+
+int main(int argc, char* argv[]) {
+    return iDAW::runRenderHarness(argc, argv, "Parrot", [] {
+        return std::make_unique<iDAW::ParrotProcessor>();
+    });
+}
@@ -0,0 +1,14 @@
+/**
+ * render_pencil.cpp - Offline render harness entry for "The Pencil"
+ *
+ * Usage: see RenderHarness.h
+ */
+
+#include "PencilProcessor.h"
+#include "RenderHarness.h"
+
+int main(int argc, char* argv[]) {
+    return iDAW::runRenderHarness(argc, argv, "Pencil", [] {
+        return std::make_unique<iDAW::PencilProcessor>();
+    });
+}
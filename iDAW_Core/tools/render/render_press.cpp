@@ -0,0 +1,14 @@
+/**
+ * render_press.cpp - Offline render harness entry for "The Press"
+ *
+ * Usage: see RenderHarness.h
+ */
+
+#include "PressProcessor.h"
+#include "RenderHarness.h"
+
+int main(int argc, char* argv[]) {
+    return iDAW::runRenderHarness(argc, argv, "Press", [] {
+        return std::make_unique<iDAW::PressProcessor>();
+    });
+}
@@ -0,0 +1,22 @@
+/**
+ * render_smudge.cpp - Offline render harness entry for "The Smudge"
+ *
+ * The Smudge passes audio through until an IR is loaded: --aux loads an
+ * impulse response WAV, otherwise the "Hall" library space is used.
+ *
+ * Usage: see RenderHarness.h
+ */
+
+#include "SmudgeProcessor.h"
+#include "RenderHarness.h"
+
+int main(int argc, char* argv[]) {
+    return iDAW::runRenderHarness(
+        argc, argv, "Smudge",
+        [] { return std::make_unique<iDAW::SmudgeProcessor>(); },
+        [](juce::AudioProcessor& processor, const iDAW::RenderOptions& options) {
+            auto& smudge = static_cast<iDAW::SmudgeProcessor&>(processor);
+            return options.aux != juce::File() ? smudge.loadIR(options.aux)
+                                               : smudge.loadIRFromLibrary("Hall");
+        });
+}
@@ -0,0 +1,14 @@
+/**
+ * render_trace.cpp - Offline render harness entry for "The Trace"
+ *
+ * Usage: see RenderHarness.h
+ */
+
+#include "TraceProcessor.h"
+#include "RenderHarness.h"
+
+int main(int argc, char* argv[]) {
+    return iDAW::runRenderHarness(argc, argv, "Trace", [] {
+        return std::make_unique<iDAW::TraceProcessor>();
+    });
+}